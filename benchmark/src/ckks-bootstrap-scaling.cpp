@@ -0,0 +1,139 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/*
+ * Strong scaling of CKKS bootstrapping: the same full-slot bootstrapping is run with 1 to 64 threads.
+ * The context and the keys are generated once and shared by all thread counts. Thread counts above
+ * the number of threads available to OpenMP are skipped.
+ */
+
+#define PROFILE
+#include "scheme/ckksrns/gen-cryptocontext-ckksrns.h"
+#include "gen-cryptocontext.h"
+
+#include "benchmark/benchmark.h"
+
+#include <iostream>
+#include <vector>
+
+using namespace lbcrypto;
+
+static std::vector<uint32_t> levelBudget = {4, 4};
+static std::vector<int> threadCounts     = {1, 2, 4, 8, 16, 32, 64};
+
+static void ThreadArguments(benchmark::internal::Benchmark* b) {
+    for (int threads : threadCounts) {
+        b->ArgName("threads")->Arg(threads);
+    }
+}
+
+/*
+ * Context setup utility methods
+ */
+
+struct BootstrapSetup {
+    CryptoContext<DCRTPoly> cc;
+    KeyPair<DCRTPoly> keyPair;
+    Ciphertext<DCRTPoly> ciphertext;
+};
+
+static BootstrapSetup& GetBootstrapSetup() {
+    static BootstrapSetup setup = [] {
+        BootstrapSetup s;
+
+        CCParams<CryptoContextCKKSRNS> parameters;
+        SecretKeyDist secretKeyDist = UNIFORM_TERNARY;
+        parameters.SetSecretKeyDist(secretKeyDist);
+        parameters.SetSecurityLevel(HEStd_128_classic);
+#if NATIVEINT == 128 && !defined(__EMSCRIPTEN__)
+        parameters.SetScalingTechnique(FIXEDAUTO);
+        parameters.SetScalingModSize(78);
+        parameters.SetFirstModSize(89);
+#else
+        parameters.SetScalingTechnique(FLEXIBLEAUTO);
+        parameters.SetScalingModSize(59);
+        parameters.SetFirstModSize(60);
+#endif
+        uint32_t levelsAvailableAfterBootstrap = 10;
+        usint depth = levelsAvailableAfterBootstrap + FHECKKSRNS::GetBootstrapDepth(levelBudget, secretKeyDist);
+        parameters.SetMultiplicativeDepth(depth);
+
+        s.cc = GenCryptoContext(parameters);
+        s.cc->Enable(PKE);
+        s.cc->Enable(KEYSWITCH);
+        s.cc->Enable(LEVELEDSHE);
+        s.cc->Enable(ADVANCEDSHE);
+        s.cc->Enable(FHE);
+
+        usint numSlots = s.cc->GetRingDimension() / 2;
+        s.cc->EvalBootstrapSetup(levelBudget);
+
+        s.keyPair = s.cc->KeyGen();
+        s.cc->EvalMultKeyGen(s.keyPair.secretKey);
+        s.cc->EvalBootstrapKeyGen(s.keyPair.secretKey, numSlots);
+
+        std::vector<double> x(numSlots);
+        for (usint i = 0; i < numSlots; ++i)
+            x[i] = static_cast<double>(i % 16) / 16;
+        // a depleted ciphertext that has used up all of its levels
+        Plaintext ptxt = s.cc->MakeCKKSPackedPlaintext(x, 1, depth - 1);
+        s.ciphertext   = s.cc->Encrypt(s.keyPair.publicKey, ptxt);
+
+        std::cout << "CKKS bootstrapping with ring dimension " << s.cc->GetRingDimension() << " and " << numSlots
+                  << " slots" << std::endl;
+        return s;
+    }();
+    return setup;
+}
+
+/*
+ * CKKS benchmarks
+ */
+
+void CKKSrns_EvalBootstrap(benchmark::State& state) {
+    int threads = state.range(0);
+    if (threads > OpenFHEParallelControls.GetMachineThreads()) {
+        state.SkipWithError("more threads than available to OpenMP");
+        return;
+    }
+
+    BootstrapSetup& setup = GetBootstrapSetup();
+    OpenFHEParallelControls.SetNumThreads(threads);
+
+    while (state.KeepRunning()) {
+        auto ciphertextAfter = setup.cc->EvalBootstrap(setup.ciphertext);
+    }
+
+    OpenFHEParallelControls.Enable();
+}
+
+BENCHMARK(CKKSrns_EvalBootstrap)->Unit(benchmark::kMillisecond)->UseRealTime()->Apply(ThreadArguments);
+
+BENCHMARK_MAIN();
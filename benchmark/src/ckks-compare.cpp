@@ -0,0 +1,157 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/*
+ * Comparison of two CKKS ciphertexts: the native composite-polynomial sign (EvalCompare) against the
+ * scheme-switching path (EvalCompareSchemeSwitching) that evaluates the sign with FHEW bootstrapping.
+ * Both compare the same 16 slots; the cost of EvalCompare does not depend on the number of slots while the
+ * scheme-switching path bootstraps every slot separately. Toy parameters (HEStd_NotSet) are used as in the
+ * scheme-switching example.
+ */
+
+#define PROFILE
+#include "scheme/ckksrns/gen-cryptocontext-ckksrns.h"
+#include "gen-cryptocontext.h"
+
+#include "benchmark/benchmark.h"
+
+#include <iostream>
+#include <vector>
+
+using namespace lbcrypto;
+
+constexpr usint RING_DIM   = 8192;
+constexpr usint SLOTS      = 16;
+constexpr double BOUND     = 16;
+constexpr double GAP       = 1.0 / 64;
+constexpr usint PRECISION  = 10;
+constexpr usint SS_DEPTH   = 17;
+constexpr usint LOGQ_FHEW  = 25;
+constexpr usint SCALE_BITS = 50;
+
+/*
+ * Context setup utility methods
+ */
+
+struct CompareSetup {
+    CryptoContext<DCRTPoly> cc;
+    KeyPair<DCRTPoly> keyPair;
+    Ciphertext<DCRTPoly> ciphertext1;
+    Ciphertext<DCRTPoly> ciphertext2;
+};
+
+static CompareSetup GenerateCompareSetup(usint depth, bool schemeSwitching) {
+    CompareSetup s;
+
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetMultiplicativeDepth(depth);
+    parameters.SetScalingModSize(SCALE_BITS);
+    parameters.SetFirstModSize(60);
+    parameters.SetScalingTechnique(FLEXIBLEAUTO);
+    parameters.SetSecurityLevel(HEStd_NotSet);
+    parameters.SetRingDim(RING_DIM);
+    parameters.SetBatchSize(SLOTS);
+
+    s.cc = GenCryptoContext(parameters);
+    s.cc->Enable(PKE);
+    s.cc->Enable(KEYSWITCH);
+    s.cc->Enable(LEVELEDSHE);
+    s.cc->Enable(ADVANCEDSHE);
+
+    s.keyPair = s.cc->KeyGen();
+    s.cc->EvalMultKeyGen(s.keyPair.secretKey);
+
+    if (schemeSwitching) {
+        s.cc->Enable(SCHEMESWITCH);
+
+        SchSwchParams params;
+        params.SetSecurityLevelCKKS(HEStd_NotSet);
+        params.SetSecurityLevelFHEW(TOY);
+        params.SetCtxtModSizeFHEWLargePrec(LOGQ_FHEW);
+        params.SetNumSlotsCKKS(SLOTS);
+        params.SetNumValues(SLOTS);
+        auto privateKeyFHEW = s.cc->EvalSchemeSwitchingSetup(params);
+        auto ccLWE          = s.cc->GetBinCCForSchemeSwitch();
+        ccLWE->BTKeyGen(privateKeyFHEW);
+        s.cc->EvalSchemeSwitchingKeyGen(s.keyPair, privateKeyFHEW);
+
+        auto pLWE = (1 << LOGQ_FHEW) / (2 * ccLWE->GetBeta().ConvertToInt());
+        s.cc->EvalCompareSwitchPrecompute(pLWE, 1.0);
+    }
+
+    // the differences are at least 0.25 = GAP * BOUND apart from zero
+    std::vector<double> x1(SLOTS);
+    for (usint i = 0; i < SLOTS; ++i)
+        x1[i] = static_cast<double>(i);
+    std::vector<double> x2(SLOTS, 5.25);
+    s.ciphertext1 = s.cc->Encrypt(s.keyPair.publicKey, s.cc->MakeCKKSPackedPlaintext(x1, 1, 0, nullptr, SLOTS));
+    s.ciphertext2 = s.cc->Encrypt(s.keyPair.publicKey, s.cc->MakeCKKSPackedPlaintext(x2, 1, 0, nullptr, SLOTS));
+
+    std::cout << (schemeSwitching ? "Scheme switching" : "Native") << " comparison with ring dimension "
+              << s.cc->GetRingDimension() << " and multiplicative depth " << depth << std::endl;
+    return s;
+}
+
+static CompareSetup& GetNativeSetup() {
+    static CompareSetup setup = GenerateCompareSetup(CryptoContextImpl<DCRTPoly>::GetEvalSignDepth(GAP, PRECISION),
+                                                     false);
+    return setup;
+}
+
+static CompareSetup& GetSchemeSwitchingSetup() {
+    static CompareSetup setup = GenerateCompareSetup(SS_DEPTH, true);
+    return setup;
+}
+
+/*
+ * CKKS benchmarks
+ */
+
+void CKKSrns_EvalCompare(benchmark::State& state) {
+    CompareSetup& setup = GetNativeSetup();
+
+    while (state.KeepRunning()) {
+        auto result = setup.cc->EvalCompare(setup.ciphertext1, setup.ciphertext2, BOUND, GAP, PRECISION);
+    }
+}
+
+BENCHMARK(CKKSrns_EvalCompare)->Unit(benchmark::kMillisecond);
+
+void CKKSrns_EvalCompareSchemeSwitching(benchmark::State& state) {
+    CompareSetup& setup = GetSchemeSwitchingSetup();
+
+    while (state.KeepRunning()) {
+        auto result = setup.cc->EvalCompareSchemeSwitching(setup.ciphertext1, setup.ciphertext2, SLOTS, SLOTS);
+    }
+}
+
+BENCHMARK(CKKSrns_EvalCompareSchemeSwitching)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
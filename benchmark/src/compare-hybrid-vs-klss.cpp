@@ -0,0 +1,194 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+ * Compares the performance of HYBRID and KLSS key switching for CKKS and BGV
+ * using EvalMult (with relinearization) and EvalRotate operations.
+ * Both techniques use the same moduli Q and P, so the ring dimension and the security level are the same.
+ */
+
+#define PROFILE
+#include "scheme/bgvrns/gen-cryptocontext-bgvrns.h"
+#include "scheme/ckksrns/gen-cryptocontext-ckksrns.h"
+#include "gen-cryptocontext.h"
+
+#include "benchmark/benchmark.h"
+
+#include <iostream>
+#include <vector>
+
+using namespace lbcrypto;
+
+constexpr usint MULT_DEPTH = 15;
+// the 17 towers of Q can be distributed into 3, 6 or 9 digits; KLSS pays off for many digits
+static std::vector<usint> dnum_args{3, 6, 9};
+
+static void KeySwitchArguments(benchmark::internal::Benchmark* b) {
+    for (usint klss : {0, 1}) {
+        for (usint dnum : dnum_args) {
+            b->ArgNames({"klss", "dnum"})->Args({klss, dnum});
+        }
+    }
+}
+
+/*
+ * Context setup utility methods
+ */
+
+CryptoContext<DCRTPoly> GenerateCKKSContext(KeySwitchTechnique ksTech, usint dnum) {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetMultiplicativeDepth(MULT_DEPTH);
+    parameters.SetScalingModSize(50);
+    parameters.SetBatchSize(16);
+    parameters.SetSecurityLevel(HEStd_128_classic);
+    parameters.SetKeySwitchTechnique(ksTech);
+    parameters.SetNumLargeDigits(dnum);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+
+    return cc;
+}
+
+CryptoContext<DCRTPoly> GenerateBGVrnsContext(KeySwitchTechnique ksTech, usint dnum) {
+    CCParams<CryptoContextBGVRNS> parameters;
+    parameters.SetMultiplicativeDepth(MULT_DEPTH);
+    parameters.SetPlaintextModulus(65537);
+    parameters.SetSecurityLevel(HEStd_128_classic);
+    parameters.SetKeySwitchTechnique(ksTech);
+    parameters.SetNumLargeDigits(dnum);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+
+    return cc;
+}
+
+static KeySwitchTechnique GetKeySwitchTechnique(const benchmark::State& state) {
+    return state.range(0) ? KLSS : HYBRID;
+}
+
+/*
+ * CKKS benchmarks
+ */
+
+void CKKSrns_MultRelin(benchmark::State& state) {
+    CryptoContext<DCRTPoly> cc = GenerateCKKSContext(GetKeySwitchTechnique(state), state.range(1));
+
+    KeyPair<DCRTPoly> keyPair = cc->KeyGen();
+    cc->EvalMultKeyGen(keyPair.secretKey);
+
+    std::vector<double> vectorOfInts = {1.0, 0.5, 0.25, 0.125, -1.0, -0.5, -0.25, -0.125};
+    Plaintext plaintext              = cc->MakeCKKSPackedPlaintext(vectorOfInts);
+    auto ciphertext                  = cc->Encrypt(keyPair.publicKey, plaintext);
+
+    while (state.KeepRunning()) {
+        auto ciphertextMult = cc->EvalMult(ciphertext, ciphertext);
+    }
+}
+
+BENCHMARK(CKKSrns_MultRelin)->Unit(benchmark::kMicrosecond)->Apply(KeySwitchArguments);
+
+void CKKSrns_EvalRotate(benchmark::State& state) {
+    CryptoContext<DCRTPoly> cc = GenerateCKKSContext(GetKeySwitchTechnique(state), state.range(1));
+
+    KeyPair<DCRTPoly> keyPair = cc->KeyGen();
+    cc->EvalRotateKeyGen(keyPair.secretKey, {1});
+
+    std::vector<double> vectorOfInts = {1.0, 0.5, 0.25, 0.125, -1.0, -0.5, -0.25, -0.125};
+    Plaintext plaintext              = cc->MakeCKKSPackedPlaintext(vectorOfInts);
+    auto ciphertext                  = cc->Encrypt(keyPair.publicKey, plaintext);
+
+    while (state.KeepRunning()) {
+        auto ciphertextRot = cc->EvalRotate(ciphertext, 1);
+    }
+}
+
+BENCHMARK(CKKSrns_EvalRotate)->Unit(benchmark::kMicrosecond)->Apply(KeySwitchArguments);
+
+void CKKSrns_EvalMultKeyGen(benchmark::State& state) {
+    CryptoContext<DCRTPoly> cc = GenerateCKKSContext(GetKeySwitchTechnique(state), state.range(1));
+
+    KeyPair<DCRTPoly> keyPair = cc->KeyGen();
+
+    while (state.KeepRunning()) {
+        cc->EvalMultKeyGen(keyPair.secretKey);
+        state.PauseTiming();
+        cc->ClearEvalMultKeys();
+        state.ResumeTiming();
+    }
+}
+
+BENCHMARK(CKKSrns_EvalMultKeyGen)->Unit(benchmark::kMicrosecond)->Apply(KeySwitchArguments);
+
+/*
+ * BGV benchmarks
+ */
+
+void BGVrns_MultRelin(benchmark::State& state) {
+    CryptoContext<DCRTPoly> cc = GenerateBGVrnsContext(GetKeySwitchTechnique(state), state.range(1));
+
+    KeyPair<DCRTPoly> keyPair = cc->KeyGen();
+    cc->EvalMultKeyGen(keyPair.secretKey);
+
+    std::vector<int64_t> vectorOfInts = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    Plaintext plaintext               = cc->MakePackedPlaintext(vectorOfInts);
+    auto ciphertext                   = cc->Encrypt(keyPair.publicKey, plaintext);
+
+    while (state.KeepRunning()) {
+        auto ciphertextMult = cc->EvalMult(ciphertext, ciphertext);
+    }
+}
+
+BENCHMARK(BGVrns_MultRelin)->Unit(benchmark::kMicrosecond)->Apply(KeySwitchArguments);
+
+void BGVrns_EvalRotate(benchmark::State& state) {
+    CryptoContext<DCRTPoly> cc = GenerateBGVrnsContext(GetKeySwitchTechnique(state), state.range(1));
+
+    KeyPair<DCRTPoly> keyPair = cc->KeyGen();
+    cc->EvalRotateKeyGen(keyPair.secretKey, {1});
+
+    std::vector<int64_t> vectorOfInts = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    Plaintext plaintext               = cc->MakePackedPlaintext(vectorOfInts);
+    auto ciphertext                   = cc->Encrypt(keyPair.publicKey, plaintext);
+
+    while (state.KeepRunning()) {
+        auto ciphertextRot = cc->EvalRotate(ciphertext, 1);
+    }
+}
+
+BENCHMARK(BGVrns_EvalRotate)->Unit(benchmark::kMicrosecond)->Apply(KeySwitchArguments);
+
+BENCHMARK_MAIN();
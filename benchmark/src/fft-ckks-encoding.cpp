@@ -121,5 +121,33 @@ void FFTSpecialInv_RingDim65536(benchmark::State& state) {
 }
 BENCHMARK(FFTSpecialInv_RingDim65536)->Unit(benchmark::kMicrosecond);
 //=====================================================================================================================
+// CKKS encoding applies the inverse special FFT to the slot values and decoding applies the forward one.
+// Both are reported as slots per second for every slot count supported by ring dimension 65536.
+void FFTSpecialInv_Encode_Slots(benchmark::State& state) {
+    const uint32_t cyclOrder               = 1 << 17;
+    const uint32_t slots                   = state.range(0);
+    std::vector<std::complex<double>> vals = GenerateRandNumberVector(slots);
+    DiscreteFourierTransform::Initialize(cyclOrder, slots);
+
+    while (state.KeepRunning()) {
+        DiscreteFourierTransform::FFTSpecialInv(vals, cyclOrder);
+    }
+    state.SetItemsProcessed(state.iterations() * slots);
+}
+BENCHMARK(FFTSpecialInv_Encode_Slots)->Unit(benchmark::kMicrosecond)->RangeMultiplier(4)->Range(8, 1 << 15);
+//=====================================================================================================================
+void FFTSpecial_Decode_Slots(benchmark::State& state) {
+    const uint32_t cyclOrder               = 1 << 17;
+    const uint32_t slots                   = state.range(0);
+    std::vector<std::complex<double>> vals = GenerateRandNumberVector(slots);
+    DiscreteFourierTransform::Initialize(cyclOrder, slots);
+
+    while (state.KeepRunning()) {
+        DiscreteFourierTransform::FFTSpecial(vals, cyclOrder);
+    }
+    state.SetItemsProcessed(state.iterations() * slots);
+}
+BENCHMARK(FFTSpecial_Decode_Slots)->Unit(benchmark::kMicrosecond)->RangeMultiplier(4)->Range(8, 1 << 15);
+//=====================================================================================================================
 
 BENCHMARK_MAIN();
@@ -40,6 +40,7 @@
 #include "math/hal/basicint.h"
 #include "scheme/ckksrns/gen-cryptocontext-ckksrns.h"
 #include "scheme/bfvrns/gen-cryptocontext-bfvrns.h"
+#include "scheme/bfvrns/bfvrns-leveledshe.h"
 #include "scheme/bgvrns/gen-cryptocontext-bgvrns.h"
 #include "gen-cryptocontext.h"
 
@@ -361,6 +362,51 @@ void BFVrns_MultRelin(benchmark::State& state) {
 
 BENCHMARK(BFVrns_MultRelin)->Unit(benchmark::kMicrosecond)->Apply(DepthArgs);  // ->Complexity(benchmark::oAuto);
 
+/*
+ * BFV tensor product of two 2-element ciphertexts on the extended basis Q*R, as done inside BFVrns_MultRelin.
+ * BFVrns_TensorProductUnfused is the loop EvalMult used before (four DCRTPoly products and one addition);
+ * BFVrns_TensorProduct is the one EvalMult uses now (one pass per tower when 128-bit integers are available).
+ */
+static std::vector<DCRTPoly> GenerateBFVrnsTensorInput(const CryptoContext<DCRTPoly>& cc) {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersBFVRNS>(cc->GetCryptoParameters());
+    // HPSPOVERQLEVELED (the default) at the top level
+    const size_t sizeQ = cryptoParams->GetElementParams()->GetParams().size();
+    const auto params  = cryptoParams->GetParamsQlRl(sizeQ - 1);
+
+    DCRTPoly::DugType dug;
+    return {DCRTPoly(dug, params, Format::EVALUATION), DCRTPoly(dug, params, Format::EVALUATION)};
+}
+
+void BFVrns_TensorProductUnfused(benchmark::State& state) {
+    CryptoContext<DCRTPoly> cc = GenerateBFVrnsContext(state.range(0));
+
+    std::vector<DCRTPoly> cv1 = GenerateBFVrnsTensorInput(cc);
+    std::vector<DCRTPoly> cv2 = GenerateBFVrnsTensorInput(cc);
+
+    while (state.KeepRunning()) {
+        std::vector<DCRTPoly> cvMult(3);
+        cvMult[0] = cv1[0] * cv2[0];
+        cvMult[1] = cv1[0] * cv2[1];
+        cvMult[1] += cv1[1] * cv2[0];
+        cvMult[2] = cv1[1] * cv2[1];
+    }
+}
+
+BENCHMARK(BFVrns_TensorProductUnfused)->Unit(benchmark::kMicrosecond)->Apply(DepthArgs);
+
+void BFVrns_TensorProduct(benchmark::State& state) {
+    CryptoContext<DCRTPoly> cc = GenerateBFVrnsContext(state.range(0));
+
+    std::vector<DCRTPoly> cv1 = GenerateBFVrnsTensorInput(cc);
+    std::vector<DCRTPoly> cv2 = GenerateBFVrnsTensorInput(cc);
+
+    while (state.KeepRunning()) {
+        auto cvMult = LeveledSHEBFVRNS::TensorProduct(cv1, cv2);
+    }
+}
+
+BENCHMARK(BFVrns_TensorProduct)->Unit(benchmark::kMicrosecond)->Apply(DepthArgs);
+
 void BFVrns_EvalAtIndex(benchmark::State& state) {
     CryptoContext<DCRTPoly> cc = GenerateBFVrnsContext();
 
@@ -738,6 +784,43 @@ void CKKSrns_EvalAtIndex(benchmark::State& state) {
 
 BENCHMARK(CKKSrns_EvalAtIndex)->Unit(benchmark::kMicrosecond);
 
+[[maybe_unused]] static void ChebyshevDegreeArgs(benchmark::internal::Benchmark* b) {
+    for (uint32_t d : {13, 59, 119, 247})
+        b->ArgName("degree")->Arg(d);
+}
+
+// the power basis of a Chebyshev series: the waves of baby steps run in parallel only if they are wide enough
+void CKKSrns_EvalChebyshevPowerBasis(benchmark::State& state) {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetScalingModSize(48);
+    parameters.SetBatchSize(8);
+    parameters.SetScalingTechnique(FLEXIBLEAUTO);
+    parameters.SetMultiplicativeDepth(9);
+    auto cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+    cc->Enable(ADVANCEDSHE);
+
+    KeyPair<DCRTPoly> keyPair = cc->KeyGen();
+    cc->EvalMultKeyGen(keyPair.secretKey);
+
+    usint slots = cc->GetEncodingParams()->GetBatchSize();
+    std::vector<double> input(slots);
+    for (usint i = 0; i < slots; i++) {
+        input[i] = -1.0 + 2.0 * i / slots;
+    }
+
+    auto ciphertext = cc->Encrypt(keyPair.publicKey, cc->MakeCKKSPackedPlaintext(input));
+    uint32_t degree = state.range(0);
+
+    while (state.KeepRunning()) {
+        auto basis = cc->EvalChebyshevPowerBasis(ciphertext, degree, -1.0, 1.0);
+    }
+}
+
+BENCHMARK(CKKSrns_EvalChebyshevPowerBasis)->Unit(benchmark::kMillisecond)->Apply(ChebyshevDegreeArgs);
+
 /*
  * BGVrns benchmarks
  * */
@@ -0,0 +1,159 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/*
+ * Performance of the encrypted d x d matrix product (EvalMatMul) for CKKS and BGV, for d = 16..128.
+ * The ring dimension is the smallest one for the security level that has at least d^2 slots.
+ * d = 128 generates 508 rotation keys for ring dimension 32768 and needs several GB of memory.
+ */
+
+#define PROFILE
+#include "scheme/bgvrns/gen-cryptocontext-bgvrns.h"
+#include "scheme/ckksrns/gen-cryptocontext-ckksrns.h"
+#include "gen-cryptocontext.h"
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+using namespace lbcrypto;
+
+// EvalMatMul consumes three levels
+constexpr usint MULT_DEPTH     = 3;
+constexpr usint MIN_RING_DIM   = 16384;
+static std::vector<usint> dims = {16, 32, 64, 128};
+
+static void DimArguments(benchmark::internal::Benchmark* b) {
+    for (usint dim : dims) {
+        b->ArgName("dim")->Arg(dim);
+    }
+}
+
+/*
+ * Context setup utility methods
+ */
+
+CryptoContext<DCRTPoly> GenerateCKKSContext(usint dim) {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetMultiplicativeDepth(MULT_DEPTH);
+    parameters.SetScalingModSize(50);
+    parameters.SetRingDim(std::max(MIN_RING_DIM, 2 * dim * dim));
+    parameters.SetBatchSize(dim * dim);
+    parameters.SetSecurityLevel(HEStd_128_classic);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+    cc->Enable(ADVANCEDSHE);
+
+    return cc;
+}
+
+CryptoContext<DCRTPoly> GenerateBGVrnsContext(usint dim) {
+    CCParams<CryptoContextBGVRNS> parameters;
+    parameters.SetMultiplicativeDepth(MULT_DEPTH);
+    parameters.SetPlaintextModulus(65537);
+    parameters.SetRingDim(std::max(MIN_RING_DIM, 2 * dim * dim));
+    parameters.SetSecurityLevel(HEStd_128_classic);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+    cc->Enable(ADVANCEDSHE);
+
+    return cc;
+}
+
+/*
+ * CKKS benchmarks
+ */
+
+void CKKSrns_EvalMatMulPrecompute(benchmark::State& state) {
+    usint dim                  = state.range(0);
+    CryptoContext<DCRTPoly> cc = GenerateCKKSContext(dim);
+
+    while (state.KeepRunning()) {
+        auto precom = cc->EvalMatMulPrecompute(dim);
+    }
+}
+
+BENCHMARK(CKKSrns_EvalMatMulPrecompute)->Unit(benchmark::kMillisecond)->Apply(DimArguments);
+
+void CKKSrns_EvalMatMul(benchmark::State& state) {
+    usint dim                  = state.range(0);
+    CryptoContext<DCRTPoly> cc = GenerateCKKSContext(dim);
+
+    KeyPair<DCRTPoly> keyPair = cc->KeyGen();
+    cc->EvalMultKeyGen(keyPair.secretKey);
+    cc->EvalMatMulKeyGen(keyPair.secretKey, dim);
+
+    std::vector<double> matrix(dim * dim);
+    for (usint i = 0; i < dim * dim; ++i)
+        matrix[i] = static_cast<double>(i % 17) / 16;
+    auto ciphertext = cc->Encrypt(keyPair.publicKey, cc->MakeCKKSPackedPlaintext(matrix));
+    auto precom     = cc->EvalMatMulPrecompute(dim);
+
+    while (state.KeepRunning()) {
+        auto ciphertextProduct = cc->EvalMatMul(ciphertext, ciphertext, precom);
+    }
+}
+
+BENCHMARK(CKKSrns_EvalMatMul)->Unit(benchmark::kMillisecond)->Apply(DimArguments);
+
+/*
+ * BGV benchmarks
+ */
+
+void BGVrns_EvalMatMul(benchmark::State& state) {
+    usint dim                  = state.range(0);
+    CryptoContext<DCRTPoly> cc = GenerateBGVrnsContext(dim);
+
+    KeyPair<DCRTPoly> keyPair = cc->KeyGen();
+    cc->EvalMultKeyGen(keyPair.secretKey);
+    cc->EvalMatMulKeyGen(keyPair.secretKey, dim);
+
+    std::vector<int64_t> matrix(dim * dim);
+    for (usint i = 0; i < dim * dim; ++i)
+        matrix[i] = static_cast<int64_t>(i % 17) - 8;
+    auto ciphertext = cc->Encrypt(keyPair.publicKey, cc->MakePackedPlaintext(matrix));
+    auto precom     = cc->EvalMatMulPrecompute(dim);
+
+    while (state.KeepRunning()) {
+        auto ciphertextProduct = cc->EvalMatMul(ciphertext, ciphertext, precom);
+    }
+}
+
+BENCHMARK(BGVrns_EvalMatMul)->Unit(benchmark::kMillisecond)->Apply(DimArguments);
+
+BENCHMARK_MAIN();
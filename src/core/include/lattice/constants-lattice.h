@@ -45,7 +45,9 @@ enum SecretKeyDist {
     GAUSSIAN        = 0,
     UNIFORM_TERNARY = 1,  // Default value, all schemes support this key distribution
     SPARSE_TERNARY  = 2,
-    // BINARY = 3, // Future implementation
+    // CKKS only: uniform ternary secret key; bootstrapping uses an ephemeral sparse secret for ModRaise
+    SPARSE_ENCAPSULATED = 3,
+    // BINARY = 4, // Future implementation
 };
 SecretKeyDist convertToSecretKeyDist(const std::string& str);
 SecretKeyDist convertToSecretKeyDist(uint32_t num);
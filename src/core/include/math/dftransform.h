@@ -38,7 +38,9 @@
 
 #include <complex>
 #include <cstdint>
+#include <memory>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #ifndef M_PI
@@ -47,6 +49,76 @@
 
 namespace lbcrypto {
 
+/**
+ * @brief Precomputed tables of the special FFT used in CKKS encoding and decoding for a given
+ * cyclotomic order and number of values.
+ *
+ * The twiddle factors of every stage are stored contiguously as separate real and imaginary arrays
+ * in the order in which the butterflies use them, so the inner loops run with unit stride over split
+ * real/imaginary data and are vectorized. The transforms of std::complex values split them into
+ * per-thread scratch buffers, applying the bit-reversal permutation in the same pass. A plan is
+ * immutable after construction and can be used by any number of threads at the same time.
+ */
+class FFTSpecialPlan {
+public:
+    /**
+   * @param cyclOrder cyclotomic order M, a power of two
+   * @param size number of values to transform, a power of two not larger than M/4
+   */
+    FFTSpecialPlan(uint32_t cyclOrder, uint32_t size);
+
+    /**
+   * In-place special FFT used in CKKS decoding
+   *
+   * @param re real parts of GetSize() values
+   * @param im imaginary parts of GetSize() values
+   */
+    void Forward(double* re, double* im) const;
+
+    /**
+   * In-place inverse special FFT used in CKKS encoding, including the division by GetSize()
+   *
+   * @param re real parts of GetSize() values
+   * @param im imaginary parts of GetSize() values
+   */
+    void Inverse(double* re, double* im) const;
+
+    /**
+   * In-place special FFT used in CKKS decoding
+   *
+   * @param vals GetSize() values
+   */
+    void Forward(std::complex<double>* vals) const;
+
+    /**
+   * In-place inverse special FFT used in CKKS encoding, including the division by GetSize()
+   *
+   * @param vals GetSize() values
+   */
+    void Inverse(std::complex<double>* vals) const;
+
+    uint32_t GetCyclotomicOrder() const {
+        return m_M;
+    }
+
+    uint32_t GetSize() const {
+        return m_size;
+    }
+
+private:
+    // the butterfly stages without the bit-reversal permutation
+    void ForwardStages(double* re, double* im) const;
+    void InverseStages(double* re, double* im) const;
+
+    uint32_t m_M;
+    uint32_t m_size;
+    // the bit-reversal permutation: the value at index i moves to index m_reversed[i]
+    std::vector<uint32_t> m_reversed;
+    // twiddle factors of the forward transform; the stage with half-length h starts at offset h - 1
+    std::vector<double> m_rootsRe;
+    std::vector<double> m_rootsIm;
+};
+
 /**
  * @brief Discrete Fourier Transform FFT implementation.
  */
@@ -100,6 +172,16 @@ public:
    */
     static void FFTSpecial(std::vector<std::complex<double>>& vals, uint32_t cyclOrder);
 
+    /**
+   * Returns the plan of the special FFT for the given cyclotomic order and number of values. The plan is
+   * created on first use and cached; the function can be called from several threads at the same time.
+   *
+   * @param cyclOrder cyclotomic order.
+   * @param size number of values to transform.
+   * @return the shared immutable plan.
+   */
+    static std::shared_ptr<const FFTSpecialPlan> GetFFTSpecialPlan(uint32_t cyclOrder, uint32_t size);
+
     /**
    * Reset cached values for the transform to empty.
    */
@@ -107,27 +189,14 @@ public:
 
     static void PreComputeTable(uint32_t s);
 
+    /**
+   * Creates the special FFT plan for the cyclotomic order m and nh values ahead of time. The plans are also
+   * created on first use, so calling Initialize() is optional.
+   */
     static void Initialize(uint32_t m, uint32_t nh);
 
 private:
     static std::complex<double>* rootOfUnityTable;
-
-    // structure to keep values precomputed by Initialize() for every cyclotomic order value
-    struct PrecomputedValues {
-        // cyclotomic order
-        uint32_t m_M;
-        uint32_t m_Nh;
-        // rotation group indexes
-        std::vector<uint32_t> m_rotGroup;
-        // ksi powers
-        std::vector<std::complex<double>> m_ksiPows;
-
-        PrecomputedValues(uint32_t m, uint32_t nh);
-    };
-    // precomputedValues: key - cyclotomic order, data - values precomputed for the given cyclotomic order
-    static std::unordered_map<uint32_t, PrecomputedValues> precomputedValues;
-
-    static void BitReverse(std::vector<std::complex<double>>& vals);
 };
 
 }  // namespace lbcrypto
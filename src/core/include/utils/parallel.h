@@ -108,10 +108,12 @@ public:
 #endif
     }
 
-    // @Brief returns min of int n and machineThreads
+    // @Brief returns min of int n and the number of threads OpenMP currently uses for a parallel region
+    // (machineThreads unless changed by SetNumThreads or Disable)
     int GetThreadLimit(int n) const {
 #ifdef PARALLEL
-        return n > machineThreads ? machineThreads : n;
+        int numThreads = omp_get_max_threads();
+        return n > numThreads ? numThreads : n;
 #else
         return 1;
 #endif
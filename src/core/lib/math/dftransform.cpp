@@ -40,33 +40,201 @@
 #include "utils/parallel.h"
 
 #include <complex>
+#include <map>
+#include <mutex>
+#include <string>
 #include <vector>
 
 namespace lbcrypto {
 
 std::complex<double>* DiscreteFourierTransform::rootOfUnityTable = nullptr;
-std::unordered_map<uint32_t, DiscreteFourierTransform::PrecomputedValues> DiscreteFourierTransform::precomputedValues;
-
-DiscreteFourierTransform::PrecomputedValues::PrecomputedValues(uint32_t m, uint32_t nh) {
-    m_M  = m;
-    m_Nh = nh;
-
-    m_rotGroup.resize(m_Nh);
-    uint32_t fivePows = 1;
-    for (size_t i = 0; i < m_Nh; ++i) {
-        m_rotGroup[i] = fivePows;
-        fivePows *= 5;
-        fivePows %= m_M;
+
+namespace {
+
+using FFTSpecialPlanMap = std::map<std::pair<uint32_t, uint32_t>, std::shared_ptr<const FFTSpecialPlan>>;
+
+// the plans are published through an atomically swapped immutable map, so lookups do not take the
+// cache mutex (std::atomic_load may still use a short internal lock of the standard library);
+// the mutex serializes the creation of new plans only
+std::mutex fftSpecialPlanMutex;
+std::shared_ptr<const FFTSpecialPlanMap> fftSpecialPlans = std::make_shared<const FFTSpecialPlanMap>();
+
+}  // namespace
+
+FFTSpecialPlan::FFTSpecialPlan(uint32_t cyclOrder, uint32_t size) : m_M(cyclOrder), m_size(size) {
+    if (cyclOrder == 0 || (cyclOrder & (cyclOrder - 1)) != 0)
+        OPENFHE_THROW("The cyclotomic order must be a power of two: " + std::to_string(cyclOrder));
+    if (size == 0 || (size & (size - 1)) != 0 || size > cyclOrder / 4)
+        OPENFHE_THROW("The number of values must be a power of two not larger than " + std::to_string(cyclOrder / 4) +
+                      ": " + std::to_string(size));
+
+    m_reversed.resize(size);
+    for (uint32_t i = 1, j = 0; i < size; ++i) {
+        uint32_t bit = size >> 1;
+        for (; j >= bit; bit >>= 1)
+            j -= bit;
+        j += bit;
+        m_reversed[i] = j;
+    }
+
+    // the stage with half-length h uses the roots ksi^((5^j mod 8h) * M/8h), j < h
+    m_rootsRe.resize(size > 1 ? size - 1 : 0);
+    m_rootsIm.resize(m_rootsRe.size());
+    for (uint32_t lenh = 1; lenh < size; lenh <<= 1) {
+        uint32_t lenq     = lenh << 3;
+        uint32_t gap      = m_M / lenq;
+        uint32_t fivePows = 1;
+        for (uint32_t j = 0; j < lenh; ++j) {
+            double angle            = 2.0 * M_PI * ((fivePows % lenq) * gap) / m_M;
+            m_rootsRe[lenh - 1 + j] = cos(angle);
+            m_rootsIm[lenh - 1 + j] = sin(angle);
+            fivePows                = (fivePows * 5) % m_M;
+        }
+    }
+}
+
+namespace {
+
+// The butterflies of one block of a stage. The four halves never overlap, so with __restrict the loops
+// are vectorized for the widest vector unit the compiler targets (AVX2/AVX-512 with WITH_NATIVEOPT).
+void ForwardButterflies(double* __restrict uRe, double* __restrict uIm, double* __restrict vRe,
+                        double* __restrict vIm, const double* __restrict wRe, const double* __restrict wIm,
+                        uint32_t lenh) {
+    for (uint32_t j = 0; j < lenh; ++j) {
+        double tRe = vRe[j] * wRe[j] - vIm[j] * wIm[j];
+        double tIm = vRe[j] * wIm[j] + vIm[j] * wRe[j];
+        vRe[j]     = uRe[j] - tRe;
+        vIm[j]     = uIm[j] - tIm;
+        uRe[j] += tRe;
+        uIm[j] += tIm;
+    }
+}
+
+void InverseButterflies(double* __restrict uRe, double* __restrict uIm, double* __restrict vRe,
+                        double* __restrict vIm, const double* __restrict wRe, const double* __restrict wIm,
+                        uint32_t lenh) {
+    for (uint32_t j = 0; j < lenh; ++j) {
+        double dRe = uRe[j] - vRe[j];
+        double dIm = uIm[j] - vIm[j];
+        uRe[j] += vRe[j];
+        uIm[j] += vIm[j];
+        vRe[j] = dRe * wRe[j] + dIm * wIm[j];
+        vIm[j] = dIm * wRe[j] - dRe * wIm[j];
+    }
+}
+
+// split real/imaginary buffers of the calling thread, reused by all transforms
+struct FFTSpecialScratch {
+    std::vector<double> re;
+    std::vector<double> im;
+};
+
+FFTSpecialScratch& GetScratch(uint32_t size) {
+    thread_local FFTSpecialScratch scratch;
+    if (scratch.re.size() < size) {
+        scratch.re.resize(size);
+        scratch.im.resize(size);
+    }
+    return scratch;
+}
+
+}  // namespace
+
+void FFTSpecialPlan::ForwardStages(double* re, double* im) const {
+    for (uint32_t lenh = 1; lenh < m_size; lenh <<= 1) {
+        const double* wRe = &m_rootsRe[lenh - 1];
+        const double* wIm = &m_rootsIm[lenh - 1];
+        for (uint32_t i = 0; i < m_size; i += 2 * lenh)
+            ForwardButterflies(re + i, im + i, re + i + lenh, im + i + lenh, wRe, wIm, lenh);
+    }
+}
+
+void FFTSpecialPlan::InverseStages(double* re, double* im) const {
+    // the inverse transform uses the conjugated roots of the forward transform in the reverse order of stages
+    for (uint32_t lenh = m_size >> 1; lenh >= 1; lenh >>= 1) {
+        const double* wRe = &m_rootsRe[lenh - 1];
+        const double* wIm = &m_rootsIm[lenh - 1];
+        for (uint32_t i = 0; i < m_size; i += 2 * lenh)
+            InverseButterflies(re + i, im + i, re + i + lenh, im + i + lenh, wRe, wIm, lenh);
+    }
+}
+
+void FFTSpecialPlan::Forward(double* re, double* im) const {
+    for (uint32_t i = 0; i < m_size; ++i) {
+        uint32_t j = m_reversed[i];
+        if (i < j) {
+            std::swap(re[i], re[j]);
+            std::swap(im[i], im[j]);
+        }
+    }
+    ForwardStages(re, im);
+}
+
+void FFTSpecialPlan::Inverse(double* re, double* im) const {
+    InverseStages(re, im);
+    const double scale = 1.0 / m_size;
+    for (uint32_t i = 0; i < m_size; ++i) {
+        uint32_t j = m_reversed[i];
+        if (i < j) {
+            std::swap(re[i], re[j]);
+            std::swap(im[i], im[j]);
+        }
+    }
+    for (uint32_t i = 0; i < m_size; ++i) {
+        re[i] *= scale;
+        im[i] *= scale;
+    }
+}
+
+void FFTSpecialPlan::Forward(std::complex<double>* vals) const {
+    auto& scratch = GetScratch(m_size);
+    double* re    = scratch.re.data();
+    double* im    = scratch.im.data();
+    // the bit-reversal permutation is applied while the values are split
+    for (uint32_t i = 0; i < m_size; ++i) {
+        re[i] = vals[m_reversed[i]].real();
+        im[i] = vals[m_reversed[i]].imag();
+    }
+    ForwardStages(re, im);
+    for (uint32_t i = 0; i < m_size; ++i)
+        vals[i] = std::complex<double>(re[i], im[i]);
+}
+
+void FFTSpecialPlan::Inverse(std::complex<double>* vals) const {
+    auto& scratch = GetScratch(m_size);
+    double* re    = scratch.re.data();
+    double* im    = scratch.im.data();
+    for (uint32_t i = 0; i < m_size; ++i) {
+        re[i] = vals[i].real();
+        im[i] = vals[i].imag();
     }
+    InverseStages(re, im);
+    // the bit-reversal permutation and the division by the size are applied while the values are merged
+    const double scale = 1.0 / m_size;
+    for (uint32_t i = 0; i < m_size; ++i)
+        vals[i] = std::complex<double>(re[m_reversed[i]] * scale, im[m_reversed[i]] * scale);
+}
 
-    m_ksiPows.resize(m_M + 1);
-    for (size_t j = 0; j < m_M; ++j) {
-        double angle = 2.0 * M_PI * j / m_M;
-        m_ksiPows[j].real(cos(angle));
-        m_ksiPows[j].imag(sin(angle));
+std::shared_ptr<const FFTSpecialPlan> DiscreteFourierTransform::GetFFTSpecialPlan(uint32_t cyclOrder, uint32_t size) {
+    const auto key = std::make_pair(cyclOrder, size);
+    {
+        const auto plans = std::atomic_load(&fftSpecialPlans);
+        auto it          = plans->find(key);
+        if (it != plans->end())
+            return it->second;
     }
 
-    m_ksiPows[m_M] = m_ksiPows[0];
+    std::lock_guard<std::mutex> lock(fftSpecialPlanMutex);
+    const auto plans = std::atomic_load(&fftSpecialPlans);
+    auto it          = plans->find(key);
+    if (it != plans->end())
+        return it->second;
+
+    auto plan        = std::make_shared<const FFTSpecialPlan>(cyclOrder, size);
+    auto newPlans    = std::make_shared<FFTSpecialPlanMap>(*plans);
+    (*newPlans)[key] = plan;
+    std::atomic_store(&fftSpecialPlans, std::shared_ptr<const FFTSpecialPlanMap>(std::move(newPlans)));
+    return plan;
 }
 
 void DiscreteFourierTransform::Reset() {
@@ -77,11 +245,7 @@ void DiscreteFourierTransform::Reset() {
 }
 
 void DiscreteFourierTransform::Initialize(uint32_t m, uint32_t nh) {
-#pragma omp critical
-    // add a PrecomputedValues object to the map of precomputedValues only if it doesn't already exist for the given cyclotomic order
-    if (precomputedValues.find(m) == precomputedValues.end()) {
-        precomputedValues.insert({m, PrecomputedValues(m, nh)});
-    }
+    GetFFTSpecialPlan(m, nh);
 }
 
 void DiscreteFourierTransform::PreComputeTable(uint32_t s) {
@@ -207,78 +371,15 @@ std::vector<std::complex<double>> DiscreteFourierTransform::InverseTransform(std
 }
 
 void DiscreteFourierTransform::FFTSpecialInv(std::vector<std::complex<double>>& vals, uint32_t cyclOrder) {
-    // check if the precomputed table exists for the given cyclotomic order
-    const auto it = precomputedValues.find(cyclOrder);
-    if (it == precomputedValues.end()) {
-        std::string errMsg("DiscreteFourierTransform::Initialize() must be called for cyclOrder = ");
-        errMsg += std::to_string(cyclOrder);
-        OPENFHE_THROW(errMsg);
-    }
-
-    const uint32_t valsSize = vals.size();
-    for (size_t len = valsSize; len >= 1; len >>= 1) {
-        for (size_t i = 0; i < valsSize; i += len) {
-            size_t lenh = len >> 1;
-            size_t lenq = len << 2;
-            size_t gap  = it->second.m_M / lenq;
-            for (size_t j = 0; j < lenh; ++j) {
-                size_t idx             = (lenq - (it->second.m_rotGroup[j] % lenq)) * gap;
-                std::complex<double> u = vals[i + j] + vals[i + j + lenh];
-                std::complex<double> v = vals[i + j] - vals[i + j + lenh];
-                v *= it->second.m_ksiPows[idx];
-                vals[i + j]        = u;
-                vals[i + j + lenh] = v;
-            }
-        }
-    }
-    BitReverse(vals);
-
-    for (size_t i = 0; i < valsSize; ++i) {
-        vals[i] /= valsSize;
-    }
+    if (vals.empty())
+        return;
+    GetFFTSpecialPlan(cyclOrder, vals.size())->Inverse(vals.data());
 }
 
 void DiscreteFourierTransform::FFTSpecial(std::vector<std::complex<double>>& vals, uint32_t cyclOrder) {
-    // check if the precomputed table exists for the given cyclotomic order
-    const auto it = precomputedValues.find(cyclOrder);
-    if (it == precomputedValues.end()) {
-        std::string errMsg("DiscreteFourierTransform::Initialize() must be called for cyclOrder = ");
-        errMsg += std::to_string(cyclOrder);
-        OPENFHE_THROW(errMsg);
-    }
-    const PrecomputedValues& prepValues = it->second;
-
-    BitReverse(vals);
-    uint32_t size = vals.size();
-    for (size_t len = 2; len <= size; len <<= 1) {
-        size_t lenh = len >> 1;
-        size_t lenq = len << 2;
-        size_t gap  = prepValues.m_M / lenq;
-        for (size_t i = 0; i < size; i += len) {
-            for (size_t j = 0; j < lenh; ++j) {
-                int64_t idx            = ((prepValues.m_rotGroup[j] % lenq)) * gap;
-                std::complex<double> u = vals[i + j];
-                std::complex<double> v = vals[i + j + lenh];
-                v *= prepValues.m_ksiPows[idx];
-                vals[i + j]        = u + v;
-                vals[i + j + lenh] = u - v;
-            }
-        }
-    }
-}
-
-void DiscreteFourierTransform::BitReverse(std::vector<std::complex<double>>& vals) {
-    uint32_t size = vals.size();
-    for (size_t i = 1, j = 0; i < size; ++i) {
-        size_t bit = size >> 1;
-        for (; j >= bit; bit >>= 1) {
-            j -= bit;
-        }
-        j += bit;
-        if (i < j) {
-            swap(vals[i], vals[j]);
-        }
-    }
+    if (vals.empty())
+        return;
+    GetFFTSpecialPlan(cyclOrder, vals.size())->Forward(vals.data());
 }
 
 }  // namespace lbcrypto
@@ -33,12 +33,15 @@
   This code tests the transform feature of the OpenFHE lattice encryption library
  */
 
+#include <atomic>
 #include <iostream>
+#include <thread>
 #include "gtest/gtest.h"
 
 #include "lattice/lat-hal.h"
 #include "lattice/ilelement.h"
 #include "math/math-hal.h"
+#include "math/dftransform.h"
 #include "math/distrgen.h"
 #include "math/nbtheory.h"
 #include "random"
@@ -375,3 +378,60 @@ void CRT_CHECK_very_big_ring_precomputed(const std::string& msg) {
 TEST(UTTransform, CRT_CHECK_very_big_ring_precomputed) {
     RUN_BIG_BACKENDS(CRT_CHECK_very_big_ring_precomputed, "CRT_CHECK_very_big_ring_precomputed")
 }
+
+// the special FFT evaluates sum_j vals[j] * w^(j * 5^k mod 4n), w = exp(2 pi i / 4n), for every slot k
+TEST(UTTransform, FFTSpecial) {
+    const uint32_t cyclOrder = 1 << 10;
+    for (uint32_t size = 1; size <= cyclOrder / 4; size <<= 1) {
+        std::vector<std::complex<double>> vals(size);
+        for (uint32_t j = 0; j < size; ++j)
+            vals[j] = std::complex<double>(std::cos(j + 1.0), std::sin(3.0 * j));
+
+        std::vector<std::complex<double>> expected(size);
+        uint32_t fivePows = 1;
+        for (uint32_t k = 0; k < size; ++k) {
+            for (uint32_t j = 0; j < size; ++j)
+                expected[k] += vals[j] * std::polar(1.0, 2 * M_PI * ((j * fivePows) % (4 * size)) / (4 * size));
+            fivePows = (fivePows * 5) % (4 * size);
+        }
+
+        auto result = vals;
+        DiscreteFourierTransform::FFTSpecial(result, cyclOrder);
+        for (uint32_t k = 0; k < size; ++k)
+            EXPECT_NEAR(std::abs(result[k] - expected[k]), 0, 1e-9) << "FFTSpecial failed for size " << size;
+
+        DiscreteFourierTransform::FFTSpecialInv(result, cyclOrder);
+        for (uint32_t j = 0; j < size; ++j)
+            EXPECT_NEAR(std::abs(result[j] - vals[j]), 0, 1e-9) << "FFTSpecialInv failed for size " << size;
+    }
+
+    std::vector<std::complex<double>> tooLong(cyclOrder / 2);
+    EXPECT_THROW(DiscreteFourierTransform::FFTSpecial(tooLong, cyclOrder), OpenFHEException);
+}
+
+TEST(UTTransform, FFTSpecial_concurrent_plans) {
+    // every thread creates plans for its own cyclotomic orders while the others use theirs
+    constexpr uint32_t NUM_THREADS = 4;
+    std::atomic<uint32_t> failures{0};
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([t, &failures]() {
+            for (uint32_t logM = 3; logM <= 12; ++logM) {
+                const uint32_t cyclOrder = (1 << logM) << (t % 2);
+                std::vector<std::complex<double>> vals(cyclOrder / 4);
+                for (size_t j = 0; j < vals.size(); ++j)
+                    vals[j] = std::complex<double>(j % 7, t);
+                auto result = vals;
+                DiscreteFourierTransform::FFTSpecialInv(result, cyclOrder);
+                DiscreteFourierTransform::FFTSpecial(result, cyclOrder);
+                for (size_t j = 0; j < vals.size(); ++j) {
+                    if (std::abs(result[j] - vals[j]) > 1e-9)
+                        ++failures;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    EXPECT_EQ(failures.load(), 0U);
+}
@@ -62,6 +62,7 @@ enum ScalingTechnique {
     FLEXIBLEAUTO,
     FLEXIBLEAUTOEXT,
     NORESCALE,
+    COMPOSITESCALINGAUTO,
     INVALID_RS_TECHNIQUE,  // TODO (dsuponit): make this the first value
 };
 ScalingTechnique convertToScalingTechnique(const std::string& str);
@@ -108,6 +109,7 @@ enum KeySwitchTechnique {
     INVALID_KS_TECH = 0,
     BV,
     HYBRID,
+    KLSS,
 };
 KeySwitchTechnique convertToKeySwitchTechnique(const std::string& str);
 KeySwitchTechnique convertToKeySwitchTechnique(uint32_t num);
@@ -154,6 +156,14 @@ enum {
     BASE_NUM_LEVELS_TO_DROP = 1,
 };
 
+/**
+ * @brief COMPOSITE_SCALING_DEGREE is the number of RNS moduli that make up one level and are dropped together by one
+ * rescaling when the COMPOSITESCALINGAUTO scaling technique is used
+ */
+enum {
+    COMPOSITE_SCALING_DEGREE = 2,
+};
+
 enum NOISE_FLOODING {
     // noise flooding distribution parameter for distributed decryption in threshold FHE
     MP_SD = 1048576,
@@ -40,9 +40,12 @@
 #include "cryptocontext-fwd.h"
 #include "ciphertext.h"
 
+#include "encoding/encodingcache.h"
 #include "encoding/plaintextfactory.h"
 
 #include "key/evalkey.h"
+#include "key/evalkeycache.h"
+#include "key/evalkeystore.h"
 #include "key/keypair.h"
 
 #include "schemebase/base-pke.h"
@@ -57,10 +60,12 @@
 
 #include "binfhecontext.h"
 
+#include <cmath>
 #include <functional>
 #include <map>
 #include <memory>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 #include <algorithm>
@@ -106,6 +111,19 @@ class CryptoContextImpl : public Serializable {
 
     void SetKSTechniqueInScheme();
 
+    /**
+    * @brief GetEvalAutomorphismKeyMapForIndex returns the automorphism keys needed to rotate by index.
+    *        If the keys for keyTag are loaded lazily, only the key for this index is deserialized
+    * @param keyTag secret key tag
+    * @param index rotation index
+    */
+    std::shared_ptr<std::map<usint, EvalKey<Element>>> GetEvalAutomorphismKeyMapForIndex(const std::string& keyTag,
+                                                                                         int32_t index) const {
+        if (index == 0 || CryptoContextImpl<Element>::GetEvalAutomorphismKeyStore(keyTag) == nullptr)
+            return CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(keyTag);
+        return CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(keyTag, {FindAutomorphismIndex(index)});
+    }
+
     const CryptoContext<Element> GetContextForPointer(const CryptoContextImpl<Element>* cc) const {
         const auto& contexts = CryptoContextFactory<Element>::GetAllContexts();
         for (const auto& ctx : contexts) {
@@ -126,6 +144,15 @@ class CryptoContextImpl : public Serializable {
             size_t numModuli = cryptoParams->GetElementParams()->GetParams().size();
             uint32_t multiplicativeDepth =
                 (cryptoParams->GetScalingTechnique() == FLEXIBLEAUTOEXT) ? (numModuli - 2) : (numModuli - 1);
+            // with composite scaling the levels are counted in RNS moduli and every level spans several of them
+            uint32_t compositeDegree = cryptoParams->GetCompositeDegree();
+            if (compositeDegree > 1) {
+                multiplicativeDepth = numModuli / compositeDegree - 1;
+                if (level % compositeDegree != 0)
+                    OPENFHE_THROW("The level value should be a multiple of the composite degree [" +
+                                  std::to_string(compositeDegree) + "]. Currently: level is [" +
+                                  std::to_string(level) + "]");
+            }
             // we throw an exception if level >= numModuli. however, we use multiplicativeDepth in the error message,
             // so the user can understand the error more easily.
             if (level >= numModuli) {
@@ -222,6 +249,15 @@ class CryptoContextImpl : public Serializable {
             size_t numModuli = cryptoParams->GetElementParams()->GetParams().size();
             uint32_t multiplicativeDepth =
                 (cryptoParams->GetScalingTechnique() == FLEXIBLEAUTOEXT) ? (numModuli - 2) : (numModuli - 1);
+            // with composite scaling the levels are counted in RNS moduli and every level spans several of them
+            uint32_t compositeDegree = cryptoParams->GetCompositeDegree();
+            if (compositeDegree > 1) {
+                multiplicativeDepth = numModuli / compositeDegree - 1;
+                if (level % compositeDegree != 0)
+                    OPENFHE_THROW("The level value should be a multiple of the composite degree [" +
+                                  std::to_string(compositeDegree) + "]. Currently: level is [" +
+                                  std::to_string(level) + "]");
+            }
             // we throw an exception if level >= numModuli. however, we use multiplicativeDepth in the error message,
             // so the user can understand the error more easily.
             if (level >= numModuli) {
@@ -281,10 +317,22 @@ class CryptoContextImpl : public Serializable {
                                                value2);
     }
 
+    // evalautomorphism keys of one secret key: either the keys themselves or an indexed key file
+    // (see DeserializeEvalAutomorphismKeyLazy) they are loaded from on first use. with a key file,
+    // keys holds the keys added after the file was loaded
+    struct EvalAutomorphismKeyEntry {
+        std::shared_ptr<std::map<usint, EvalKey<Element>>> keys;
+        std::shared_ptr<EvalKeyStore<Element>> store;
+    };
+
     // cached evalmult keys, by secret key UID
-    static std::map<std::string, std::vector<EvalKey<Element>>> s_evalMultKeyMap;
-    // cached evalautomorphism keys, by secret key UID
-    static std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>> s_evalAutomorphismKeyMap;
+    static EvalKeyCache<std::vector<EvalKey<Element>>> s_evalMultKeyMap;
+    // cached evalautomorphism keys, by secret key UID. the key maps are never modified after they are
+    // added to the cache: adding keys for an existing UID replaces its map with an extended copy
+    static EvalKeyCache<EvalAutomorphismKeyEntry> s_evalAutomorphismKeyMap;
+    // cached keys for switching to and from the ephemeral sparse secret of CKKS bootstrapping with
+    // SPARSE_ENCAPSULATED, by secret key UID
+    static EvalKeyCache<std::vector<EvalKey<Element>>> s_evalEncapsulationKeyMap;
 
 protected:
     // crypto parameters used for this context
@@ -296,6 +344,44 @@ protected:
 
     uint32_t m_keyGenLevel{0};
 
+    // key of an encoded CKKS constant: operand, level, number of towers, noise scale degree (0 for
+    // multiplication), and whether it was encoded for multiplication or for addition
+    using EncodedConstantKey   = std::tuple<double, uint32_t, uint32_t, uint32_t, bool>;
+    using EncodedConstantCache = EncodingCache<EncodedConstantKey, std::vector<typename Element::Integer>>;
+    // key of an encoded CKKS plaintext: real and imaginary parts of the values, noise scale degree, level, slots
+    using EncodedPlaintextKey   = std::tuple<std::vector<double>, size_t, uint32_t, usint>;
+    using EncodedPlaintextCache = EncodingCache<EncodedPlaintextKey, ConstPlaintext>;
+
+    // bounded caches of encoded constants and plaintexts, disabled until EnableEncodingCache() is called
+    std::shared_ptr<EncodedConstantCache> m_encodedConstantCache{std::make_shared<EncodedConstantCache>()};
+    std::shared_ptr<EncodedPlaintextCache> m_encodedPlaintextCache{std::make_shared<EncodedPlaintextCache>()};
+
+    /**
+   * Encodes a CKKS plaintext through the encoded plaintext cache if the cache is enabled and the plaintext
+   * is encoded with the parameters of this context. The cached plaintext is shared, so the caller gets a copy
+   * it can modify.
+   */
+    Plaintext MakeCKKSPackedPlaintextCached(const std::vector<std::complex<double>>& value, size_t noiseScaleDeg,
+                                            uint32_t level, const std::shared_ptr<ParmType> params,
+                                            usint slots) const {
+        if (params != nullptr || m_encodedPlaintextCache->GetCapacity() == 0)
+            return MakeCKKSPackedPlaintextInternal(value, noiseScaleDeg, level, params, slots);
+
+        std::vector<double> parts;
+        parts.reserve(2 * value.size());
+        for (const auto& v : value) {
+            // NaN breaks the ordering of the keys
+            if (std::isnan(v.real()) || std::isnan(v.imag()))
+                return MakeCKKSPackedPlaintextInternal(value, noiseScaleDeg, level, params, slots);
+            parts.push_back(v.real());
+            parts.push_back(v.imag());
+        }
+        ConstPlaintext cached = m_encodedPlaintextCache->GetOrCompute(
+            EncodedPlaintextKey{std::move(parts), noiseScaleDeg, level, slots},
+            [&]() { return MakeCKKSPackedPlaintextInternal(value, noiseScaleDeg, level, params, slots); });
+        return std::make_shared<CKKSPackedEncoding>(*std::dynamic_pointer_cast<const CKKSPackedEncoding>(cached));
+    }
+
     /**
    * TypeCheck makes sure that an operation between two ciphertexts is permitted
    * @param a
@@ -580,7 +666,7 @@ public:
    */
     template <typename ST>
     static bool SerializeEvalMultKey(std::ostream& ser, const ST& sertype, std::string id = "") {
-        const auto& evalMultKeys = CryptoContextImpl<Element>::GetAllEvalMultKeys();
+        const auto evalMultKeys = CryptoContextImpl<Element>::GetAllEvalMultKeysSnapshot();
         if (id.length() == 0) {
             Serial::Serialize(evalMultKeys, ser, sertype);
         }
@@ -608,7 +694,7 @@ public:
     template <typename ST>
     static bool SerializeEvalMultKey(std::ostream& ser, const ST& sertype, const CryptoContext<Element> cc) {
         std::map<std::string, std::vector<EvalKey<Element>>> omap;
-        for (const auto& [key, vec] : CryptoContextImpl<Element>::GetAllEvalMultKeys()) {
+        for (const auto& [key, vec] : CryptoContextImpl<Element>::GetAllEvalMultKeysSnapshot()) {
             if (vec[0]->GetCryptoContext() == cc) {
                 omap[key] = vec;
             }
@@ -632,15 +718,15 @@ public:
    */
     template <typename ST>
     static bool DeserializeEvalMultKey(std::istream& ser, const ST& sertype) {
-        Serial::Deserialize(CryptoContextImpl<Element>::GetAllEvalMultKeys(), ser, sertype);
+        std::map<std::string, std::vector<EvalKey<Element>>> evalMultKeys;
 
-        // TODO (dsuponit): should we keep the code below?
-        // // The deserialize call created any contexts that needed to be created....
-        // // so all we need to do is put the keys into the maps for their context
+        Serial::Deserialize(evalMultKeys, ser, sertype);
 
-        // for (auto k : CryptoContextImpl<Element>::s_evalMultKeyMap) {
-        //     CryptoContextImpl<Element>::s_evalMultKeyMap[k.first] = k.second;
-        // }
+        // The deserialize call created any contexts that needed to be created....
+        // so all we need to do is put the keys into the maps for their context
+        for (auto& k : evalMultKeys) {
+            CryptoContextImpl<Element>::s_evalMultKeyMap.Insert(k.first, std::move(k.second));
+        }
         return true;
     }
 
@@ -746,17 +832,15 @@ public:
     template <typename ST>
     static bool SerializeEvalAutomorphismKey(std::ostream& ser, const ST& sertype, std::string id = "") {
         // TODO (dsuponit): do we need Serailize/Deserialized to return bool?
-        std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>>* smap;
         std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>> omap;
         if (id.length() == 0) {
-            smap = &CryptoContextImpl<Element>::GetAllEvalAutomorphismKeys();
+            // the snapshot has the lazily loaded keys deserialized, so they can be serialized again
+            omap = CryptoContextImpl<Element>::GetAllEvalAutomorphismKeysSnapshot();
         }
         else {
-            const auto keys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(id);
-            omap[id]        = keys;
-            smap            = &omap;
+            omap[id] = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(id);
         }
-        Serial::Serialize(*smap, ser, sertype);
+        Serial::Serialize(omap, ser, sertype);
         return true;
     }
 
@@ -771,8 +855,8 @@ public:
     template <typename ST>
     static bool SerializeEvalAutomorphismKey(std::ostream& ser, const ST& sertype, const CryptoContext<Element> cc) {
         std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>> omap;
-        for (const auto& k : CryptoContextImpl<Element>::GetAllEvalAutomorphismKeys()) {
-            if (k.second->begin()->second->GetCryptoContext() == cc) {
+        for (const auto& k : CryptoContextImpl<Element>::GetAllEvalAutomorphismKeysSnapshot()) {
+            if (!k.second->empty() && k.second->begin()->second->GetCryptoContext() == cc) {
                 omap[k.first] = k.second;
             }
         }
@@ -833,6 +917,116 @@ public:
     // TODO (dsuponit): move InsertEvalAutomorphismKey() to the private section of the class
     static void InsertEvalAutomorphismKey(const std::shared_ptr<std::map<usint, EvalKey<Element>>> evalKeyMap,
                                           const std::string& keyTag = "");
+
+    /**
+   * SerializeEvalAutomorphismKeyIndexed writes the EvalAuto keys for a given id into an
+   * indexed binary file. Unlike SerializeEvalAutomorphismKey, every key is serialized on its own,
+   * so the file can be memory-mapped and the keys deserialized one by one with
+   * DeserializeEvalAutomorphismKeyLazy
+   *
+   * @param filename - output file
+   * @param id - key to serialize
+   * @return true on success
+   */
+    static bool SerializeEvalAutomorphismKeyIndexed(const std::string& filename, const std::string& id);
+
+    /**
+   * DeserializeEvalAutomorphismKeyLazy memory-maps a file written by SerializeEvalAutomorphismKeyIndexed
+   * without deserializing any key. A key is deserialized the first time a rotation needs it.
+   * The keys silently replace any existing keys for the same id.
+   * EvalSum, EvalMerge, EvalInnerProduct, etc. deserialize only the keys they use. Keys added later
+   * for the same id are kept in memory next to the file. Calls that need the whole key map
+   * (GetEvalAutomorphismKeyMap(id), serialization) deserialize all remaining keys and turn them into
+   * regular automorphism keys
+   *
+   * @param filename - indexed key file
+   * @param maxResidentKeys - maximum number of deserialized keys kept in memory; the least recently
+   * used keys are released first. 0 means no limit
+   * @return true on success
+   */
+    static bool DeserializeEvalAutomorphismKeyLazy(const std::string& filename, uint32_t maxResidentKeys = 0);
+
+    /**
+   * Get the lazy key store for a specific secret key tag
+   * @return the key store or nullptr if the keys for keyTag are not loaded lazily
+   */
+    static std::shared_ptr<EvalKeyStore<Element>> GetEvalAutomorphismKeyStore(const std::string& keyTag);
+
+    /**
+   * SerializeEvalEncapsulationKey for the sparse-secret encapsulation keys of a single secret key or of all
+   * secret keys. These keys are generated by EvalBootstrapKeyGen for SPARSE_ENCAPSULATED and are not a part
+   * of the automorphism keys
+   *
+   * @param ser - stream to serialize to
+   * @param sertype - type of serialization
+   * @param id - key to serialize; empty std::string means all keys
+   * @return true on success
+   */
+    template <typename ST>
+    static bool SerializeEvalEncapsulationKey(std::ostream& ser, const ST& sertype, std::string id = "") {
+        std::map<std::string, std::vector<EvalKey<Element>>> omap;
+        if (id.length() == 0) {
+            for (const auto& [keyTag, evalKeys] : CryptoContextImpl<Element>::s_evalEncapsulationKeyMap.Snapshot())
+                omap.emplace(keyTag, *evalKeys);
+        }
+        else {
+            auto evalKeys = CryptoContextImpl<Element>::s_evalEncapsulationKeyMap.Find(id);
+            if (evalKeys == nullptr)
+                return false;  // no such id
+            omap.emplace(id, *evalKeys);
+        }
+
+        Serial::Serialize(omap, ser, sertype);
+        return true;
+    }
+
+    /**
+   * DeserializeEvalEncapsulationKey deserialize all keys in the serialization
+   * deserialized keys silently replace any existing matching keys
+   * deserialization will create CryptoContextImpl if necessary
+   *
+   * @param ser - stream to serialize from
+   * @param sertype - type of serialization
+   * @return true on success
+   */
+    template <typename ST>
+    static bool DeserializeEvalEncapsulationKey(std::istream& ser, const ST& sertype) {
+        std::map<std::string, std::vector<EvalKey<Element>>> evalKeys;
+
+        Serial::Deserialize(evalKeys, ser, sertype);
+
+        for (auto& k : evalKeys) {
+            CryptoContextImpl<Element>::InsertEvalEncapsulationKey(k.second, k.first);
+        }
+        return true;
+    }
+
+    /**
+   * ClearEvalEncapsulationKeys - flush the cache of sparse-secret encapsulation keys
+   */
+    static void ClearEvalEncapsulationKeys();
+
+    /**
+   * ClearEvalEncapsulationKeys - flush the cache of sparse-secret encapsulation keys for a given id
+   * @param id key id
+   */
+    static void ClearEvalEncapsulationKeys(const std::string& id);
+
+    /**
+   * InsertEvalEncapsulationKey - add the keys for switching to and from the ephemeral sparse secret,
+   * replacing the existing keys for keyTag if there
+   * @param evalKeys the key to the sparse secret, followed by the key back to the main secret
+   * @param keyTag tag of the main secret key
+   */
+    static void InsertEvalEncapsulationKey(const std::vector<EvalKey<Element>>& evalKeys, const std::string& keyTag);
+
+    /**
+   * Get the sparse-secret encapsulation keys for a specific secret key tag. The vector is shared with the key
+   * cache without copying and stays valid even if the keys are cleared or replaced concurrently
+   * @return the key to the sparse secret, followed by the key back to the main secret
+   */
+    static std::shared_ptr<const std::vector<EvalKey<Element>>> GetEvalEncapsulationKeyVectorPtr(
+        const std::string& keyID);
     //------------------------------------------------------------------------------
     // TURN FEATURES ON
     //------------------------------------------------------------------------------
@@ -941,35 +1135,87 @@ public:
     //------------------------------------------------------------------------------
 
     /**
-   * Get a map of relinearization keys for all secret keys
+   * Get relinearization keys for all secret keys. The map is a per-thread copy of the key cache made by
+   * every call: the reference stays valid until the next call from the same thread, and changes to the map
+   * are not written back; use InsertEvalMultKey/ClearEvalMultKeys to change the keys
    */
     static std::map<std::string, std::vector<EvalKey<Element>>>& GetAllEvalMultKeys();
 
     /**
-   * Get relinearization keys for a specific secret key tag
+   * Get a snapshot of relinearization keys for all secret keys. The snapshot is a copy made by every call,
+   * so it is not changed by later inserts or clears
    */
-    static const std::vector<EvalKey<Element>>& GetEvalMultKeyVector(const std::string& keyID);
+    static std::map<std::string, std::vector<EvalKey<Element>>> GetAllEvalMultKeysSnapshot();
+
+    /**
+   * Get relinearization keys for a specific secret key tag. The vector is shared with the key cache
+   * without copying and stays valid even if the keys are cleared or replaced concurrently
+   */
+    static std::shared_ptr<const std::vector<EvalKey<Element>>> GetEvalMultKeyVector(const std::string& keyID) {
+        return CryptoContextImpl<Element>::GetEvalMultKeyVectorPtr(keyID);
+    }
 
     /**
-   * Get a map of automorphism keys for all secret keys
+   * Get relinearization keys for a specific secret key tag. Same as GetEvalMultKeyVector
+   */
+    static std::shared_ptr<const std::vector<EvalKey<Element>>> GetEvalMultKeyVectorPtr(const std::string& keyID);
+
+    /**
+   * Get automorphism keys for all secret keys. The map is a per-thread copy of the key cache made by every
+   * call: the reference stays valid until the next call from the same thread, and changes to the map are
+   * not written back; use InsertEvalAutomorphismKey/ClearEvalAutomorphismKeys to change the keys. The key
+   * maps in it are shared with the key cache and must not be modified. Keys loaded by
+   * DeserializeEvalAutomorphismKeyLazy are deserialized, so every key is listed
    */
     static std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>>& GetAllEvalAutomorphismKeys();
+
+    /**
+   * Get a snapshot of automorphism keys for all secret keys. The snapshot is a copy made by every call,
+   * so it is not changed by later inserts or clears; the key maps in it are shared with the key cache and
+   * must not be modified. Keys loaded by DeserializeEvalAutomorphismKeyLazy are deserialized, so every key is listed
+   */
+    static std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>>
+    GetAllEvalAutomorphismKeysSnapshot();
+
     /**
-   * Get automorphism keys for a specific secret key tag
+   * Get automorphism keys for a specific secret key tag. The map is shared with the key cache
+   * and must not be modified; it stays valid even if the keys are cleared or extended concurrently
    */
     static std::shared_ptr<std::map<usint, EvalKey<Element>>> GetEvalAutomorphismKeyMapPtr(const std::string& keyID);
 
-    static std::map<usint, EvalKey<Element>>& GetEvalAutomorphismKeyMap(const std::string& keyID) {
-        return *(CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(keyID));
+    /**
+   * Get automorphism keys for a specific secret key tag. The map is shared with the key cache without
+   * copying and stays valid even if the keys are cleared or extended concurrently
+   */
+    static std::shared_ptr<const std::map<usint, EvalKey<Element>>> GetEvalAutomorphismKeyMap(
+        const std::string& keyID) {
+        return CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(keyID);
     }
 
     /**
-   * Get a map of summation keys (each is composed of several automorphism keys) for all secret keys
+   * Get automorphism keys for a specific secret key tag that contain at least the keys for the given
+   * automorphism indices. If the keys come from DeserializeEvalAutomorphismKeyLazy, only these keys are
+   * deserialized and returned
+   */
+    static std::shared_ptr<std::map<usint, EvalKey<Element>>> GetEvalAutomorphismKeyMapPtr(
+        const std::string& keyID, const std::vector<uint32_t>& indexList);
+
+    /**
+   * Get the crypto context the automorphism keys for a specific secret key tag belong to
+   * @return the crypto context or nullptr if there are no keys for keyID
+   */
+    static CryptoContext<Element> GetEvalAutomorphismKeyContext(const std::string& keyID);
+
+    /**
+   * Get summation keys (each is composed of several automorphism keys) for all secret keys.
+   * See GetAllEvalAutomorphismKeys
    */
     static std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>>& GetAllEvalSumKeys();
 
     /**
-   * Get a map of summation keys (each is composed of several automorphism keys) for a specific secret key tag
+   * Get a map of summation keys (each is composed of several automorphism keys) for a specific secret key tag.
+   * The map is a per-thread copy made by every call, so the reference stays valid until the next call from
+   * the same thread; use GetEvalAutomorphismKeyMap to share the keys with the key cache instead
    */
     static const std::map<usint, EvalKey<Element>>& GetEvalSumKeyMap(const std::string& id);
 
@@ -1036,7 +1282,7 @@ public:
         if (!value.size())
             OPENFHE_THROW("Cannot encode an empty value vector");
 
-        return MakeCKKSPackedPlaintextInternal(value, scaleDeg, level, params, slots);
+        return MakeCKKSPackedPlaintextCached(value, scaleDeg, level, params, slots);
     }
 
     /**
@@ -1058,7 +1304,109 @@ public:
         std::transform(value.begin(), value.end(), complexValue.begin(),
                        [](double da) { return std::complex<double>(da); });
 
-        return MakeCKKSPackedPlaintextInternal(complexValue, scaleDeg, level, params, slots);
+        return MakeCKKSPackedPlaintextCached(complexValue, scaleDeg, level, params, slots);
+    }
+
+    /**
+   * MakePackedPlaintexts encodes a batch of vectors as PackedEncodings in this context. The items are
+   * encoded in parallel, each into its own entry of the returned vector
+   * @param values vectors of signed integers mod t
+   * @param noiseScaleDegs per-item degrees of the scaling factor; empty means 1 for every item
+   * @param levels per-item levels to encode the plaintexts at; empty means 0 for every item
+   * @return plaintexts in the order of values
+   */
+    std::vector<Plaintext> MakePackedPlaintexts(const std::vector<std::vector<int64_t>>& values,
+                                                const std::vector<size_t>& noiseScaleDegs = {},
+                                                const std::vector<uint32_t>& levels       = {}) const;
+
+    /**
+   * MakeCKKSPackedPlaintexts encodes a batch of real-number vectors as CKKSPackedEncodings in this context.
+   * The items are encoded in parallel, each into its own entry of the returned vector
+   * @param values input vectors of real numbers
+   * @param scaleDegs per-item degrees of the scaling factor; empty means 1 for every item
+   * @param levels per-item levels at which the vectors will get encrypted; empty means 0 for every item
+   * @param slots number of slots used for every item
+   * @return plaintexts in the order of values
+   */
+    std::vector<Plaintext> MakeCKKSPackedPlaintexts(const std::vector<std::vector<double>>& values,
+                                                    const std::vector<size_t>& scaleDegs = {},
+                                                    const std::vector<uint32_t>& levels  = {}, usint slots = 0) const;
+
+    /**
+   * MakePackedPlaintextExt constructs a PackedEncoding in the extended basis P*Q_l, where Q_l are the towers of a
+   * ciphertext at the given level. The result is meant for EvalMultExt. Only supported for hybrid key switching.
+   * @param value vector of signed integers mod t
+   * @param noiseScaleDeg is degree of the scaling factor to encode the plaintext at
+   * @param level is the level of the ciphertexts the plaintext will be multiplied with
+   * @return plaintext in the extended basis
+   */
+    Plaintext MakePackedPlaintextExt(const std::vector<int64_t>& value, size_t noiseScaleDeg = 1,
+                                     uint32_t level = 0) const;
+
+    /**
+   * MakeCKKSPackedPlaintextExt constructs a CKKSPackedEncoding in the extended basis P*Q_l, where Q_l are the towers
+   * of a ciphertext at the given level. The result is meant for EvalMultExt. Only supported for hybrid key switching.
+   * @param value - input vector of real numbers
+   * @param scaleDeg - degree of scaling factor used to encode the vector
+   * @param level - level of the ciphertexts the plaintext will be multiplied with
+   * @param slots - number of slots
+   * @return plaintext in the extended basis
+   */
+    Plaintext MakeCKKSPackedPlaintextExt(const std::vector<double>& value, size_t scaleDeg = 1, uint32_t level = 0,
+                                         usint slots = 0) const;
+
+    /**
+   * EnableEncodingCache sets the capacity of the context caches of encoded CKKS constants and plaintexts.
+   * With the caches enabled, EvalMult/EvalAdd/EvalSub with a real constant and MakeCKKSPackedPlaintext
+   * reuse the encodings of the values they have seen at the same level and scaling factor. A cached plaintext
+   * is returned as a copy, so it can be modified without affecting the cache
+   * @param capacity the maximum number of entries in each cache; 0 disables and empties the caches
+   */
+    void EnableEncodingCache(size_t capacity) {
+        m_encodedConstantCache->SetCapacity(capacity);
+        m_encodedPlaintextCache->SetCapacity(capacity);
+    }
+
+    /**
+   * ClearEncodingCache removes all cached encodings and resets the hit/miss counters
+   */
+    void ClearEncodingCache() {
+        m_encodedConstantCache->Clear();
+        m_encodedPlaintextCache->Clear();
+    }
+
+    /**
+   * @return hit/miss counters, size and capacity of the cache of encoded constants
+   */
+    EncodingCacheStats GetEncodedConstantCacheStats() const {
+        return m_encodedConstantCache->GetStats();
+    }
+
+    /**
+   * @return hit/miss counters, size and capacity of the cache of encoded plaintexts
+   */
+    EncodingCacheStats GetEncodedPlaintextCacheStats() const {
+        return m_encodedPlaintextCache->GetStats();
+    }
+
+    /**
+   * EnableFusedRescale makes CKKS products rescale inside their relinearization: one ModDown by q_l*P replaces
+   * the ModDown by P of the key switch and the separate rescaling. It applies to EvalMult/EvalSquare under
+   * FLEXIBLEAUTO, whose products are then returned rescaled instead of with a pending rescale, and to
+   * ComposedEvalMult under FIXEDMANUAL. The setting is part of the crypto parameters, so it is serialized with
+   * the context; call it before evaluating. Supported only for HYBRID key switching
+   */
+    void EnableFusedRescale() {
+        VerifyCKKSScheme(__func__);
+        const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(GetCryptoParameters());
+        cryptoParams->EnableFusedRescale();
+    }
+
+    /**
+   * For the scheme implementations: the cache of constants encoded for the towers of a ciphertext
+   */
+    EncodedConstantCache& GetEncodedConstantCache() const {
+        return *m_encodedConstantCache;
     }
 
     /**
@@ -1606,6 +1954,17 @@ public:
    */
     void EvalMultKeyGen(const PrivateKey<Element> key);
 
+    /**
+   * EvalMultKeyGen creates a relinearization key (for s^2) that only supports ciphertexts at the given
+   * level or above (ciphertexts with at most sizeQ - level towers). The RNS towers of Q that are not needed
+   * for such ciphertexts are dropped from the key, which reduces its size proportionally. If there is a key
+   * for the secret key already, it is kept as is (see TrimEvalMultKeys()).
+   * the new evaluation key is stored in cryptocontext
+   * @param key secret key
+   * @param level the lowest level of ciphertexts the key is used for
+   */
+    void EvalMultKeyGen(const PrivateKey<Element> key, uint32_t level);
+
     /**
    * EvalMultsKeyGen creates a vector evalmult keys that can be used with the
    * OpenFHE EvalMult operator 1st key (for s^2) is used for multiplication of
@@ -1626,12 +1985,12 @@ public:
     Ciphertext<Element> EvalMult(ConstCiphertext<Element> ciphertext1, ConstCiphertext<Element> ciphertext2) const {
         TypeCheck(ciphertext1, ciphertext2);
 
-        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertext1->GetKeyTag());
-        if (!evalKeyVec.size()) {
+        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVectorPtr(ciphertext1->GetKeyTag());
+        if (!evalKeyVec->size()) {
             OPENFHE_THROW("Evaluation key has not been generated for EvalMult");
         }
 
-        return GetScheme()->EvalMult(ciphertext1, ciphertext2, evalKeyVec[0]);
+        return GetScheme()->EvalMult(ciphertext1, ciphertext2, (*evalKeyVec)[0]);
     }
 
     /**
@@ -1643,12 +2002,12 @@ public:
     Ciphertext<Element> EvalMultMutable(Ciphertext<Element>& ciphertext1, Ciphertext<Element>& ciphertext2) const {
         TypeCheck(ciphertext1, ciphertext2);
 
-        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertext1->GetKeyTag());
-        if (!evalKeyVec.size()) {
+        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVectorPtr(ciphertext1->GetKeyTag());
+        if (!evalKeyVec->size()) {
             OPENFHE_THROW("Evaluation key has not been generated for EvalMultMutable");
         }
 
-        return GetScheme()->EvalMultMutable(ciphertext1, ciphertext2, evalKeyVec[0]);
+        return GetScheme()->EvalMultMutable(ciphertext1, ciphertext2, (*evalKeyVec)[0]);
     }
 
     /**
@@ -1659,12 +2018,12 @@ public:
     void EvalMultMutableInPlace(Ciphertext<Element>& ciphertext1, Ciphertext<Element>& ciphertext2) const {
         TypeCheck(ciphertext1, ciphertext2);
 
-        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertext1->GetKeyTag());
-        if (!evalKeyVec.size()) {
+        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVectorPtr(ciphertext1->GetKeyTag());
+        if (!evalKeyVec->size()) {
             OPENFHE_THROW("Evaluation key has not been generated for EvalMultMutable");
         }
 
-        GetScheme()->EvalMultMutableInPlace(ciphertext1, ciphertext2, evalKeyVec[0]);
+        GetScheme()->EvalMultMutableInPlace(ciphertext1, ciphertext2, (*evalKeyVec)[0]);
     }
 
     /**
@@ -1675,12 +2034,12 @@ public:
     Ciphertext<Element> EvalSquare(ConstCiphertext<Element> ciphertext) const {
         ValidateCiphertext(ciphertext);
 
-        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertext->GetKeyTag());
-        if (!evalKeyVec.size()) {
+        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVectorPtr(ciphertext->GetKeyTag());
+        if (!evalKeyVec->size()) {
             OPENFHE_THROW("Evaluation key has not been generated for EvalMult");
         }
 
-        return GetScheme()->EvalSquare(ciphertext, evalKeyVec[0]);
+        return GetScheme()->EvalSquare(ciphertext, (*evalKeyVec)[0]);
     }
 
     /**
@@ -1691,12 +2050,12 @@ public:
     Ciphertext<Element> EvalSquareMutable(Ciphertext<Element>& ciphertext) const {
         ValidateCiphertext(ciphertext);
 
-        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertext->GetKeyTag());
-        if (!evalKeyVec.size()) {
+        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVectorPtr(ciphertext->GetKeyTag());
+        if (!evalKeyVec->size()) {
             OPENFHE_THROW("Evaluation key has not been generated for EvalMultMutable");
         }
 
-        return GetScheme()->EvalSquareMutable(ciphertext, evalKeyVec[0]);
+        return GetScheme()->EvalSquareMutable(ciphertext, (*evalKeyVec)[0]);
     }
 
     /**
@@ -1707,12 +2066,12 @@ public:
     void EvalSquareInPlace(Ciphertext<Element>& ciphertext) const {
         ValidateCiphertext(ciphertext);
 
-        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertext->GetKeyTag());
-        if (!evalKeyVec.size()) {
+        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVectorPtr(ciphertext->GetKeyTag());
+        if (!evalKeyVec->size()) {
             OPENFHE_THROW("Evaluation key has not been generated for EvalMultMutable");
         }
 
-        GetScheme()->EvalSquareInPlace(ciphertext, evalKeyVec[0]);
+        GetScheme()->EvalSquareInPlace(ciphertext, (*evalKeyVec)[0]);
     }
 
     /**
@@ -1737,15 +2096,15 @@ public:
         if (!ciphertext)
             OPENFHE_THROW("Input ciphertext is nullptr");
 
-        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertext->GetKeyTag());
+        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVectorPtr(ciphertext->GetKeyTag());
 
-        if (evalKeyVec.size() < (ciphertext->NumberCiphertextElements() - 2)) {
+        if (evalKeyVec->size() < (ciphertext->NumberCiphertextElements() - 2)) {
             OPENFHE_THROW(
                 "Insufficient value was used for maxRelinSkDeg to generate "
                 "keys for EvalMult");
         }
 
-        return GetScheme()->Relinearize(ciphertext, evalKeyVec);
+        return GetScheme()->Relinearize(ciphertext, *evalKeyVec);
     }
 
     /**
@@ -1757,14 +2116,14 @@ public:
         if (!ciphertext)
             OPENFHE_THROW("Input ciphertext is nullptr");
 
-        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertext->GetKeyTag());
-        if (evalKeyVec.size() < (ciphertext->NumberCiphertextElements() - 2)) {
+        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVectorPtr(ciphertext->GetKeyTag());
+        if (evalKeyVec->size() < (ciphertext->NumberCiphertextElements() - 2)) {
             OPENFHE_THROW(
                 "Insufficient value was used for maxRelinSkDeg to generate "
                 "keys for EvalMult");
         }
 
-        GetScheme()->RelinearizeInPlace(ciphertext, evalKeyVec);
+        GetScheme()->RelinearizeInPlace(ciphertext, *evalKeyVec);
     }
 
     /**
@@ -1779,16 +2138,16 @@ public:
         if (!ciphertext1 || !ciphertext2)
             OPENFHE_THROW("Input ciphertext is nullptr");
 
-        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertext1->GetKeyTag());
+        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVectorPtr(ciphertext1->GetKeyTag());
 
-        if (evalKeyVec.size() <
+        if (evalKeyVec->size() <
             (ciphertext1->NumberCiphertextElements() + ciphertext2->NumberCiphertextElements() - 3)) {
             OPENFHE_THROW(
                 "Insufficient value was used for maxRelinSkDeg to generate "
                 "keys for EvalMult");
         }
 
-        return GetScheme()->EvalMultAndRelinearize(ciphertext1, ciphertext2, evalKeyVec);
+        return GetScheme()->EvalMultAndRelinearize(ciphertext1, ciphertext2, *evalKeyVec);
     }
 
     /**
@@ -2011,8 +2370,8 @@ public:
     Ciphertext<Element> EvalRotate(ConstCiphertext<Element> ciphertext, int32_t index) const {
         ValidateCiphertext(ciphertext);
 
-        auto evalKeyMap = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
-        return GetScheme()->EvalAtIndex(ciphertext, index, evalKeyMap);
+        auto evalKeyMap = GetEvalAutomorphismKeyMapForIndex(ciphertext->GetKeyTag(), index);
+        return GetScheme()->EvalAtIndex(ciphertext, index, *evalKeyMap);
     }
 
     /**
@@ -2100,9 +2459,9 @@ public:
    */
     Ciphertext<Element> EvalFastRotationExt(ConstCiphertext<Element> ciphertext, usint index,
                                             const std::shared_ptr<std::vector<Element>> digits, bool addFirst) const {
-        auto evalKeyMap = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
+        auto evalKeyMap = GetEvalAutomorphismKeyMapForIndex(ciphertext->GetKeyTag(), index);
 
-        return GetScheme()->EvalFastRotationExt(ciphertext, index, digits, addFirst, evalKeyMap);
+        return GetScheme()->EvalFastRotationExt(ciphertext, index, digits, addFirst, *evalKeyMap);
     }
 
     /**
@@ -2140,6 +2499,80 @@ public:
         return GetScheme()->KeySwitchExt(ciphertext, addFirst);
     }
 
+    /**
+   * Only supported for hybrid key switching.
+   * Multiplies a ciphertext in the extended basis P*Q by a plaintext encoded in the same basis
+   * (see MakeCKKSPackedPlaintextExt and MakePackedPlaintextExt). Together with KeySwitchExt,
+   * EvalFastRotationExt and EvalAddExtInPlace, this allows to accumulate many rotated and
+   * multiplied terms in the extended basis and to call KeySwitchDown only once at the end:
+   *
+   *   auto digits = cc->EvalFastRotationPrecompute(ct);
+   *   auto acc    = cc->EvalMultExt(cc->KeySwitchExt(ct, true), pt[0]);
+   *   for (i = 1; i < n; ++i)
+   *       cc->EvalAddExtInPlace(acc, cc->EvalMultExt(cc->EvalFastRotationExt(ct, i, digits, true), pt[i]));
+   *   auto result = cc->KeySwitchDown(acc);
+   *
+   * @param ciphertext input ciphertext in the extended basis
+   * @param plaintext plaintext encoded in the extended basis at the level of the ciphertext
+   * @return resulting ciphertext in the extended basis
+   */
+    Ciphertext<Element> EvalMultExt(ConstCiphertext<Element> ciphertext, ConstPlaintext plaintext) const {
+        return GetScheme()->EvalMultExt(ciphertext, plaintext);
+    }
+
+    /**
+   * Only supported for hybrid key switching.
+   * Adds two ciphertexts in the extended basis P*Q in-place.
+   *
+   * @param ciphertext1 first ciphertext in the extended basis; the result is stored here
+   * @param ciphertext2 second ciphertext in the extended basis
+   */
+    void EvalAddExtInPlace(Ciphertext<Element>& ciphertext1, ConstCiphertext<Element> ciphertext2) const {
+        GetScheme()->EvalAddExtInPlace(ciphertext1, ciphertext2);
+    }
+
+    /**
+   * Only supported for hybrid key switching.
+   * Adds two ciphertexts in the extended basis P*Q.
+   *
+   * @param ciphertext1 first ciphertext in the extended basis
+   * @param ciphertext2 second ciphertext in the extended basis
+   * @return resulting ciphertext in the extended basis
+   */
+    Ciphertext<Element> EvalAddExt(ConstCiphertext<Element> ciphertext1, ConstCiphertext<Element> ciphertext2) const {
+        return GetScheme()->EvalAddExt(ciphertext1, ciphertext2);
+    }
+
+    /**
+   * TrimEvalKey drops the RNS towers of Q from a key-switching key that are not needed to key-switch
+   * ciphertexts at the given level or above (ciphertexts with at most sizeQ - level towers)
+   *
+   * @param evalKey key-switching key
+   * @param level the lowest level of ciphertexts the key is used for
+   * @return the trimmed key; evalKey itself if it has no towers to drop
+   */
+    EvalKey<Element> TrimEvalKey(const EvalKey<Element> evalKey, uint32_t level) const {
+        return GetScheme()->TrimEvalKey(evalKey, level);
+    }
+
+    /**
+   * TrimEvalMultKeys replaces the relinearization keys for a given secret key tag with keys that only
+   * support ciphertexts at the given level or above
+   *
+   * @param keyTag secret key tag
+   * @param level the lowest level of ciphertexts the keys are used for
+   */
+    void TrimEvalMultKeys(const std::string& keyTag, uint32_t level) const;
+
+    /**
+   * TrimEvalAutomorphismKeys replaces the automorphism keys for a given secret key tag with keys that only
+   * support ciphertexts at the given level or above. Lazily loaded keys are deserialized first
+   *
+   * @param keyTag secret key tag
+   * @param level the lowest level of ciphertexts the keys are used for
+   */
+    void TrimEvalAutomorphismKeys(const std::string& keyTag, uint32_t level) const;
+
     /**
    * EvalAtIndexKeyGen generates evaluation keys for a list of rotation indices
    *
@@ -2150,6 +2583,19 @@ public:
     void EvalAtIndexKeyGen(const PrivateKey<Element> privateKey, const std::vector<int32_t>& indexList,
                            const PublicKey<Element> publicKey = nullptr);
 
+    /**
+   * EvalAtIndexKeyGen generates evaluation keys for a list of rotation indices that only support
+   * ciphertexts at the given level or above (ciphertexts with at most sizeQ - level towers). The RNS towers
+   * of Q that are not needed for such ciphertexts are dropped from the keys. Keys that exist already for
+   * some of the indices are kept as is (see TrimEvalAutomorphismKeys()).
+   *
+   * @param privateKey private key.
+   * @param indexList list of indices.
+   * @param level the lowest level of ciphertexts the keys are used for
+   */
+    void EvalAtIndexKeyGen(const PrivateKey<Element> privateKey, const std::vector<int32_t>& indexList,
+                           uint32_t level);
+
     // [[deprecated(
     //     "Use EvalAtIndexKeyGen(const PrivateKey<Element> privateKey, const std::vector<int32_t>& indexList) instead.")]] void
     // EvalAtIndexKeyGen(const PrivateKey<Element> privateKey, const std::vector<int32_t>& indexList,
@@ -2171,6 +2617,19 @@ public:
                           const PublicKey<Element> publicKey = nullptr) {
         EvalAtIndexKeyGen(privateKey, indexList, publicKey);
     };
+
+    /**
+   * EvalRotateKeyGen generates evaluation keys for a list of rotation indices that only support
+   * ciphertexts at the given level or above. Calls EvalAtIndexKeyGen under the hood.
+   *
+   * @param privateKey private key.
+   * @param indexList list of indices.
+   * @param level the lowest level of ciphertexts the keys are used for
+   */
+    void EvalRotateKeyGen(const PrivateKey<Element> privateKey, const std::vector<int32_t>& indexList,
+                          uint32_t level) {
+        EvalAtIndexKeyGen(privateKey, indexList, level);
+    };
     // [[deprecated(
     //     "Use EvalRotateKeyGen(const PrivateKey<Element> privateKey, const std::vector<int32_t>& indexList) instead.")]] void
     // EvalRotateKeyGen(const PrivateKey<Element> privateKey, const std::vector<int32_t>& indexList,
@@ -2203,12 +2662,12 @@ public:
         ValidateCiphertext(ciphertext1);
         ValidateCiphertext(ciphertext2);
 
-        auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertext1->GetKeyTag());
-        if (!evalKeyVec.size()) {
+        auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVectorPtr(ciphertext1->GetKeyTag());
+        if (!evalKeyVec->size()) {
             OPENFHE_THROW("Evaluation key has not been generated for EvalMult");
         }
 
-        return GetScheme()->ComposedEvalMult(ciphertext1, ciphertext2, evalKeyVec[0]);
+        return GetScheme()->ComposedEvalMult(ciphertext1, ciphertext2, (*evalKeyVec)[0]);
     }
 
     /**
@@ -2303,7 +2762,8 @@ public:
 
     /**
    * EvalAddMany - Evaluate addition on a vector of ciphertexts.
-   * It computes the addition in a binary tree manner.
+   * It computes the addition in a binary tree manner. For CKKS with automatic scaling, the ciphertexts of the
+   * same level and noise scale degree are added first, so every partial sum is rescaled at most once.
    *
    * @param ctList is the list of ciphertexts.
    * @return new ciphertext.
@@ -2360,12 +2820,12 @@ public:
             return ciphertextVec[0];
         }
 
-        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertextVec[0]->GetKeyTag());
-        if (evalKeyVec.size() < (ciphertextVec[0]->NumberCiphertextElements() - 2)) {
+        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVectorPtr(ciphertextVec[0]->GetKeyTag());
+        if (evalKeyVec->size() < (ciphertextVec[0]->NumberCiphertextElements() - 2)) {
             OPENFHE_THROW("Insufficient value was used for maxRelinSkDeg to generate keys");
         }
 
-        return GetScheme()->EvalMultMany(ciphertextVec, evalKeyVec);
+        return GetScheme()->EvalMultMany(ciphertextVec, *evalKeyVec);
     }
 
     //------------------------------------------------------------------------------
@@ -2429,7 +2889,8 @@ public:
     //------------------------------------------------------------------------------
 
     /**
-   * Method for evaluation for polynomials represented as power series. Supported only in CKKS.
+   * Method for evaluation for polynomials represented as power series. Supported in CKKS, BFV and BGV;
+   * for BFV and BGV the coefficients must be integers and are reduced mod the plaintext modulus.
    * If the degree of the polynomial is less than 5, use
    * EvalPolyLinear (naive linear method), otherwise, use EvalPolyPS (Paterson-Stockmeyer method).
    *
@@ -2448,7 +2909,7 @@ public:
     /**
    * Naive method for polynomial evaluation for polynomials represented in the power
    * series (fast only for small-degree polynomials; less than 10). Uses a binary tree computation of
-   * the polynomial powers. Supported only in CKKS.
+   * the polynomial powers. Supported in CKKS, BFV and BGV.
    *
    * @param cipherText input ciphertext
    * @param &coefficients is the vector of coefficients in the polynomial; the
@@ -2464,7 +2925,7 @@ public:
 
     /**
    * Paterson-Stockmeyer method for evaluation for polynomials represented in the power
-   * series. Supported only in CKKS.
+   * series. Supported in CKKS, BFV and BGV.
    *
    * @param cipherText input ciphertext
    * @param &coefficients is the vector of coefficients in the polynomial; the
@@ -2537,6 +2998,60 @@ public:
         return GetScheme()->EvalChebyshevSeriesPS(ciphertext, coefficients, a, b);
     }
 
+    /**
+   * Computes the Chebyshev power basis of a ciphertext once, so that several Chebyshev series of the same
+   * degree can be evaluated on it with EvalChebyshevSeriesWithBasis without recomputing the powers.
+   * The independent baby steps are computed in parallel when there are at least as many of them as threads.
+   * Supported only in CKKS.
+   *
+   * @param ciphertext input ciphertext
+   * @param degree degree of the series that will be evaluated with the basis
+   * @param a - lower bound of argument for which the coefficients were found
+   * @param b - upper bound of argument for which the coefficients were found
+   * @return the power basis
+   */
+    std::shared_ptr<const ChebyshevPowerBasis<Element>> EvalChebyshevPowerBasis(ConstCiphertext<Element> ciphertext,
+                                                                                uint32_t degree, double a,
+                                                                                double b) const {
+        ValidateCiphertext(ciphertext);
+
+        return GetScheme()->EvalChebyshevPowerBasis(ciphertext, degree, a, b);
+    }
+
+    /**
+   * Evaluates a Chebyshev series with the Paterson-Stockmeyer method on a precomputed power basis.
+   * The result is the same as the one of EvalChebyshevSeriesPS. Supported only in CKKS.
+   *
+   * @param basis power basis computed by EvalChebyshevPowerBasis
+   * @param coefficients coefficients of the Chebyshev expansion; the series must have the degree the basis
+   * was computed for or another degree with the same Paterson-Stockmeyer parameters
+   * @return the result of polynomial evaluation.
+   */
+    Ciphertext<Element> EvalChebyshevSeriesWithBasis(const std::shared_ptr<const ChebyshevPowerBasis<Element>>& basis,
+                                                     const std::vector<double>& coefficients) const {
+        if (basis == nullptr)
+            OPENFHE_THROW("Input power basis is nullptr");
+
+        return GetScheme()->EvalChebyshevSeriesWithBasis(*basis, coefficients);
+    }
+
+    /**
+   * Evaluates several Chebyshev series on a precomputed power basis. Supported only in CKKS.
+   *
+   * @param basis power basis computed by EvalChebyshevPowerBasis
+   * @param coefficients coefficients of the Chebyshev expansions, one vector per series
+   * @return the results of the polynomial evaluations in the order of coefficients
+   */
+    std::vector<Ciphertext<Element>> EvalChebyshevSeriesWithBasis(
+        const std::shared_ptr<const ChebyshevPowerBasis<Element>>& basis,
+        const std::vector<std::vector<double>>& coefficients) const {
+        std::vector<Ciphertext<Element>> results;
+        results.reserve(coefficients.size());
+        for (const auto& coeffs : coefficients)
+            results.push_back(EvalChebyshevSeriesWithBasis(basis, coeffs));
+        return results;
+    }
+
     /**
    * Method for calculating Chebyshev evaluation on a ciphertext for a smooth input
    * function over the range [a,b]. Supported only in CKKS.
@@ -2599,6 +3114,137 @@ public:
    */
     Ciphertext<Element> EvalDivide(ConstCiphertext<Element> ciphertext, double a, double b, uint32_t degree) const;
 
+    //------------------------------------------------------------------------------
+    // Advanced SHE COMPARISON
+    //------------------------------------------------------------------------------
+
+    /**
+   * Returns the multiplicative depth consumed by EvalSign and EvalCompare for the given gap and precision.
+   * EvalMax and EvalMin consume one more level; every round of EvalMaxSlots and EvalMinSlots and every stage
+   * of EvalSortSlots consumes two more levels. Supported only in CKKS.
+   *
+   * @param gap smallest |x| / bound for which the sign is approximated to the requested precision
+   * @param precision number of bits of precision of the sign for inputs satisfying the gap
+   * @return the multiplicative depth
+   */
+    static uint32_t GetEvalSignDepth(double gap, uint32_t precision);
+
+    /**
+   * Evaluates the sign function on a ciphertext as a composition of low-degree odd polynomials that drive
+   * every |x| >= gap * bound to within 2^-precision of +-1. Inputs closer to zero are mapped into (-1, 1).
+   * The composition is evaluated as a few Chebyshev series, so it is cheaper than a single high-degree
+   * approximation of the same precision. Supported only in CKKS.
+   *
+   * @param ciphertext input ciphertext; all values must lie in [-bound, bound]
+   * @param bound upper bound on the magnitude of the input values
+   * @param gap smallest |x| / bound for which the sign is approximated to the requested precision; in (0, 1)
+   * @param precision number of bits of precision of the sign for inputs satisfying the gap
+   * @return the ciphertext of approximate signs
+   */
+    Ciphertext<Element> EvalSign(ConstCiphertext<Element> ciphertext, double bound, double gap,
+                                 uint32_t precision) const {
+        return GetScheme()->EvalSign(ciphertext, bound, gap, precision);
+    }
+
+    /**
+   * Compares two ciphertexts slot by slot: the result is close to 1 where ciphertext1 > ciphertext2 and close to 0
+   * where ciphertext1 < ciphertext2 (0.5 at equality). Consumes the same depth as EvalSign.
+   * Supported only in CKKS.
+   *
+   * @param ciphertext1 first input ciphertext
+   * @param ciphertext2 second input ciphertext
+   * @param bound upper bound on |ciphertext1 - ciphertext2| in every slot
+   * @param gap smallest |ciphertext1 - ciphertext2| / bound for which the result has the requested precision
+   * @param precision number of bits of precision of the result for inputs satisfying the gap
+   * @return the ciphertext of comparison results
+   */
+    Ciphertext<Element> EvalCompare(ConstCiphertext<Element> ciphertext1, ConstCiphertext<Element> ciphertext2,
+                                    double bound, double gap, uint32_t precision) const {
+        return GetScheme()->EvalCompare(ciphertext1, ciphertext2, bound, gap, precision);
+    }
+
+    /**
+   * Computes the slot-wise maximum of two ciphertexts as ((x + y) + (x - y) * sign(x - y)) / 2. Where the values
+   * are closer than gap * bound the error is at most |x - y|. Requires an automatic scaling technique and the
+   * relinearization key. Supported only in CKKS.
+   *
+   * @param ciphertext1 first input ciphertext
+   * @param ciphertext2 second input ciphertext
+   * @param bound upper bound on |ciphertext1 - ciphertext2| in every slot
+   * @param gap smallest |ciphertext1 - ciphertext2| / bound for which the sign is accurate
+   * @param precision number of bits of precision of the sign for inputs satisfying the gap
+   * @return the ciphertext of slot-wise maxima
+   */
+    Ciphertext<Element> EvalMax(ConstCiphertext<Element> ciphertext1, ConstCiphertext<Element> ciphertext2,
+                                double bound, double gap, uint32_t precision) const {
+        return GetScheme()->EvalMax(ciphertext1, ciphertext2, bound, gap, precision);
+    }
+
+    /**
+   * Computes the slot-wise minimum of two ciphertexts. See EvalMax for the parameters and requirements.
+   * Supported only in CKKS.
+   */
+    Ciphertext<Element> EvalMin(ConstCiphertext<Element> ciphertext1, ConstCiphertext<Element> ciphertext2,
+                                double bound, double gap, uint32_t precision) const {
+        return GetScheme()->EvalMin(ciphertext1, ciphertext2, bound, gap, precision);
+    }
+
+    /**
+   * Generates the rotation keys needed by EvalMaxSlots, EvalMinSlots and EvalSortSlots for numValues slots.
+   * The relinearization key is generated separately by EvalMultKeyGen.
+   *
+   * @param privateKey private key
+   * @param numValues number of slots to compare; must be a power of two
+   */
+    void EvalCompareSlotsKeyGen(const PrivateKey<Element> privateKey, uint32_t numValues) {
+        ValidateKey(privateKey);
+
+        auto evalKeys = GetScheme()->EvalCompareSlotsKeyGen(privateKey, numValues);
+        CryptoContextImpl<Element>::InsertEvalAutomorphismKey(evalKeys, privateKey->GetKeyTag());
+    }
+
+    /**
+   * Computes the maximum of the first numValues slots by a tournament of log2(numValues) rounds of EvalMax
+   * against rotated copies. The result is in slot 0. Supported only in CKKS.
+   *
+   * @param ciphertext input ciphertext
+   * @param numValues number of slots to compare; a power of two not larger than the number of slots
+   * @param bound upper bound on the difference of any two of the values
+   * @param gap smallest difference / bound for which the sign is accurate
+   * @param precision number of bits of precision of the sign for inputs satisfying the gap
+   * @return the ciphertext with the maximum in slot 0
+   */
+    Ciphertext<Element> EvalMaxSlots(ConstCiphertext<Element> ciphertext, uint32_t numValues, double bound,
+                                     double gap, uint32_t precision) const {
+        return GetScheme()->EvalMaxSlots(ciphertext, numValues, bound, gap, precision);
+    }
+
+    /**
+   * Computes the minimum of the first numValues slots. See EvalMaxSlots for the parameters.
+   * Supported only in CKKS.
+   */
+    Ciphertext<Element> EvalMinSlots(ConstCiphertext<Element> ciphertext, uint32_t numValues, double bound,
+                                     double gap, uint32_t precision) const {
+        return GetScheme()->EvalMinSlots(ciphertext, numValues, bound, gap, precision);
+    }
+
+    /**
+   * Sorts the first numValues slots in ascending order with a bitonic network of
+   * log2(numValues) * (log2(numValues) + 1) / 2 compare-exchange stages. Each stage compares every slot with its
+   * partner in one sign evaluation. The other slots are left unchanged. Supported only in CKKS.
+   *
+   * @param ciphertext input ciphertext
+   * @param numValues number of slots to sort; a power of two not larger than the number of slots
+   * @param bound upper bound on the difference of any two of the values
+   * @param gap smallest difference / bound for which the sign is accurate
+   * @param precision number of bits of precision of the sign for inputs satisfying the gap
+   * @return the ciphertext with the sorted values
+   */
+    Ciphertext<Element> EvalSortSlots(ConstCiphertext<Element> ciphertext, uint32_t numValues, double bound,
+                                      double gap, uint32_t precision) const {
+        return GetScheme()->EvalSortSlots(ciphertext, numValues, bound, gap, precision);
+    }
+
     //------------------------------------------------------------------------------
     // Advanced SHE EVAL SUM
     //------------------------------------------------------------------------------
@@ -2732,6 +3378,57 @@ public:
    */
     Ciphertext<Element> EvalMerge(const std::vector<Ciphertext<Element>>& ciphertextVec) const;
 
+    //------------------------------------------------------------------------------
+    // Advanced SHE MATRIX MULTIPLICATION
+    //------------------------------------------------------------------------------
+
+    /**
+   * Generates the rotation keys needed by EvalMatMul for d x d matrices. The relinearization key
+   * has to be generated with EvalMultKeyGen.
+   *
+   * @param privateKey private key.
+   * @param dim matrix dimension d
+   */
+    void EvalMatMulKeyGen(const PrivateKey<Element> privateKey, uint32_t dim) {
+        ValidateKey(privateKey);
+
+        EvalRotateKeyGen(privateKey, GetScheme()->FindMatMulRotationIndices(dim));
+    }
+
+    /**
+   * Encodes the permutation diagonals used by EvalMatMul for d x d matrices. The result can be reused
+   * for every product of ciphertexts at the given level. Supported in CKKS, BGV and BFV.
+   *
+   * @param dim matrix dimension d; d^2 should not exceed the number of slots
+   * @param level level of the ciphertexts that will be multiplied
+   * @param slots number of slots of the ciphertexts (CKKS only); 0 means the default number of slots
+   * @return the encoded diagonals
+   */
+    std::shared_ptr<const MatMulPrecom> EvalMatMulPrecompute(uint32_t dim, uint32_t level = 0,
+                                                             uint32_t slots = 0) const {
+        return GetScheme()->EvalMatMulPrecompute(*this, dim, level, slots);
+    }
+
+    /**
+   * Multiplies two encrypted d x d matrices packed row by row into the first d^2 slots, with the method of
+   * Jiang, Kim, Lauter and Song. The rotations of each input are hoisted and run in parallel; the result is
+   * relinearized once. Consumes three levels. Requires the keys of EvalMatMulKeyGen and EvalMultKeyGen.
+   *
+   * @param ciphertextA the left matrix
+   * @param ciphertextB the right matrix
+   * @param precom diagonals computed by EvalMatMulPrecompute for the level of the inputs
+   * @return the encrypted product, packed row by row
+   */
+    Ciphertext<Element> EvalMatMul(ConstCiphertext<Element> ciphertextA, ConstCiphertext<Element> ciphertextB,
+                                   const std::shared_ptr<const MatMulPrecom>& precom) const {
+        ValidateCiphertext(ciphertextA);
+        ValidateCiphertext(ciphertextB);
+        if (precom == nullptr)
+            OPENFHE_THROW("Input matrix multiplication precomputation is nullptr");
+
+        return GetScheme()->EvalMatMul(ciphertextA, ciphertextB, *precom);
+    }
+
     //------------------------------------------------------------------------------
     // PRE Wrapper
     //------------------------------------------------------------------------------
@@ -3188,6 +3885,10 @@ public:
     /**
    * Generates all automorphism keys for EvalBootstrap. Supported in CKKS only.
    * EvalBootstrapKeyGen uses the baby-step/giant-step strategy.
+   * For the SPARSE_ENCAPSULATED secret key distribution, it also generates the keys for switching to and
+   * from the ephemeral sparse secret used by bootstrapping. They are stored apart from the automorphism keys;
+   * see SerializeEvalEncapsulationKey. For a security level other than HEStd_NotSet, the context generation
+   * rejects the parameters if log2(Q_0 * P) is too large for the sparse secret; more large digits reduce P.
    *
    * @param privateKey private key.
    * @param slots number of slots to support permutations on
@@ -3216,11 +3917,93 @@ public:
    * @param precision precision of initial bootstrapping algorithm. This value is
    * determined by the user experimentally by first running EvalBootstrap with numIterations = 1 and precision = 0 (unused).
    * @return the refreshed ciphertext.
+   *
+   * Thread safety: once the bootstrapping setup and key generation are complete, EvalBootstrap,
+   * EvalBootstrapBatch and EvalBootstrapPair may be called concurrently from any number of threads on the
+   * same crypto context, also together with other evaluation operations and with the generation of new keys.
+   * The following calls are not supported concurrently with bootstrapping on the same crypto context:
+   * EvalBootstrapSetup, EvalBootstrapPrecompute, DeserializeEvalBootstrapPrecomputation and the removal of
+   * the keys used by bootstrapping (ClearEvalMultKeys, ClearEvalAutomorphismKeys and the like).
    */
     Ciphertext<Element> EvalBootstrap(ConstCiphertext<Element> ciphertext, uint32_t numIterations = 1,
                                       uint32_t precision = 0) const {
         return GetScheme()->EvalBootstrap(ciphertext, numIterations, precision);
     }
+    /**
+   * Generates the automorphism keys for EvalBootstrapBatch: the bootstrapping keys for the packed
+   * number of slots and the rotation keys used to unpack the batch. Supported in CKKS only.
+   *
+   * @param privateKey private key.
+   * @param slots number of slots of every ciphertext in the batch
+   * @param batchSize maximum number of ciphertexts bootstrapped together
+   */
+    void EvalBootstrapBatchKeyGen(const PrivateKey<Element> privateKey, uint32_t slots, uint32_t batchSize) {
+        ValidateKey(privateKey);
+
+        auto evalKeys = GetScheme()->EvalBootstrapBatchKeyGen(privateKey, slots, batchSize);
+
+        CryptoContextImpl<Element>::InsertEvalAutomorphismKey(evalKeys, privateKey->GetKeyTag());
+    }
+    /**
+   * Bootstraps several sparsely packed ciphertexts at the cost of a single bootstrapping. The ciphertexts
+   * are interleaved into one ciphertext with slots * k slots, where k is batchSize rounded up to a power
+   * of two, which is bootstrapped and then split again using k - 1 rotations. A batch that is not a power
+   * of two is padded, so it costs as many rotations as the next power of two.
+   * EvalBootstrapSetup() has to be called for the packed number of slots and the keys have to be
+   * generated by EvalBootstrapBatchKeyGen(). Supported in CKKS only.
+   *
+   * @param ciphertexts the input ciphertexts; all of them must have the same number of slots.
+   * @param numIterations number of iterations to run iterative bootstrapping (Meta-BTS).
+   * @param precision precision of initial bootstrapping algorithm.
+   * @return the refreshed ciphertexts in the order of the input.
+   */
+    std::vector<Ciphertext<Element>> EvalBootstrapBatch(const std::vector<Ciphertext<Element>>& ciphertexts,
+                                                        uint32_t numIterations = 1, uint32_t precision = 0) const {
+        return GetScheme()->EvalBootstrapBatch(ciphertexts, numIterations, precision);
+    }
+    /**
+   * Bootstraps two ciphertexts with real-valued messages at the cost of a single bootstrapping. The
+   * second ciphertext is packed as the imaginary part of the first one, the complex ciphertext is
+   * bootstrapped, and the two are separated again using conjugation. Both ciphertexts must have the
+   * same number of slots, and only the keys generated by EvalBootstrapKeyGen() are needed. The
+   * imaginary parts of the input messages are not preserved. Supported in CKKS only.
+   *
+   * @param ciphertext1 the first input ciphertext.
+   * @param ciphertext2 the second input ciphertext.
+   * @param numIterations number of iterations to run iterative bootstrapping (Meta-BTS).
+   * @param precision precision of initial bootstrapping algorithm.
+   * @return the refreshed ciphertexts in the order of the input.
+   */
+    std::pair<Ciphertext<Element>, Ciphertext<Element>> EvalBootstrapPair(ConstCiphertext<Element> ciphertext1,
+                                                                        ConstCiphertext<Element> ciphertext2,
+                                                                        uint32_t numIterations = 1,
+                                                                        uint32_t precision     = 0) const {
+        return GetScheme()->EvalBootstrapPair(ciphertext1, ciphertext2, numIterations, precision);
+    }
+    /**
+   * Writes the bootstrapping precomputations done by EvalBootstrapSetup/EvalBootstrapPrecompute for
+   * all numbers of slots into a binary file. The plaintexts are stored in the evaluation (NTT) form,
+   * so DeserializeEvalBootstrapPrecomputation restores them without any FFT, encoding or NTT.
+   * Supported in CKKS only.
+   *
+   * @param filename output file
+   * @return true on success
+   */
+    bool SerializeEvalBootstrapPrecomputation(const std::string& filename) const {
+        return GetScheme()->SerializeEvalBootstrapPrecomputation(*this, filename);
+    }
+    /**
+   * Reads a file written by SerializeEvalBootstrapPrecomputation and restores the bootstrapping
+   * precomputations from it, so EvalBootstrapSetup and EvalBootstrapPrecompute do not have to be called.
+   * The file must have been written for the same crypto parameters. The precomputations for the same
+   * number of slots are replaced. Supported in CKKS only.
+   *
+   * @param filename input file
+   * @return true on success
+   */
+    bool DeserializeEvalBootstrapPrecomputation(const std::string& filename) {
+        return GetScheme()->DeserializeEvalBootstrapPrecomputation(*this, filename);
+    }
 
     //------------------------------------------------------------------------------
     // Scheme switching Methods
@@ -3364,6 +4147,7 @@ public:
         // TODO (dsuponit): is this correct - PlaintextModulus used as scalingModSize?
         params.SetScalingModSize(GetEncodingParams()->GetPlaintextModulus());
         params.SetBatchSize(GetEncodingParams()->GetBatchSize());
+        params.SetScalingTechniqueCKKS(cryptoParams->GetScalingTechnique());
 
         params.SetParamsFromCKKSCryptocontextCalled();
     }
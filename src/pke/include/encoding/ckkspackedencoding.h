@@ -175,6 +175,17 @@ public:
                                                   const std::vector<DCRTPoly::Integer>& b,
                                                   const std::vector<DCRTPoly::Integer>& mods);
 
+    /**
+   * Static utility method to convert a non-negative real number to CRT representation after
+   * rounding it to the nearest integer. Unlike a direct conversion to a 64-bit integer, it also
+   * supports values of 2^63 and above, e.g., scaling factors made of several RNS moduli.
+   *
+   * @param value is the number to convert.
+   * @param mods are the moduli of the CRT representation.
+   * @return the rounded value in CRT representation.
+   */
+    static std::vector<DCRTPoly::Integer> CRTFromDouble(double value, const std::vector<DCRTPoly::Integer>& mods);
+
     /**
    * GetEncodingType
    * @return CKKS_PACKED_ENCODING
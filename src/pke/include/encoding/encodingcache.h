@@ -0,0 +1,178 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+#ifndef LBCRYPTO_CRYPTO_ENCODING_ENCODINGCACHE_H
+#define LBCRYPTO_CRYPTO_ENCODING_ENCODINGCACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <map>
+#include <mutex>
+#include <utility>
+
+/**
+ * @namespace lbcrypto
+ * The namespace of lbcrypto
+ */
+namespace lbcrypto {
+
+/**
+ * @brief Counters of an EncodingCache
+ */
+struct EncodingCacheStats {
+    uint64_t hits{0};
+    uint64_t misses{0};
+    size_t size{0};
+    size_t capacity{0};
+};
+
+/**
+ * @brief Thread-safe bounded cache of encoded values with least-recently-used eviction.
+ *
+ * A cache with capacity 0 is disabled: GetOrCompute() always computes the value without taking the lock
+ * and does not count hits or misses. The values are computed outside of the lock, so two threads missing
+ * on the same key may both compute it; the value inserted last wins. The values are shared by all callers,
+ * so Value should be immutable (e.g. a pointer to const) or copied by the caller before it is modified.
+ *
+ * @tparam Key ordered key type
+ * @tparam Value the cached value
+ */
+template <typename Key, typename Value>
+class EncodingCache {
+public:
+    explicit EncodingCache(size_t capacity = 0) : m_capacity(capacity) {}
+
+    EncodingCache(const EncodingCache&)            = delete;
+    EncodingCache& operator=(const EncodingCache&) = delete;
+
+    /**
+   * Sets the maximum number of cached values; the least recently used ones are evicted to fit it
+   * @param capacity the new capacity; 0 disables the cache and removes all values
+   */
+    void SetCapacity(size_t capacity) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_capacity.store(capacity, std::memory_order_relaxed);
+        EvictToCapacity();
+    }
+
+    size_t GetCapacity() const {
+        return m_capacity.load(std::memory_order_relaxed);
+    }
+
+    /**
+   * Returns the cached value for key or computes, caches and returns it
+   * @param key the key of the value
+   * @param compute callable without arguments returning the value for key
+   * @return the value for key
+   */
+    template <typename Func>
+    Value GetOrCompute(const Key& key, Func&& compute) {
+        // a disabled cache does not lock
+        if (GetCapacity() == 0)
+            return compute();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            auto it = m_index.find(key);
+            if (it != m_index.end()) {
+                ++m_hits;
+                // move the entry to the front of the recency list
+                m_items.splice(m_items.begin(), m_items, it->second);
+                return it->second->second;
+            }
+            ++m_misses;
+        }
+
+        Value value = compute();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (GetCapacity() == 0)
+            return value;
+        auto it = m_index.find(key);
+        if (it != m_index.end()) {
+            it->second->second = value;
+            m_items.splice(m_items.begin(), m_items, it->second);
+        }
+        else {
+            m_items.emplace_front(key, value);
+            m_index.emplace(key, m_items.begin());
+            EvictToCapacity();
+        }
+        return value;
+    }
+
+    /**
+   * Removes all values and resets the counters
+   */
+    void Clear() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_items.clear();
+        m_index.clear();
+        m_hits   = 0;
+        m_misses = 0;
+    }
+
+    EncodingCacheStats GetStats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        EncodingCacheStats stats;
+        stats.hits     = m_hits;
+        stats.misses   = m_misses;
+        stats.size     = m_items.size();
+        stats.capacity = GetCapacity();
+        return stats;
+    }
+
+private:
+    using ItemList = std::list<std::pair<Key, Value>>;
+
+    // must be called with m_mutex held
+    void EvictToCapacity() {
+        while (m_items.size() > GetCapacity()) {
+            m_index.erase(m_items.back().first);
+            m_items.pop_back();
+        }
+    }
+
+    mutable std::mutex m_mutex;
+    // read without the lock by GetOrCompute(); written with the lock held
+    std::atomic<size_t> m_capacity;
+    // the most recently used entry is at the front
+    ItemList m_items;
+    std::map<Key, typename ItemList::iterator> m_index;
+    uint64_t m_hits{0};
+    uint64_t m_misses{0};
+};
+
+}  // namespace lbcrypto
+
+#endif
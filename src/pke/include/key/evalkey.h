@@ -95,6 +95,17 @@ public:
         OPENFHE_THROW("GetAVector operation not supported");
     }
 
+    /**
+   * Getter function to access a copy of Relinearization Element Vector A.
+   * Unlike GetAVector(), it does not make a key kept in another layout store the vector as well.
+   *
+   * @return a copy of Element vector A.
+   */
+
+    virtual std::vector<Element> CopyAVector() const {
+        return GetAVector();
+    }
+
     /**
    * Setter function to store Relinearization Element Vector B.
    * Throws exception, to be overridden by derived class.
@@ -128,6 +139,17 @@ public:
         OPENFHE_THROW("GetBVector operation not supported");
     }
 
+    /**
+   * Getter function to access a copy of Relinearization Element Vector B.
+   * Unlike GetBVector(), it does not make a key kept in another layout store the vector as well.
+   *
+   * @return a copy of Element vector B.
+   */
+
+    virtual std::vector<Element> CopyBVector() const {
+        return GetBVector();
+    }
+
     /**
    * Setter function to store key switch Element.
    * Throws exception, to be overridden by derived class.
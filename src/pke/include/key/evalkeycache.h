@@ -0,0 +1,284 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+#ifndef LBCRYPTO_CRYPTO_KEY_EVALKEYCACHE_H
+#define LBCRYPTO_CRYPTO_KEY_EVALKEYCACHE_H
+
+#include <array>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+/**
+ * @namespace lbcrypto
+ * The namespace of lbcrypto
+ */
+namespace lbcrypto {
+
+/**
+ * @brief Thread-safe cache of evaluation keys indexed by the secret key tag.
+ *
+ * The tags are spread over a fixed number of shards. Each shard publishes an immutable map through a
+ * shared_ptr that is read with std::atomic_load and replaced with std::atomic_store. A lookup loads the
+ * current map and searches it without taking the shard mutex, so readers never wait for writers; the
+ * standard library may still guard the pointer copy itself with a short internal spinlock. The values
+ * are kept as shared_ptr<const T>, so a reader keeps a consistent value even if it is replaced or removed
+ * afterwards. Writers of a shard are serialized by the shard mutex: they copy the map (the pointers only,
+ * not the keys), change the copy and publish it. Writers to different shards do not block each other.
+ * Operations on a single tag are atomic, Clear() and EraseIf() are atomic per shard.
+ *
+ * @tparam T the value stored per key tag
+ */
+template <typename T>
+class EvalKeyCache {
+public:
+    using ValuePtr = std::shared_ptr<const T>;
+    using MapType  = std::map<std::string, ValuePtr>;
+
+    static constexpr size_t NUM_SHARDS = 16;
+
+    EvalKeyCache()                               = default;
+    EvalKeyCache(const EvalKeyCache&)            = delete;
+    EvalKeyCache& operator=(const EvalKeyCache&) = delete;
+
+    /**
+   * @param keyTag secret key tag
+   * @return the value for keyTag or nullptr if keyTag is not found
+   */
+    ValuePtr Find(const std::string& keyTag) const {
+        const auto map = GetShard(keyTag).Load();
+        auto it        = map->find(keyTag);
+        return (it == map->end()) ? nullptr : it->second;
+    }
+
+    bool Contains(const std::string& keyTag) const {
+        const auto map = GetShard(keyTag).Load();
+        return map->find(keyTag) != map->end();
+    }
+
+    /**
+   * Adds the value for keyTag, replacing the existing one if there
+   */
+    void Insert(const std::string& keyTag, T value) {
+        auto ptr    = std::make_shared<const T>(std::move(value));
+        auto& shard = GetShard(keyTag);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto map       = std::make_shared<MapType>(*shard.Load());
+        (*map)[keyTag] = std::move(ptr);
+        shard.Store(std::move(map));
+    }
+
+    /**
+   * Adds the value for keyTag only if there is no value for it yet
+   * @return true if the value was added
+   */
+    bool InsertIfAbsent(const std::string& keyTag, T value) {
+        auto& shard = GetShard(keyTag);
+        if (shard.Load()->count(keyTag) != 0)
+            return false;
+
+        auto ptr = std::make_shared<const T>(std::move(value));
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto current = shard.Load();
+        if (current->count(keyTag) != 0)
+            return false;
+        auto map = std::make_shared<MapType>(*current);
+        map->emplace(keyTag, std::move(ptr));
+        shard.Store(std::move(map));
+        return true;
+    }
+
+    /**
+   * Atomically replaces the value for keyTag with func(current), where current is nullptr if
+   * there is no value for keyTag yet. Concurrent writers of the same shard wait for func, so func
+   * should not be expensive unless the update really has to be atomic; lookups do not wait.
+   *
+   * @param func callable taking const T* and returning the new T
+   */
+    template <typename Func>
+    void Update(const std::string& keyTag, Func&& func) {
+        auto& shard = GetShard(keyTag);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto map       = std::make_shared<MapType>(*shard.Load());
+        auto it        = map->find(keyTag);
+        auto value     = std::make_shared<const T>(func((it == map->end()) ? nullptr : it->second.get()));
+        (*map)[keyTag] = std::move(value);
+        shard.Store(std::move(map));
+    }
+
+    /**
+   * Atomically replaces the value for keyTag with func(current) if there is a value for keyTag
+   *
+   * @param func callable taking const T& and returning the new T
+   * @return true if there was a value for keyTag
+   */
+    template <typename Func>
+    bool Modify(const std::string& keyTag, Func&& func) {
+        auto& shard = GetShard(keyTag);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto current = shard.Load();
+        auto it      = current->find(keyTag);
+        if (it == current->end())
+            return false;
+        auto value     = std::make_shared<const T>(func(*(it->second)));
+        auto map       = std::make_shared<MapType>(*current);
+        (*map)[keyTag] = std::move(value);
+        shard.Store(std::move(map));
+        return true;
+    }
+
+    /**
+   * Atomically replaces the value for keyTag with desired if the value is still expected. This lets an
+   * expensive new value be computed from expected without holding the lock; the caller retries if the
+   * value was changed in the meantime.
+   *
+   * @param expected the value the new one was computed from, as returned by Find()
+   * @return true if the value was replaced; false if it was replaced or removed in the meantime
+   */
+    bool CompareAndSwap(const std::string& keyTag, const ValuePtr& expected, T desired) {
+        auto ptr    = std::make_shared<const T>(std::move(desired));
+        auto& shard = GetShard(keyTag);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto current = shard.Load();
+        auto it      = current->find(keyTag);
+        if (it == current->end() || it->second != expected)
+            return false;
+        auto map       = std::make_shared<MapType>(*current);
+        (*map)[keyTag] = std::move(ptr);
+        shard.Store(std::move(map));
+        return true;
+    }
+
+    /**
+   * Removes the value for keyTag
+   * @return true if there was a value for keyTag
+   */
+    bool Erase(const std::string& keyTag) {
+        auto& shard = GetShard(keyTag);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto current = shard.Load();
+        if (current->count(keyTag) == 0)
+            return false;
+        auto map = std::make_shared<MapType>(*current);
+        map->erase(keyTag);
+        shard.Store(std::move(map));
+        return true;
+    }
+
+    /**
+   * Removes all values for which pred(keyTag, value) returns true
+   */
+    template <typename Pred>
+    void EraseIf(Pred&& pred) {
+        for (auto& shard : m_shards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+
+            auto map      = std::make_shared<MapType>(*shard.Load());
+            bool modified = false;
+            for (auto it = map->begin(); it != map->end();) {
+                if (pred(it->first, *(it->second))) {
+                    it       = map->erase(it);
+                    modified = true;
+                }
+                else {
+                    ++it;
+                }
+            }
+            if (modified)
+                shard.Store(std::move(map));
+        }
+    }
+
+    void Clear() {
+        for (auto& shard : m_shards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.Store(std::make_shared<MapType>());
+        }
+    }
+
+    /**
+   * @return all values; the shards are read one after another, so the result is consistent per shard only
+   */
+    MapType Snapshot() const {
+        MapType result;
+        for (const auto& shard : m_shards) {
+            const auto map = shard.Load();
+            result.insert(map->begin(), map->end());
+        }
+        return result;
+    }
+
+    size_t Size() const {
+        size_t size = 0;
+        for (const auto& shard : m_shards)
+            size += shard.Load()->size();
+        return size;
+    }
+
+private:
+    struct Shard {
+        // serializes the writers only
+        std::mutex mutex;
+        // accessed through std::atomic_load/std::atomic_store only
+        std::shared_ptr<const MapType> map = std::make_shared<const MapType>();
+
+        std::shared_ptr<const MapType> Load() const {
+            return std::atomic_load(&map);
+        }
+
+        void Store(std::shared_ptr<const MapType> newMap) {
+            std::atomic_store(&map, std::move(newMap));
+        }
+    };
+
+    const Shard& GetShard(const std::string& keyTag) const {
+        return m_shards[std::hash<std::string>{}(keyTag) % NUM_SHARDS];
+    }
+
+    Shard& GetShard(const std::string& keyTag) {
+        return m_shards[std::hash<std::string>{}(keyTag) % NUM_SHARDS];
+    }
+
+    std::array<Shard, NUM_SHARDS> m_shards;
+};
+
+}  // namespace lbcrypto
+
+#endif
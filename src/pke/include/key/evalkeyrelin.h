@@ -34,10 +34,14 @@
 
 #include "key/evalkeyrelin-fwd.h"
 #include "key/evalkey.h"
+#include "key/packedevalkey.h"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 // TODO: fix insert issue if SetBVector used before SetAVector
@@ -70,8 +74,11 @@ public:
    *
    *@param &rhs key to copy from
    */
-    explicit EvalKeyRelinImpl(const EvalKeyRelinImpl<Element>& rhs)
-        : EvalKeyImpl<Element>(rhs.GetCryptoContext()), m_rKey(rhs.m_rKey) {}
+    explicit EvalKeyRelinImpl(const EvalKeyRelinImpl<Element>& rhs) : EvalKeyImpl<Element>(rhs.GetCryptoContext()) {
+        std::lock_guard<std::mutex> lock(rhs.m_mutex);
+        m_rKey      = rhs.m_rKey;
+        m_packedKey = rhs.m_packedKey;
+    }
 
     /**
    * Move constructor
@@ -79,10 +86,13 @@ public:
    *@param &rhs key to move from
    */
     explicit EvalKeyRelinImpl(EvalKeyRelinImpl<Element>&& rhs) noexcept
-        : EvalKeyImpl<Element>(rhs.GetCryptoContext()), m_rKey(std::move(rhs.m_rKey)) {}
+        : EvalKeyImpl<Element>(rhs.GetCryptoContext()),
+          m_rKey(std::move(rhs.m_rKey)),
+          m_packedKey(std::move(rhs.m_packedKey)) {}
 
     operator bool() const {
-        return static_cast<bool>(this->context) && m_rKey.size() != 0;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return static_cast<bool>(this->context) && (m_rKey.size() != 0 || m_packedKey != nullptr);
     }
 
     /**
@@ -91,8 +101,13 @@ public:
    * @param &rhs key to copy from
    */
     EvalKeyRelinImpl<Element>& operator=(const EvalKeyRelinImpl<Element>& rhs) {
+        if (this == &rhs)
+            return *this;
+        std::scoped_lock lock(m_mutex, rhs.m_mutex);
         this->context = rhs.context;
-        this->m_rKey  = rhs.m_rKey;
+        m_rKey        = rhs.m_rKey;
+        m_vectorsInUse.store(false, std::memory_order_relaxed);
+        std::atomic_store(&m_packedKey, std::atomic_load(&rhs.m_packedKey));
         return *this;
     }
 
@@ -105,6 +120,8 @@ public:
         this->context = rhs.context;
         rhs.context   = 0;
         m_rKey        = std::move(rhs.m_rKey);
+        m_vectorsInUse.store(false, std::memory_order_relaxed);
+        std::atomic_store(&m_packedKey, std::move(rhs.m_packedKey));
         return *this;
     }
 
@@ -115,6 +132,7 @@ public:
    * @param &a is the Element vector to be copied.
    */
     virtual void SetAVector(const std::vector<Element>& a) {
+        UnpackForUpdate();
         m_rKey.insert(m_rKey.begin() + 0, a);
     }
 
@@ -125,6 +143,7 @@ public:
    * @param &&a is the Element vector to be moved.
    */
     virtual void SetAVector(std::vector<Element>&& a) {
+        UnpackForUpdate();
         m_rKey.insert(m_rKey.begin() + 0, std::move(a));
     }
 
@@ -135,7 +154,17 @@ public:
    * @return Element vector A.
    */
     virtual const std::vector<Element>& GetAVector() const {
-        return m_rKey.at(0);
+        return GetKeyVectors().at(0);
+    }
+
+    /**
+   * Getter function to access a copy of Relinearization Element Vector A.
+   * Overrides base class implementation. A packed key stays packed only.
+   *
+   * @return a copy of Element vector A.
+   */
+    virtual std::vector<Element> CopyAVector() const {
+        return CopyKeyVector(0);
     }
 
     /**
@@ -145,6 +174,7 @@ public:
    * @param &b is the Element vector to be copied.
    */
     virtual void SetBVector(const std::vector<Element>& b) {
+        UnpackForUpdate();
         m_rKey.insert(m_rKey.begin() + 1, b);
     }
 
@@ -155,6 +185,7 @@ public:
    * @param &&b is the Element vector to be moved.
    */
     virtual void SetBVector(std::vector<Element>&& b) {
+        UnpackForUpdate();
         m_rKey.insert(m_rKey.begin() + 1, std::move(b));
     }
 
@@ -165,7 +196,17 @@ public:
    * @return Element vector B.
    */
     virtual const std::vector<Element>& GetBVector() const {
-        return m_rKey.at(1);
+        return GetKeyVectors().at(1);
+    }
+
+    /**
+   * Getter function to access a copy of Relinearization Element Vector B.
+   * Overrides base class implementation. A packed key stays packed only.
+   *
+   * @return a copy of Element vector B.
+   */
+    virtual std::vector<Element> CopyBVector() const {
+        return CopyKeyVector(1);
     }
 
     /**
@@ -233,8 +274,44 @@ public:
     }
 
     virtual void ClearKeys() {
+        std::lock_guard<std::mutex> lock(m_mutex);
         m_rKey.clear();
         m_dcrtKeys.clear();
+        m_vectorsInUse.store(false, std::memory_order_relaxed);
+        std::atomic_store(&m_packedKey, std::shared_ptr<const PackedEvalKey>());
+    }
+
+    /**
+   * Getter for the key in the layout used by hybrid key switching. The first call packs the key; the
+   * per-digit polynomials are released then, unless GetAVector() or GetBVector() has been called before.
+   * Both getters rebuild them from the packed key if they are called later and keep them from then on, so
+   * the key is stored twice; use CopyAVector() and CopyBVector() to read a packed key without this.
+   * Safe for keys shared by threads.
+   *
+   * @return the packed key
+   */
+    std::shared_ptr<const PackedEvalKey> GetPackedKey() const {
+        auto packedKey = std::atomic_load(&m_packedKey);
+        if (packedKey != nullptr)
+            return packedKey;
+
+        if constexpr (std::is_same_v<Element, DCRTPoly>) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_packedKey != nullptr)
+                return m_packedKey;
+            if (m_rKey.size() < 2)
+                OPENFHE_THROW("The key has no components to pack");
+
+            packedKey = std::make_shared<const PackedEvalKey>(m_rKey[1], m_rKey[0]);
+            std::atomic_store(&m_packedKey, packedKey);
+            // the references returned by GetAVector()/GetBVector() must stay valid
+            if (!m_vectorsInUse.load(std::memory_order_relaxed))
+                std::vector<std::vector<Element>>().swap(m_rKey);
+            return packedKey;
+        }
+        else {
+            OPENFHE_THROW("Only DCRTPoly keys can be packed");
+        }
     }
 
     bool key_compare(const EvalKeyImpl<Element>& other) const {
@@ -243,13 +320,15 @@ public:
         if (!CryptoObject<Element>::operator==(other))
             return false;
 
-        if (this->m_rKey.size() != oth.m_rKey.size())
+        const auto rKey    = this->CopyKeyVectors();
+        const auto othRKey = oth.CopyKeyVectors();
+        if (rKey.size() != othRKey.size())
             return false;
-        for (size_t i = 0; i < this->m_rKey.size(); i++) {
-            if (this->m_rKey[i].size() != oth.m_rKey[i].size())
+        for (size_t i = 0; i < rKey.size(); i++) {
+            if (rKey[i].size() != othRKey[i].size())
                 return false;
-            for (size_t j = 0; j < this->m_rKey[i].size(); j++) {
-                if (this->m_rKey[i][j] != oth.m_rKey[i][j])
+            for (size_t j = 0; j < rKey[i].size(); j++) {
+                if (rKey[i][j] != othRKey[i][j])
                     return false;
             }
         }
@@ -259,7 +338,12 @@ public:
     template <class Archive>
     void save(Archive& ar, std::uint32_t const version) const {
         ar(::cereal::base_class<EvalKeyImpl<Element>>(this));
-        ar(::cereal::make_nvp("k", m_rKey));
+        // a packed key is serialized through a temporary copy, so it stays packed
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_rKey.empty() && m_packedKey != nullptr)
+            ar(::cereal::make_nvp("k", UnpackKey()));
+        else
+            ar(::cereal::make_nvp("k", m_rKey));
     }
 
     template <class Archive>
@@ -269,7 +353,10 @@ public:
                           " is from a later version of the library");
         }
         ar(::cereal::base_class<EvalKeyImpl<Element>>(this));
+        std::lock_guard<std::mutex> lock(m_mutex);
         ar(::cereal::make_nvp("k", m_rKey));
+        m_vectorsInUse.store(false, std::memory_order_relaxed);
+        std::atomic_store(&m_packedKey, std::shared_ptr<const PackedEvalKey>());
     }
     std::string SerializedObjectName() const {
         return "EvalKeyRelin";
@@ -279,11 +366,65 @@ public:
     }
 
 private:
-    // private member to store vector of vector of Element.
-    std::vector<std::vector<Element>> m_rKey;
+    // the components of a packed key, rebuilt from m_packedKey
+    std::vector<std::vector<Element>> UnpackKey() const {
+        std::vector<std::vector<Element>> rKey(2);
+        if constexpr (std::is_same_v<Element, DCRTPoly>) {
+            auto packedKey = std::atomic_load(&m_packedKey);
+            if (packedKey != nullptr)
+                packedKey->Unpack(rKey[1], rKey[0]);
+        }
+        return rKey;
+    }
+
+    // a copy of the components that leaves a packed key packed
+    std::vector<std::vector<Element>> CopyKeyVectors() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return (m_rKey.empty() && m_packedKey != nullptr) ? UnpackKey() : m_rKey;
+    }
+
+    // a copy of one component that leaves a packed key packed
+    std::vector<Element> CopyKeyVector(size_t index) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_rKey.empty() && m_packedKey != nullptr)
+            return std::move(UnpackKey().at(index));
+        return m_rKey.at(index);
+    }
+
+    // returns m_rKey, rebuilding it if the key is packed. m_rKey is not released after this call
+    const std::vector<std::vector<Element>>& GetKeyVectors() const {
+        if (m_vectorsInUse.load(std::memory_order_acquire))
+            return m_rKey;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_rKey.empty() && m_packedKey != nullptr)
+            m_rKey = UnpackKey();
+        m_vectorsInUse.store(true, std::memory_order_release);
+        return m_rKey;
+    }
+
+    // the setters change m_rKey, so a packed key is turned back into m_rKey
+    void UnpackForUpdate() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_rKey.empty() && m_packedKey != nullptr)
+            m_rKey = UnpackKey();
+        std::atomic_store(&m_packedKey, std::shared_ptr<const PackedEvalKey>());
+    }
+
+    // private member to store vector of vector of Element: the a and b components of the key.
+    // empty if the key is packed and nobody has requested the components since
+    mutable std::vector<std::vector<Element>> m_rKey;
 
     // Used for hybrid key switching
     std::vector<DCRTPoly> m_dcrtKeys;
+
+    // the key in the layout of the key-switching inner product; made on first use and not serialized.
+    // accessed through std::atomic_load/std::atomic_store only
+    mutable std::shared_ptr<const PackedEvalKey> m_packedKey;
+    // true once references to m_rKey may have been handed out, so m_rKey must be kept
+    mutable std::atomic<bool> m_vectorsInUse{false};
+    // guards m_rKey while the key is packed or unpacked
+    mutable std::mutex m_mutex;
 };
 
 }  // namespace lbcrypto
@@ -0,0 +1,171 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+#ifndef LBCRYPTO_CRYPTO_KEY_EVALKEYSTORE_H
+#define LBCRYPTO_CRYPTO_KEY_EVALKEYSTORE_H
+
+#include "cryptocontext-fwd.h"
+#include "key/evalkey.h"
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @namespace lbcrypto
+ * The namespace of lbcrypto
+ */
+namespace lbcrypto {
+
+/**
+ * @brief File-backed store of automorphism keys for a single key tag.
+ *
+ * The keys are written by Write() into an indexed binary file: a small header with the key tag,
+ * the serialized crypto context and a table of (automorphism index, offset, size), followed by
+ * every key serialized on its own. The store memory-maps the file and deserializes a key only when
+ * it is requested by Load(). Deserialized keys stay resident in the store; if maxResidentKeys is
+ * not 0, the least recently used keys are released once their number exceeds maxResidentKeys.
+ * Load() may be called concurrently.
+ *
+ * @tparam Element a ring element.
+ */
+template <typename Element>
+class EvalKeyStore {
+public:
+    /**
+   * Opens and memory-maps a file created by Write()
+   *
+   * @param filename the indexed key file
+   * @param maxResidentKeys the maximum number of deserialized keys to keep; 0 means no limit
+   */
+    explicit EvalKeyStore(const std::string& filename, uint32_t maxResidentKeys = 0);
+
+    ~EvalKeyStore();
+
+    EvalKeyStore(const EvalKeyStore&)            = delete;
+    EvalKeyStore& operator=(const EvalKeyStore&) = delete;
+
+    /**
+   * Writes automorphism keys into an indexed file that can be opened by EvalKeyStore
+   *
+   * @param filename output file
+   * @param keyTag the key tag the keys belong to
+   * @param keyMap the automorphism keys to write
+   * @return true on success
+   */
+    static bool Write(const std::string& filename, const std::string& keyTag,
+                      const std::map<uint32_t, EvalKey<Element>>& keyMap);
+
+    /**
+   * Deserializes the keys for the given automorphism indices if they are not resident yet.
+   * Indices that are not in the file are ignored. The keys requested by a single call are never
+   * evicted by the same call, even if their number exceeds maxResidentKeys.
+   *
+   * @param indexList automorphism indices
+   * @return the requested keys
+   */
+    std::map<uint32_t, EvalKey<Element>> Load(const std::vector<uint32_t>& indexList);
+
+    /**
+   * Deserializes all keys in the file
+   *
+   * @return all keys
+   */
+    std::map<uint32_t, EvalKey<Element>> LoadAll();
+
+    const std::string& GetKeyTag() const {
+        return m_keyTag;
+    }
+
+    const std::string& GetFileName() const {
+        return m_filename;
+    }
+
+    CryptoContext<Element> GetCryptoContext() const {
+        return m_cc;
+    }
+
+    /**
+   * @return all automorphism indices available in the file
+   */
+    std::vector<uint32_t> GetIndices() const;
+
+    bool Contains(uint32_t index) const {
+        return m_index.find(index) != m_index.end();
+    }
+
+    /**
+   * @return the number of currently deserialized keys
+   */
+    size_t GetResidentCount();
+
+    uint32_t GetMaxResidentKeys() const {
+        return m_maxResidentKeys;
+    }
+
+    void SetMaxResidentKeys(uint32_t maxResidentKeys);
+
+private:
+    struct KeyLocation {
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    EvalKey<Element> Materialize(const KeyLocation& location) const;
+
+    // removes the least recently used keys until at most "keep" of them are resident
+    void Evict(size_t keep);
+
+    std::string m_filename;
+    std::string m_keyTag;
+    CryptoContext<Element> m_cc{nullptr};
+
+    const char* m_data{nullptr};
+    uint64_t m_size{0};
+
+    std::map<uint32_t, KeyLocation> m_index;
+    std::unordered_map<uint32_t, EvalKey<Element>> m_resident;
+
+    uint32_t m_maxResidentKeys{0};
+    // most recently used indices are at the front
+    std::list<uint32_t> m_lru;
+    std::unordered_map<uint32_t, std::list<uint32_t>::iterator> m_lruPos;
+    std::mutex m_mutex;
+};
+
+}  // namespace lbcrypto
+
+#endif
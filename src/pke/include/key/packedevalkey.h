@@ -0,0 +1,133 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+#ifndef LBCRYPTO_CRYPTO_KEY_PACKEDEVALKEY_H
+#define LBCRYPTO_CRYPTO_KEY_PACKEDEVALKEY_H
+
+#include "lattice/lat-hal.h"
+
+#include <memory>
+#include <new>
+#include <vector>
+
+/**
+ * @namespace lbcrypto
+ * The namespace of lbcrypto
+ */
+namespace lbcrypto {
+
+/**
+ * @brief Key-switching key repacked for the inner product of hybrid key switching.
+ *
+ * An evaluation key stores one DCRTPoly per digit for each of its two components, and every tower of
+ * these polynomials is a separate heap allocation. The inner product of key switching walks the
+ * towers in the outer loop and the digits in the inner loop, so it touches 2 * numDigits unrelated
+ * allocations per tower. PackedEvalKey stores the key in a single cache-line aligned buffer in the
+ * order (tower, digit, component, coefficient): all data needed for one tower of the result are
+ * adjacent in memory and are read strictly sequentially. Once a key is packed, EvalKeyRelinImpl
+ * keeps only this buffer and rebuilds the per-digit polynomials from it when they are requested.
+ *
+ * The object is immutable after construction and can be shared by threads.
+ */
+class PackedEvalKey {
+public:
+    static constexpr size_t ALIGNMENT = 64;
+
+    /**
+   * Packs the key components b and a (see EvalKeyImpl::GetBVector() and GetAVector())
+   *
+   * @param bv the b component of the key: one polynomial in evaluation format per digit
+   * @param av the a component of the key: one polynomial in evaluation format per digit
+   */
+    PackedEvalKey(const std::vector<DCRTPoly>& bv, const std::vector<DCRTPoly>& av);
+
+    PackedEvalKey(const PackedEvalKey&)            = delete;
+    PackedEvalKey& operator=(const PackedEvalKey&) = delete;
+
+    uint32_t GetNumTowers() const {
+        return m_numTowers;
+    }
+
+    uint32_t GetNumDigits() const {
+        return m_numDigits;
+    }
+
+    uint32_t GetRingDimension() const {
+        return m_ringDim;
+    }
+
+    /**
+   * @return the ring dimension coefficients of component b of the key for the given tower and
+   * digit, immediately followed by the coefficients of component a
+   */
+    const NativeInteger* GetBlock(uint32_t tower, uint32_t digit) const {
+        return m_data.get() + (static_cast<size_t>(tower) * m_numDigits + digit) * 2 * m_ringDim;
+    }
+
+    const NativeInteger& GetModulus(uint32_t tower) const {
+        return m_moduli[tower];
+    }
+
+    /**
+   * @return Barrett constant of the modulus of the given tower (see NativeInteger::ComputeMu())
+   */
+    const NativeInteger& GetModulusMu(uint32_t tower) const {
+        return m_mu[tower];
+    }
+
+    /**
+   * Rebuilds the key components the key was packed from
+   *
+   * @param bv receives the b component of the key: one polynomial in evaluation format per digit
+   * @param av receives the a component of the key: one polynomial in evaluation format per digit
+   */
+    void Unpack(std::vector<DCRTPoly>& bv, std::vector<DCRTPoly>& av) const;
+
+private:
+    struct AlignedDelete {
+        void operator()(NativeInteger* ptr) const {
+            ::operator delete(ptr, std::align_val_t(ALIGNMENT));
+        }
+    };
+
+    uint32_t m_numTowers = 0;
+    uint32_t m_numDigits = 0;
+    uint32_t m_ringDim   = 0;
+    std::shared_ptr<DCRTPoly::Params> m_params;
+    std::vector<NativeInteger> m_moduli;
+    std::vector<NativeInteger> m_mu;
+    std::unique_ptr<NativeInteger[], AlignedDelete> m_data;
+};
+
+}  // namespace lbcrypto
+
+#endif
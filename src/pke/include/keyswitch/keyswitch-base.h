@@ -107,6 +107,28 @@ public:
     virtual Element KeySwitchDownFirstElement(ConstCiphertext<Element> ciphertext) const {
         OPENFHE_THROW("KeySwitchDownFirstElement is not supported");
     }
+
+    /**
+   * Key switches the last element of a 3-element ciphertext and rescales the result by the last RNS tower of Q
+   * in the same ModDown (CKKS only)
+   *
+   * @param ciphertext the tensored ciphertext; replaced by the relinearized and rescaled one
+   * @param evalKey the relinearization key
+   */
+    virtual void KeySwitchRescaleInPlace(Ciphertext<Element>& ciphertext, const EvalKey<Element> evalKey) const {
+        OPENFHE_THROW("KeySwitchRescale is not supported");
+    }
+
+    /**
+   * Drops the RNS towers of Q that are not needed to key-switch ciphertexts at the given level or above
+   *
+   * @param evalKey the key to trim
+   * @param level the lowest level of ciphertexts the key will be used for
+   * @return the trimmed key; evalKey itself if it has no towers to drop
+   */
+    virtual EvalKey<Element> TrimEvalKey(const EvalKey<Element> evalKey, uint32_t level) const {
+        OPENFHE_THROW("TrimEvalKey is not supported");
+    }
     /////////////////////////////////////////
     // CORE OPERATIONS
     /////////////////////////////////////////
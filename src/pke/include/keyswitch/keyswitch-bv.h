@@ -76,6 +76,8 @@ public:
 
     void KeySwitchInPlace(Ciphertext<DCRTPoly>& ciphertext, const EvalKey<DCRTPoly> evalKey) const override;
 
+    EvalKey<DCRTPoly> TrimEvalKey(const EvalKey<DCRTPoly> evalKey, uint32_t level) const override;
+
     /////////////////////////////////////////
     // CORE OPERATIONS
     /////////////////////////////////////////
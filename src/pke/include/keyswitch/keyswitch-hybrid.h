@@ -84,12 +84,16 @@ public:
 
     void KeySwitchInPlace(Ciphertext<DCRTPoly>& ciphertext, const EvalKey<DCRTPoly> evalKey) const override;
 
+    EvalKey<DCRTPoly> TrimEvalKey(const EvalKey<DCRTPoly> evalKey, uint32_t level) const override;
+
     Ciphertext<DCRTPoly> KeySwitchExt(ConstCiphertext<DCRTPoly> ciphertext, bool addFirst) const override;
 
     Ciphertext<DCRTPoly> KeySwitchDown(ConstCiphertext<DCRTPoly> ciphertext) const override;
 
     DCRTPoly KeySwitchDownFirstElement(ConstCiphertext<DCRTPoly> ciphertext) const override;
 
+    void KeySwitchRescaleInPlace(Ciphertext<DCRTPoly>& ciphertext, const EvalKey<DCRTPoly> evalKey) const override;
+
     /////////////////////////////////////////
     // CORE OPERATIONS
     /////////////////////////////////////////
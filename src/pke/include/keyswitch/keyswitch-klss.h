@@ -0,0 +1,143 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+/**
+ * KLSS key switching introduced in "Accelerating HE Operations from Key Decomposition Technique"
+ * by Kim, Lee, Seo and Song (https://eprint.iacr.org/2023/413).
+
+* KLSS Keyswitching :
+    Uses the same digits and special primes P as hybrid key switching, but the inner product of the
+    digits with the key is computed in an auxiliary CRT basis R and converted exactly to the parts of QP.
+    The size of the parts of QP is chosen to minimize the cost of key switching.
+    Pros : Fewer NTTs than HYBRID at a large number of digits: for CKKS with depth 15, n = 2^14 and
+           9 digits, EvalRotate is about 30% faster than with HYBRID;
+           the noise and the security are the same as for HYBRID
+    Cons : Evaluation keys about twice as large as for HYBRID (1.8x for the example above);
+           slower than HYBRID for few digits (about 1.6x for 3 digits);
+           no threshold key generation and no trimming of the keys
+*/
+#ifndef LBCRYPTO_CRYPTO_KEYSWITCH_KLSS_H
+#define LBCRYPTO_CRYPTO_KEYSWITCH_KLSS_H
+
+#include "keyswitch/keyswitch-hybrid.h"
+#include "schemebase/rlwe-cryptoparameters.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+
+/**
+ * @namespace lbcrypto
+ * The namespace of lbcrypto
+ */
+namespace lbcrypto {
+
+/**
+ * @brief KLSS key switching: hybrid key switching where the key is decomposed a second time over the
+ * parts {QP}_c of QP (groups of CryptoParametersRNS::GetNumPerPartQP() towers of Q, followed by groups
+ * of as many special primes).
+ *
+ * The evaluation key stores, for every digit j and part c, the hybrid key reduced modulo {QP}_c and
+ * lifted to the auxiliary basis R. Key switching lifts every digit to R, computes sum_j d_j * key_{j,c}
+ * in R, where it is exact, and converts the result exactly to every part {QP}_c. The result in Ql*P is
+ * the same as for HYBRID, so ModDown and the noise are unchanged. The number of NTTs in R grows with
+ * the number of parts instead of the number of digits times the number of towers in Ql*P. Larger parts
+ * need fewer products in R but a larger R; the key has numDigits * numParts * sizeR towers.
+ */
+class KeySwitchKLSS : public KeySwitchHYBRID {
+    using ParmType = typename DCRTPoly::Params;
+
+public:
+    KeySwitchKLSS(){};
+
+    virtual ~KeySwitchKLSS(){};
+
+    EvalKey<DCRTPoly> KeySwitchGenInternal(const PrivateKey<DCRTPoly> oldPrivateKey,
+                                           const PrivateKey<DCRTPoly> newPrivateKey) const override;
+
+    EvalKey<DCRTPoly> KeySwitchGenInternal(const PrivateKey<DCRTPoly> oldPrivateKey,
+                                           const PrivateKey<DCRTPoly> newPrivateKey,
+                                           const EvalKey<DCRTPoly> evalKey) const override;
+
+    EvalKey<DCRTPoly> KeySwitchGenInternal(const PrivateKey<DCRTPoly> oldPrivateKey,
+                                           const PublicKey<DCRTPoly> newPublicKey) const override;
+
+    EvalKey<DCRTPoly> TrimEvalKey(const EvalKey<DCRTPoly> evalKey, uint32_t level) const override;
+
+    /////////////////////////////////////////
+    // CORE OPERATIONS
+    /////////////////////////////////////////
+
+    /**
+   * Decomposes c into digits and lifts every digit to the auxiliary basis R.
+   * The digits are in the basis Ql*R; their towers of Ql only hold the towers of c of the digit itself.
+   */
+    std::shared_ptr<std::vector<DCRTPoly>> EvalKeySwitchPrecomputeCore(
+        const DCRTPoly& c, std::shared_ptr<CryptoParametersBase<DCRTPoly>> cryptoParamsBase) const override;
+
+    std::shared_ptr<std::vector<DCRTPoly>> EvalFastKeySwitchCore(
+        const std::shared_ptr<std::vector<DCRTPoly>> digits, const EvalKey<DCRTPoly> evalKey,
+        const std::shared_ptr<ParmType> paramsQl) const override;
+
+    /**
+   * Computes the inner product of the digits with the key in R and converts it to Ql*P
+   */
+    std::shared_ptr<std::vector<DCRTPoly>> EvalFastKeySwitchCoreExt(
+        const std::shared_ptr<std::vector<DCRTPoly>> digits, const EvalKey<DCRTPoly> evalKey,
+        const std::shared_ptr<ParmType> paramsQl) const override;
+
+    /////////////////////////////////////////
+    // SERIALIZATION
+    /////////////////////////////////////////
+
+    template <class Archive>
+    void save(Archive& ar) const {
+        ar(cereal::base_class<KeySwitchHYBRID>(this));
+    }
+
+    template <class Archive>
+    void load(Archive& ar) {
+        ar(cereal::base_class<KeySwitchHYBRID>(this));
+    }
+
+    std::string SerializedObjectName() const override {
+        return "KeySwitchKLSS";
+    }
+
+    /**
+   * Converts a hybrid key switching key to the KLSS layout. Key switching with the result gives the same
+   * ciphertext in Ql*P as hybrid key switching with evalKey.
+   */
+    EvalKey<DCRTPoly> ConvertHybridKey(const EvalKey<DCRTPoly> evalKey) const;
+};
+
+}  // namespace lbcrypto
+
+#endif
@@ -103,6 +103,17 @@ public:
 
     void EvalMultCoreInPlace(Ciphertext<DCRTPoly>& ciphertext, const NativeInteger& constant) const;
 
+    /**
+   * Tensor product of two ciphertexts in evaluation format: result[k] = sum_{i + j = k} cv1[i] * cv2[j].
+   * EvalMult calls it after the basis extension. The product of two 2-element ciphertexts is computed in
+   * one pass per tower when 128-bit integers are available.
+   *
+   * @param cv1 the elements of the first ciphertext.
+   * @param cv2 the elements of the second ciphertext.
+   * @return cv1.size() + cv2.size() - 1 elements.
+   */
+    static std::vector<DCRTPoly> TensorProduct(const std::vector<DCRTPoly>& cv1, const std::vector<DCRTPoly>& cv2);
+
     /////////////////////////////////////
     // AUTOMORPHISM
     /////////////////////////////////////
@@ -34,6 +34,8 @@
 
 #include "schemerns/rns-advancedshe.h"
 
+#include <map>
+#include <memory>
 #include <vector>
 #include <string>
 
@@ -47,6 +49,19 @@ class AdvancedSHECKKSRNS : public AdvancedSHERNS {
 public:
     virtual ~AdvancedSHECKKSRNS() {}
 
+    //------------------------------------------------------------------------------
+    // EVAL ADD MANY
+    //------------------------------------------------------------------------------
+
+    /**
+   * Adds the ciphertexts of the same level and noise scale degree first and adjusts every such partial sum
+   * only once to the ciphertext with the highest level. A sum of products that still carry their pending
+   * rescale (noise scale degree 2) is then rescaled once per level instead of once per product or partial sum.
+   */
+    Ciphertext<DCRTPoly> EvalAddMany(const std::vector<Ciphertext<DCRTPoly>>& ciphertextVec) const override;
+
+    Ciphertext<DCRTPoly> EvalAddManyInPlace(std::vector<Ciphertext<DCRTPoly>>& ciphertextVec) const override;
+
     //------------------------------------------------------------------------------
     // LINEAR WEIGHTED SUM
     //------------------------------------------------------------------------------
@@ -94,6 +109,50 @@ public:
                                                const std::vector<double>& coefficients, double a,
                                                double b) const override;
 
+    std::shared_ptr<const ChebyshevPowerBasis<DCRTPoly>> EvalChebyshevPowerBasis(ConstCiphertext<DCRTPoly> ciphertext,
+                                                                                 uint32_t degree, double a,
+                                                                                 double b) const override;
+
+    Ciphertext<DCRTPoly> EvalChebyshevSeriesWithBasis(const ChebyshevPowerBasis<DCRTPoly>& basis,
+                                                      const std::vector<double>& coefficients) const override;
+
+    //------------------------------------------------------------------------------
+    // EVAL COMPARISON
+    //------------------------------------------------------------------------------
+
+    /**
+   * Returns the multiplicative depth consumed by EvalSign and EvalCompare for the given gap and precision
+   */
+    static uint32_t GetEvalSignDepth(double gap, uint32_t precision);
+
+    Ciphertext<DCRTPoly> EvalSign(ConstCiphertext<DCRTPoly> ciphertext, double bound, double gap,
+                                  uint32_t precision) const override;
+
+    Ciphertext<DCRTPoly> EvalCompare(ConstCiphertext<DCRTPoly> ciphertext1, ConstCiphertext<DCRTPoly> ciphertext2,
+                                     double bound, double gap, uint32_t precision) const override;
+
+    Ciphertext<DCRTPoly> EvalMax(ConstCiphertext<DCRTPoly> ciphertext1, ConstCiphertext<DCRTPoly> ciphertext2,
+                                 double bound, double gap, uint32_t precision) const override;
+
+    Ciphertext<DCRTPoly> EvalMin(ConstCiphertext<DCRTPoly> ciphertext1, ConstCiphertext<DCRTPoly> ciphertext2,
+                                 double bound, double gap, uint32_t precision) const override;
+
+    std::shared_ptr<std::map<usint, EvalKey<DCRTPoly>>> EvalCompareSlotsKeyGen(const PrivateKey<DCRTPoly> privateKey,
+                                                                               uint32_t numValues) const override;
+
+    Ciphertext<DCRTPoly> EvalMaxSlots(ConstCiphertext<DCRTPoly> ciphertext, uint32_t numValues, double bound,
+                                      double gap, uint32_t precision) const override;
+
+    Ciphertext<DCRTPoly> EvalMinSlots(ConstCiphertext<DCRTPoly> ciphertext, uint32_t numValues, double bound,
+                                      double gap, uint32_t precision) const override;
+
+    /**
+   * Sorts the first numValues slots with a bitonic network; every compare-exchange stage pairs slot i with
+   * slot i ^ j through two rotations and needs a single sign evaluation
+   */
+    Ciphertext<DCRTPoly> EvalSortSlots(ConstCiphertext<DCRTPoly> ciphertext, uint32_t numValues, double bound,
+                                       double gap, uint32_t precision) const override;
+
     //------------------------------------------------------------------------------
     // EVAL LINEAR TRANSFORMATION
     //------------------------------------------------------------------------------
@@ -115,6 +174,14 @@ public:
     std::string SerializedObjectName() const {
         return "AdvancedSHECKKSRNS";
     }
+
+private:
+    ChebyshevPowerBasis<DCRTPoly> ComputeChebyshevPowerBasis(ConstCiphertext<DCRTPoly> x, uint32_t degree, double a,
+                                                             double b) const;
+
+    // the evaluation modifies the baby steps of basis in place
+    Ciphertext<DCRTPoly> EvalChebyshevSeriesPSInternal(const std::vector<double>& coefficients,
+                                                       ChebyshevPowerBasis<DCRTPoly>& basis) const;
 };
 
 }  // namespace lbcrypto
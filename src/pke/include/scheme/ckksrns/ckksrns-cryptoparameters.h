@@ -91,6 +91,16 @@ public:
 
     uint64_t FindAuxPrimeStep() const override;
 
+    /**
+   * Enables the fused key switch and rescale: EvalMult and EvalSquare under FLEXIBLEAUTO and ComposedEvalMult
+   * under FIXEDMANUAL then rescale the product inside its relinearization with a single ModDown by q_l*P.
+   * FLEXIBLEAUTO products are returned rescaled (noise scale degree 1, one level lower) instead of carrying a
+   * pending rescale. The setting is serialized with the crypto parameters and precomputes the tables it needs,
+   * so it should be set before the context is used for evaluation. Requires HYBRID key switching and FLEXIBLEAUTO
+   * or FIXEDMANUAL scaling.
+   */
+    void EnableFusedRescale();
+
     /////////////////////////////////////
     // SERIALIZATION
     /////////////////////////////////////
@@ -121,6 +131,9 @@ public:
     static uint32_t SerializedVersion() {
         return 1;
     }
+
+private:
+    void PrecomputeFusedRescaleTables();
 };
 
 }  // namespace lbcrypto
@@ -51,6 +51,8 @@
  */
 namespace lbcrypto {
 
+class CryptoParametersCKKSRNS;
+
 class CKKSBootstrapPrecom {
 public:
     CKKSBootstrapPrecom() {}
@@ -153,6 +155,24 @@ public:
     Ciphertext<DCRTPoly> EvalBootstrap(ConstCiphertext<DCRTPoly> ciphertext, uint32_t numIterations,
                                        uint32_t precision) const override;
 
+    std::shared_ptr<std::map<usint, EvalKey<DCRTPoly>>> EvalBootstrapBatchKeyGen(const PrivateKey<DCRTPoly> privateKey,
+                                                                                 uint32_t slots,
+                                                                                 uint32_t batchSize) override;
+
+    std::vector<Ciphertext<DCRTPoly>> EvalBootstrapBatch(const std::vector<Ciphertext<DCRTPoly>>& ciphertexts,
+                                                         uint32_t numIterations, uint32_t precision) const override;
+
+    std::pair<Ciphertext<DCRTPoly>, Ciphertext<DCRTPoly>> EvalBootstrapPair(ConstCiphertext<DCRTPoly> ciphertext1,
+                                                                          ConstCiphertext<DCRTPoly> ciphertext2,
+                                                                          uint32_t numIterations,
+                                                                          uint32_t precision) const override;
+
+    bool SerializeEvalBootstrapPrecomputation(const CryptoContextImpl<DCRTPoly>& cc,
+                                              const std::string& filename) const override;
+
+    bool DeserializeEvalBootstrapPrecomputation(const CryptoContextImpl<DCRTPoly>& cc,
+                                                const std::string& filename) override;
+
     //------------------------------------------------------------------------------
     // Find Rotation Indices
     //------------------------------------------------------------------------------
@@ -235,12 +255,32 @@ private:
     //------------------------------------------------------------------------------
     // Auxiliary Bootstrap Functions
     //------------------------------------------------------------------------------
+    /**
+   * EvalBootstrap that also divides the message by 2^logScaleDown. The division is taken out of the
+   * integer factors that scale the message back up at the end of bootstrapping, so it does not
+   * consume a level.
+   */
+    Ciphertext<DCRTPoly> EvalBootstrapInternal(ConstCiphertext<DCRTPoly> ciphertext, uint32_t numIterations,
+                                               uint32_t precision, uint32_t logScaleDown) const;
+
     uint32_t GetBootstrapDepthInternal(uint32_t approxModDepth, const std::vector<uint32_t>& levelBudget,
                                        const CryptoContextImpl<DCRTPoly>& cc);
     static uint32_t GetModDepthInternal(SecretKeyDist secretKeyDist);
 
     void AdjustCiphertext(Ciphertext<DCRTPoly>& ciphertext, double correction) const;
 
+    /**
+   * @return the modulus of level 0: q_0, or the product of the moduli of level 0 with composite scaling
+   */
+    static double GetLevelZeroModulus(const CryptoParametersCKKSRNS& cryptoParams);
+
+    /**
+   * Raises the elements of a ciphertext modulo the first numTowers moduli of paramsRaised to all moduli of
+   * paramsRaised by an exact CRT basis extension. Used for the modulus raising when level 0 spans several towers.
+   */
+    static void ExtendCiphertext(std::vector<DCRTPoly>& ctxtDCRT, const std::shared_ptr<DCRTPoly::Params>& paramsRaised,
+                                 uint32_t numTowers);
+
     void ApplyDoubleAngleIterations(Ciphertext<DCRTPoly>& ciphertext, uint32_t numIt) const;
 
     Plaintext MakeAuxPlaintext(const CryptoContextImpl<DCRTPoly>& cc, const std::shared_ptr<ParmType> params,
@@ -253,6 +293,24 @@ private:
 
     Ciphertext<DCRTPoly> EvalAddExt(ConstCiphertext<DCRTPoly> ciphertext1, ConstCiphertext<DCRTPoly> ciphertext2) const;
 
+    /**
+   * Giant-step stage of one level of CoeffsToSlots/SlotsToCoeffs. The giant steps are independent;
+   * if there are at least as many of them as threads, they are split across threads that accumulate
+   * into their own extended ciphertexts. The partial sums are added and brought down to the Q basis
+   * at the end.
+   *
+   * @param fastRotation hoisted baby-step rotations of the input (in the extended basis)
+   * @param A diagonals of the current level
+   * @param rotOut giant-step rotation indices
+   * @param b number of giant steps
+   * @param g number of baby steps
+   * @param numRotations index of the diagonal that is skipped
+   * @return the result of the level in the Q basis
+   */
+    Ciphertext<DCRTPoly> EvalGiantStepsExt(const std::vector<Ciphertext<DCRTPoly>>& fastRotation,
+                                           const std::vector<ConstPlaintext>& A, const std::vector<int32_t>& rotOut,
+                                           int32_t b, int32_t g, int32_t numRotations) const;
+
     EvalKey<DCRTPoly> ConjugateKeyGen(const PrivateKey<DCRTPoly> privateKey) const;
 
     Ciphertext<DCRTPoly> Conjugate(ConstCiphertext<DCRTPoly> ciphertext,
@@ -282,6 +340,7 @@ private:
 
     const uint32_t K_SPARSE  = 28;   // upper bound for the number of overflows in the sparse secret case
     const uint32_t K_UNIFORM = 512;  // upper bound for the number of overflows in the uniform secret case
+    const uint32_t H_ENCAPSULATED = 32;  // Hamming weight of the ephemeral secret for SPARSE_ENCAPSULATED
     static const uint32_t R_UNIFORM =
         6;  // number of double-angle iterations in CKKS bootstrapping. Must be static because it is used in a static function.
     static const uint32_t R_SPARSE =
@@ -289,6 +348,7 @@ private:
     uint32_t m_correctionFactor = 0;  // correction factor, which we scale the message by to improve precision
 
     // key tuple is dim1, levelBudgetEnc, levelBudgetDec
+    // written only by the setup, precomputation and deserialization; bootstrapping only reads it
     std::map<uint32_t, std::shared_ptr<CKKSBootstrapPrecom>> m_bootPrecomMap;
 
     // Chebyshev series coefficients for the SPARSE case
@@ -91,6 +91,42 @@ public:
     // SHE MULTIPLICATION
     /////////////////////////////////////////
 
+    using LeveledSHEBase<DCRTPoly>::EvalMultMutable;
+    using LeveledSHEBase<DCRTPoly>::EvalMultMutableInPlace;
+    using LeveledSHEBase<DCRTPoly>::EvalSquare;
+    using LeveledSHEBase<DCRTPoly>::EvalSquareInPlace;
+    using LeveledSHEBase<DCRTPoly>::EvalSquareMutable;
+
+    /**
+   * Multiplies and relinearizes two ciphertexts. With hybrid key switching under FLEXIBLEAUTO the rescaling of
+   * the product is fused with the ModDown of the key switch, so the result has noise scale degree 1 and is one
+   * level lower instead of being rescaled before the next multiplication.
+   *
+   * @param ciphertext1 the first input ciphertext.
+   * @param ciphertext2 the second input ciphertext.
+   * @param evalKey the relinearization key.
+   * @return the new ciphertext.
+   */
+    Ciphertext<DCRTPoly> EvalMult(ConstCiphertext<DCRTPoly> ciphertext1, ConstCiphertext<DCRTPoly> ciphertext2,
+                                  const EvalKey<DCRTPoly> evalKey) const override;
+
+    void EvalMultInPlace(Ciphertext<DCRTPoly>& ciphertext1, ConstCiphertext<DCRTPoly> ciphertext2,
+                         const EvalKey<DCRTPoly> evalKey) const override;
+
+    Ciphertext<DCRTPoly> EvalMultMutable(Ciphertext<DCRTPoly>& ciphertext1, Ciphertext<DCRTPoly>& ciphertext2,
+                                         const EvalKey<DCRTPoly> evalKey) const override;
+
+    void EvalMultMutableInPlace(Ciphertext<DCRTPoly>& ciphertext1, Ciphertext<DCRTPoly>& ciphertext2,
+                                const EvalKey<DCRTPoly> evalKey) const override;
+
+    Ciphertext<DCRTPoly> EvalSquare(ConstCiphertext<DCRTPoly> ciphertext,
+                                    const EvalKey<DCRTPoly> evalKey) const override;
+
+    void EvalSquareInPlace(Ciphertext<DCRTPoly>& ciphertext, const EvalKey<DCRTPoly> evalKey) const override;
+
+    Ciphertext<DCRTPoly> EvalSquareMutable(Ciphertext<DCRTPoly>& ciphertext,
+                                           const EvalKey<DCRTPoly> evalKey) const override;
+
     /////////////////////////////////////////
     // SHE MULTIPLICATION PLAINTEXT
     /////////////////////////////////////////
@@ -114,10 +150,6 @@ public:
     // AUTOMORPHISM
     /////////////////////////////////////
 
-    Ciphertext<DCRTPoly> EvalFastRotationExt(ConstCiphertext<DCRTPoly> ciphertext, usint index,
-                                             const std::shared_ptr<std::vector<DCRTPoly>> digits, bool addFirst,
-                                             const std::map<usint, EvalKey<DCRTPoly>>& evalKeys) const override;
-
     usint FindAutomorphismIndex(usint index, usint m) const override;
 
     /////////////////////////////////////
@@ -133,6 +165,18 @@ public:
    */
     void ModReduceInternalInPlace(Ciphertext<DCRTPoly>& ciphertext, size_t levels) const override;
 
+    /**
+   * Method for multiplication, relinearization and rescaling. Under FIXEDMANUAL the rescaling is fused with the
+   * ModDown of the key switch if the fused rescale is enabled (see CryptoParametersCKKSRNS::EnableFusedRescale).
+   *
+   * @param ciphertext1 the first input ciphertext.
+   * @param ciphertext2 the second input ciphertext.
+   * @param evalKey the relinearization key.
+   * @return the new ciphertext.
+   */
+    Ciphertext<DCRTPoly> ComposedEvalMult(ConstCiphertext<DCRTPoly> ciphertext1, ConstCiphertext<DCRTPoly> ciphertext2,
+                                          const EvalKey<DCRTPoly> evalKey) const override;
+
     /////////////////////////////////////
     // Level Reduce
     /////////////////////////////////////
@@ -157,6 +201,25 @@ public:
 
     void EvalMultCoreInPlace(Ciphertext<DCRTPoly>& ciphertext, double operand) const;
 
+    /**
+   * Relinearizes a tensored ciphertext; under FLEXIBLEAUTO the product is also rescaled if the fused rescale is
+   * enabled (see KeySwitchRescaleInPlace).
+   *
+   * @param ciphertext the 3-element ciphertext, relinearized in place.
+   * @param evalKey the relinearization key.
+   */
+    void RelinearizeCoreInPlace(Ciphertext<DCRTPoly>& ciphertext, const EvalKey<DCRTPoly> evalKey) const;
+
+    /**
+   * Relinearizes and rescales a tensored ciphertext with one ModDown by q_l*P if the fused rescale is enabled
+   * and the number of towers allows it.
+   *
+   * @param ciphertext the 3-element ciphertext.
+   * @param evalKey the relinearization key.
+   * @return true if the ciphertext was relinearized and rescaled; false if it was left unchanged.
+   */
+    bool KeySwitchRescaleInPlace(Ciphertext<DCRTPoly>& ciphertext, const EvalKey<DCRTPoly> evalKey) const;
+
     void AdjustLevelsAndDepthInPlace(Ciphertext<DCRTPoly>& ciphertext1,
                                      Ciphertext<DCRTPoly>& ciphertext2) const override;
 
@@ -54,8 +54,10 @@ template <typename ContextGeneratorType, typename Element>
 typename ContextGeneratorType::ContextType genCryptoContextCKKSRNSInternal(
     const CCParams<ContextGeneratorType>& parameters) {
 #if NATIVEINT == 128 && !defined(__EMSCRIPTEN__)
-    if (parameters.GetScalingTechnique() == FLEXIBLEAUTO || parameters.GetScalingTechnique() == FLEXIBLEAUTOEXT) {
-        OPENFHE_THROW("128-bit CKKS is not supported for the FLEXIBLEAUTO or FLEXIBLEAUTOEXT methods.");
+    if (parameters.GetScalingTechnique() == FLEXIBLEAUTO || parameters.GetScalingTechnique() == FLEXIBLEAUTOEXT ||
+        parameters.GetScalingTechnique() == COMPOSITESCALINGAUTO) {
+        OPENFHE_THROW(
+            "128-bit CKKS is not supported for the FLEXIBLEAUTO, FLEXIBLEAUTOEXT or COMPOSITESCALINGAUTO methods.");
     }
 #endif
     using ParmType                   = typename Element::Params;
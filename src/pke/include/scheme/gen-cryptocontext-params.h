@@ -73,11 +73,11 @@ class Params {
     // Max relinearization degree of secret key polynomial (used for lazy relinearization)
     usint maxRelinSkDeg;
 
-    // key switching technique: BV or HYBRID currently
+    // key switching technique: BV, HYBRID or KLSS currently
     // For BV we do not have extra modulus, so the security depends on ciphertext modulus Q.
-    // For HYBRID we do have extra modulus P, so the security depends on modulus P*Q
+    // For HYBRID and KLSS we do have extra modulus P, so the security depends on modulus P*Q
     // For BV we need digitSize - digit size in digit decomposition
-    // For HYBRID we need numLargeDigits - number of digits in digit decomposition
+    // For HYBRID and KLSS we need numLargeDigits - number of digits in digit decomposition
     // it is good to have alternative to numLargeDigits (possibly numPrimesInDigit?)
     KeySwitchTechnique ksTech;
 
@@ -33,6 +33,7 @@
 
 #include "lattice/stdlatticeparms.h"
 #include "binfhe-constants.h"
+#include "constants.h"
 #include "math/math-hal.h"
 
 #include "utils/exception.h"
@@ -78,6 +79,7 @@ class SchSwchParams {
     uint32_t ringDimension{0};
     uint32_t scalingModSize{0};
     uint32_t batchSize{0};
+    ScalingTechnique scalingTechniqueCKKS{FIXEDMANUAL};
 
     void VerifyObjectData() const {
         if (!setParamsFromCKKSCryptocontextCalled) {
@@ -149,6 +151,9 @@ public:
     void SetBatchSize(uint32_t batchSize0) {
         batchSize = batchSize0;
     }
+    void SetScalingTechniqueCKKS(ScalingTechnique scalingTechniqueCKKS0) {
+        scalingTechniqueCKKS = scalingTechniqueCKKS0;
+    }
     //=================================================================================================================
     SecurityLevel GetSecurityLevelCKKS() const {
         VerifyObjectData();
@@ -226,6 +231,10 @@ public:
         VerifyObjectData();
         return batchSize;
     }
+    ScalingTechnique GetScalingTechniqueCKKS() const {
+        VerifyObjectData();
+        return scalingTechniqueCKKS;
+    }
 };
 
 }  // namespace lbcrypto
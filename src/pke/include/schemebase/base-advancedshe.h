@@ -37,9 +37,11 @@
 #include "key/evalkey-fwd.h"
 #include "encoding/plaintext-fwd.h"
 #include "ciphertext-fwd.h"
+#include "cryptocontext-fwd.h"
 #include "utils/inttypes.h"
 #include "utils/exception.h"
 
+#include <array>
 #include <memory>
 #include <vector>
 #include <string>
@@ -51,6 +53,54 @@
  */
 namespace lbcrypto {
 
+/**
+ * @brief Chebyshev power basis of a ciphertext for the Paterson-Stockmeyer evaluation of Chebyshev series.
+ *
+ * Holds the baby steps T_1(y), ..., T_k(y) and the giant steps T_k(y), T_{2k}(y), ..., T_{2^{m-1}k}(y) of
+ * y = -1 + 2 (x-a)/(b-a), where (k, m) are the Paterson-Stockmeyer degrees of the series degree the basis was
+ * computed for. The basis is not modified by the evaluations that use it.
+ * @tparam Element a ring element.
+ */
+template <class Element>
+struct ChebyshevPowerBasis {
+    // degree of the series the basis was computed for
+    uint32_t degree{0};
+    uint32_t k{0};
+    uint32_t m{0};
+    // baby steps: T[i] = T_{i+1}(y)
+    std::vector<Ciphertext<Element>> T;
+    // giant steps: T2[i] = T_{2^i k}(y)
+    std::vector<Ciphertext<Element>> T2;
+    // T_{k(2^m - 1)}(y)
+    Ciphertext<Element> T2km1;
+};
+
+/**
+ * @brief Encoded permutation diagonals for the product of packed d x d matrices.
+ *
+ * A d x d matrix is packed row by row into the first d^2 slots. The product AB is computed as in Jiang, Kim,
+ * Lauter and Song, "Secure Outsourced Matrix Computation and Application to Neural Networks",
+ * https://eprint.iacr.org/2018/1041, as the sum over k of phi^k(sigma(A)) * psi^k(tau(B)). Every permutation
+ * is a sum of masked rotations, and the plaintexts below are the masks of the slots moved by each rotation.
+ * No rotation moves a value across the boundary of the first d^2 slots, so any number of slots >= d^2 works.
+ */
+struct MatMulPrecom {
+    // matrix dimension d
+    uint32_t dim{0};
+    // level of the input ciphertexts
+    uint32_t level{0};
+    // number of slots the masks were encoded with
+    uint32_t slots{0};
+    // sigma[r + d - 1] masks the slots of sigma(A) rotated by r, -d < r < d
+    std::vector<Plaintext> sigma;
+    // tau[r + d - 1] masks the slots of tau(B) rotated by r * d, -d < r < d
+    std::vector<Plaintext> tau;
+    // phi[k] masks the slots of phi^k rotated by k and by k - d; phi[0][1] is not set
+    std::vector<std::array<Plaintext, 2>> phi;
+    // psi[k] masks the slots of psi^k rotated by k * d and by (k - d) * d; psi[0][1] is not set
+    std::vector<std::array<Plaintext, 2>> psi;
+};
+
 /**
  * @brief Abstract base class for derived HE algorithms
  * @tparam Element a ring element.
@@ -199,6 +249,93 @@ public:
         OPENFHE_THROW("EvalChebyshevSeriesPS is not supported for the scheme.");
     }
 
+    /**
+   * Computes the Chebyshev power basis used by the Paterson-Stockmeyer evaluation of Chebyshev series
+   * of the given degree
+   *
+   * @param ciphertext input ciphertext
+   * @param degree degree of the series that will be evaluated with the basis
+   * @param a - lower bound of argument for which the coefficients were found
+   * @param b - upper bound of argument for which the coefficients were found
+   * @return the power basis
+   */
+    virtual std::shared_ptr<const ChebyshevPowerBasis<Element>> EvalChebyshevPowerBasis(
+        ConstCiphertext<Element> ciphertext, uint32_t degree, double a, double b) const {
+        OPENFHE_THROW("EvalChebyshevPowerBasis is not supported for the scheme.");
+    }
+
+    /**
+   * Evaluates a Chebyshev series with a precomputed power basis
+   *
+   * @param basis power basis computed by EvalChebyshevPowerBasis
+   * @param coefficients coefficients of the series; its Paterson-Stockmeyer degrees must match the basis
+   * @return the result of polynomial evaluation.
+   */
+    virtual Ciphertext<Element> EvalChebyshevSeriesWithBasis(const ChebyshevPowerBasis<Element>& basis,
+                                                             const std::vector<double>& coefficients) const {
+        OPENFHE_THROW("EvalChebyshevSeriesWithBasis is not supported for the scheme.");
+    }
+
+    //------------------------------------------------------------------------------
+    // EVAL COMPARISON
+    //------------------------------------------------------------------------------
+
+    /**
+   * Evaluates the sign function as a composition of low-degree odd polynomials
+   *
+   * @param ciphertext input ciphertext; all values must lie in [-bound, bound]
+   * @param bound upper bound on the magnitude of the input values
+   * @param gap smallest |x| / bound for which the sign is approximated to the requested precision
+   * @param precision number of bits of precision of the sign for inputs satisfying the gap
+   * @return the ciphertext of approximate signs
+   */
+    virtual Ciphertext<Element> EvalSign(ConstCiphertext<Element> ciphertext, double bound, double gap,
+                                         uint32_t precision) const {
+        OPENFHE_THROW("EvalSign is not supported for the scheme.");
+    }
+
+    virtual Ciphertext<Element> EvalCompare(ConstCiphertext<Element> ciphertext1, ConstCiphertext<Element> ciphertext2,
+                                            double bound, double gap, uint32_t precision) const {
+        OPENFHE_THROW("EvalCompare is not supported for the scheme.");
+    }
+
+    virtual Ciphertext<Element> EvalMax(ConstCiphertext<Element> ciphertext1, ConstCiphertext<Element> ciphertext2,
+                                        double bound, double gap, uint32_t precision) const {
+        OPENFHE_THROW("EvalMax is not supported for the scheme.");
+    }
+
+    virtual Ciphertext<Element> EvalMin(ConstCiphertext<Element> ciphertext1, ConstCiphertext<Element> ciphertext2,
+                                        double bound, double gap, uint32_t precision) const {
+        OPENFHE_THROW("EvalMin is not supported for the scheme.");
+    }
+
+    /**
+   * Generates the rotation keys for EvalMaxSlots, EvalMinSlots and EvalSortSlots
+   *
+   * @param privateKey private key
+   * @param numValues number of slots to compare
+   * @return the evaluation keys
+   */
+    virtual std::shared_ptr<std::map<usint, EvalKey<Element>>> EvalCompareSlotsKeyGen(
+        const PrivateKey<Element> privateKey, uint32_t numValues) const {
+        OPENFHE_THROW("EvalCompareSlotsKeyGen is not supported for the scheme.");
+    }
+
+    virtual Ciphertext<Element> EvalMaxSlots(ConstCiphertext<Element> ciphertext, uint32_t numValues, double bound,
+                                             double gap, uint32_t precision) const {
+        OPENFHE_THROW("EvalMaxSlots is not supported for the scheme.");
+    }
+
+    virtual Ciphertext<Element> EvalMinSlots(ConstCiphertext<Element> ciphertext, uint32_t numValues, double bound,
+                                             double gap, uint32_t precision) const {
+        OPENFHE_THROW("EvalMinSlots is not supported for the scheme.");
+    }
+
+    virtual Ciphertext<Element> EvalSortSlots(ConstCiphertext<Element> ciphertext, uint32_t numValues, double bound,
+                                              double gap, uint32_t precision) const {
+        OPENFHE_THROW("EvalSortSlots is not supported for the scheme.");
+    }
+
     //------------------------------------------------------------------------------
     // Advanced SHE EVAL SUM
     //------------------------------------------------------------------------------
@@ -251,6 +388,15 @@ public:
     virtual Ciphertext<Element> EvalSum(ConstCiphertext<Element> ciphertext, usint batchSize,
                                         const std::map<usint, EvalKey<Element>>& evalSumKeyMap) const;
 
+    /**
+   * Finds the automorphism indices of the keys used by EvalSum
+   *
+   * @param ciphertext the input ciphertext.
+   * @param batchSize size of the batch to be summed up
+   * @return the automorphism indices
+   */
+    std::vector<uint32_t> FindEvalSumAutomorphismIndices(ConstCiphertext<Element> ciphertext, usint batchSize) const;
+
     /**
    * Sums all elements over row-vectors in a matrix - works only with packed
    * encoding
@@ -343,6 +489,39 @@ public:
     // LINEAR TRANSFORMATION
     //------------------------------------------------------------------------------
 
+    /**
+   * Finds the rotation indices needed by EvalMatMul for d x d matrices
+   *
+   * @param dim matrix dimension d
+   * @return the rotation indices
+   */
+    virtual std::vector<int32_t> FindMatMulRotationIndices(uint32_t dim) const;
+
+    /**
+   * Encodes the permutation diagonals used by EvalMatMul for d x d matrices
+   *
+   * @param cc crypto context
+   * @param dim matrix dimension d
+   * @param level level of the ciphertexts that will be multiplied
+   * @param slots number of slots of the ciphertexts (CKKS only); 0 means the default number of slots
+   * @return the encoded diagonals
+   */
+    virtual std::shared_ptr<const MatMulPrecom> EvalMatMulPrecompute(const CryptoContextImpl<Element>& cc,
+                                                                     uint32_t dim, uint32_t level,
+                                                                     uint32_t slots) const;
+
+    /**
+   * Multiplies two d x d matrices packed row by row. The rotations of every input are hoisted, and the
+   * masked rotations of the permutations are computed in parallel. Consumes three levels.
+   *
+   * @param ciphertextA the left matrix
+   * @param ciphertextB the right matrix
+   * @param precom diagonals computed by EvalMatMulPrecompute for the level of the inputs
+   * @return the encrypted product, packed row by row
+   */
+    virtual Ciphertext<Element> EvalMatMul(ConstCiphertext<Element> ciphertextA, ConstCiphertext<Element> ciphertextB,
+                                           const MatMulPrecom& precom) const;
+
     //------------------------------------------------------------------------------
     // Other Methods for Bootstrap
     //------------------------------------------------------------------------------
@@ -45,6 +45,7 @@
 #include <memory>
 #include <vector>
 #include <map>
+#include <string>
 #include <utility>
 
 /**
@@ -130,6 +131,71 @@ public:
         OPENFHE_THROW("EvalBootstrap is not implemented for this scheme");
     }
 
+    /**
+   * Generates the automorphism keys for EvalBootstrapBatch. Supported in CKKS only.
+   *
+   * @param privateKey private key.
+   * @param slots number of slots of every ciphertext in the batch
+   * @param batchSize maximum number of ciphertexts bootstrapped together
+   * @return map of rotation keys
+   */
+    virtual std::shared_ptr<std::map<usint, EvalKey<Element>>> EvalBootstrapBatchKeyGen(
+        const PrivateKey<Element> privateKey, uint32_t slots, uint32_t batchSize) {
+        OPENFHE_THROW("EvalBootstrapBatchKeyGen is not implemented for this scheme");
+    }
+
+    /**
+   * Bootstraps several sparsely packed ciphertexts with a single bootstrapping
+   *
+   * @param ciphertexts the input ciphertexts; all of them must have the same number of slots.
+   * @param numIterations number of iterations to run iterative bootstrapping (Meta-BTS).
+   * @param precision precision of initial bootstrapping algorithm.
+   * @return the refreshed ciphertexts in the order of the input.
+   */
+    virtual std::vector<Ciphertext<Element>> EvalBootstrapBatch(const std::vector<Ciphertext<Element>>& ciphertexts,
+                                                                uint32_t numIterations, uint32_t precision) const {
+        OPENFHE_THROW("EvalBootstrapBatch is not implemented for this scheme");
+    }
+
+    /**
+   * Bootstraps two ciphertexts with real-valued messages with a single bootstrapping
+   *
+   * @param ciphertext1 the first input ciphertext.
+   * @param ciphertext2 the second input ciphertext.
+   * @param numIterations number of iterations to run iterative bootstrapping (Meta-BTS).
+   * @param precision precision of initial bootstrapping algorithm.
+   * @return the refreshed ciphertexts in the order of the input.
+   */
+    virtual std::pair<Ciphertext<Element>, Ciphertext<Element>> EvalBootstrapPair(ConstCiphertext<Element> ciphertext1,
+                                                                                 ConstCiphertext<Element> ciphertext2,
+                                                                                 uint32_t numIterations,
+                                                                                 uint32_t precision) const {
+        OPENFHE_THROW("EvalBootstrapPair is not implemented for this scheme");
+    }
+
+    /**
+   * Writes the bootstrapping precomputations (parameters and encoded plaintexts for all numbers of slots)
+   * into a binary file
+   *
+   * @param filename output file
+   * @return true on success
+   */
+    virtual bool SerializeEvalBootstrapPrecomputation(const CryptoContextImpl<Element>& cc,
+                                                      const std::string& filename) const {
+        OPENFHE_THROW("SerializeEvalBootstrapPrecomputation is not implemented for this scheme");
+    }
+
+    /**
+   * Loads the bootstrapping precomputations written by SerializeEvalBootstrapPrecomputation
+   *
+   * @param filename input file
+   * @return true on success
+   */
+    virtual bool DeserializeEvalBootstrapPrecomputation(const CryptoContextImpl<Element>& cc,
+                                                        const std::string& filename) {
+        OPENFHE_THROW("DeserializeEvalBootstrapPrecomputation is not implemented for this scheme");
+    }
+
     /**
    * Sets all parameters for switching from CKKS to FHEW
    *
@@ -608,6 +608,43 @@ public:
         OPENFHE_THROW(errMsg);
     }
 
+    /**
+   * Virtual function for multiplying a ciphertext in the extended basis P*Q
+   * by a plaintext encoded in the same extended basis.
+   *
+   * @param ciphertext the input ciphertext in the extended basis
+   * @param plaintext the plaintext encoded in the extended basis
+   * @return resulting ciphertext in the extended basis
+   */
+    virtual Ciphertext<Element> EvalMultExt(ConstCiphertext<Element> ciphertext, ConstPlaintext plaintext) const {
+        std::string errMsg = "EvalMultExt is not implemented for this scheme.";
+        OPENFHE_THROW(errMsg);
+    }
+
+    /**
+   * Virtual function for adding two ciphertexts in the extended basis P*Q in-place.
+   *
+   * @param ciphertext1 the first ciphertext in the extended basis; the result is stored here
+   * @param ciphertext2 the second ciphertext in the extended basis
+   */
+    virtual void EvalAddExtInPlace(Ciphertext<Element>& ciphertext1, ConstCiphertext<Element> ciphertext2) const {
+        std::string errMsg = "EvalAddExtInPlace is not implemented for this scheme.";
+        OPENFHE_THROW(errMsg);
+    }
+
+    /**
+   * Virtual function for adding two ciphertexts in the extended basis P*Q.
+   *
+   * @param ciphertext1 the first ciphertext in the extended basis
+   * @param ciphertext2 the second ciphertext in the extended basis
+   * @return resulting ciphertext in the extended basis
+   */
+    virtual Ciphertext<Element> EvalAddExt(ConstCiphertext<Element> ciphertext1,
+                                           ConstCiphertext<Element> ciphertext2) const {
+        std::string errMsg = "EvalAddExt is not implemented for this scheme.";
+        OPENFHE_THROW(errMsg);
+    }
+
     /**
    * Generates evaluation keys for a list of indices
    * Currently works only for power-of-two and cyclic-group cyclotomics
@@ -356,6 +356,22 @@ public:
         return m_KeySwitch->KeySwitchDown(ciphertext);
     }
 
+    virtual void KeySwitchRescaleInPlace(Ciphertext<Element>& ciphertext, const EvalKey<Element> evalKey) const {
+        VerifyKeySwitchEnabled(__func__);
+        if (!ciphertext)
+            OPENFHE_THROW("Input ciphertext is nullptr");
+        if (!evalKey)
+            OPENFHE_THROW("Input evaluation key is nullptr");
+        m_KeySwitch->KeySwitchRescaleInPlace(ciphertext, evalKey);
+    }
+
+    virtual EvalKey<Element> TrimEvalKey(const EvalKey<Element> evalKey, uint32_t level) const {
+        VerifyKeySwitchEnabled(__func__);
+        if (!evalKey)
+            OPENFHE_THROW("Input evaluation key is nullptr");
+        return m_KeySwitch->TrimEvalKey(evalKey, level);
+    }
+
     virtual std::shared_ptr<std::vector<Element>> EvalKeySwitchPrecomputeCore(
         const Element& c, std::shared_ptr<CryptoParametersBase<Element>> cryptoParamsBase) const {
         VerifyKeySwitchEnabled(__func__);
@@ -929,6 +945,34 @@ public:
         return m_LeveledSHE->EvalFastRotationExt(ciphertext, index, digits, addFirst, evalKeys);
     }
 
+    virtual Ciphertext<Element> EvalMultExt(ConstCiphertext<Element> ciphertext, ConstPlaintext plaintext) const {
+        VerifyLeveledSHEEnabled(__func__);
+        if (!ciphertext)
+            OPENFHE_THROW("Input ciphertext is nullptr");
+        if (!plaintext)
+            OPENFHE_THROW("Input plaintext is nullptr");
+        return m_LeveledSHE->EvalMultExt(ciphertext, plaintext);
+    }
+
+    virtual void EvalAddExtInPlace(Ciphertext<Element>& ciphertext1, ConstCiphertext<Element> ciphertext2) const {
+        VerifyLeveledSHEEnabled(__func__);
+        if (!ciphertext1)
+            OPENFHE_THROW("Input first ciphertext is nullptr");
+        if (!ciphertext2)
+            OPENFHE_THROW("Input second ciphertext is nullptr");
+        m_LeveledSHE->EvalAddExtInPlace(ciphertext1, ciphertext2);
+    }
+
+    virtual Ciphertext<Element> EvalAddExt(ConstCiphertext<Element> ciphertext1,
+                                           ConstCiphertext<Element> ciphertext2) const {
+        VerifyLeveledSHEEnabled(__func__);
+        if (!ciphertext1)
+            OPENFHE_THROW("Input first ciphertext is nullptr");
+        if (!ciphertext2)
+            OPENFHE_THROW("Input second ciphertext is nullptr");
+        return m_LeveledSHE->EvalAddExt(ciphertext1, ciphertext2);
+    }
+
     /**
    * Only supported for hybrid key switching.
    * Scales down the polynomial c0 from extended basis P*Q to Q.
@@ -1180,6 +1224,89 @@ public:
         return m_AdvancedSHE->EvalChebyshevSeriesPS(ciphertext, coefficients, a, b);
     }
 
+    std::shared_ptr<const ChebyshevPowerBasis<Element>> EvalChebyshevPowerBasis(ConstCiphertext<Element> ciphertext,
+                                                                                uint32_t degree, double a,
+                                                                                double b) const {
+        VerifyAdvancedSHEEnabled(__func__);
+        if (!ciphertext)
+            OPENFHE_THROW("Input ciphertext is nullptr");
+        return m_AdvancedSHE->EvalChebyshevPowerBasis(ciphertext, degree, a, b);
+    }
+
+    Ciphertext<Element> EvalChebyshevSeriesWithBasis(const ChebyshevPowerBasis<Element>& basis,
+                                                     const std::vector<double>& coefficients) const {
+        VerifyAdvancedSHEEnabled(__func__);
+        return m_AdvancedSHE->EvalChebyshevSeriesWithBasis(basis, coefficients);
+    }
+
+    /////////////////////////////////////
+    // Advanced SHE EVAL COMPARISON
+    /////////////////////////////////////
+
+    Ciphertext<Element> EvalSign(ConstCiphertext<Element> ciphertext, double bound, double gap,
+                                 uint32_t precision) const {
+        VerifyAdvancedSHEEnabled(__func__);
+        if (!ciphertext)
+            OPENFHE_THROW("Input ciphertext is nullptr");
+        return m_AdvancedSHE->EvalSign(ciphertext, bound, gap, precision);
+    }
+
+    Ciphertext<Element> EvalCompare(ConstCiphertext<Element> ciphertext1, ConstCiphertext<Element> ciphertext2,
+                                    double bound, double gap, uint32_t precision) const {
+        VerifyAdvancedSHEEnabled(__func__);
+        if (!ciphertext1 || !ciphertext2)
+            OPENFHE_THROW("Input ciphertext is nullptr");
+        return m_AdvancedSHE->EvalCompare(ciphertext1, ciphertext2, bound, gap, precision);
+    }
+
+    Ciphertext<Element> EvalMax(ConstCiphertext<Element> ciphertext1, ConstCiphertext<Element> ciphertext2,
+                                double bound, double gap, uint32_t precision) const {
+        VerifyAdvancedSHEEnabled(__func__);
+        if (!ciphertext1 || !ciphertext2)
+            OPENFHE_THROW("Input ciphertext is nullptr");
+        return m_AdvancedSHE->EvalMax(ciphertext1, ciphertext2, bound, gap, precision);
+    }
+
+    Ciphertext<Element> EvalMin(ConstCiphertext<Element> ciphertext1, ConstCiphertext<Element> ciphertext2,
+                                double bound, double gap, uint32_t precision) const {
+        VerifyAdvancedSHEEnabled(__func__);
+        if (!ciphertext1 || !ciphertext2)
+            OPENFHE_THROW("Input ciphertext is nullptr");
+        return m_AdvancedSHE->EvalMin(ciphertext1, ciphertext2, bound, gap, precision);
+    }
+
+    std::shared_ptr<std::map<usint, EvalKey<Element>>> EvalCompareSlotsKeyGen(const PrivateKey<Element> privateKey,
+                                                                              uint32_t numValues) const {
+        VerifyAdvancedSHEEnabled(__func__);
+        if (!privateKey)
+            OPENFHE_THROW("Input private key is nullptr");
+        return m_AdvancedSHE->EvalCompareSlotsKeyGen(privateKey, numValues);
+    }
+
+    Ciphertext<Element> EvalMaxSlots(ConstCiphertext<Element> ciphertext, uint32_t numValues, double bound, double gap,
+                                     uint32_t precision) const {
+        VerifyAdvancedSHEEnabled(__func__);
+        if (!ciphertext)
+            OPENFHE_THROW("Input ciphertext is nullptr");
+        return m_AdvancedSHE->EvalMaxSlots(ciphertext, numValues, bound, gap, precision);
+    }
+
+    Ciphertext<Element> EvalMinSlots(ConstCiphertext<Element> ciphertext, uint32_t numValues, double bound, double gap,
+                                     uint32_t precision) const {
+        VerifyAdvancedSHEEnabled(__func__);
+        if (!ciphertext)
+            OPENFHE_THROW("Input ciphertext is nullptr");
+        return m_AdvancedSHE->EvalMinSlots(ciphertext, numValues, bound, gap, precision);
+    }
+
+    Ciphertext<Element> EvalSortSlots(ConstCiphertext<Element> ciphertext, uint32_t numValues, double bound,
+                                      double gap, uint32_t precision) const {
+        VerifyAdvancedSHEEnabled(__func__);
+        if (!ciphertext)
+            OPENFHE_THROW("Input ciphertext is nullptr");
+        return m_AdvancedSHE->EvalSortSlots(ciphertext, numValues, bound, gap, precision);
+    }
+
     /////////////////////////////////////
     // Advanced SHE EVAL SUM
     /////////////////////////////////////
@@ -1204,6 +1331,13 @@ public:
         return m_AdvancedSHE->EvalSum(ciphertext, batchSize, evalKeyMap);
     }
 
+    std::vector<uint32_t> FindEvalSumAutomorphismIndices(ConstCiphertext<Element> ciphertext, usint batchSize) const {
+        VerifyAdvancedSHEEnabled(__func__);
+        if (!ciphertext)
+            OPENFHE_THROW("Input ciphertext is nullptr");
+        return m_AdvancedSHE->FindEvalSumAutomorphismIndices(ciphertext, batchSize);
+    }
+
     virtual Ciphertext<Element> EvalSumRows(ConstCiphertext<Element> ciphertext, usint rowSize,
                                             const std::map<usint, EvalKey<Element>>& evalKeyMap,
                                             usint subringDim) const {
@@ -1265,6 +1399,23 @@ public:
         return m_AdvancedSHE->EvalMerge(ciphertextVec, evalKeyMap);
     }
 
+    std::vector<int32_t> FindMatMulRotationIndices(uint32_t dim) const {
+        VerifyAdvancedSHEEnabled(__func__);
+        return m_AdvancedSHE->FindMatMulRotationIndices(dim);
+    }
+
+    std::shared_ptr<const MatMulPrecom> EvalMatMulPrecompute(const CryptoContextImpl<Element>& cc, uint32_t dim,
+                                                             uint32_t level, uint32_t slots) const {
+        VerifyAdvancedSHEEnabled(__func__);
+        return m_AdvancedSHE->EvalMatMulPrecompute(cc, dim, level, slots);
+    }
+
+    Ciphertext<Element> EvalMatMul(ConstCiphertext<Element> ciphertextA, ConstCiphertext<Element> ciphertextB,
+                                   const MatMulPrecom& precom) const {
+        VerifyAdvancedSHEEnabled(__func__);
+        return m_AdvancedSHE->EvalMatMul(ciphertextA, ciphertextB, precom);
+    }
+
     /////////////////////////////////////////
     // MULTIPARTY WRAPPER
     /////////////////////////////////////////
@@ -1405,6 +1556,36 @@ public:
         return m_FHE->EvalBootstrap(ciphertext, numIterations, precision);
     }
 
+    std::shared_ptr<std::map<usint, EvalKey<Element>>> EvalBootstrapBatchKeyGen(const PrivateKey<Element> privateKey,
+                                                                                uint32_t slots, uint32_t batchSize) {
+        VerifyFHEEnabled(__func__);
+        return m_FHE->EvalBootstrapBatchKeyGen(privateKey, slots, batchSize);
+    }
+
+    std::vector<Ciphertext<Element>> EvalBootstrapBatch(const std::vector<Ciphertext<Element>>& ciphertexts,
+                                                        uint32_t numIterations = 1, uint32_t precision = 0) const {
+        VerifyFHEEnabled(__func__);
+        return m_FHE->EvalBootstrapBatch(ciphertexts, numIterations, precision);
+    }
+
+    std::pair<Ciphertext<Element>, Ciphertext<Element>> EvalBootstrapPair(ConstCiphertext<Element> ciphertext1,
+                                                                        ConstCiphertext<Element> ciphertext2,
+                                                                        uint32_t numIterations = 1,
+                                                                        uint32_t precision     = 0) const {
+        VerifyFHEEnabled(__func__);
+        return m_FHE->EvalBootstrapPair(ciphertext1, ciphertext2, numIterations, precision);
+    }
+
+    bool SerializeEvalBootstrapPrecomputation(const CryptoContextImpl<Element>& cc, const std::string& filename) const {
+        VerifyFHEEnabled(__func__);
+        return m_FHE->SerializeEvalBootstrapPrecomputation(cc, filename);
+    }
+
+    bool DeserializeEvalBootstrapPrecomputation(const CryptoContextImpl<Element>& cc, const std::string& filename) {
+        VerifyFHEEnabled(__func__);
+        return m_FHE->DeserializeEvalBootstrapPrecomputation(cc, filename);
+    }
+
     // SCHEMESWITCHING methods
 
     LWEPrivateKey EvalCKKStoFHEWSetup(const SchSwchParams& params) {
@@ -37,6 +37,7 @@
 #include "schemebase/base-advancedshe.h"
 
 #include <string>
+#include <vector>
 
 /**
  * @namespace lbcrypto
@@ -52,6 +53,33 @@ class AdvancedSHERNS : public AdvancedSHEBase<DCRTPoly> {
 public:
     virtual ~AdvancedSHERNS() {}
 
+    //------------------------------------------------------------------------------
+    // EVAL POLYNOMIAL
+    //------------------------------------------------------------------------------
+
+    /**
+   * Evaluates a polynomial with integer coefficients mod t (BFV and BGV). Uses EvalPolyLinear for degrees below 5
+   * and EvalPolyPS otherwise.
+   * @param x input ciphertext
+   * @param coefficients integer coefficients, starting with the free term; reduced mod t
+   * @return the result of polynomial evaluation
+   */
+    Ciphertext<DCRTPoly> EvalPoly(ConstCiphertext<DCRTPoly> x, const std::vector<double>& coefficients) const override;
+
+    /**
+   * Computes all powers of x up to the degree with a binary tree and sums the scaled powers
+   */
+    Ciphertext<DCRTPoly> EvalPolyLinear(ConstCiphertext<DCRTPoly> x,
+                                        const std::vector<double>& coefficients) const override;
+
+    /**
+   * Paterson-Stockmeyer evaluation: O(sqrt(d)) ciphertext multiplications and depth ceil(log2(d + 1)) for a
+   * polynomial of degree d. The baby steps and the blocks of each level of the tree are computed in parallel,
+   * and the sums of products are relinearized only when they are multiplied again
+   */
+    Ciphertext<DCRTPoly> EvalPolyPS(ConstCiphertext<DCRTPoly> x,
+                                    const std::vector<double>& coefficients) const override;
+
     /////////////////////////////////////
     // SERIALIZATION
     /////////////////////////////////////
@@ -72,7 +72,8 @@ protected:
           m_scalTechnique(rhs.m_scalTechnique),
           m_encTechnique(rhs.m_encTechnique),
           m_multTechnique(rhs.m_multTechnique),
-          m_MPIntBootCiphertextCompressionLevel(rhs.m_MPIntBootCiphertextCompressionLevel) {}
+          m_MPIntBootCiphertextCompressionLevel(rhs.m_MPIntBootCiphertextCompressionLevel),
+          m_fusedRescale(rhs.m_fusedRescale) {}
 
     /**
    * Constructor that initializes values.  Note that it is possible to set
@@ -168,11 +169,12 @@ public:
         if (el == nullptr)
             return false;
 
-        return CryptoParametersBase<DCRTPoly>::operator==(rhs) && m_scalTechnique == el->GetScalingTechnique() &&
+        return CryptoParametersRLWE<DCRTPoly>::operator==(rhs) && m_scalTechnique == el->GetScalingTechnique() &&
                m_ksTechnique == el->GetKeySwitchTechnique() && m_multTechnique == el->GetMultiplicationTechnique() &&
                m_encTechnique == el->GetEncryptionTechnique() && m_numPartQ == el->GetNumPartQ() &&
                m_auxBits == el->GetAuxBits() && m_extraBits == el->GetExtraBits() && m_PREMode == el->GetPREMode() &&
-               m_multipartyMode == el->GetMultipartyMode() && m_executionMode == el->GetExecutionMode();
+               m_multipartyMode == el->GetMultipartyMode() && m_executionMode == el->GetExecutionMode() &&
+               m_fusedRescale == el->GetFusedRescale();
     }
 
     void PrintParameters(std::ostream& os) const override {
@@ -201,6 +203,16 @@ public:
         return m_scalTechnique;
     }
 
+    /**
+   * Method to retrieve the number of RNS moduli that make up one level. All of them are dropped by one rescaling
+   * and the levels of ciphertexts and plaintexts are multiples of this number.
+   *
+   * @return COMPOSITE_SCALING_DEGREE for COMPOSITESCALINGAUTO and 1 for all other scaling techniques.
+   */
+    uint32_t GetCompositeDegree() const {
+        return (m_scalTechnique == COMPOSITESCALINGAUTO) ? COMPOSITE_SCALING_DEGREE : 1;
+    }
+
     /**
    * Method to retrieve the technique to be used for rescaling.
    *
@@ -228,7 +240,7 @@ public:
     }
 
     const std::shared_ptr<ILDCRTParams<BigInteger>> GetParamsPK() const override {
-        if ((m_ksTechnique == HYBRID) && (m_PREMode != NOT_SET))
+        if ((m_ksTechnique == HYBRID || m_ksTechnique == KLSS) && (m_PREMode != NOT_SET))
             return m_paramsQP;
         if ((m_encTechnique == EXTENDED) && (m_paramsQr != nullptr))
             return m_paramsQr;
@@ -465,6 +477,176 @@ public:
             "of bounds.");
     }
 
+    /////////////////////////////////////
+    // KeySwitchKLSS
+    /////////////////////////////////////
+
+    /**
+   * Gets the auxiliary CRT basis R used in KLSS key switching
+   *
+   * @return the element parameters of R
+   */
+    const std::shared_ptr<ILDCRTParams<BigInteger>> GetParamsAux() const {
+        return m_paramsAux;
+    }
+
+    /**
+   * Gets the parameters of the parts {QP}_c of QP used in KLSS key switching:
+   * the parts of Q followed by the parts of P, with GetNumPerPartQP() towers each
+   *
+   * @return the parameters of all parts
+   */
+    const std::vector<std::shared_ptr<ILDCRTParams<BigInteger>>>& GetParamsPartQP() const {
+        return m_paramsPartQP;
+    }
+
+    /**
+   * Gets the number of towers in every part {QP}_c used in KLSS key switching.
+   * This is the alpha~ parameter of the gadget decomposition of the key.
+   *
+   * @return the number of towers per part
+   */
+    uint32_t GetNumPerPartQP() const {
+        return m_numPerPartQP;
+    }
+
+    /**
+   * Gets the number of parts {QP}_c made of towers of Q; the parts of P follow them
+   *
+   * @return the number of parts of Q
+   */
+    uint32_t GetNumPartQInQP() const {
+        return m_numPartQInQP;
+    }
+
+    /**
+   * Gets the table [(Q_k)^(l)/q_i]_{r_j} for the ModUp of a digit to R
+   *
+   * @param part the digit
+   * @param sublvl the number of towers of the digit minus one
+   * @return the precomputed table
+   */
+    const std::vector<std::vector<NativeInteger>>& GetPartQlHatModAux(uint32_t part, uint32_t sublvl) const {
+        if (part < m_PartQlHatModAux.size() && sublvl < m_PartQlHatModAux[part].size())
+            return m_PartQlHatModAux[part][sublvl];
+
+        OPENFHE_THROW("CryptoParametersRNS::GetPartQlHatModAux - index out of bounds.");
+    }
+
+    /**
+   * Gets the Barrett modulo reduction precomputation for r_j
+   *
+   * @return the precomputed table
+   */
+    const std::vector<DoubleNativeInt>& GetModAuxBarrettMu() const {
+        return m_modAuxBarrettMu;
+    }
+
+    /**
+   * Gets the table [({QP}_c/q_i)^{-1}]_{q_i} for lifting a part of the key to R
+   *
+   * @param part the part {QP}_c
+   * @return the precomputed table
+   */
+    const std::vector<NativeInteger>& GetPartQPHatInvModq(uint32_t part) const {
+        if (part < m_PartQPHatInvModq.size())
+            return m_PartQPHatInvModq[part];
+
+        OPENFHE_THROW("CryptoParametersRNS::GetPartQPHatInvModq - index out of bounds.");
+    }
+
+    /**
+   * Gets the NTL precomputations for [({QP}_c/q_i)^{-1}]_{q_i}
+   *
+   * @param part the part {QP}_c
+   * @return the precomputed table
+   */
+    const std::vector<NativeInteger>& GetPartQPHatInvModqPrecon(uint32_t part) const {
+        if (part < m_PartQPHatInvModqPrecon.size())
+            return m_PartQPHatInvModqPrecon[part];
+
+        OPENFHE_THROW("CryptoParametersRNS::GetPartQPHatInvModqPrecon - index out of bounds.");
+    }
+
+    /**
+   * Gets the table [{QP}_c/q_i]_{r_j} for lifting a part of the key to R
+   *
+   * @param part the part {QP}_c
+   * @return the precomputed table
+   */
+    const std::vector<std::vector<NativeInteger>>& GetPartQPHatModAux(uint32_t part) const {
+        if (part < m_PartQPHatModAux.size())
+            return m_PartQPHatModAux[part];
+
+        OPENFHE_THROW("CryptoParametersRNS::GetPartQPHatModAux - index out of bounds.");
+    }
+
+    /**
+   * Gets the table [(R/r_j)^{-1}]_{r_j}
+   *
+   * @return the precomputed table
+   */
+    const std::vector<NativeInteger>& GetAuxHatInvModAux() const {
+        return m_AuxHatInvModAux;
+    }
+
+    /**
+   * Gets the NTL precomputations for [(R/r_j)^{-1}]_{r_j}
+   *
+   * @return the precomputed table
+   */
+    const std::vector<NativeInteger>& GetAuxHatInvModAuxPrecon() const {
+        return m_AuxHatInvModAuxPrecon;
+    }
+
+    /**
+   * Gets the table [R/r_j]_{q_i} for the exact conversion from R to the part {QP}_c
+   *
+   * @param part the part {QP}_c
+   * @return the precomputed table
+   */
+    const std::vector<std::vector<NativeInteger>>& GetAuxHatModPartQP(uint32_t part) const {
+        if (part < m_AuxHatModPartQP.size())
+            return m_AuxHatModPartQP[part];
+
+        OPENFHE_THROW("CryptoParametersRNS::GetAuxHatModPartQP - index out of bounds.");
+    }
+
+    /**
+   * Gets the table [u * R]_{q_i} for the exact conversion from R to the part {QP}_c
+   *
+   * @param part the part {QP}_c
+   * @return the precomputed table
+   */
+    const std::vector<std::vector<NativeInteger>>& GetalphaAuxModPartQP(uint32_t part) const {
+        if (part < m_alphaAuxModPartQP.size())
+            return m_alphaAuxModPartQP[part];
+
+        OPENFHE_THROW("CryptoParametersRNS::GetalphaAuxModPartQP - index out of bounds.");
+    }
+
+    /**
+   * Gets the Barrett modulo reduction precomputation for the moduli of the part {QP}_c
+   *
+   * @param part the part {QP}_c
+   * @return the precomputed table
+   */
+    const std::vector<DoubleNativeInt>& GetModPartQPBarrettMu(uint32_t part) const {
+        if (part < m_modPartQPBarrettMu.size())
+            return m_modPartQPBarrettMu[part];
+
+        OPENFHE_THROW("CryptoParametersRNS::GetModPartQPBarrettMu - index out of bounds.");
+    }
+
+    /**
+   * Gets the table 1/r_j used to count the overflows in the exact conversion from R
+   *
+   * @return the precomputed table
+   */
+    const std::vector<double>& GetAuxInv() const {
+        return m_auxInv;
+    }
+
     /**
    * Gets the precomputed table of [P^{-1}]_{q_i}
    * Used in GHS key switching
@@ -532,6 +714,93 @@ public:
         return m_modqBarrettMu;
     }
 
+    /////////////////////////////////////
+    // CKKSrns : KeySwitchHybrid fused with Rescale
+    /////////////////////////////////////
+
+    /**
+   * Gets the CRT basis {q_0,...,q_{l-1}} left after the fused key switch and rescale
+   * of a ciphertext with towers {q_0,...,q_l}; i is the number of towers already dropped
+   *
+   * @return the precomputed CRT params
+   */
+    const std::shared_ptr<ILDCRTParams<BigInteger>>& GetParamsQlRescale(size_t i) const {
+        return m_paramsQlRescale[i];
+    }
+
+    /**
+   * Gets the CRT basis {q_l,p_1,...,p_k} divided out by the fused key switch and rescale
+   *
+   * @return the precomputed CRT params
+   */
+    const std::shared_ptr<ILDCRTParams<BigInteger>>& GetParamsqlP(size_t i) const {
+        return m_paramsqlP[i];
+    }
+
+    /**
+   * Gets the precomputed table of [(q_l*P)^{-1}]_{q_i}
+   *
+   * @return the precomputed table
+   */
+    const std::vector<NativeInteger>& GetqlPInvModq(size_t i) const {
+        return m_qlPInvModq[i];
+    }
+
+    /**
+   * Gets the NTL precomputions for [(q_l*P)^{-1}]_{q_i}
+   *
+   * @return the precomputed table
+   */
+    const std::vector<NativeInteger>& GetqlPInvModqPrecon(size_t i) const {
+        return m_qlPInvModqPrecon[i];
+    }
+
+    /**
+   * Gets the precomputed table of [(q_l*P/m_j)^{-1}]_{m_j} for m_j in {q_l,p_1,...,p_k}
+   *
+   * @return the precomputed table
+   */
+    const std::vector<NativeInteger>& GetqlPHatInvModp(size_t i) const {
+        return m_qlPHatInvModp[i];
+    }
+
+    /**
+   * Gets the NTL precomputions for [(q_l*P/m_j)^{-1}]_{m_j}
+   *
+   * @return the precomputed table
+   */
+    const std::vector<NativeInteger>& GetqlPHatInvModpPrecon(size_t i) const {
+        return m_qlPHatInvModpPrecon[i];
+    }
+
+    /**
+   * Gets the precomputed table of [q_l*P/m_j]_{q_i} for m_j in {q_l,p_1,...,p_k}
+   *
+   * @return the precomputed table
+   */
+    const std::vector<std::vector<NativeInteger>>& GetqlPHatModq(size_t i) const {
+        return m_qlPHatModq[i];
+    }
+
+    /**
+   * Checks whether the tables for the fused key switch and rescale were precomputed
+   *
+   * @return true if KeySwitchRescaleInPlace can be used
+   */
+    bool HasKeySwitchRescaleTables() const {
+        return !m_paramsQlRescale.empty();
+    }
+
+    /**
+   * Checks whether CKKS products are rescaled inside their relinearization (see
+   * CryptoParametersCKKSRNS::EnableFusedRescale)
+   *
+   * @return true if the fused key switch and rescale is enabled
+   */
+    bool GetFusedRescale() const {
+        return m_fusedRescale;
+    }
+
     /**
    * Method that returns the precomputed values for [t^(-1)]_{q_i}
    * Used in ModulusSwitching.
@@ -582,7 +851,8 @@ public:
    * @return the scaling factor.
    */
     double GetScalingFactorReal(uint32_t l = 0) const {
-        if (m_scalTechnique == FLEXIBLEAUTO || m_scalTechnique == FLEXIBLEAUTOEXT) {
+        if (m_scalTechnique == FLEXIBLEAUTO || m_scalTechnique == FLEXIBLEAUTOEXT ||
+            m_scalTechnique == COMPOSITESCALINGAUTO) {
             if (l >= m_scalingFactorsReal.size()) {
                 // TODO: Return an error here.
                 return m_approxSF;
@@ -595,7 +865,8 @@ public:
     }
 
     double GetScalingFactorRealBig(uint32_t l = 0) const {
-        if (m_scalTechnique == FLEXIBLEAUTO || m_scalTechnique == FLEXIBLEAUTOEXT) {
+        if (m_scalTechnique == FLEXIBLEAUTO || m_scalTechnique == FLEXIBLEAUTOEXT ||
+            m_scalTechnique == COMPOSITESCALINGAUTO) {
             if (l >= m_scalingFactorsRealBig.size()) {
                 // TODO: Return an error here.
                 return m_approxSF;
@@ -614,7 +885,8 @@ public:
    * @return the precomputed table
    */
     double GetModReduceFactor(uint32_t l = 0) const {
-        if (m_scalTechnique == FLEXIBLEAUTO || m_scalTechnique == FLEXIBLEAUTOEXT) {
+        if (m_scalTechnique == FLEXIBLEAUTO || m_scalTechnique == FLEXIBLEAUTOEXT ||
+            m_scalTechnique == COMPOSITESCALINGAUTO) {
             return m_dmoduliQ[l];
         }
 
@@ -1432,12 +1704,89 @@ protected:
     // Stores NTL precomputations for [t^{-1}]_{p_j}
     std::vector<NativeInteger> m_tInvModpPrecon;
 
+    /////////////////////////////////////
+    // CKKSrns KeySwitchHybrid fused with Rescale
+    /////////////////////////////////////
+
+    // Params for {q_0,...,q_{l-1}}, indexed by the number of dropped towers
+    std::vector<std::shared_ptr<ILDCRTParams<BigInteger>>> m_paramsQlRescale;
+
+    // Params for {q_l,p_1,...,p_k}, indexed by the number of dropped towers
+    std::vector<std::shared_ptr<ILDCRTParams<BigInteger>>> m_paramsqlP;
+
+    // Stores [(q_l*P)^{-1}]_{q_i}
+    std::vector<std::vector<NativeInteger>> m_qlPInvModq;
+
+    // Stores NTL precomputations for [(q_l*P)^{-1}]_{q_i}
+    std::vector<std::vector<NativeInteger>> m_qlPInvModqPrecon;
+
+    // Stores [(q_l*P/m_j)^{-1}]_{m_j}
+    std::vector<std::vector<NativeInteger>> m_qlPHatInvModp;
+
+    // Stores NTL precomputations for [(q_l*P/m_j)^{-1}]_{m_j}
+    std::vector<std::vector<NativeInteger>> m_qlPHatInvModpPrecon;
+
+    // Stores [q_l*P/m_j]_{q_i}
+    std::vector<std::vector<std::vector<NativeInteger>>> m_qlPHatModq;
+
+    // Rescale CKKS products inside the relinearization; off by default
+    bool m_fusedRescale = false;
+
+    /////////////////////////////////////
+    // KeySwitchKLSS
+    /////////////////////////////////////
+
+    // Params for the auxiliary CRT basis {R} = {r_1,...,r_m}
+    std::shared_ptr<ILDCRTParams<BigInteger>> m_paramsAux;
+
+    // Stores the parameters of the parts {QP}_c: the parts of Q followed by the parts of P
+    std::vector<std::shared_ptr<ILDCRTParams<BigInteger>>> m_paramsPartQP;
+
+    // Stores the number of towers per part {QP}_c
+    uint32_t m_numPerPartQP = 0;
+
+    // Stores the number of parts {QP}_c made of towers of Q
+    uint32_t m_numPartQInQP = 0;
+
+    // Stores [(Q_k)^(l)/q_i]_{r_j}
+    std::vector<std::vector<std::vector<std::vector<NativeInteger>>>> m_PartQlHatModAux;
+
+    // Stores the BarrettUint128ModUint64 precomputations for r_j
+    std::vector<DoubleNativeInt> m_modAuxBarrettMu;
+
+    // Stores [({QP}_c/q_i)^{-1}]_{q_i}
+    std::vector<std::vector<NativeInteger>> m_PartQPHatInvModq;
+
+    // Stores NTL precomputations for [({QP}_c/q_i)^{-1}]_{q_i}
+    std::vector<std::vector<NativeInteger>> m_PartQPHatInvModqPrecon;
+
+    // Stores [{QP}_c/q_i]_{r_j}
+    std::vector<std::vector<std::vector<NativeInteger>>> m_PartQPHatModAux;
+
+    // Stores [(R/r_j)^{-1}]_{r_j}
+    std::vector<NativeInteger> m_AuxHatInvModAux;
+
+    // Stores NTL precomputations for [(R/r_j)^{-1}]_{r_j}
+    std::vector<NativeInteger> m_AuxHatInvModAuxPrecon;
+
+    // Stores [R/r_j]_{q_i} for the moduli q_i of every part {QP}_c
+    std::vector<std::vector<std::vector<NativeInteger>>> m_AuxHatModPartQP;
+
+    // Stores [u * R]_{q_i} for the moduli q_i of every part {QP}_c
+    std::vector<std::vector<std::vector<NativeInteger>>> m_alphaAuxModPartQP;
+
+    // Stores the BarrettUint128ModUint64 precomputations for the moduli of every part {QP}_c
+    std::vector<std::vector<DoubleNativeInt>> m_modPartQPBarrettMu;
+
+    // Stores 1/r_j
+    std::vector<double> m_auxInv;
+
     /////////////////////////////////////
     // CKKS Scaling Factor
     /////////////////////////////////////
 
     // A vector holding the doubles that correspond to the exact
-    // scaling factor of each level, when FLEXIBLEAUTO is used.
+    // scaling factor of each level, when FLEXIBLEAUTO or COMPOSITESCALINGAUTO is used.
     std::vector<double> m_scalingFactorsReal;
 
     std::vector<double> m_scalingFactorsRealBig;
@@ -1753,6 +2102,7 @@ public:
         ar(cereal::make_nvp("ab", m_auxBits));
         ar(cereal::make_nvp("eb", m_extraBits));
         ar(cereal::make_nvp("ccl", m_MPIntBootCiphertextCompressionLevel));
+        ar(cereal::make_nvp("frs", m_fusedRescale));
     }
 
     template <class Archive>
@@ -1777,6 +2127,12 @@ public:
         } catch(cereal::Exception&) {
         	m_MPIntBootCiphertextCompressionLevel = COMPRESSION_LEVEL::SLACK;
         }
+        // m_fusedRescale was added after m_MPIntBootCiphertextCompressionLevel; contexts saved without it do not fuse
+        try {
+            ar(cereal::make_nvp("frs", m_fusedRescale));
+        } catch(cereal::Exception&) {
+            m_fusedRescale = false;
+        }
     }
 
     std::string SerializedObjectName() const override {
@@ -261,6 +261,21 @@ public:
     // SHE AUTOMORPHISM
     /////////////////////////////////////////
 
+    Ciphertext<DCRTPoly> EvalFastRotationExt(ConstCiphertext<DCRTPoly> ciphertext, usint index,
+                                             const std::shared_ptr<std::vector<DCRTPoly>> digits, bool addFirst,
+                                             const std::map<usint, EvalKey<DCRTPoly>>& evalKeys) const override;
+
+    /////////////////////////////////////////
+    // SHE EXTENDED BASIS
+    /////////////////////////////////////////
+
+    Ciphertext<DCRTPoly> EvalMultExt(ConstCiphertext<DCRTPoly> ciphertext, ConstPlaintext plaintext) const override;
+
+    void EvalAddExtInPlace(Ciphertext<DCRTPoly>& ciphertext1, ConstCiphertext<DCRTPoly> ciphertext2) const override;
+
+    Ciphertext<DCRTPoly> EvalAddExt(ConstCiphertext<DCRTPoly> ciphertext1,
+                                    ConstCiphertext<DCRTPoly> ciphertext2) const override;
+
     /////////////////////////////////////////
     // SHE LEVELED Mod Reduce
     /////////////////////////////////////////
@@ -45,6 +45,7 @@
 #include "schemerns/rns-multiparty.h"
 
 #include "keyswitch/keyswitch-hybrid.h"
+#include "keyswitch/keyswitch-klss.h"
 #include "keyswitch/keyswitch-bv.h"
 #include "constants.h"
 #include "utils/exception.h"
@@ -75,6 +76,9 @@ public:
         else if (ksTech == HYBRID) {
             m_KeySwitch = std::make_shared<KeySwitchHYBRID>();
         }
+        else if (ksTech == KLSS) {
+            m_KeySwitch = std::make_shared<KeySwitchKLSS>();
+        }
         else
             OPENFHE_THROW("ksTech is invalid");
     }
@@ -81,6 +81,8 @@ ScalingTechnique convertToScalingTechnique(const std::string& str) {
         return FLEXIBLEAUTOEXT;
     else if (str == "NORESCALE")
         return NORESCALE;
+    else if (str == "COMPOSITESCALINGAUTO")
+        return COMPOSITESCALINGAUTO;
 
     std::string errMsg(std::string("Unknown ScalingTechnique ") + str);
     OPENFHE_THROW(errMsg);
@@ -93,6 +95,7 @@ ScalingTechnique convertToScalingTechnique(uint32_t num) {
         case FLEXIBLEAUTO:
         case FLEXIBLEAUTOEXT:
         case NORESCALE:
+        case COMPOSITESCALINGAUTO:
             // case INVALID_RS_TECHNIQUE:
             return scTech;
         default:
@@ -119,6 +122,9 @@ std::ostream& operator<<(std::ostream& s, ScalingTechnique t) {
         case NORESCALE:
             s << "NORESCALE";
             break;
+        case COMPOSITESCALINGAUTO:
+            s << "COMPOSITESCALINGAUTO";
+            break;
         case INVALID_RS_TECHNIQUE:
             s << "INVALID_RS_TECHNIQUE";
             break;
@@ -306,6 +312,8 @@ KeySwitchTechnique convertToKeySwitchTechnique(const std::string& str) {
         return BV;
     else if (str == "HYBRID")
         return HYBRID;
+    else if (str == "KLSS")
+        return KLSS;
 
     std::string errMsg(std::string("Unknown KeySwitchTechnique ") + str);
     OPENFHE_THROW(errMsg);
@@ -316,6 +324,7 @@ KeySwitchTechnique convertToKeySwitchTechnique(uint32_t num) {
         // case INVALID_KS_TECH:
         case BV:
         case HYBRID:
+        case KLSS:
             return ksTech;
         default:
             break;
@@ -332,6 +341,9 @@ std::ostream& operator<<(std::ostream& s, KeySwitchTechnique t) {
         case HYBRID:
             s << "HYBRID";
             break;
+        case KLSS:
+            s << "KLSS";
+            break;
         default:
             s << "UNKNOWN";
             break;
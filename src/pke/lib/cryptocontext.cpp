@@ -39,15 +39,18 @@
 #include "key/publickey.h"
 #include "math/chebyshev.h"
 #include "schemerns/rns-scheme.h"
+#include "scheme/ckksrns/ckksrns-advancedshe.h"
 #include "scheme/ckksrns/ckksrns-cryptoparameters.h"
 
 namespace lbcrypto {
 
 template <typename Element>
-std::map<std::string, std::vector<EvalKey<Element>>> CryptoContextImpl<Element>::s_evalMultKeyMap{};
+EvalKeyCache<std::vector<EvalKey<Element>>> CryptoContextImpl<Element>::s_evalMultKeyMap{};
 template <typename Element>
-std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>>
+EvalKeyCache<typename CryptoContextImpl<Element>::EvalAutomorphismKeyEntry>
     CryptoContextImpl<Element>::s_evalAutomorphismKeyMap{};
+template <typename Element>
+EvalKeyCache<std::vector<EvalKey<Element>>> CryptoContextImpl<Element>::s_evalEncapsulationKeyMap{};
 
 template <typename Element>
 void CryptoContextImpl<Element>::SetKSTechniqueInScheme() {
@@ -71,11 +74,21 @@ template <typename Element>
 void CryptoContextImpl<Element>::EvalMultKeyGen(const PrivateKey<Element> key) {
     ValidateKey(key);
 
-    if (CryptoContextImpl<Element>::s_evalMultKeyMap.find(key->GetKeyTag()) ==
-        CryptoContextImpl<Element>::s_evalMultKeyMap.end()) {
+    if (!CryptoContextImpl<Element>::s_evalMultKeyMap.Contains(key->GetKeyTag())) {
         // the key is not found in the map, so the key has to be generated
-        EvalKey<Element> k                                           = GetScheme()->EvalMultKeyGen(key);
-        CryptoContextImpl<Element>::s_evalMultKeyMap[k->GetKeyTag()] = {k};
+        EvalKey<Element> k = GetScheme()->EvalMultKeyGen(key);
+        CryptoContextImpl<Element>::s_evalMultKeyMap.InsertIfAbsent(k->GetKeyTag(), {k});
+    }
+}
+
+template <typename Element>
+void CryptoContextImpl<Element>::EvalMultKeyGen(const PrivateKey<Element> key, uint32_t level) {
+    ValidateKey(key);
+
+    if (!CryptoContextImpl<Element>::s_evalMultKeyMap.Contains(key->GetKeyTag())) {
+        // the key is not found in the map, so the key has to be generated
+        EvalKey<Element> k = GetScheme()->TrimEvalKey(GetScheme()->EvalMultKeyGen(key), level);
+        CryptoContextImpl<Element>::s_evalMultKeyMap.InsertIfAbsent(k->GetKeyTag(), {k});
     }
 }
 
@@ -83,42 +96,34 @@ template <typename Element>
 void CryptoContextImpl<Element>::EvalMultKeysGen(const PrivateKey<Element> key) {
     ValidateKey(key);
 
-    if (CryptoContextImpl<Element>::s_evalMultKeyMap.find(key->GetKeyTag()) ==
-        CryptoContextImpl<Element>::s_evalMultKeyMap.end()) {
+    if (!CryptoContextImpl<Element>::s_evalMultKeyMap.Contains(key->GetKeyTag())) {
         // the key is not found in the map, so the key has to be generated
-        const std::vector<EvalKey<Element>>& evalKeys                  = GetScheme()->EvalMultKeysGen(key);
-        CryptoContextImpl<Element>::s_evalMultKeyMap[key->GetKeyTag()] = evalKeys;
+        const std::vector<EvalKey<Element>>& evalKeys = GetScheme()->EvalMultKeysGen(key);
+        CryptoContextImpl<Element>::s_evalMultKeyMap.InsertIfAbsent(key->GetKeyTag(), evalKeys);
     }
 }
 
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalMultKeys() {
-    CryptoContextImpl<Element>::s_evalMultKeyMap.clear();
+    CryptoContextImpl<Element>::s_evalMultKeyMap.Clear();
 }
 
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalMultKeys(const std::string& id) {
-    auto kd = CryptoContextImpl<Element>::s_evalMultKeyMap.find(id);
-    if (kd != CryptoContextImpl<Element>::s_evalMultKeyMap.end())
-        CryptoContextImpl<Element>::s_evalMultKeyMap.erase(kd);
+    CryptoContextImpl<Element>::s_evalMultKeyMap.Erase(id);
 }
 
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalMultKeys(const CryptoContext<Element> cc) {
-    for (auto it = CryptoContextImpl<Element>::s_evalMultKeyMap.begin();
-         it != CryptoContextImpl<Element>::s_evalMultKeyMap.end();) {
-        if (it->second[0]->GetCryptoContext() == cc) {
-            it = CryptoContextImpl<Element>::s_evalMultKeyMap.erase(it);
-        }
-        else {
-            ++it;
-        }
-    }
+    CryptoContextImpl<Element>::s_evalMultKeyMap.EraseIf(
+        [&cc](const std::string&, const std::vector<EvalKey<Element>>& keys) {
+            return keys[0]->GetCryptoContext() == cc;
+        });
 }
 
 template <typename Element>
 void CryptoContextImpl<Element>::InsertEvalMultKey(const std::vector<EvalKey<Element>>& vectorToInsert) {
-    CryptoContextImpl<Element>::GetAllEvalMultKeys()[vectorToInsert[0]->GetKeyTag()] = vectorToInsert;
+    CryptoContextImpl<Element>::s_evalMultKeyMap.Insert(vectorToInsert[0]->GetKeyTag(), vectorToInsert);
 }
 
 /////////////////////////////////////////
@@ -167,41 +172,135 @@ std::shared_ptr<std::map<usint, EvalKey<Element>>> CryptoContextImpl<Element>::E
 
 template <typename Element>
 const std::map<usint, EvalKey<Element>>& CryptoContextImpl<Element>::GetEvalSumKeyMap(const std::string& keyID) {
-    return CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(keyID);
+    // a reference into the key cache could be invalidated by another thread, so a per-thread copy is returned
+    thread_local std::map<usint, EvalKey<Element>> evalSumKeys;
+    evalSumKeys = *(CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(keyID));
+    return evalSumKeys;
+}
+
+template <typename Element>
+std::map<std::string, std::vector<EvalKey<Element>>> CryptoContextImpl<Element>::GetAllEvalMultKeysSnapshot() {
+    // the cache is sharded, so the keys are copied to a new map. EvalKeys are shared pointers,
+    // so only the vectors are copied
+    std::map<std::string, std::vector<EvalKey<Element>>> snapshot;
+    for (const auto& [keyTag, evalKeys] : CryptoContextImpl<Element>::s_evalMultKeyMap.Snapshot())
+        snapshot.emplace(keyTag, *evalKeys);
+    return snapshot;
 }
 
 template <typename Element>
 std::map<std::string, std::vector<EvalKey<Element>>>& CryptoContextImpl<Element>::GetAllEvalMultKeys() {
-    return CryptoContextImpl<Element>::s_evalMultKeyMap;
+    thread_local std::map<std::string, std::vector<EvalKey<Element>>> evalMultKeys;
+    evalMultKeys = CryptoContextImpl<Element>::GetAllEvalMultKeysSnapshot();
+    return evalMultKeys;
 }
 
 template <typename Element>
-const std::vector<EvalKey<Element>>& CryptoContextImpl<Element>::GetEvalMultKeyVector(const std::string& keyID) {
-    auto ekv = CryptoContextImpl<Element>::s_evalMultKeyMap.find(keyID);
-    if (ekv == CryptoContextImpl<Element>::s_evalMultKeyMap.end()) {
+std::shared_ptr<const std::vector<EvalKey<Element>>> CryptoContextImpl<Element>::GetEvalMultKeyVectorPtr(
+    const std::string& keyID) {
+    auto evalKeys = CryptoContextImpl<Element>::s_evalMultKeyMap.Find(keyID);
+    if (evalKeys == nullptr) {
         std::string errMsg(std::string("Call EvalMultKeyGen() to have EvalMultKey available for ID [") + keyID + "].");
         OPENFHE_THROW(errMsg);
     }
-    return ekv->second;
+    return evalKeys;
+}
+
+template <typename Element>
+std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>>
+CryptoContextImpl<Element>::GetAllEvalAutomorphismKeysSnapshot() {
+    std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>> snapshot;
+    for (const auto& [keyTag, entry] : CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.Snapshot()) {
+        // lazily loaded keys are deserialized, so that every key is listed as before
+        if (entry->store == nullptr) {
+            snapshot.emplace(keyTag, entry->keys);
+            continue;
+        }
+        try {
+            snapshot.emplace(keyTag, CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(keyTag));
+        }
+        catch (const OpenFHEException&) {
+            // the keys were cleared by another thread in the meantime
+        }
+    }
+    return snapshot;
 }
 
 template <typename Element>
 std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>>&
 CryptoContextImpl<Element>::GetAllEvalAutomorphismKeys() {
-    return CryptoContextImpl<Element>::s_evalAutomorphismKeyMap;
+    thread_local std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>> evalAutomorphismKeys;
+    evalAutomorphismKeys = CryptoContextImpl<Element>::GetAllEvalAutomorphismKeysSnapshot();
+    return evalAutomorphismKeys;
 }
 
 template <typename Element>
 std::shared_ptr<std::map<usint, EvalKey<Element>>> CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(
     const std::string& keyID) {
-    auto ekv = CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.find(keyID);
-    if (ekv == CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.end()) {
-        std::string errMsg(
-            std::string("Call EvalAutomorphismKeyGen() to have EvalAutomorphismKeys available for ID [") + keyID +
-            "].");
-        OPENFHE_THROW(errMsg);
+    const std::string errMsg(std::string("Call EvalAutomorphismKeyGen() to have EvalAutomorphismKeys available for ID [") +
+                             keyID + "].");
+
+    // the whole map is requested: deserialize the remaining lazily loaded keys and release the key file.
+    // the file is read without holding the lock of the cache, and the merged keys are published only if the
+    // entry was not changed in the meantime; otherwise the merge is redone with the keys read already
+    std::shared_ptr<EvalKeyStore<Element>> loadedFrom;
+    std::map<usint, EvalKey<Element>> loaded;
+    while (true) {
+        auto current = CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.Find(keyID);
+        // the keys could be cleared by another thread in the meantime
+        if (current == nullptr)
+            OPENFHE_THROW(errMsg);
+        if (current->store == nullptr)
+            return current->keys;
+
+        if (loadedFrom != current->store) {
+            loaded     = current->store->LoadAll();
+            loadedFrom = current->store;
+        }
+
+        // the keys inserted after the file was loaded replace the keys from the file
+        auto keys = std::make_shared<std::map<usint, EvalKey<Element>>>(*(current->keys));
+        keys->insert(loaded.begin(), loaded.end());
+        if (CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.CompareAndSwap(keyID, current,
+                                                                                EvalAutomorphismKeyEntry{keys, nullptr}))
+            return keys;
+    }
+}
+
+template <typename Element>
+std::shared_ptr<std::map<usint, EvalKey<Element>>> CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(
+    const std::string& keyID, const std::vector<uint32_t>& indexList) {
+    auto entry = CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.Find(keyID);
+    if (entry == nullptr || entry->store == nullptr)
+        return CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(keyID);
+
+    // the keys inserted after the key file was loaded are used as they are; only the others are deserialized
+    auto keys = std::make_shared<std::map<usint, EvalKey<Element>>>();
+    std::vector<uint32_t> toLoad;
+    for (uint32_t index : indexList) {
+        auto it = entry->keys->find(index);
+        if (it != entry->keys->end())
+            (*keys)[index] = it->second;
+        else
+            toLoad.push_back(index);
+    }
+    if (!toLoad.empty()) {
+        auto loaded = entry->store->Load(toLoad);
+        keys->insert(loaded.begin(), loaded.end());
     }
-    return ekv->second;
+    return keys;
+}
+
+template <typename Element>
+CryptoContext<Element> CryptoContextImpl<Element>::GetEvalAutomorphismKeyContext(const std::string& keyID) {
+    auto entry = CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.Find(keyID);
+    if (entry == nullptr)
+        return nullptr;
+    if (entry->store != nullptr)
+        return entry->store->GetCryptoContext();
+    if (entry->keys->empty())
+        return nullptr;
+    return entry->keys->begin()->second->GetCryptoContext();
 }
 
 template <typename Element>
@@ -250,9 +349,46 @@ void CryptoContextImpl<Element>::EvalAtIndexKeyGen(const PrivateKey<Element> pri
     CryptoContextImpl<Element>::InsertEvalAutomorphismKey(evalKeys, privateKey->GetKeyTag());
 }
 
+template <typename Element>
+void CryptoContextImpl<Element>::EvalAtIndexKeyGen(const PrivateKey<Element> privateKey,
+                                                   const std::vector<int32_t>& indexList, uint32_t level) {
+    ValidateKey(privateKey);
+
+    auto evalKeys = GetScheme()->EvalAtIndexKeyGen(nullptr, privateKey, indexList);
+    for (auto& [index, evalKey] : *evalKeys)
+        evalKey = GetScheme()->TrimEvalKey(evalKey, level);
+    CryptoContextImpl<Element>::InsertEvalAutomorphismKey(evalKeys, privateKey->GetKeyTag());
+}
+
+template <typename Element>
+void CryptoContextImpl<Element>::TrimEvalMultKeys(const std::string& keyTag, uint32_t level) const {
+    bool found = CryptoContextImpl<Element>::s_evalMultKeyMap.Modify(
+        keyTag, [&](const std::vector<EvalKey<Element>>& evalKeys) {
+            std::vector<EvalKey<Element>> trimmed;
+            trimmed.reserve(evalKeys.size());
+            for (const auto& evalKey : evalKeys)
+                trimmed.push_back(GetScheme()->TrimEvalKey(evalKey, level));
+            return trimmed;
+        });
+    if (!found) {
+        std::string errMsg(std::string("Call EvalMultKeyGen() to have EvalMultKey available for ID [") + keyTag + "].");
+        OPENFHE_THROW(errMsg);
+    }
+}
+
+template <typename Element>
+void CryptoContextImpl<Element>::TrimEvalAutomorphismKeys(const std::string& keyTag, uint32_t level) const {
+    auto evalKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(keyTag);
+
+    auto trimmed = std::make_shared<std::map<usint, EvalKey<Element>>>();
+    for (const auto& [index, evalKey] : *evalKeys)
+        (*trimmed)[index] = GetScheme()->TrimEvalKey(evalKey, level);
+    CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.Insert(keyTag, EvalAutomorphismKeyEntry{trimmed, nullptr});
+}
+
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalAutomorphismKeys() {
-    CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.clear();
+    CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.Clear();
 }
 
 /**
@@ -261,9 +397,7 @@ void CryptoContextImpl<Element>::ClearEvalAutomorphismKeys() {
  */
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalAutomorphismKeys(const std::string& id) {
-    auto kd = CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.find(id);
-    if (kd != CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.end())
-        CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.erase(kd);
+    CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.Erase(id);
 }
 
 /**
@@ -273,31 +407,65 @@ void CryptoContextImpl<Element>::ClearEvalAutomorphismKeys(const std::string& id
  */
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalAutomorphismKeys(const CryptoContext<Element> cc) {
-    for (auto it = CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.begin();
-         it != CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.end();) {
-        if (it->second->begin()->second->GetCryptoContext() == cc) {
-            it = CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.erase(it);
-        }
-        else {
-            ++it;
-        }
+    CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.EraseIf(
+        [&cc](const std::string&, const EvalAutomorphismKeyEntry& entry) {
+            if (entry.store != nullptr)
+                return entry.store->GetCryptoContext() == cc;
+            return !entry.keys->empty() && entry.keys->begin()->second->GetCryptoContext() == cc;
+        });
+}
+
+template <typename Element>
+void CryptoContextImpl<Element>::ClearEvalEncapsulationKeys() {
+    CryptoContextImpl<Element>::s_evalEncapsulationKeyMap.Clear();
+}
+
+template <typename Element>
+void CryptoContextImpl<Element>::ClearEvalEncapsulationKeys(const std::string& id) {
+    CryptoContextImpl<Element>::s_evalEncapsulationKeyMap.Erase(id);
+}
+
+template <typename Element>
+void CryptoContextImpl<Element>::InsertEvalEncapsulationKey(const std::vector<EvalKey<Element>>& evalKeys,
+                                                            const std::string& keyTag) {
+    if (evalKeys.size() != 2)
+        OPENFHE_THROW("Sparse-secret encapsulation needs two keys, " + std::to_string(evalKeys.size()) + " given");
+    CryptoContextImpl<Element>::s_evalEncapsulationKeyMap.Insert(keyTag, evalKeys);
+}
+
+template <typename Element>
+std::shared_ptr<const std::vector<EvalKey<Element>>> CryptoContextImpl<Element>::GetEvalEncapsulationKeyVectorPtr(
+    const std::string& keyID) {
+    auto evalKeys = CryptoContextImpl<Element>::s_evalEncapsulationKeyMap.Find(keyID);
+    if (evalKeys == nullptr) {
+        std::string errMsg(std::string("Call EvalBootstrapKeyGen() to have the sparse-secret encapsulation keys "
+                                       "available for ID [") +
+                           keyID + "].");
+        OPENFHE_THROW(errMsg);
     }
+    return evalKeys;
 }
 
 template <typename Element>
 std::vector<uint32_t> CryptoContextImpl<Element>::GetExistingEvalAutomorphismKeyIndices(const std::string& keyTag) {
-    auto keyMapIt = CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.find(keyTag);
-    if (keyMapIt == CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.end())
+    auto entry = CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.Find(keyTag);
+    if (entry == nullptr)
         // there is no keys for the given id, return empty vector
         return std::vector<uint32_t>();
-
     // get all inidices from the existing automorphism key map
-    auto& keyMap = *(keyMapIt->second);
+    auto& keyMap = *(entry->keys);
     std::vector<uint32_t> indices(keyMap.size());
     for (const auto& [key, _] : keyMap) {
         indices.push_back(key);
     }
 
+    if (entry->store != nullptr) {
+        for (uint32_t index : entry->store->GetIndices()) {
+            if (keyMap.find(index) == keyMap.end())
+                indices.push_back(index);
+        }
+    }
+
     return indices;
 }
 
@@ -325,35 +493,57 @@ void CryptoContextImpl<Element>::InsertEvalAutomorphismKey(
 
     auto mapToInsertIt   = mapToInsert->begin();
     const std::string id = (keyTag.empty()) ? mapToInsertIt->second->GetKeyTag() : keyTag;
-    std::vector<uint32_t> existingIndices{CryptoContextImpl<Element>::GetExistingEvalAutomorphismKeyIndices(id)};
-    if (existingIndices.empty()) {
-        // there is no keys for the given id, so we insert full mapToInsert
-        CryptoContextImpl<Element>::s_evalAutomorphismKeyMap[id] = mapToInsert;
-    }
-    else {
-        // get all indices from mapToInsert
-        std::vector<uint32_t> newIndices(mapToInsert->size());
-        for (const auto& [key, _] : *mapToInsert) {
-            newIndices.push_back(key);
+    CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.Update(id, [&mapToInsert](const EvalAutomorphismKeyEntry* current) {
+        if (current == nullptr || (current->store == nullptr && current->keys->empty())) {
+            // there is no keys for the given id, so we insert full mapToInsert
+            return EvalAutomorphismKeyEntry{mapToInsert, nullptr};
         }
 
-        // find all indices in mapToInsert that are not in the exising map and
-        // insert those new indices and their corresponding keys to the existing map
-        std::vector<uint32_t> indicesToInsert{CryptoContextImpl<Element>::GetUniqueValues(existingIndices, newIndices)};
-        auto keyMapIt = CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.find(id);
-        auto& keyMap  = *(keyMapIt->second);
-        for (uint32_t indx : indicesToInsert) {
-            keyMap[indx] = (*mapToInsert)[indx];
+        // the existing map may be in use by other threads, so the keys from mapToInsert that are not in it yet
+        // are added to its copy. for lazily loaded keys, the key file stays in use and the new keys are kept
+        // next to it, so that no key is deserialized from the file
+        auto keyMap = std::make_shared<std::map<usint, EvalKey<Element>>>(*(current->keys));
+        for (const auto& [index, evalKey] : *mapToInsert) {
+            if (current->store == nullptr || !current->store->Contains(index))
+                keyMap->insert({index, evalKey});
         }
-    }
+        return EvalAutomorphismKeyEntry{keyMap, current->store};
+    });
+}
+
+template <typename Element>
+bool CryptoContextImpl<Element>::SerializeEvalAutomorphismKeyIndexed(const std::string& filename,
+                                                                     const std::string& id) {
+    const auto keys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(id);
+    return EvalKeyStore<Element>::Write(filename, id, *keys);
+}
+
+template <typename Element>
+bool CryptoContextImpl<Element>::DeserializeEvalAutomorphismKeyLazy(const std::string& filename,
+                                                                    uint32_t maxResidentKeys) {
+    auto store = std::make_shared<EvalKeyStore<Element>>(filename, maxResidentKeys);
+
+    const std::string& id = store->GetKeyTag();
+    // the key map for id holds only the keys inserted later, until the whole map is requested
+    CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.Insert(
+        id, EvalAutomorphismKeyEntry{std::make_shared<std::map<usint, EvalKey<Element>>>(), store});
+    return true;
+}
+
+template <typename Element>
+std::shared_ptr<EvalKeyStore<Element>> CryptoContextImpl<Element>::GetEvalAutomorphismKeyStore(
+    const std::string& keyTag) {
+    auto entry = CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.Find(keyTag);
+    return (entry == nullptr) ? nullptr : entry->store;
 }
 
 template <typename Element>
 Ciphertext<Element> CryptoContextImpl<Element>::EvalSum(ConstCiphertext<Element> ciphertext, usint batchSize) const {
     ValidateCiphertext(ciphertext);
 
-    auto evalSumKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
-    auto rv          = GetScheme()->EvalSum(ciphertext, batchSize, evalSumKeys);
+    auto evalSumKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(
+        ciphertext->GetKeyTag(), GetScheme()->FindEvalSumAutomorphismIndices(ciphertext, batchSize));
+    auto rv = GetScheme()->EvalSum(ciphertext, batchSize, *evalSumKeys);
     return rv;
 }
 
@@ -373,8 +563,9 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalSumCols(
     const std::map<usint, EvalKey<Element>>& evalSumKeysRight) const {
     ValidateCiphertext(ciphertext);
 
-    auto evalSumKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
-    auto rv          = GetScheme()->EvalSumCols(ciphertext, rowSize, evalSumKeys, evalSumKeysRight);
+    auto evalSumKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(
+        ciphertext->GetKeyTag(), GetScheme()->FindEvalSumAutomorphismIndices(ciphertext, rowSize));
+    auto rv = GetScheme()->EvalSumCols(ciphertext, rowSize, *evalSumKeys, evalSumKeysRight);
     return rv;
 }
 
@@ -390,9 +581,9 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalAtIndex(ConstCiphertext<Elem
         return rv;
     }
 
-    auto evalAutomorphismKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
+    auto evalAutomorphismKeys = GetEvalAutomorphismKeyMapForIndex(ciphertext->GetKeyTag(), index);
 
-    auto rv = GetScheme()->EvalAtIndex(ciphertext, index, evalAutomorphismKeys);
+    auto rv = GetScheme()->EvalAtIndex(ciphertext, index, *evalAutomorphismKeys);
     return rv;
 }
 
@@ -401,9 +592,15 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalMerge(
     const std::vector<Ciphertext<Element>>& ciphertextVector) const {
     ValidateCiphertext(ciphertextVector[0]);
 
-    auto evalAutomorphismKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ciphertextVector[0]->GetKeyTag());
+    // EvalMerge rotates the i-th ciphertext by -i
+    std::vector<uint32_t> indices;
+    indices.reserve(ciphertextVector.size());
+    for (size_t i = 1; i < ciphertextVector.size(); ++i)
+        indices.push_back(FindAutomorphismIndex(-static_cast<int32_t>(i)));
+    auto evalAutomorphismKeys =
+        CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(ciphertextVector[0]->GetKeyTag(), indices);
 
-    auto rv = GetScheme()->EvalMerge(ciphertextVector, evalAutomorphismKeys);
+    auto rv = GetScheme()->EvalMerge(ciphertextVector, *evalAutomorphismKeys);
 
     return rv;
 }
@@ -417,10 +614,11 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalInnerProduct(ConstCiphertext
             "Information passed to EvalInnerProduct was not generated "
             "with this crypto context");
 
-    auto evalSumKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ct1->GetKeyTag());
-    auto ek          = CryptoContextImpl<Element>::GetEvalMultKeyVector(ct1->GetKeyTag());
+    auto evalSumKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(
+        ct1->GetKeyTag(), GetScheme()->FindEvalSumAutomorphismIndices(ct1, batchSize));
+    auto ek = CryptoContextImpl<Element>::GetEvalMultKeyVectorPtr(ct1->GetKeyTag());
 
-    auto rv = GetScheme()->EvalInnerProduct(ct1, ct2, batchSize, evalSumKeys, ek[0]);
+    auto rv = GetScheme()->EvalInnerProduct(ct1, ct2, batchSize, *evalSumKeys, (*ek)[0]);
     return rv;
 }
 
@@ -433,9 +631,10 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalInnerProduct(ConstCiphertext
             "Information passed to EvalInnerProduct was not generated "
             "with this crypto context");
 
-    auto evalSumKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ct1->GetKeyTag());
+    auto evalSumKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(
+        ct1->GetKeyTag(), GetScheme()->FindEvalSumAutomorphismIndices(ct1, batchSize));
 
-    auto rv = GetScheme()->EvalInnerProduct(ct1, ct2, batchSize, evalSumKeys);
+    auto rv = GetScheme()->EvalInnerProduct(ct1, ct2, batchSize, *evalSumKeys);
     return rv;
 }
 
@@ -536,6 +735,15 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalDivide(ConstCiphertext<Eleme
     return EvalChebyshevFunction([](double x) -> double { return 1 / x; }, ciphertext, a, b, degree);
 }
 
+//------------------------------------------------------------------------------
+// Advanced SHE COMPARISON
+//------------------------------------------------------------------------------
+
+template <typename Element>
+uint32_t CryptoContextImpl<Element>::GetEvalSignDepth(double gap, uint32_t precision) {
+    return AdvancedSHECKKSRNS::GetEvalSignDepth(gap, precision);
+}
+
 }  // namespace lbcrypto
 
 // the code below is from cryptocontext-impl.cpp
@@ -885,6 +1093,135 @@ void CryptoContextImpl<DCRTPoly>::RecoverSharedKey(PrivateKey<DCRTPoly>& sk,
     }
 }
 
+namespace {
+// encodes the items of a batch into plaintexts[i] = encode(i). The first item is encoded serially so that it
+// validates the arguments shared by all items and fills the lazily initialized encoding tables before the
+// remaining items are encoded in parallel
+template <typename EncodeFunc>
+void EncodeBatch(std::vector<Plaintext>& plaintexts, const EncodeFunc& encode) {
+    const size_t numItems = plaintexts.size();
+    if (numItems == 0)
+        return;
+    plaintexts[0] = encode(0);
+
+    std::string exceptionMessage;
+    bool hadEx = false;
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(numItems - 1))
+    for (size_t i = 1; i < numItems; ++i) {
+        try {
+            plaintexts[i] = encode(i);
+        }
+        catch (std::exception& e) {
+#pragma omp critical
+            {
+                if (!hadEx) {
+                    exceptionMessage = "Item [" + std::to_string(i) + "]: " + e.what();
+                    hadEx            = true;
+                }
+            }
+        }
+    }
+    if (hadEx)
+        OPENFHE_THROW(exceptionMessage);
+}
+
+void ValidateBatchArgument(size_t argSize, size_t numItems, const std::string& argName) {
+    if (argSize != 0 && argSize != numItems)
+        OPENFHE_THROW("The number of " + argName + " [" + std::to_string(argSize) +
+                      "] should be either 0 or equal to the number of values [" + std::to_string(numItems) + "]");
+}
+
+// Builds the parameters of the extended basis P*Q_l used by hybrid key switching for ciphertexts at the given level
+std::shared_ptr<DCRTPoly::Params> ElementParamsExt(const std::shared_ptr<CryptoParametersRNS>& cryptoParams,
+                                                   uint32_t level) {
+    if (cryptoParams->GetKeySwitchTechnique() != HYBRID)
+        OPENFHE_THROW("The extended basis is only supported for hybrid key switching");
+
+    const auto& paramsQ = cryptoParams->GetElementParams()->GetParams();
+    const auto& paramsP = cryptoParams->GetParamsP()->GetParams();
+    if (level >= paramsQ.size())
+        OPENFHE_THROW("The level [" + std::to_string(level) + "] should be less than the number of towers [" +
+                      std::to_string(paramsQ.size()) + "]");
+
+    const size_t sizeQl = paramsQ.size() - level;
+    const size_t sizeP  = paramsP.size();
+    std::vector<NativeInteger> moduli(sizeQl + sizeP);
+    std::vector<NativeInteger> roots(sizeQl + sizeP);
+    for (size_t i = 0; i < sizeQl; ++i) {
+        moduli[i] = paramsQ[i]->GetModulus();
+        roots[i]  = paramsQ[i]->GetRootOfUnity();
+    }
+    for (size_t i = 0; i < sizeP; ++i) {
+        moduli[sizeQl + i] = paramsP[i]->GetModulus();
+        roots[sizeQl + i]  = paramsP[i]->GetRootOfUnity();
+    }
+    return std::make_shared<DCRTPoly::Params>(cryptoParams->GetElementParams()->GetCyclotomicOrder(), moduli, roots);
+}
+}  // namespace
+
+template <typename Element>
+std::vector<Plaintext> CryptoContextImpl<Element>::MakePackedPlaintexts(const std::vector<std::vector<int64_t>>& values,
+                                                                        const std::vector<size_t>& noiseScaleDegs,
+                                                                        const std::vector<uint32_t>& levels) const {
+    ValidateBatchArgument(noiseScaleDegs.size(), values.size(), "noiseScaleDegs");
+    ValidateBatchArgument(levels.size(), values.size(), "levels");
+
+    std::vector<Plaintext> plaintexts(values.size());
+    EncodeBatch(plaintexts, [&](size_t i) {
+        return MakePackedPlaintext(values[i], noiseScaleDegs.empty() ? 1 : noiseScaleDegs[i],
+                                   levels.empty() ? 0 : levels[i]);
+    });
+    return plaintexts;
+}
+
+template <typename Element>
+std::vector<Plaintext> CryptoContextImpl<Element>::MakeCKKSPackedPlaintexts(
+    const std::vector<std::vector<double>>& values, const std::vector<size_t>& scaleDegs,
+    const std::vector<uint32_t>& levels, usint slots) const {
+    VerifyCKKSScheme(__func__);
+    ValidateBatchArgument(scaleDegs.size(), values.size(), "scaleDegs");
+    ValidateBatchArgument(levels.size(), values.size(), "levels");
+
+    std::vector<Plaintext> plaintexts(values.size());
+    EncodeBatch(plaintexts, [&](size_t i) {
+        return MakeCKKSPackedPlaintext(values[i], scaleDegs.empty() ? 1 : scaleDegs[i], levels.empty() ? 0 : levels[i],
+                                       nullptr, slots);
+    });
+    return plaintexts;
+}
+
+template <typename Element>
+Plaintext CryptoContextImpl<Element>::MakePackedPlaintextExt(const std::vector<int64_t>& value, size_t noiseScaleDeg,
+                                                            uint32_t level) const {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(GetCryptoParameters());
+    const auto paramsExt    = ElementParamsExt(cryptoParams, level);
+
+    // the regular encoding validates the level and sets the scaling metadata
+    Plaintext p = MakePackedPlaintext(value, noiseScaleDeg, level);
+
+    // the encoded coefficients are smaller than t, so every tower of the extended basis is obtained from the first one
+    Element& element         = p->GetElement<Element>();
+    const auto& first        = element.GetElementAtIndex(0);
+    const auto& nativeParams = paramsExt->GetParams();
+    Element elementExt(paramsExt, Format::COEFFICIENT, true);
+    for (size_t i = 0; i < nativeParams.size(); ++i) {
+        auto tower = first;
+        tower.SwitchModulus(nativeParams[i]->GetModulus(), nativeParams[i]->GetRootOfUnity(),
+                            nativeParams[i]->GetBigModulus(), nativeParams[i]->GetBigRootOfUnity());
+        elementExt.SetElementAtIndex(i, std::move(tower));
+    }
+    element = std::move(elementExt);
+    return p;
+}
+
+template <typename Element>
+Plaintext CryptoContextImpl<Element>::MakeCKKSPackedPlaintextExt(const std::vector<double>& value, size_t scaleDeg,
+                                                                uint32_t level, usint slots) const {
+    VerifyCKKSScheme(__func__);
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(GetCryptoParameters());
+    return MakeCKKSPackedPlaintext(value, scaleDeg, level, ElementParamsExt(cryptoParams, level), slots);
+}
+
 template class CryptoContextImpl<DCRTPoly>;
 
 }  // namespace lbcrypto
@@ -122,6 +122,35 @@ std::vector<DCRTPoly::Integer> CKKSPackedEncoding::CRTMult(const std::vector<DCR
     return result;
 }
 
+std::vector<DCRTPoly::Integer> CKKSPackedEncoding::CRTFromDouble(double value,
+                                                                 const std::vector<DCRTPoly::Integer>& mods) {
+    if (value < 0)
+        OPENFHE_THROW("The value to be converted must be non-negative");
+
+    std::vector<DCRTPoly::Integer> result(mods.size());
+
+    // values that fit in a 64-bit word are rounded directly
+    if (value < std::pow(2, 63)) {
+        DCRTPoly::Integer intValue(static_cast<uint64_t>(std::llround(value)));
+        for (usint i = 0; i < mods.size(); i++) {
+            result[i] = intValue.Mod(mods[i]);
+        }
+        return result;
+    }
+
+    // larger values are integers already: value = mantissa * 2^(exponent - 53) with a 53-bit integer mantissa
+    constexpr int32_t precision = 53;
+    int32_t exponent            = 0;
+    double mantissa             = std::frexp(value, &exponent);
+    DCRTPoly::Integer intMantissa(static_cast<uint64_t>(std::ldexp(mantissa, precision)));
+    DCRTPoly::Integer two(2);
+    for (usint i = 0; i < mods.size(); i++) {
+        auto powTwo = two.ModExp(DCRTPoly::Integer(exponent - precision), mods[i]);
+        result[i]   = intMantissa.Mod(mods[i]).ModMulFast(powTwo, mods[i]);
+    }
+    return result;
+}
+
 #if NATIVEINT == 128 && !defined(__EMSCRIPTEN__)
 bool CKKSPackedEncoding::Encode() {
     if (this->isEncoded)
@@ -376,8 +405,7 @@ bool CKKSPackedEncoding::Encode() {
             moduli[i] = nativeParams[i]->GetModulus();
         }
 
-        DCRTPoly::Integer intPowP(static_cast<uint64_t>(std::llround(powP)));
-        std::vector<DCRTPoly::Integer> crtPowP(numTowers, intPowP);
+        std::vector<DCRTPoly::Integer> crtPowP = CRTFromDouble(powP, moduli);
 
         auto currPowP = crtPowP;
 
@@ -434,7 +462,7 @@ bool CKKSPackedEncoding::Decode(size_t noiseScaleDeg, double scalingFactor, Scal
     std::vector<std::complex<double>> curValues(slots);
 
     if (this->typeFlag == IsNativePoly) {
-        if (scalTech == FLEXIBLEAUTO || scalTech == FLEXIBLEAUTOEXT)
+        if (scalTech == FLEXIBLEAUTO || scalTech == FLEXIBLEAUTOEXT || scalTech == COMPOSITESCALINGAUTO)
             powP = pow(scalingFactor, -1);
         else
             powP = pow(2, -p);
@@ -463,7 +491,7 @@ bool CKKSPackedEncoding::Decode(size_t noiseScaleDeg, double scalingFactor, Scal
 
         // we will bring down the scaling factor to 2^p
         double scalingFactorPre = 0.0;
-        if (scalTech == FLEXIBLEAUTO || scalTech == FLEXIBLEAUTOEXT)
+        if (scalTech == FLEXIBLEAUTO || scalTech == FLEXIBLEAUTOEXT || scalTech == COMPOSITESCALINGAUTO)
             scalingFactorPre = pow(scalingFactor, -1) * pow(2, p);
         else
             scalingFactorPre = pow(2, -p * (noiseScaleDeg - 1));
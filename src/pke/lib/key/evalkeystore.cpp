@@ -0,0 +1,325 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+#include "key/evalkeystore.h"
+
+#include "cryptocontext-ser.h"
+#include "key/key-ser.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <streambuf>
+
+#if !defined(_WIN32)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace lbcrypto {
+
+namespace {
+
+constexpr char EVAL_KEY_STORE_MAGIC[8]    = {'O', 'F', 'H', 'E', 'E', 'K', 'S', '\0'};
+constexpr uint32_t EVAL_KEY_STORE_VERSION = 1;
+
+// read-only stream buffer over a memory-mapped region, so cereal reads the keys without copying
+class MemoryStreamBuf : public std::streambuf {
+public:
+    MemoryStreamBuf(const char* data, size_t size) {
+        char* p = const_cast<char*>(data);
+        setg(p, p, p + size);
+    }
+};
+
+template <typename T>
+void WriteValue(std::ostream& os, const T& value) {
+    os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T ReadValue(const char* data, uint64_t size, uint64_t& pos) {
+    if (pos + sizeof(T) > size)
+        OPENFHE_THROW("EvalKeyStore: unexpected end of the key file");
+    T value;
+    std::memcpy(&value, data + pos, sizeof(T));
+    pos += sizeof(T);
+    return value;
+}
+
+}  // namespace
+
+template <typename Element>
+EvalKeyStore<Element>::EvalKeyStore(const std::string& filename, uint32_t maxResidentKeys)
+    : m_filename(filename), m_maxResidentKeys(maxResidentKeys) {
+#if !defined(_WIN32)
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        OPENFHE_THROW("EvalKeyStore: can not open " + filename);
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        OPENFHE_THROW("EvalKeyStore: can not get the size of " + filename);
+    }
+    m_size    = static_cast<uint64_t>(st.st_size);
+    void* ptr = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+    // the mapping stays valid after the descriptor is closed
+    close(fd);
+    if (ptr == MAP_FAILED)
+        OPENFHE_THROW("EvalKeyStore: can not memory-map " + filename);
+    m_data = static_cast<const char*>(ptr);
+#else
+    std::ifstream file(filename, std::ios::in | std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+        OPENFHE_THROW("EvalKeyStore: can not open " + filename);
+    m_size    = static_cast<uint64_t>(file.tellg());
+    char* buf = new char[m_size];
+    file.seekg(0);
+    file.read(buf, m_size);
+    m_data = buf;
+#endif
+
+    try {
+        uint64_t pos = 0;
+        if (m_size < sizeof(EVAL_KEY_STORE_MAGIC) ||
+            std::memcmp(m_data, EVAL_KEY_STORE_MAGIC, sizeof(EVAL_KEY_STORE_MAGIC)) != 0)
+            OPENFHE_THROW(filename + " is not an indexed evaluation key file");
+        pos += sizeof(EVAL_KEY_STORE_MAGIC);
+
+        auto version = ReadValue<uint32_t>(m_data, m_size, pos);
+        if (version > EVAL_KEY_STORE_VERSION)
+            OPENFHE_THROW("EvalKeyStore: " + filename + " is from a later version of the library");
+        ReadValue<uint32_t>(m_data, m_size, pos);  // reserved
+
+        auto tagSize = ReadValue<uint64_t>(m_data, m_size, pos);
+        if (pos + tagSize > m_size)
+            OPENFHE_THROW("EvalKeyStore: unexpected end of the key file");
+        m_keyTag.assign(m_data + pos, tagSize);
+        pos += tagSize;
+
+        auto ccSize = ReadValue<uint64_t>(m_data, m_size, pos);
+        if (pos + ccSize > m_size)
+            OPENFHE_THROW("EvalKeyStore: unexpected end of the key file");
+        {
+            MemoryStreamBuf buf(m_data + pos, ccSize);
+            std::istream is(&buf);
+            Serial::Deserialize(m_cc, is, SerType::BINARY);
+        }
+        pos += ccSize;
+
+        auto numKeys = ReadValue<uint64_t>(m_data, m_size, pos);
+        for (uint64_t i = 0; i < numKeys; ++i) {
+            auto index = ReadValue<uint32_t>(m_data, m_size, pos);
+            ReadValue<uint32_t>(m_data, m_size, pos);  // reserved
+            KeyLocation location;
+            location.offset = ReadValue<uint64_t>(m_data, m_size, pos);
+            location.size   = ReadValue<uint64_t>(m_data, m_size, pos);
+            if (location.offset + location.size > m_size)
+                OPENFHE_THROW("EvalKeyStore: key [" + std::to_string(index) + "] is out of the file bounds");
+            m_index[index] = location;
+        }
+    }
+    catch (...) {
+#if !defined(_WIN32)
+        munmap(const_cast<char*>(m_data), m_size);
+#else
+        delete[] m_data;
+#endif
+        throw;
+    }
+}
+
+template <typename Element>
+EvalKeyStore<Element>::~EvalKeyStore() {
+#if !defined(_WIN32)
+    munmap(const_cast<char*>(m_data), m_size);
+#else
+    delete[] m_data;
+#endif
+}
+
+template <typename Element>
+bool EvalKeyStore<Element>::Write(const std::string& filename, const std::string& keyTag,
+                                  const std::map<uint32_t, EvalKey<Element>>& keyMap) {
+    if (keyMap.empty())
+        return false;
+
+    std::ofstream file(filename, std::ios::out | std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    file.write(EVAL_KEY_STORE_MAGIC, sizeof(EVAL_KEY_STORE_MAGIC));
+    WriteValue(file, EVAL_KEY_STORE_VERSION);
+    WriteValue(file, uint32_t(0));
+
+    WriteValue(file, static_cast<uint64_t>(keyTag.size()));
+    file.write(keyTag.data(), keyTag.size());
+
+    {
+        std::stringstream s;
+        Serial::Serialize(keyMap.begin()->second->GetCryptoContext(), s, SerType::BINARY);
+        const std::string ccSer = s.str();
+        WriteValue(file, static_cast<uint64_t>(ccSer.size()));
+        file.write(ccSer.data(), ccSer.size());
+    }
+
+    // the table is written twice: first as a placeholder and then with the actual offsets,
+    // so only one key at a time has to be kept serialized in memory
+    WriteValue(file, static_cast<uint64_t>(keyMap.size()));
+    const auto tablePos = file.tellp();
+    for (size_t i = 0; i < keyMap.size(); ++i) {
+        WriteValue(file, uint32_t(0));
+        WriteValue(file, uint32_t(0));
+        WriteValue(file, uint64_t(0));
+        WriteValue(file, uint64_t(0));
+    }
+
+    std::vector<KeyLocation> locations;
+    locations.reserve(keyMap.size());
+    for (const auto& [index, key] : keyMap) {
+        std::stringstream s;
+        Serial::Serialize(key, s, SerType::BINARY);
+        const std::string keySer = s.str();
+        locations.push_back({static_cast<uint64_t>(file.tellp()), static_cast<uint64_t>(keySer.size())});
+        file.write(keySer.data(), keySer.size());
+    }
+
+    file.seekp(tablePos);
+    size_t i = 0;
+    for (const auto& [index, key] : keyMap) {
+        WriteValue(file, index);
+        WriteValue(file, uint32_t(0));
+        WriteValue(file, locations[i].offset);
+        WriteValue(file, locations[i].size);
+        ++i;
+    }
+
+    file.close();
+    return !file.fail();
+}
+
+template <typename Element>
+EvalKey<Element> EvalKeyStore<Element>::Materialize(const KeyLocation& location) const {
+    EvalKey<Element> key;
+    {
+        MemoryStreamBuf buf(m_data + location.offset, location.size);
+        std::istream is(&buf);
+        Serial::Deserialize(key, is, SerType::BINARY);
+    }
+#if !defined(_WIN32)
+    // the serialized copy is no longer needed; let the kernel drop its pages from our resident set
+    const uint64_t pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    const uint64_t begin    = (location.offset + pageSize - 1) / pageSize * pageSize;
+    const uint64_t end      = (location.offset + location.size) / pageSize * pageSize;
+    if (end > begin)
+        madvise(const_cast<char*>(m_data) + begin, end - begin, MADV_DONTNEED);
+#endif
+    return key;
+}
+
+template <typename Element>
+std::map<uint32_t, EvalKey<Element>> EvalKeyStore<Element>::Load(const std::vector<uint32_t>& indexList) {
+    std::map<uint32_t, EvalKey<Element>> keys;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (uint32_t index : indexList) {
+        if (keys.find(index) != keys.end())
+            continue;
+
+        auto lruIt = m_lruPos.find(index);
+        if (lruIt != m_lruPos.end()) {
+            // already resident: make it the most recently used one
+            m_lru.splice(m_lru.begin(), m_lru, lruIt->second);
+            keys[index] = m_resident[index];
+            continue;
+        }
+
+        auto locIt = m_index.find(index);
+        if (locIt == m_index.end())
+            continue;
+
+        auto key          = Materialize(locIt->second);
+        m_resident[index] = key;
+        m_lru.push_front(index);
+        m_lruPos[index] = m_lru.begin();
+        keys[index]     = key;
+    }
+
+    if (m_maxResidentKeys != 0)
+        Evict(std::max<size_t>(m_maxResidentKeys, keys.size()));
+
+    return keys;
+}
+
+template <typename Element>
+std::map<uint32_t, EvalKey<Element>> EvalKeyStore<Element>::LoadAll() {
+    return Load(GetIndices());
+}
+
+template <typename Element>
+size_t EvalKeyStore<Element>::GetResidentCount() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_resident.size();
+}
+
+template <typename Element>
+std::vector<uint32_t> EvalKeyStore<Element>::GetIndices() const {
+    std::vector<uint32_t> indices;
+    indices.reserve(m_index.size());
+    for (const auto& [index, _] : m_index)
+        indices.push_back(index);
+    return indices;
+}
+
+template <typename Element>
+void EvalKeyStore<Element>::SetMaxResidentKeys(uint32_t maxResidentKeys) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxResidentKeys = maxResidentKeys;
+    if (m_maxResidentKeys != 0)
+        Evict(m_maxResidentKeys);
+}
+
+template <typename Element>
+void EvalKeyStore<Element>::Evict(size_t keep) {
+    while (m_lru.size() > keep) {
+        uint32_t index = m_lru.back();
+        m_lru.pop_back();
+        m_lruPos.erase(index);
+        m_resident.erase(index);
+    }
+}
+
+template class EvalKeyStore<DCRTPoly>;
+
+}  // namespace lbcrypto
@@ -0,0 +1,95 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+#include "cryptocontext.h"
+#include "key/packedevalkey.h"
+
+#include "utils/exception.h"
+
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+
+namespace lbcrypto {
+
+PackedEvalKey::PackedEvalKey(const std::vector<DCRTPoly>& bv, const std::vector<DCRTPoly>& av) {
+    if (bv.empty() || bv.size() != av.size())
+        OPENFHE_THROW("The key components must have the same nonzero number of digits");
+
+    m_numDigits = bv.size();
+    m_numTowers = bv[0].GetNumOfElements();
+    m_ringDim   = bv[0].GetRingDimension();
+
+    static_assert(std::is_trivially_destructible_v<NativeInteger>,
+                  "the packed buffer is released without calling destructors");
+
+    const size_t size = static_cast<size_t>(m_numTowers) * m_numDigits * 2 * m_ringDim;
+    m_data.reset(static_cast<NativeInteger*>(::operator new(size * sizeof(NativeInteger), std::align_val_t(ALIGNMENT))));
+
+    m_params = bv[0].GetParams();
+    m_moduli.resize(m_numTowers);
+    m_mu.resize(m_numTowers);
+    const auto& towerParams = m_params->GetParams();
+    for (uint32_t i = 0; i < m_numTowers; ++i) {
+        m_moduli[i] = towerParams[i]->GetModulus();
+        m_mu[i]     = m_moduli[i].ComputeMu();
+    }
+
+    for (uint32_t j = 0; j < m_numDigits; ++j) {
+        if (bv[j].GetFormat() != Format::EVALUATION || av[j].GetFormat() != Format::EVALUATION)
+            OPENFHE_THROW("The key components must be in evaluation format");
+        if (bv[j].GetNumOfElements() != m_numTowers || av[j].GetNumOfElements() != m_numTowers)
+            OPENFHE_THROW("All digits of the key must have the same number of towers");
+    }
+
+    for (uint32_t i = 0; i < m_numTowers; ++i) {
+        for (uint32_t j = 0; j < m_numDigits; ++j) {
+            auto* block     = m_data.get() + (static_cast<size_t>(i) * m_numDigits + j) * 2 * m_ringDim;
+            const auto& bji = bv[j].GetElementAtIndex(i).GetValues();
+            const auto& aji = av[j].GetElementAtIndex(i).GetValues();
+            std::uninitialized_copy_n(&bji[0], m_ringDim, block);
+            std::uninitialized_copy_n(&aji[0], m_ringDim, block + m_ringDim);
+        }
+    }
+}
+
+void PackedEvalKey::Unpack(std::vector<DCRTPoly>& bv, std::vector<DCRTPoly>& av) const {
+    bv.assign(m_numDigits, DCRTPoly(m_params, Format::EVALUATION, true));
+    av.assign(m_numDigits, DCRTPoly(m_params, Format::EVALUATION, true));
+    for (uint32_t j = 0; j < m_numDigits; ++j) {
+        for (uint32_t i = 0; i < m_numTowers; ++i) {
+            const auto* block = GetBlock(i, j);
+            std::copy_n(block, m_ringDim, &bv[j].GetAllElements()[i][0]);
+            std::copy_n(block + m_ringDim, m_ringDim, &av[j].GetAllElements()[i][0]);
+        }
+    }
+}
+
+}  // namespace lbcrypto
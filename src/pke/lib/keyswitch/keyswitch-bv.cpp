@@ -86,6 +86,9 @@ EvalKey<DCRTPoly> KeySwitchBV::KeySwitchGenInternal(const PrivateKey<DCRTPoly> o
     std::vector<DCRTPoly> av(nWindows);
     std::vector<DCRTPoly> bv(nWindows);
 
+    // threshold HE reuses the a component of the previous key
+    const std::vector<DCRTPoly> avPrev = (ek == nullptr) ? std::vector<DCRTPoly>() : ek->CopyAVector();
+
     if (digitSize > 0) {
         for (usint i = 0; i < sOld.GetNumOfElements(); i++) {
             std::vector<DCRTPoly::PolyType> sOldDecomposed = sOld.GetElementAtIndex(i).PowersOfBase(digitSize);
@@ -162,6 +165,9 @@ EvalKey<DCRTPoly> KeySwitchBV::KeySwitchGenInternal(const PrivateKey<DCRTPoly> o
     std::vector<DCRTPoly> av(nWindows);
     std::vector<DCRTPoly> bv(nWindows);
 
+    // threshold HE reuses the a component of the previous key
+    const std::vector<DCRTPoly> avPrev = (ek == nullptr) ? std::vector<DCRTPoly>() : ek->CopyAVector();
+
     if (digitSize > 0) {
         for (usint i = 0; i < sizeSOld; i++) {
             std::vector<DCRTPoly::PolyType> sOldDecomposed = sOld.GetElementAtIndex(i).PowersOfBase(digitSize);
@@ -175,7 +181,7 @@ EvalKey<DCRTPoly> KeySwitchBV::KeySwitchGenInternal(const PrivateKey<DCRTPoly> o
                     av[k + arrWindows[i]] = DCRTPoly(dug, elementParams, Format::EVALUATION);
                 }
                 else {  // threshold HE
-                    av[k + arrWindows[i]] = ek->GetAVector()[k + arrWindows[i]];
+                    av[k + arrWindows[i]] = avPrev[k + arrWindows[i]];
                 }
 
                 DCRTPoly e(dgg, elementParams, Format::EVALUATION);
@@ -193,7 +199,7 @@ EvalKey<DCRTPoly> KeySwitchBV::KeySwitchGenInternal(const PrivateKey<DCRTPoly> o
                 av[i] = DCRTPoly(dug, elementParams, Format::EVALUATION);
             }
             else {  // threshold HE
-                av[i] = ek->GetAVector()[i];
+                av[i] = avPrev[i];
             }
 
             DCRTPoly e(dgg, elementParams, Format::EVALUATION);
@@ -300,6 +306,50 @@ void KeySwitchBV::KeySwitchInPlace(Ciphertext<DCRTPoly>& ciphertext, const EvalK
     cv.resize(2);
 }
 
+EvalKey<DCRTPoly> KeySwitchBV::TrimEvalKey(const EvalKey<DCRTPoly> evalKey, uint32_t level) const {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(evalKey->GetCryptoParameters());
+
+    const std::vector<DCRTPoly>& bv = evalKey->GetBVector();
+    const std::vector<DCRTPoly>& av = evalKey->GetAVector();
+
+    const auto elementParams = cryptoParams->GetElementParams();
+    size_t sizeQ             = elementParams->GetParams().size();
+    if (level >= sizeQ)
+        OPENFHE_THROW("The level [" + std::to_string(level) + "] must be less than the number of towers [" +
+                      std::to_string(sizeQ) + "]");
+
+    // the key may have been trimmed already
+    size_t sizeQk = bv[0].GetNumOfElements();
+    size_t sizeQl = sizeQ - level;
+    if (sizeQl >= sizeQk)
+        return evalKey;
+
+    // the key has one component per digit of every tower (see CRTDecompose()); only the digits of
+    // the first sizeQl towers are used
+    uint32_t digitSize = cryptoParams->GetDigitSize();
+    size_t numDigits   = sizeQl;
+    if (digitSize > 0) {
+        numDigits = 0;
+        for (size_t i = 0; i < sizeQl; ++i) {
+            uint32_t nBits = elementParams->GetParams()[i]->GetModulus().GetLengthForBase(2);
+            numDigits += (nBits + digitSize - 1) / digitSize;
+        }
+    }
+
+    std::vector<DCRTPoly> bvTrimmed(bv.begin(), bv.begin() + numDigits);
+    std::vector<DCRTPoly> avTrimmed(av.begin(), av.begin() + numDigits);
+    for (size_t k = 0; k < numDigits; ++k) {
+        bvTrimmed[k].DropLastElements(sizeQk - sizeQl);
+        avTrimmed[k].DropLastElements(sizeQk - sizeQl);
+    }
+
+    EvalKeyRelin<DCRTPoly> ek = std::make_shared<EvalKeyRelinImpl<DCRTPoly>>(evalKey->GetCryptoContext());
+    ek->SetAVector(std::move(avTrimmed));
+    ek->SetBVector(std::move(bvTrimmed));
+    ek->SetKeyTag(evalKey->GetKeyTag());
+    return ek;
+}
+
 std::shared_ptr<std::vector<DCRTPoly>> KeySwitchBV::KeySwitchCore(const DCRTPoly& a,
                                                                   const EvalKey<DCRTPoly> evalKey) const {
     return EvalFastKeySwitchCore(EvalKeySwitchPrecomputeCore(a, evalKey->GetCryptoParameters()), evalKey,
@@ -315,11 +365,15 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchBV::EvalKeySwitchPrecomputeCore(
 std::shared_ptr<std::vector<DCRTPoly>> KeySwitchBV::EvalFastKeySwitchCore(
     const std::shared_ptr<std::vector<DCRTPoly>> digits, const EvalKey<DCRTPoly> evalKey,
     const std::shared_ptr<ParmType> paramsQl) const {
-    std::vector<DCRTPoly> bv(evalKey->GetBVector());
-    std::vector<DCRTPoly> av(evalKey->GetAVector());
-
-    auto sizeQ    = bv[0].GetParams()->GetParams().size();
-    auto sizeQl   = paramsQl->GetParams().size();
+    std::vector<DCRTPoly> bv(evalKey->CopyBVector());
+    std::vector<DCRTPoly> av(evalKey->CopyAVector());
+
+    // the key has fewer towers than the context if it was trimmed by TrimEvalKey()
+    auto sizeQ  = bv[0].GetParams()->GetParams().size();
+    auto sizeQl = paramsQl->GetParams().size();
+    if (sizeQl > sizeQ || digits->size() > bv.size())
+        OPENFHE_THROW("The evaluation key was trimmed for ciphertexts with at most " + std::to_string(sizeQ) +
+                      " towers; the ciphertext has " + std::to_string(sizeQl));
     size_t diffQl = sizeQ - sizeQl;
 
     for (size_t k = 0; k < bv.size(); k++) {
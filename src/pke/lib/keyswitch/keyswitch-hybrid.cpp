@@ -45,6 +45,22 @@
 
 namespace lbcrypto {
 
+namespace {
+// the key-switching inner product prefetches the key PREFETCH_DISTANCE coefficients ahead, once per
+// cache line
+constexpr uint32_t PREFETCH_DISTANCE    = 64;
+constexpr uint32_t PREFETCH_STRIDE_MASK = PackedEvalKey::ALIGNMENT / sizeof(NativeInteger) - 1;
+
+// returns the packed layout of the key, packing it on first use
+std::shared_ptr<const PackedEvalKey> GetPackedEvalKey(const EvalKey<DCRTPoly>& evalKey) {
+    const auto ek = std::dynamic_pointer_cast<EvalKeyRelinImpl<DCRTPoly>>(evalKey);
+    if (ek == nullptr)
+        OPENFHE_THROW("Hybrid key switching requires a relinearization key");
+
+    return ek->GetPackedKey();
+}
+}  // namespace
+
 EvalKey<DCRTPoly> KeySwitchHYBRID::KeySwitchGenInternal(const PrivateKey<DCRTPoly> oldKey,
                                                         const PrivateKey<DCRTPoly> newKey) const {
     return KeySwitchHYBRID::KeySwitchGenInternal(oldKey, newKey, nullptr);
@@ -99,9 +115,11 @@ EvalKey<DCRTPoly> KeySwitchHYBRID::KeySwitchGenInternal(const PrivateKey<DCRTPol
     std::vector<NativeInteger> PModq = cryptoParams->GetPModq();
     size_t numPerPartQ               = cryptoParams->GetNumPerPartQ();
 
+    const std::vector<DCRTPoly> avPrev = (ekPrev == nullptr) ? std::vector<DCRTPoly>() : ekPrev->CopyAVector();
+
     for (size_t part = 0; part < numPartQ; ++part) {
         DCRTPoly a = (ekPrev == nullptr) ? DCRTPoly(dug, paramsQP, Format::EVALUATION) :  // single-key HE
-                                           ekPrev->GetAVector()[part];                                      // threshold HE
+                                           avPrev[part];                                  // threshold HE
         DCRTPoly e(dgg, paramsQP, Format::EVALUATION);
         DCRTPoly b(paramsQP, Format::EVALUATION, true);
 
@@ -227,8 +245,68 @@ void KeySwitchHYBRID::KeySwitchInPlace(Ciphertext<DCRTPoly>& ciphertext, const E
     cv.resize(2);
 }
 
+EvalKey<DCRTPoly> KeySwitchHYBRID::TrimEvalKey(const EvalKey<DCRTPoly> evalKey, uint32_t level) const {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(evalKey->GetCryptoParameters());
+
+    // copies, so a packed key is not unpacked for good
+    const std::vector<DCRTPoly> bv = evalKey->CopyBVector();
+    const std::vector<DCRTPoly> av = evalKey->CopyAVector();
+
+    size_t sizeQ = cryptoParams->GetElementParams()->GetParams().size();
+    size_t sizeP = cryptoParams->GetParamsP()->GetParams().size();
+    if (level >= sizeQ)
+        OPENFHE_THROW("The level [" + std::to_string(level) + "] must be less than the number of towers [" +
+                      std::to_string(sizeQ) + "]");
+
+    // the key may have been trimmed already
+    const std::shared_ptr<ParmType> paramsQkP = bv[0].GetParams();
+    size_t sizeQk                             = paramsQkP->GetParams().size() - sizeP;
+    size_t sizeQl                             = sizeQ - level;
+    if (sizeQl >= sizeQk)
+        return evalKey;
+
+    // basis Ql*P: the first sizeQl towers of Q followed by all towers of P
+    std::vector<NativeInteger> moduli(sizeQl + sizeP);
+    std::vector<NativeInteger> roots(sizeQl + sizeP);
+    for (size_t i = 0; i < sizeQl; ++i) {
+        moduli[i] = paramsQkP->GetParams()[i]->GetModulus();
+        roots[i]  = paramsQkP->GetParams()[i]->GetRootOfUnity();
+    }
+    for (size_t j = 0; j < sizeP; ++j) {
+        moduli[sizeQl + j] = paramsQkP->GetParams()[sizeQk + j]->GetModulus();
+        roots[sizeQl + j]  = paramsQkP->GetParams()[sizeQk + j]->GetRootOfUnity();
+    }
+    auto paramsQlP = std::make_shared<ParmType>(paramsQkP->GetCyclotomicOrder(), moduli, roots);
+
+    // only the digits covering the first sizeQl towers are used
+    uint32_t alpha     = cryptoParams->GetNumPerPartQ();
+    uint32_t numPartQl = std::ceil(static_cast<double>(sizeQl) / alpha);
+
+    auto trim = [&](const DCRTPoly& poly) {
+        DCRTPoly result(paramsQlP, Format::EVALUATION, true);
+        for (size_t i = 0; i < sizeQl; ++i)
+            result.SetElementAtIndex(i, poly.GetElementAtIndex(i));
+        for (size_t j = 0; j < sizeP; ++j)
+            result.SetElementAtIndex(sizeQl + j, poly.GetElementAtIndex(sizeQk + j));
+        return result;
+    };
+
+    std::vector<DCRTPoly> bvTrimmed(numPartQl);
+    std::vector<DCRTPoly> avTrimmed(numPartQl);
+    for (uint32_t part = 0; part < numPartQl; ++part) {
+        bvTrimmed[part] = trim(bv[part]);
+        avTrimmed[part] = trim(av[part]);
+    }
+
+    EvalKeyRelin<DCRTPoly> ek = std::make_shared<EvalKeyRelinImpl<DCRTPoly>>(evalKey->GetCryptoContext());
+    ek->SetAVector(std::move(avTrimmed));
+    ek->SetBVector(std::move(bvTrimmed));
+    ek->SetKeyTag(evalKey->GetKeyTag());
+    return ek;
+}
+
 Ciphertext<DCRTPoly> KeySwitchHYBRID::KeySwitchExt(ConstCiphertext<DCRTPoly> ciphertext, bool addFirst) const {
-    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(ciphertext->GetCryptoParameters());
 
     const std::vector<DCRTPoly>& cv = ciphertext->GetElements();
 
@@ -255,7 +333,7 @@ Ciphertext<DCRTPoly> KeySwitchHYBRID::KeySwitchExt(ConstCiphertext<DCRTPoly> cip
 }
 
 Ciphertext<DCRTPoly> KeySwitchHYBRID::KeySwitchDown(ConstCiphertext<DCRTPoly> ciphertext) const {
-    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(ciphertext->GetCryptoParameters());
 
     const auto paramsP   = cryptoParams->GetParamsP();
     const auto paramsQlP = ciphertext->GetElements()[0].GetParams();
@@ -292,7 +370,7 @@ Ciphertext<DCRTPoly> KeySwitchHYBRID::KeySwitchDown(ConstCiphertext<DCRTPoly> ci
 }
 
 DCRTPoly KeySwitchHYBRID::KeySwitchDownFirstElement(ConstCiphertext<DCRTPoly> ciphertext) const {
-    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(ciphertext->GetCryptoParameters());
 
     const std::vector<DCRTPoly>& cTilda = ciphertext->GetElements();
 
@@ -320,6 +398,49 @@ DCRTPoly KeySwitchHYBRID::KeySwitchDownFirstElement(ConstCiphertext<DCRTPoly> ci
     return cv0;
 }
 
+void KeySwitchHYBRID::KeySwitchRescaleInPlace(Ciphertext<DCRTPoly>& ciphertext, const EvalKey<DCRTPoly> ek) const {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(ek->GetCryptoParameters());
+
+    std::vector<DCRTPoly>& cv = ciphertext->GetElements();
+    if (cv.size() != 3)
+        OPENFHE_THROW("KeySwitchRescale expects a ciphertext with 3 elements; it has " + std::to_string(cv.size()));
+
+    const auto paramsQl = cv[0].GetParams();
+    size_t sizeQl       = paramsQl->GetParams().size();
+    size_t sizeQ        = cryptoParams->GetElementParams()->GetParams().size();
+    if (sizeQl < 2)
+        OPENFHE_THROW("KeySwitchRescale needs at least 2 towers to drop one");
+    // the tables are indexed by the number of towers already dropped
+    size_t k = sizeQ - sizeQl;
+
+    std::shared_ptr<std::vector<DCRTPoly>> cTilda =
+        EvalFastKeySwitchCoreExt(EvalKeySwitchPrecomputeCore(cv[2], cryptoParams), ek, paramsQl);
+
+    // P*c_0 and P*c_1 are zero modulo the towers of P, so they are added to the towers of Ql only
+    const std::vector<NativeInteger>& PModq = cryptoParams->GetPModq();
+    for (size_t e = 0; e < 2; ++e) {
+        std::vector<DCRTPoly::PolyType>& towers = (*cTilda)[e].GetAllElements();
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(sizeQl))
+        for (size_t i = 0; i < sizeQl; ++i) {
+            cv[e].GetAllElements()[i] *= PModq[i];
+            towers[i] += cv[e].GetElementAtIndex(i);
+        }
+    }
+
+    // A single ModDown by the basis {q_l, p_1, ..., p_k} divides by P * q_l, which does the ModDown of the key
+    // switch and the rescaling at once and saves the NTTs of the towers of Ql that the separate rescale needs.
+    // The scaling by t only applies to BGV, so it is disabled here.
+    const std::vector<NativeInteger> none;
+    for (size_t e = 0; e < 2; ++e) {
+        cv[e] = (*cTilda)[e].ApproxModDown(
+            cryptoParams->GetParamsQlRescale(k), cryptoParams->GetParamsqlP(k), cryptoParams->GetqlPInvModq(k),
+            cryptoParams->GetqlPInvModqPrecon(k), cryptoParams->GetqlPHatInvModp(k),
+            cryptoParams->GetqlPHatInvModpPrecon(k), cryptoParams->GetqlPHatModq(k), cryptoParams->GetModqBarrettMu(),
+            none, none, 0, none);
+    }
+    cv.resize(2);
+}
+
 std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::KeySwitchCore(const DCRTPoly& a,
                                                                       const EvalKey<DCRTPoly> evalKey) const {
     return EvalFastKeySwitchCore(EvalKeySwitchPrecomputeCore(a, evalKey->GetCryptoParameters()), evalKey,
@@ -439,40 +560,58 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalFastKeySwitchCore(
 std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalFastKeySwitchCoreExt(
     const std::shared_ptr<std::vector<DCRTPoly>> digits, const EvalKey<DCRTPoly> evalKey,
     const std::shared_ptr<ParmType> paramsQl) const {
-    const auto cryptoParams         = std::dynamic_pointer_cast<CryptoParametersRNS>(evalKey->GetCryptoParameters());
-    const std::vector<DCRTPoly>& bv = evalKey->GetBVector();
-    const std::vector<DCRTPoly>& av = evalKey->GetAVector();
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(evalKey->GetCryptoParameters());
+    // the per-digit key polynomials are not used here, so they are released once the key is packed
+    const auto packedKey = GetPackedEvalKey(evalKey);
 
     const std::shared_ptr<ParmType> paramsP   = cryptoParams->GetParamsP();
     const std::shared_ptr<ParmType> paramsQlP = (*digits)[0].GetParams();
 
     size_t sizeQl  = paramsQl->GetParams().size();
     size_t sizeQlP = paramsQlP->GetParams().size();
-    size_t sizeQ   = cryptoParams->GetElementParams()->GetParams().size();
+    // the key has fewer towers than the context if it was trimmed by TrimEvalKey()
+    size_t sizeQ = packedKey->GetNumTowers() - paramsP->GetParams().size();
+    if (sizeQl > sizeQ || digits->size() > packedKey->GetNumDigits())
+        OPENFHE_THROW("The evaluation key was trimmed for ciphertexts with at most " + std::to_string(sizeQ) +
+                      " towers; the ciphertext has " + std::to_string(sizeQl));
 
     DCRTPoly cTilda0(paramsQlP, Format::EVALUATION, true);
     DCRTPoly cTilda1(paramsQlP, Format::EVALUATION, true);
 
-    for (uint32_t j = 0; j < digits->size(); j++) {
-        const DCRTPoly& cj = (*digits)[j];
-        const DCRTPoly& bj = bv[j];
-        const DCRTPoly& aj = av[j];
-
-        for (usint i = 0; i < sizeQl; i++) {
-            const auto& cji = cj.GetElementAtIndex(i);
-            const auto& aji = aj.GetElementAtIndex(i);
-            const auto& bji = bj.GetElementAtIndex(i);
-
-            cTilda0.SetElementAtIndex(i, cTilda0.GetElementAtIndex(i) + cji * bji);
-            cTilda1.SetElementAtIndex(i, cTilda1.GetElementAtIndex(i) + cji * aji);
-        }
-        for (usint i = sizeQl, idx = sizeQ; i < sizeQlP; i++, idx++) {
-            const auto& cji = cj.GetElementAtIndex(i);
-            const auto& aji = aj.GetElementAtIndex(idx);
-            const auto& bji = bj.GetElementAtIndex(idx);
-
-            cTilda0.SetElementAtIndex(i, cTilda0.GetElementAtIndex(i) + cji * bji);
-            cTilda1.SetElementAtIndex(i, cTilda1.GetElementAtIndex(i) + cji * aji);
+    // For every tower of Ql*P the key blocks of all digits are adjacent in the packed key, and the
+    // towers of the digits are contiguous vectors, so the inner product streams through memory.
+    const uint32_t numDigits = digits->size();
+    const uint32_t ringDim   = packedKey->GetRingDimension();
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(sizeQlP))
+    for (size_t i = 0; i < sizeQlP; i++) {
+        // the towers of P follow the towers of Q in the key
+        const uint32_t idx     = (i < sizeQl) ? i : i - sizeQl + sizeQ;
+        const NativeInteger& q = packedKey->GetModulus(idx);
+#ifdef NATIVEINT_BARRET_MOD
+        const NativeInteger& mu = packedKey->GetModulusMu(idx);
+#endif
+        NativeInteger* const acc0 = &cTilda0.GetAllElements()[i][0];
+        NativeInteger* const acc1 = &cTilda1.GetAllElements()[i][0];
+
+        for (uint32_t j = 0; j < numDigits; j++) {
+            const NativeInteger* const cji = &(*digits)[j].GetElementAtIndex(i).GetValues()[0];
+            const NativeInteger* const bji = packedKey->GetBlock(idx, j);
+            const NativeInteger* const aji = bji + ringDim;
+            for (uint32_t k = 0; k < ringDim; k++) {
+#if defined(__GNUC__)
+                if ((k & PREFETCH_STRIDE_MASK) == 0 && k + PREFETCH_DISTANCE < ringDim) {
+                    __builtin_prefetch(bji + k + PREFETCH_DISTANCE);
+                    __builtin_prefetch(aji + k + PREFETCH_DISTANCE);
+                }
+#endif
+#ifdef NATIVEINT_BARRET_MOD
+                acc0[k].ModAddFastEq(cji[k].ModMulFast(bji[k], q, mu), q);
+                acc1[k].ModAddFastEq(cji[k].ModMulFast(aji[k], q, mu), q);
+#else
+                acc0[k].ModAddFastEq(cji[k].ModMulFast(bji[k], q), q);
+                acc1[k].ModAddFastEq(cji[k].ModMulFast(aji[k], q), q);
+#endif
+            }
         }
     }
 
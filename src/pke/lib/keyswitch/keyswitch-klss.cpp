@@ -0,0 +1,311 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/**
+ * KLSS key switching implementation. See "Accelerating HE Operations from Key Decomposition Technique"
+ * (https://eprint.iacr.org/2023/413) for details.
+ */
+#define PROFILE
+
+#include "keyswitch/keyswitch-klss.h"
+
+#include "key/privatekey.h"
+#include "key/publickey.h"
+#include "key/evalkeyrelin.h"
+#include "schemerns/rns-cryptoparameters.h"
+#include "ciphertext.h"
+#include "utils/utilities-int.h"
+
+#include <algorithm>
+
+namespace lbcrypto {
+
+namespace {
+// returns the parameters made of the first size towers of params
+std::shared_ptr<DCRTPoly::Params> TruncateParams(const std::shared_ptr<DCRTPoly::Params>& params, uint32_t size) {
+    if (params->GetParams().size() == size)
+        return params;
+    auto truncated = std::make_shared<DCRTPoly::Params>(*params);
+    while (truncated->GetParams().size() > size)
+        truncated->PopLastParam();
+    return truncated;
+}
+}  // namespace
+
+EvalKey<DCRTPoly> KeySwitchKLSS::KeySwitchGenInternal(const PrivateKey<DCRTPoly> oldKey,
+                                                      const PrivateKey<DCRTPoly> newKey) const {
+    return ConvertHybridKey(KeySwitchHYBRID::KeySwitchGenInternal(oldKey, newKey));
+}
+
+EvalKey<DCRTPoly> KeySwitchKLSS::KeySwitchGenInternal(const PrivateKey<DCRTPoly> oldKey,
+                                                      const PrivateKey<DCRTPoly> newKey,
+                                                      const EvalKey<DCRTPoly> ekPrev) const {
+    if (ekPrev == nullptr)
+        return KeySwitchKLSS::KeySwitchGenInternal(oldKey, newKey);
+    OPENFHE_THROW("Threshold key generation is not supported for KLSS key switching");
+}
+
+EvalKey<DCRTPoly> KeySwitchKLSS::KeySwitchGenInternal(const PrivateKey<DCRTPoly> oldKey,
+                                                      const PublicKey<DCRTPoly> newKey) const {
+    return ConvertHybridKey(KeySwitchHYBRID::KeySwitchGenInternal(oldKey, newKey));
+}
+
+EvalKey<DCRTPoly> KeySwitchKLSS::TrimEvalKey(const EvalKey<DCRTPoly> evalKey, uint32_t level) const {
+    OPENFHE_THROW("TrimEvalKey is not supported for KLSS key switching");
+}
+
+EvalKey<DCRTPoly> KeySwitchKLSS::ConvertHybridKey(const EvalKey<DCRTPoly> evalKey) const {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(evalKey->GetCryptoParameters());
+
+    const std::shared_ptr<ParmType> paramsR = cryptoParams->GetParamsAux();
+    const auto& paramsPartQP                = cryptoParams->GetParamsPartQP();
+
+    const uint32_t numPartQ     = cryptoParams->GetNumPartQ();
+    const uint32_t numPartQP    = paramsPartQP.size();
+    const uint32_t numPartQInQP = cryptoParams->GetNumPartQInQP();
+    const uint32_t sizeQ        = cryptoParams->GetElementParams()->GetParams().size();
+    const uint32_t alphaQP      = cryptoParams->GetNumPerPartQP();
+
+    // key_{j,c}: the key of digit j modulo {QP}_c, lifted to R
+    auto liftKey = [&](const std::vector<DCRTPoly>& key) {
+        std::vector<DCRTPoly> result(numPartQ * numPartQP);
+#pragma omp parallel for collapse(2) num_threads(OpenFHEParallelControls.GetThreadLimit(numPartQ * numPartQP))
+        for (uint32_t j = 0; j < numPartQ; j++) {
+            for (uint32_t c = 0; c < numPartQP; c++) {
+                // the parts of P follow the towers of Q in the key
+                uint32_t startTower = (c < numPartQInQP) ? c * alphaQP : sizeQ + (c - numPartQInQP) * alphaQP;
+                DCRTPoly part(paramsPartQP[c], Format::EVALUATION, true);
+                for (uint32_t i = 0; i < paramsPartQP[c]->GetParams().size(); i++)
+                    part.SetElementAtIndex(i, key[j].GetElementAtIndex(startTower + i));
+                part.SetFormat(Format::COEFFICIENT);
+
+                DCRTPoly lifted = part.ApproxSwitchCRTBasis(
+                    paramsPartQP[c], paramsR, cryptoParams->GetPartQPHatInvModq(c),
+                    cryptoParams->GetPartQPHatInvModqPrecon(c), cryptoParams->GetPartQPHatModAux(c),
+                    cryptoParams->GetModAuxBarrettMu());
+                lifted.SetFormat(Format::EVALUATION);
+                result[j * numPartQP + c] = std::move(lifted);
+            }
+        }
+        return result;
+    };
+
+    EvalKeyRelin<DCRTPoly> ek = std::make_shared<EvalKeyRelinImpl<DCRTPoly>>(evalKey->GetCryptoContext());
+    ek->SetAVector(liftKey(evalKey->CopyAVector()));
+    ek->SetBVector(liftKey(evalKey->CopyBVector()));
+    ek->SetKeyTag(evalKey->GetKeyTag());
+    return ek;
+}
+
+std::shared_ptr<std::vector<DCRTPoly>> KeySwitchKLSS::EvalKeySwitchPrecomputeCore(
+    const DCRTPoly& c, std::shared_ptr<CryptoParametersBase<DCRTPoly>> cryptoParamsBase) const {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(cryptoParamsBase);
+
+    const std::shared_ptr<ParmType> paramsR   = cryptoParams->GetParamsAux();
+    const std::shared_ptr<ParmType> paramsQlR = c.GetExtendedCRTBasis(paramsR);
+
+    uint32_t sizeQl = c.GetNumOfElements();
+    uint32_t sizeR  = paramsR->GetParams().size();
+
+    uint32_t alpha = cryptoParams->GetNumPerPartQ();
+    // The number of digits of the current ciphertext
+    uint32_t numPartQl = ceil((static_cast<double>(sizeQl)) / alpha);
+    if (numPartQl > cryptoParams->GetNumberOfQPartitions())
+        numPartQl = cryptoParams->GetNumberOfQPartitions();
+
+    std::vector<DCRTPoly> digits(numPartQl);
+
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(numPartQl))
+    for (uint32_t part = 0; part < numPartQl; part++) {
+        uint32_t startPartIdx = alpha * part;
+        uint32_t sizePartQl   = std::min(alpha, sizeQl - startPartIdx);
+
+        auto paramsPartQl = TruncateParams(cryptoParams->GetParamsPartQ(part), sizePartQl);
+        DCRTPoly partCt(paramsPartQl, Format::EVALUATION, true);
+        for (uint32_t i = 0; i < sizePartQl; i++)
+            partCt.SetElementAtIndex(i, c.GetElementAtIndex(startPartIdx + i));
+
+        digits[part] = DCRTPoly(paramsQlR, Format::EVALUATION, true);
+        for (uint32_t i = 0; i < sizePartQl; i++)
+            digits[part].SetElementAtIndex(startPartIdx + i, partCt.GetElementAtIndex(i));
+
+        partCt.SetFormat(Format::COEFFICIENT);
+        DCRTPoly partR = partCt.ApproxSwitchCRTBasis(
+            paramsPartQl, paramsR, cryptoParams->GetPartQlHatInvModq(part, sizePartQl - 1),
+            cryptoParams->GetPartQlHatInvModqPrecon(part, sizePartQl - 1),
+            cryptoParams->GetPartQlHatModAux(part, sizePartQl - 1), cryptoParams->GetModAuxBarrettMu());
+        partR.SetFormat(Format::EVALUATION);
+
+        for (uint32_t k = 0; k < sizeR; k++)
+            digits[part].SetElementAtIndex(sizeQl + k, std::move(partR.GetAllElements()[k]));
+    }
+
+    return std::make_shared<std::vector<DCRTPoly>>(std::move(digits));
+}
+
+std::shared_ptr<std::vector<DCRTPoly>> KeySwitchKLSS::EvalFastKeySwitchCore(
+    const std::shared_ptr<std::vector<DCRTPoly>> digits, const EvalKey<DCRTPoly> evalKey,
+    const std::shared_ptr<ParmType> paramsQl) const {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(evalKey->GetCryptoParameters());
+
+    // callers may pass the basis of the digits as paramsQl; ModDown needs Ql only
+    uint32_t sizeQl = (*digits)[0].GetNumOfElements() - cryptoParams->GetParamsAux()->GetParams().size();
+    return KeySwitchHYBRID::EvalFastKeySwitchCore(digits, evalKey, TruncateParams(paramsQl, sizeQl));
+}
+
+std::shared_ptr<std::vector<DCRTPoly>> KeySwitchKLSS::EvalFastKeySwitchCoreExt(
+    const std::shared_ptr<std::vector<DCRTPoly>> digits, const EvalKey<DCRTPoly> evalKey,
+    const std::shared_ptr<ParmType> paramsQl) const {
+    const auto cryptoParams         = std::dynamic_pointer_cast<CryptoParametersRNS>(evalKey->GetCryptoParameters());
+    const std::vector<DCRTPoly>& av = evalKey->GetAVector();
+    const std::vector<DCRTPoly>& bv = evalKey->GetBVector();
+
+    const std::shared_ptr<ParmType> paramsR = cryptoParams->GetParamsAux();
+    const std::shared_ptr<ParmType> paramsP = cryptoParams->GetParamsP();
+    const auto& paramsPartQP                = cryptoParams->GetParamsPartQP();
+
+    const uint32_t sizeR        = paramsR->GetParams().size();
+    const uint32_t sizeQl       = (*digits)[0].GetNumOfElements() - sizeR;
+    const uint32_t numPartQ     = cryptoParams->GetNumPartQ();
+    const uint32_t numPartQP    = paramsPartQP.size();
+    const uint32_t numPartQInQP = cryptoParams->GetNumPartQInQP();
+    const uint32_t alphaQP      = cryptoParams->GetNumPerPartQP();
+    const uint32_t numDigits    = digits->size();
+
+    if (bv.size() != numPartQ * numPartQP)
+        OPENFHE_THROW("The evaluation key was not generated for KLSS key switching");
+
+    const auto paramsQlP = DCRTPoly(TruncateParams(paramsQl, sizeQl), Format::EVALUATION, false)
+                               .GetExtendedCRTBasis(paramsP);
+
+    DCRTPoly cTilda0(paramsQlP, Format::EVALUATION, true);
+    DCRTPoly cTilda1(paramsQlP, Format::EVALUATION, true);
+
+    // the parts of QP present at this level: the parts of Q with towers in Ql and all parts of P
+    std::vector<uint32_t> parts;
+    for (uint32_t c = 0; c < numPartQInQP && c * alphaQP < sizeQl; c++)
+        parts.push_back(c);
+    for (uint32_t c = numPartQInQP; c < numPartQP; c++)
+        parts.push_back(c);
+
+    const uint32_t ringDim = paramsR->GetRingDimension();
+#if defined(HAVE_INT128) && NATIVEINT == 64
+    // the products are accumulated without reduction as long as their sum fits in 128 bits
+    const uint32_t maxBitsR     = paramsR->GetParams()[0]->GetModulus().GetMSB();
+    const uint32_t numLazy      = (2 * maxBitsR < 127) ? (1u << std::min<uint32_t>(127 - 2 * maxBitsR, 31)) : 1;
+    const auto& modAuxBarrettMu = cryptoParams->GetModAuxBarrettMu();
+#endif
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(parts.size()))
+    for (uint32_t idx = 0; idx < parts.size(); idx++) {
+        const uint32_t c = parts[idx];
+
+        // sum_j d_j * key_{j,c} computed in R
+        DCRTPoly sum0(paramsR, Format::EVALUATION, true);
+        DCRTPoly sum1(paramsR, Format::EVALUATION, true);
+        for (uint32_t k = 0; k < sizeR; k++) {
+            const NativeInteger& r    = paramsR->GetParams()[k]->GetModulus();
+            NativeInteger* const acc0 = &sum0.GetAllElements()[k][0];
+            NativeInteger* const acc1 = &sum1.GetAllElements()[k][0];
+#if defined(HAVE_INT128) && NATIVEINT == 64
+            std::vector<DoubleNativeInt> lazy0(ringDim, 0);
+            std::vector<DoubleNativeInt> lazy1(ringDim, 0);
+            for (uint32_t j = 0; j < numDigits; j++) {
+                const NativeInteger* const djk = &(*digits)[j].GetElementAtIndex(sizeQl + k).GetValues()[0];
+                const NativeInteger* const bjk = &bv[j * numPartQP + c].GetElementAtIndex(k).GetValues()[0];
+                const NativeInteger* const ajk = &av[j * numPartQP + c].GetElementAtIndex(k).GetValues()[0];
+                for (uint32_t i = 0; i < ringDim; i++) {
+                    lazy0[i] += Mul128(djk[i].ConvertToInt(), bjk[i].ConvertToInt());
+                    lazy1[i] += Mul128(djk[i].ConvertToInt(), ajk[i].ConvertToInt());
+                }
+                if ((j + 1) % numLazy == 0 && j + 1 < numDigits) {
+                    for (uint32_t i = 0; i < ringDim; i++) {
+                        lazy0[i] = BarrettUint128ModUint64(lazy0[i], r.ConvertToInt(), modAuxBarrettMu[k]);
+                        lazy1[i] = BarrettUint128ModUint64(lazy1[i], r.ConvertToInt(), modAuxBarrettMu[k]);
+                    }
+                }
+            }
+            for (uint32_t i = 0; i < ringDim; i++) {
+                acc0[i] = BarrettUint128ModUint64(lazy0[i], r.ConvertToInt(), modAuxBarrettMu[k]);
+                acc1[i] = BarrettUint128ModUint64(lazy1[i], r.ConvertToInt(), modAuxBarrettMu[k]);
+            }
+#else
+    #ifdef NATIVEINT_BARRET_MOD
+            const NativeInteger mu = r.ComputeMu();
+    #endif
+            for (uint32_t j = 0; j < numDigits; j++) {
+                const NativeInteger* const djk = &(*digits)[j].GetElementAtIndex(sizeQl + k).GetValues()[0];
+                const NativeInteger* const bjk = &bv[j * numPartQP + c].GetElementAtIndex(k).GetValues()[0];
+                const NativeInteger* const ajk = &av[j * numPartQP + c].GetElementAtIndex(k).GetValues()[0];
+                for (uint32_t i = 0; i < ringDim; i++) {
+    #ifdef NATIVEINT_BARRET_MOD
+                    acc0[i].ModAddFastEq(djk[i].ModMulFast(bjk[i], r, mu), r);
+                    acc1[i].ModAddFastEq(djk[i].ModMulFast(ajk[i], r, mu), r);
+    #else
+                    acc0[i].ModAddFastEq(djk[i].ModMulFast(bjk[i], r), r);
+                    acc1[i].ModAddFastEq(djk[i].ModMulFast(ajk[i], r), r);
+    #endif
+                }
+            }
+#endif
+        }
+        sum0.SetFormat(Format::COEFFICIENT);
+        sum1.SetFormat(Format::COEFFICIENT);
+
+        // the towers of the part present at this level and their position in Ql*P
+        uint32_t sizePart     = paramsPartQP[c]->GetParams().size();
+        uint32_t startPartIdx = c * alphaQP;
+        if (c < numPartQInQP) {
+            sizePart = std::min(sizePart, sizeQl - startPartIdx);
+        }
+        else {
+            startPartIdx = sizeQl + (c - numPartQInQP) * alphaQP;
+        }
+        auto paramsPart = TruncateParams(paramsPartQP[c], sizePart);
+
+        // exact conversion from R to the part
+        auto switchToPart = [&](const DCRTPoly& sum, DCRTPoly& cTilda) {
+            DCRTPoly switched = sum.SwitchCRTBasis(paramsPart, cryptoParams->GetAuxHatInvModAux(),
+                                                   cryptoParams->GetAuxHatInvModAuxPrecon(),
+                                                   cryptoParams->GetAuxHatModPartQP(c), cryptoParams->GetalphaAuxModPartQP(c),
+                                                   cryptoParams->GetModPartQPBarrettMu(c), cryptoParams->GetAuxInv());
+            switched.SetFormat(Format::EVALUATION);
+            for (uint32_t i = 0; i < sizePart; i++)
+                cTilda.SetElementAtIndex(startPartIdx + i, std::move(switched.GetAllElements()[i]));
+        };
+        switchToPart(sum0, cTilda0);
+        switchToPart(sum1, cTilda1);
+    }
+
+    return std::make_shared<std::vector<DCRTPoly>>(
+        std::initializer_list<DCRTPoly>{std::move(cTilda0), std::move(cTilda1)});
+}
+
+}  // namespace lbcrypto
@@ -42,8 +42,75 @@ BFV implementation. See https://eprint.iacr.org/2021/204 for details.
 #include "cryptocontext.h"
 #include "ciphertext.h"
 
+#include "utils/utilities-int.h"
+
 namespace lbcrypto {
 
+// For the usual product of two 2-element ciphertexts with 128-bit integers, the three outputs are computed in one
+// pass over each tower: the four input coefficients are read once, the cross term cv1[0] * cv2[1] + cv1[1] * cv2[0]
+// is reduced once (Barrett) instead of twice, and no temporary polynomial is allocated for each product.
+std::vector<DCRTPoly> LeveledSHEBFVRNS::TensorProduct(const std::vector<DCRTPoly>& cv1,
+                                                      const std::vector<DCRTPoly>& cv2) {
+    const size_t cv1Size    = cv1.size();
+    const size_t cv2Size    = cv2.size();
+    const size_t cvMultSize = cv1Size + cv2Size - 1;
+
+#if defined(HAVE_INT128) && NATIVEINT == 64
+    if (cv1Size == 2 && cv2Size == 2) {
+        std::vector<DCRTPoly> cvMult;
+        cvMult.reserve(cvMultSize);
+        for (size_t k = 0; k < cvMultSize; ++k)
+            cvMult.emplace_back(cv1[0].GetParams(), Format::EVALUATION, true);
+
+        const uint32_t numTowers = cv1[0].GetNumOfElements();
+        const uint32_t ringDim   = cv1[0].GetRingDimension();
+        const auto BarrettBase128Bit(BigInteger(1).LShiftEq(128));
+
+    #pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(numTowers))
+        for (uint32_t t = 0; t < numTowers; ++t) {
+            // the moduli have at most 60 bits, so the sum of two products does not overflow
+            const uint64_t qt        = cv1[0].GetElementAtIndex(t).GetModulus().ConvertToInt<uint64_t>();
+            const DoubleNativeInt mu = (BarrettBase128Bit / BigInteger(qt)).ConvertToInt<DoubleNativeInt>();
+
+            const NativeInteger* a0 = &cv1[0].GetElementAtIndex(t)[0];
+            const NativeInteger* a1 = &cv1[1].GetElementAtIndex(t)[0];
+            const NativeInteger* b0 = &cv2[0].GetElementAtIndex(t)[0];
+            const NativeInteger* b1 = &cv2[1].GetElementAtIndex(t)[0];
+            NativeInteger* c0       = &cvMult[0].GetAllElements()[t][0];
+            NativeInteger* c1       = &cvMult[1].GetAllElements()[t][0];
+            NativeInteger* c2       = &cvMult[2].GetAllElements()[t][0];
+
+            for (uint32_t ri = 0; ri < ringDim; ++ri) {
+                const uint64_t x0 = a0[ri].ConvertToInt<uint64_t>();
+                const uint64_t x1 = a1[ri].ConvertToInt<uint64_t>();
+                const uint64_t y0 = b0[ri].ConvertToInt<uint64_t>();
+                const uint64_t y1 = b1[ri].ConvertToInt<uint64_t>();
+
+                c0[ri] = NativeInteger(BarrettUint128ModUint64(Mul128(x0, y0), qt, mu));
+                c1[ri] = NativeInteger(BarrettUint128ModUint64(Mul128(x0, y1) + Mul128(x1, y0), qt, mu));
+                c2[ri] = NativeInteger(BarrettUint128ModUint64(Mul128(x1, y1), qt, mu));
+            }
+        }
+        return cvMult;
+    }
+#endif
+
+    std::vector<DCRTPoly> cvMult(cvMultSize);
+    std::vector<bool> isFirstAdd(cvMultSize, true);
+    for (size_t i = 0; i < cv1Size; i++) {
+        for (size_t j = 0; j < cv2Size; j++) {
+            if (isFirstAdd[i + j] == true) {
+                cvMult[i + j]     = cv1[i] * cv2[j];
+                isFirstAdd[i + j] = false;
+            }
+            else {
+                cvMult[i + j] += cv1[i] * cv2[j];
+            }
+        }
+    }
+    return cvMult;
+}
+
 void LeveledSHEBFVRNS::EvalAddInPlace(Ciphertext<DCRTPoly>& ciphertext, ConstPlaintext plaintext) const {
     const auto cryptoParams   = std::dynamic_pointer_cast<CryptoParametersBFVRNS>(ciphertext->GetCryptoParameters());
     std::vector<DCRTPoly>& cv = ciphertext->GetElements();
@@ -323,18 +390,7 @@ Ciphertext<DCRTPoly> LeveledSHEBFVRNS::EvalMult(ConstCiphertext<DCRTPoly> cipher
         }
     }
 #else
-    std::vector<bool> isFirstAdd(cvMultSize, true);
-    for (size_t i = 0; i < cv1Size; i++) {
-        for (size_t j = 0; j < cv2Size; j++) {
-            if (isFirstAdd[i + j] == true) {
-                cvMult[i + j]     = cv1[i] * cv2[j];
-                isFirstAdd[i + j] = false;
-            }
-            else {
-                cvMult[i + j] += cv1[i] * cv2[j];
-            }
-        }
-    }
+    cvMult = TensorProduct(cv1, cv2);
 #endif
 
     if (cryptoParams->GetMultiplicationTechnique() == HPS) {
@@ -793,10 +849,10 @@ Ciphertext<DCRTPoly> LeveledSHEBFVRNS::EvalFastRotation(ConstCiphertext<DCRTPoly
 
     usint autoIndex = FindAutomorphismIndex(index, m);
 
-    auto evalKeyMap = cc->GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
+    auto evalKeyMap = cc->GetEvalAutomorphismKeyMapPtr(ciphertext->GetKeyTag(), {autoIndex});
     // verify if the key autoIndex exists in the evalKeyMap
-    auto evalKeyIterator = evalKeyMap.find(autoIndex);
-    if (evalKeyIterator == evalKeyMap.end()) {
+    auto evalKeyIterator = evalKeyMap->find(autoIndex);
+    if (evalKeyIterator == evalKeyMap->end()) {
         OPENFHE_THROW("EvalKey for index [" + std::to_string(autoIndex) + "] is not found.");
     }
     auto evalKey = evalKeyIterator->second;
@@ -820,6 +876,13 @@ Ciphertext<DCRTPoly> LeveledSHEBFVRNS::EvalFastRotation(ConstCiphertext<DCRTPoly
                 elemParams.PopLastParam();
             }
         }
+        else if (cryptoParams->GetKeySwitchTechnique() == KLSS) {
+            // the KLSS digits are extended by the auxiliary basis R instead of P
+            size_t sizeR = cryptoParams->GetParamsAux()->GetParams().size();
+            for (size_t i = 0; i < sizeR; ++i) {
+                elemParams.PopLastParam();
+            }
+        }
     }
 
     std::shared_ptr<std::vector<DCRTPoly>> ba =
@@ -69,6 +69,9 @@ bool ParameterGenerationBFVRNS::ParamsGenBFVRNS(std::shared_ptr<CryptoParameters
         OPENFHE_THROW(s.str());
     }
 
+    if (cryptoParamsBFVRNS->GetSecretKeyDist() == SPARSE_ENCAPSULATED)
+        OPENFHE_THROW("SPARSE_ENCAPSULATED is supported for CKKSRNS only.");
+
     double sigma           = cryptoParamsBFVRNS->GetDistributionParameter();
     double alpha           = cryptoParamsBFVRNS->GetAssuranceMeasure();
     double p               = static_cast<double>(cryptoParamsBFVRNS->GetPlaintextModulus());
@@ -121,9 +124,9 @@ bool ParameterGenerationBFVRNS::ParamsGenBFVRNS(std::shared_ptr<CryptoParameters
     };
 
     auto noiseKS = [&](uint32_t n, double logqPrev, double w, bool mult) -> double {
-        if ((ksTech == HYBRID) && (!mult))
+        if ((ksTech == HYBRID || ksTech == KLSS) && (!mult))
             return (delta(n) * Berr + delta(n) * Bkey + 1.0) / 2;
-        else if ((ksTech == HYBRID) && (mult))
+        else if ((ksTech == HYBRID || ksTech == KLSS) && (mult))
             // conservative estimate for HYBRID to avoid the use of method of
             // iterative approximations; we do not know the number
             // of moduli at this point and use an upper bound for numDigits
@@ -319,7 +319,7 @@ void ParameterGenerationBGVRNS::InitializeFloodingDgg(std::shared_ptr<CryptoPara
                 OPENFHE_THROW("Relinwindow value cannot be 0 for BV keyswitching");
             }
         }
-        else if (ksTech == HYBRID) {
+        else if (ksTech == HYBRID || ksTech == KLSS) {
             if (r == 0) {
                 double numTowersPerDigit = cryptoParamsBGVRNS->GetNumPerPartQ();
                 int numDigits            = cryptoParamsBGVRNS->GetNumPartQ();
@@ -365,6 +365,12 @@ bool ParameterGenerationBGVRNS::ParamsGenBGVRNS(std::shared_ptr<CryptoParameters
         OPENFHE_THROW(s.str());
     }
 
+    if (scalTech == COMPOSITESCALINGAUTO)
+        OPENFHE_THROW("COMPOSITESCALINGAUTO is supported for CKKSRNS only.");
+
+    if (cryptoParamsBGVRNS->GetSecretKeyDist() == SPARSE_ENCAPSULATED)
+        OPENFHE_THROW("SPARSE_ENCAPSULATED is supported for CKKSRNS only.");
+
     bool dcrtBitsSet = (dcrtBits == 0) ? false : true;
 
     // Select the size of moduli according to the plaintext modulus
@@ -385,7 +391,7 @@ bool ParameterGenerationBGVRNS::ParamsGenBGVRNS(std::shared_ptr<CryptoParameters
     // Estimate ciphertext modulus Q bound (in case of GHS/HYBRID P*Q)
     usint extraModSize = (scalTech == FLEXIBLEAUTOEXT) ? DCRT_MODULUS::DEFAULT_EXTRA_MOD_SIZE : 0;
     uint32_t qBound    = firstModSize + (numPrimes - 1) * dcrtBits + extraModSize;
-    if (ksTech == HYBRID)
+    if (ksTech == HYBRID || ksTech == KLSS)
         qBound += ceil(ceil(static_cast<double>(qBound) / numPartQ) / auxBits) * auxBits;
 
     // Note this code is not executed if multihopQBound == 0 so it is backwards
@@ -416,7 +422,7 @@ bool ParameterGenerationBGVRNS::ParamsGenBGVRNS(std::shared_ptr<CryptoParameters
             auto moduliInfo = computeModuli(cryptoParams, n, evalAddCount, keySwitchCount, auxBits, numPrimes);
             moduliQ         = std::get<0>(moduliInfo);
             newQBound       = std::get<1>(moduliInfo);
-            if (ksTech == HYBRID)
+            if (ksTech == HYBRID || ksTech == KLSS)
                 newQBound += ceil(ceil(static_cast<double>(newQBound) / numPartQ) / auxBits) * auxBits;
         }
         cyclOrder    = 2 * n;
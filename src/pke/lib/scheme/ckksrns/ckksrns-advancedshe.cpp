@@ -36,18 +36,126 @@ CKKS implementation. See https://eprint.iacr.org/2020/1118 for details.
 #define PROFILE
 
 #include "cryptocontext.h"
+#include "math/chebyshev.h"
 #include "scheme/ckksrns/ckksrns-cryptoparameters.h"
 #include "scheme/ckksrns/ckksrns-advancedshe.h"
+#include "scheme/ckksrns/ckksrns-leveledshe.h"
 #include "scheme/ckksrns/ckksrns-utils.h"
 
 #include "schemebase/base-scheme.h"
 
+#include "utils/utilities.h"
+#include "utils/utilities-int.h"
+
+#include <algorithm>
+#include <cmath>
+
 namespace lbcrypto {
 
+//------------------------------------------------------------------------------
+// EVAL ADD MANY
+//------------------------------------------------------------------------------
+
+Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalAddMany(const std::vector<Ciphertext<DCRTPoly>>& ciphertextVec) const {
+    if (ciphertextVec.size() < 1)
+        OPENFHE_THROW("Input ciphertext vector size should be 1 or more");
+
+    const auto cryptoParams =
+        std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertextVec[0]->GetCryptoParameters());
+    if (cryptoParams->GetScalingTechnique() == FIXEDMANUAL)
+        return AdvancedSHERNS::EvalAddMany(ciphertextVec);
+
+    auto algo = ciphertextVec[0]->GetCryptoContext()->GetScheme();
+
+    // ciphertexts of the same level and noise scale degree are added without any adjustment
+    std::vector<Ciphertext<DCRTPoly>> sums;
+    for (const auto& ciphertext : ciphertextVec) {
+        auto it = std::find_if(sums.begin(), sums.end(), [&ciphertext](const Ciphertext<DCRTPoly>& sum) {
+            return sum->GetLevel() == ciphertext->GetLevel() &&
+                   sum->GetNoiseScaleDeg() == ciphertext->GetNoiseScaleDeg();
+        });
+        if (it == sums.end())
+            sums.push_back(ciphertext->Clone());
+        else
+            algo->EvalAddInPlace(*it, ciphertext);
+    }
+
+    // the partial sum with the highest level (and a pending rescale at that level) is never adjusted, so every
+    // other partial sum is adjusted exactly once when it is added to it
+    auto target = std::max_element(sums.begin(), sums.end(),
+                                   [](const Ciphertext<DCRTPoly>& a, const Ciphertext<DCRTPoly>& b) {
+                                       return (a->GetLevel() < b->GetLevel()) ||
+                                              ((a->GetLevel() == b->GetLevel()) &&
+                                               (a->GetNoiseScaleDeg() < b->GetNoiseScaleDeg()));
+                                   });
+    Ciphertext<DCRTPoly> result = *target;
+    for (auto it = sums.begin(); it != sums.end(); ++it) {
+        if (it != target)
+            algo->EvalAddMutableInPlace(result, *it);
+    }
+    return result;
+}
+
+Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalAddManyInPlace(std::vector<Ciphertext<DCRTPoly>>& ciphertextVec) const {
+    if (ciphertextVec.size() < 1)
+        OPENFHE_THROW("Input ciphertext vector size should be 1 or more");
+
+    const auto cryptoParams =
+        std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertextVec[0]->GetCryptoParameters());
+    if (cryptoParams->GetScalingTechnique() == FIXEDMANUAL)
+        return AdvancedSHERNS::EvalAddManyInPlace(ciphertextVec);
+
+    // the partial sums are kept apart from the input, so there is nothing to gain from overwriting it
+    return EvalAddMany(ciphertextVec);
+}
+
 //------------------------------------------------------------------------------
 // LINEAR WEIGHTED SUM
 //------------------------------------------------------------------------------
 
+#if defined(HAVE_INT128) && NATIVEINT == 64
+namespace {
+// Computes sum_j factors[j][i] * polys[j] for every tower i in a single pass over each input tower. The products are
+// accumulated in 128-bit integers and reduced once per coefficient (Barrett), or once per block of terms when
+// the number of terms could overflow the accumulators.
+DCRTPoly EvalWeightedSumCore(const std::vector<const DCRTPoly*>& polys,
+                             const std::vector<std::vector<DCRTPoly::Integer>>& factors) {
+    const DCRTPoly& first = *polys[0];
+    DCRTPoly result(first.GetParams(), first.GetFormat(), true);
+
+    const uint32_t numTowers = first.GetNumOfElements();
+    const uint32_t ringDim   = first.GetRingDimension();
+    const size_t numTerms    = polys.size();
+    const auto BarrettBase128Bit(BigInteger(1).LShiftEq(128));
+
+    #pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(numTowers))
+    for (uint32_t i = 0; i < numTowers; ++i) {
+        auto& out                = result.GetAllElements()[i];
+        const uint64_t qi        = out.GetModulus().ConvertToInt<uint64_t>();
+        const DoubleNativeInt mu = (BarrettBase128Bit / BigInteger(qi)).ConvertToInt<DoubleNativeInt>();
+        // every product is below 2^(2 * logqi); keep the sum of a block and the carried residue below 2^128
+        const uint32_t logqi = out.GetModulus().GetMSB();
+        const size_t block   = size_t(1) << std::min<uint32_t>(127 - std::min<uint32_t>(2 * logqi, 127), 30);
+
+        std::vector<DoubleNativeInt> sum(ringDim, 0);
+        for (size_t j = 0; j < numTerms; ++j) {
+            const auto& in     = polys[j]->GetAllElements()[i];
+            const uint64_t wji = factors[j][i].ConvertToInt<uint64_t>();
+            for (uint32_t ri = 0; ri < ringDim; ++ri)
+                sum[ri] += Mul128(in[ri].ConvertToInt<uint64_t>(), wji);
+            if ((j + 1) % block == 0) {
+                for (uint32_t ri = 0; ri < ringDim; ++ri)
+                    sum[ri] = BarrettUint128ModUint64(sum[ri], qi, mu);
+            }
+        }
+        for (uint32_t ri = 0; ri < ringDim; ++ri)
+            out[ri] = NativeInteger(BarrettUint128ModUint64(sum[ri], qi, mu));
+    }
+    return result;
+}
+}  // namespace
+#endif
+
 Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalLinearWSum(std::vector<ConstCiphertext<DCRTPoly>>& ciphertexts,
                                                         const std::vector<double>& constants) const {
     std::vector<Ciphertext<DCRTPoly>> cts(ciphertexts.size());
@@ -94,6 +202,48 @@ Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalLinearWSumMutable(std::vector<Ciphe
         }
     }
 
+#if defined(HAVE_INT128) && NATIVEINT == 64
+    // after the alignment all the terms normally have the same shape; then the sum is computed by one fused
+    // kernel instead of a scalar product and an addition (with a temporary) per term
+    const size_t numTerms = ciphertexts.size();
+    const auto& first     = ciphertexts[0];
+    bool sameShape        = constants.size() >= numTerms;
+    for (size_t j = 1; j < numTerms; ++j) {
+        const auto& cv = ciphertexts[j]->GetElements();
+        if (cv.size() != first->GetElements().size() ||
+            cv[0].GetNumOfElements() != first->GetElements()[0].GetNumOfElements() ||
+            ciphertexts[j]->GetNoiseScaleDeg() != first->GetNoiseScaleDeg())
+            sameShape = false;
+    }
+
+    if (sameShape) {
+        // the integer weights are computed exactly as in EvalMult(ciphertext, double)
+        LeveledSHECKKSRNS leveledSHE;
+        std::vector<std::vector<DCRTPoly::Integer>> factors(numTerms);
+        for (size_t j = 0; j < numTerms; ++j)
+            factors[j] = leveledSHE.GetElementForEvalMult(ciphertexts[j], constants[j]);
+
+        std::vector<DCRTPoly> elements;
+        elements.reserve(first->GetElements().size());
+        std::vector<const DCRTPoly*> polys(numTerms);
+        for (size_t k = 0; k < first->GetElements().size(); ++k) {
+            for (size_t j = 0; j < numTerms; ++j)
+                polys[j] = &ciphertexts[j]->GetElements()[k];
+            elements.push_back(EvalWeightedSumCore(polys, factors));
+        }
+
+        Ciphertext<DCRTPoly> weightedSum = first->CloneZero();
+        weightedSum->SetElements(std::move(elements));
+        weightedSum->SetNoiseScaleDeg(first->GetNoiseScaleDeg() + 1);
+        double scFactor = cryptoParams->GetScalingFactorReal(first->GetLevel());
+        weightedSum->SetScalingFactor(first->GetScalingFactor() * scFactor);
+
+        cc->ModReduceInPlace(weightedSum);
+
+        return weightedSum;
+    }
+#endif
+
     Ciphertext<DCRTPoly> weightedSum = cc->EvalMult(ciphertexts[0], constants[0]);
 
     Ciphertext<DCRTPoly> tmp;
@@ -894,19 +1044,53 @@ Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::InnerEvalChebyshevPS(ConstCiphertext<DC
 Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalChebyshevSeriesPS(ConstCiphertext<DCRTPoly> x,
                                                                const std::vector<double>& coefficients, double a,
                                                                double b) const {
-    uint32_t n = Degree(coefficients);
+    auto basis = ComputeChebyshevPowerBasis(x, Degree(coefficients), a, b);
+    return EvalChebyshevSeriesPSInternal(coefficients, basis);
+}
 
-    std::vector<double> f2 = coefficients;
+std::shared_ptr<const ChebyshevPowerBasis<DCRTPoly>> AdvancedSHECKKSRNS::EvalChebyshevPowerBasis(
+    ConstCiphertext<DCRTPoly> x, uint32_t degree, double a, double b) const {
+    return std::make_shared<const ChebyshevPowerBasis<DCRTPoly>>(ComputeChebyshevPowerBasis(x, degree, a, b));
+}
 
-    // Make sure the coefficients do not have the zero dominant terms
-    if (coefficients[coefficients.size() - 1] == 0)
-        f2.resize(n + 1);
+Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalChebyshevSeriesWithBasis(const ChebyshevPowerBasis<DCRTPoly>& basis,
+                                                                      const std::vector<double>& coefficients) const {
+    if (basis.T.empty())
+        OPENFHE_THROW("The Chebyshev power basis is empty");
 
+    uint32_t n                 = Degree(coefficients);
     std::vector<uint32_t> degs = ComputeDegreesPS(n);
+    if (degs[0] != basis.k || degs[1] != basis.m) {
+        OPENFHE_THROW("The coefficients of degree [" + std::to_string(n) +
+                      "] cannot be evaluated with the power basis computed for degree [" +
+                      std::to_string(basis.degree) + "]: their Paterson-Stockmeyer degrees do not match");
+    }
+
+    // the evaluation modifies the baby steps in place, so it works on copies of them. The giant steps are
+    // only read, except for T2[0] that is the same ciphertext as T[k-1]
+    ChebyshevPowerBasis<DCRTPoly> copy;
+    copy.degree = basis.degree;
+    copy.k      = basis.k;
+    copy.m      = basis.m;
+    copy.T.reserve(basis.T.size());
+    for (const auto& t : basis.T)
+        copy.T.push_back(t->Clone());
+    copy.T2.reserve(basis.T2.size());
+    for (const auto& t : basis.T2)
+        copy.T2.push_back((t == basis.T.back()) ? copy.T.back() : t);
+    copy.T2km1 = basis.T2km1;
+
+    return EvalChebyshevSeriesPSInternal(coefficients, copy);
+}
+
+ChebyshevPowerBasis<DCRTPoly> AdvancedSHECKKSRNS::ComputeChebyshevPowerBasis(ConstCiphertext<DCRTPoly> x,
+                                                                             uint32_t degree, double a,
+                                                                             double b) const {
+    std::vector<uint32_t> degs = ComputeDegreesPS(degree);
     uint32_t k                 = degs[0];
     uint32_t m                 = degs[1];
 
-    //  std::cerr << "\n Degree: n = " << n << ", k = " << k << ", m = " << m << endl;
+    //  std::cerr << "\n Degree: n = " << degree << ", k = " << k << ", m = " << m << endl;
 
     // computes linear transformation y = -1 + 2 (x-a)/(b-a)
     // consumes one level when a <> -1 && b <> 1
@@ -931,36 +1115,64 @@ Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalChebyshevSeriesPS(ConstCiphertext<D
 
     // Computes Chebyshev polynomials up to degree k
     // for y: T_1(y) = y, T_2(y), ... , T_k(y)
-    // uses binary tree multiplication
-    for (uint32_t i = 2; i <= k; i++) {
-        // if i is a power of two
-        if (!(i & (i - 1))) {
-            // compute T_{2i}(y) = 2*T_i(y)^2 - 1
-            auto square = cc->EvalSquare(T[i / 2 - 1]);
-            T[i - 1]    = cc->EvalAdd(square, square);
-            cc->ModReduceInPlace(T[i - 1]);
-            cc->EvalAddInPlace(T[i - 1], -1.0);
-        }
-        else {
-            // non-power of 2
-            if (i % 2 == 1) {
-                // if i is odd
-                // compute T_{2i+1}(y) = 2*T_i(y)*T_{i+1}(y) - y
-                auto prod = cc->EvalMult(T[i / 2 - 1], T[i / 2]);
-                T[i - 1]  = cc->EvalAdd(prod, prod);
-
-                cc->ModReduceInPlace(T[i - 1]);
-                cc->EvalSubInPlace(T[i - 1], y);
+    // uses binary tree multiplication. T_i only depends on T_{i/2} and T_{i/2+1}, so the polynomials of
+    // degrees 2^j+1, ..., 2^{j+1} are independent of each other. A wave is computed in parallel only if it
+    // has at least as many polynomials as there are threads: nested parallelism is off, so a parallel wave
+    // runs the per-tower loops of EvalMult and ModReduce serially, and the small first waves are faster
+    // with all threads working on the towers.
+    for (uint32_t first = 2; first <= k; first = 2 * first - 1) {
+        const uint32_t last = std::min(2 * (first - 1), k);
+
+        std::string exceptionMessage;
+        bool hadEx = false;
+#pragma omp parallel for if (static_cast<int>(last - first + 1) >= omp_get_max_threads()) \
+    num_threads(OpenFHEParallelControls.GetThreadLimit(last - first + 1))
+        for (uint32_t i = first; i <= last; i++) {
+            try {
+                // if i is a power of two
+                if (!(i & (i - 1))) {
+                    // compute T_{2i}(y) = 2*T_i(y)^2 - 1
+                    auto square = cc->EvalSquare(T[i / 2 - 1]);
+                    auto t      = cc->EvalAdd(square, square);
+                    cc->ModReduceInPlace(t);
+                    cc->EvalAddInPlace(t, -1.0);
+                    T[i - 1] = t;
+                }
+                else {
+                    // non-power of 2
+                    if (i % 2 == 1) {
+                        // if i is odd
+                        // compute T_{2i+1}(y) = 2*T_i(y)*T_{i+1}(y) - y
+                        auto prod = cc->EvalMult(T[i / 2 - 1], T[i / 2]);
+                        auto t    = cc->EvalAdd(prod, prod);
+
+                        cc->ModReduceInPlace(t);
+                        cc->EvalSubInPlace(t, y);
+                        T[i - 1] = t;
+                    }
+                    else {
+                        // i is even but not power of 2
+                        // compute T_{2i}(y) = 2*T_i(y)^2 - 1
+                        auto square = cc->EvalSquare(T[i / 2 - 1]);
+                        auto t      = cc->EvalAdd(square, square);
+                        cc->ModReduceInPlace(t);
+                        cc->EvalAddInPlace(t, -1.0);
+                        T[i - 1] = t;
+                    }
+                }
             }
-            else {
-                // i is even but not power of 2
-                // compute T_{2i}(y) = 2*T_i(y)^2 - 1
-                auto square = cc->EvalSquare(T[i / 2 - 1]);
-                T[i - 1]    = cc->EvalAdd(square, square);
-                cc->ModReduceInPlace(T[i - 1]);
-                cc->EvalAddInPlace(T[i - 1], -1.0);
+            catch (std::exception& e) {
+#pragma omp critical
+                {
+                    if (!hadEx) {
+                        exceptionMessage = e.what();
+                        hadEx            = true;
+                    }
+                }
             }
         }
+        if (hadEx)
+            OPENFHE_THROW(exceptionMessage);
     }
 
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(T[k - 1]->GetCryptoParameters());
@@ -1000,6 +1212,33 @@ Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalChebyshevSeriesPS(ConstCiphertext<D
         cc->EvalSubInPlace(T2km1, T2.front());
     }
 
+    ChebyshevPowerBasis<DCRTPoly> basis;
+    basis.degree = degree;
+    basis.k      = k;
+    basis.m      = m;
+    basis.T      = std::move(T);
+    basis.T2     = std::move(T2);
+    basis.T2km1  = T2km1;
+    return basis;
+}
+
+Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalChebyshevSeriesPSInternal(const std::vector<double>& coefficients,
+                                                                       ChebyshevPowerBasis<DCRTPoly>& basis) const {
+    uint32_t n = Degree(coefficients);
+
+    std::vector<double> f2 = coefficients;
+
+    // Make sure the coefficients do not have the zero dominant terms
+    if (coefficients[coefficients.size() - 1] == 0)
+        f2.resize(n + 1);
+
+    uint32_t k  = basis.k;
+    uint32_t m  = basis.m;
+    auto& T     = basis.T;
+    auto& T2    = basis.T2;
+    auto& T2km1 = basis.T2km1;
+    auto cc     = T.front()->GetCryptoContext();
+
     // We also need to reduce the number of levels of T[k-1] and of T2[0] by another level.
     //  cc->LevelReduceInPlace(T[k-1], nullptr);
     //  cc->LevelReduceInPlace(T2.front(), nullptr);
@@ -1075,7 +1314,7 @@ Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalChebyshevSeriesPS(ConstCiphertext<D
     Ciphertext<DCRTPoly> qu;
 
     if (Degree(divqr->q) > k) {
-        qu = InnerEvalChebyshevPS(x, divqr->q, k, m - 1, T, T2);
+        qu = InnerEvalChebyshevPS(T.front(), divqr->q, k, m - 1, T, T2);
     }
     else {
         // dq = k from construction
@@ -1113,7 +1352,7 @@ Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalChebyshevSeriesPS(ConstCiphertext<D
     Ciphertext<DCRTPoly> su;
 
     if (Degree(s2) > k) {
-        su = InnerEvalChebyshevPS(x, s2, k, m - 1, T, T2);
+        su = InnerEvalChebyshevPS(T.front(), s2, k, m - 1, T, T2);
     }
     else {
         // ds = k from construction
@@ -1165,6 +1404,228 @@ Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalChebyshevSeriesPS(ConstCiphertext<D
     return result;
 }
 
+//------------------------------------------------------------------------------
+// EVAL COMPARISON
+//------------------------------------------------------------------------------
+
+namespace {
+
+// Composite sign approximation of Cheon, Kim, Kim, Lee and Lee, "Efficient Homomorphic Comparison Methods with
+// Optimal Complexity", ASIACRYPT 2020: g quickly widens the gap around zero, f then pushes the values to +-1
+double CompareStepG(double x) {
+    double x2 = x * x;
+    return x * (4589 + x2 * (-16577 + x2 * (25614 - 12860 * x2))) / 1024;
+}
+
+double CompareStepF(double x) {
+    double x2 = x * x;
+    return x * (35 + x2 * (-35 + x2 * (21 - 5 * x2))) / 16;
+}
+
+// both steps have degree 7; two consecutive steps are merged into one series of degree 49
+constexpr uint32_t COMPARE_STEP_DEGREE = 7;
+constexpr uint32_t COMPARE_PAIR_DEGREE = 49;
+constexpr uint32_t COMPARE_MAX_STEPS   = 64;
+
+// minimum of the (odd) step over [lo, 1], i.e., the new lower bound of |x|
+double CompareStepMin(double (*step)(double), double lo) {
+    constexpr uint32_t samples = 1024;
+    double result              = step(lo);
+    for (uint32_t i = 1; i <= samples; ++i)
+        result = std::min(result, step(lo + (1 - lo) * i / samples));
+    return result;
+}
+
+// the sequence of steps (false for g, true for f) taking every gap <= |x| <= 1 to within 2^-precision of 1
+std::vector<bool> GetCompareSteps(double gap, uint32_t precision) {
+    if (!(gap > 0 && gap < 1))
+        OPENFHE_THROW("The gap must be in the interval (0, 1)");
+    if (precision == 0 || precision > 50)
+        OPENFHE_THROW("The precision must be between 1 and 50 bits");
+
+    std::vector<bool> steps;
+    double lo = gap;
+    while (lo < 0.25 && steps.size() < COMPARE_MAX_STEPS) {
+        lo = CompareStepMin(CompareStepG, lo);
+        steps.push_back(false);
+    }
+    double err = std::ldexp(1.0, -static_cast<int32_t>(precision));
+    while (1 - lo > err && steps.size() < COMPARE_MAX_STEPS) {
+        lo = CompareStepMin(CompareStepF, lo);
+        steps.push_back(true);
+    }
+    if (steps.size() == COMPARE_MAX_STEPS)
+        OPENFHE_THROW("The gap is too small for the sign approximation");
+    return steps;
+}
+
+// evaluates scale * sign(x) + shift; the first series also maps [-bound, bound] to [-1, 1]
+Ciphertext<DCRTPoly> EvalCompositeSign(ConstCiphertext<DCRTPoly> ciphertext, double bound, double gap,
+                                       uint32_t precision, double scale, double shift) {
+    if (!(bound > 0))
+        OPENFHE_THROW("The bound must be positive");
+    auto steps = GetCompareSteps(gap, precision);
+    auto cc    = ciphertext->GetCryptoContext();
+
+    ConstCiphertext<DCRTPoly> input = ciphertext;
+    Ciphertext<DCRTPoly> result;
+    for (size_t i = 0; i < steps.size(); i += 2) {
+        size_t last = std::min(i + 2, steps.size());
+        double a    = (i == 0) ? -bound : -1.0;
+        auto func   = [&](double x) -> double {
+            x = x / -a;
+            for (size_t j = i; j < last; ++j)
+                x = steps[j] ? CompareStepF(x) : CompareStepG(x);
+            return (last == steps.size()) ? scale * x + shift : x;
+        };
+        uint32_t degree = (last - i == 2) ? COMPARE_PAIR_DEGREE : COMPARE_STEP_DEGREE;
+        result          = cc->EvalChebyshevSeries(input, EvalChebyshevCoefficients(func, a, -a, degree), a, -a);
+        input           = result;
+    }
+    return result;
+}
+
+// returns (x + y) / 2 + w * (x - y) * sign(x - y) / 2 with w = 1 for the maximum and w = -1 for the minimum;
+// non-empty weights set w per slot
+Ciphertext<DCRTPoly> EvalCompareExchange(ConstCiphertext<DCRTPoly> x, ConstCiphertext<DCRTPoly> y, double bound,
+                                         double gap, uint32_t precision, bool max,
+                                         const std::vector<double>& weights = {}) {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(x->GetCryptoParameters());
+    if (cryptoParams->GetScalingTechnique() == FIXEDMANUAL)
+        OPENFHE_THROW("The maximum and minimum require an automatic scaling technique");
+
+    auto cc       = x->GetCryptoContext();
+    auto diff     = cc->EvalSub(x, y);
+    auto sign     = EvalCompositeSign(diff, bound, gap, precision, 0.5, 0.0);
+    auto weighted = max ? diff : cc->EvalNegate(diff);
+    if (!weights.empty()) {
+        auto weightsPtxt = cc->MakeCKKSPackedPlaintext(weights, 1, diff->GetLevel(), nullptr, x->GetSlots());
+        weighted         = cc->EvalMult(diff, weightsPtxt);
+    }
+    auto result = cc->EvalMult(weighted, sign);
+    cc->EvalAddInPlace(result, cc->EvalMult(cc->EvalAdd(x, y), 0.5));
+    return result;
+}
+
+void ValidateCompareSlots(uint32_t numValues, uint32_t slots) {
+    if (numValues < 2 || !IsPowerOfTwo(numValues))
+        OPENFHE_THROW("The number of values must be a power of two not smaller than 2");
+    if (numValues > slots)
+        OPENFHE_THROW("The number of values [" + std::to_string(numValues) + "] exceeds the number of slots [" +
+                      std::to_string(slots) + "]");
+}
+
+// tournament of log2(numValues) rounds; in the round of distance j, slot i < j meets slot i + j
+Ciphertext<DCRTPoly> EvalMaxMinSlots(ConstCiphertext<DCRTPoly> ciphertext, uint32_t numValues, double bound,
+                                     double gap, uint32_t precision, bool max) {
+    uint32_t slots = ciphertext->GetSlots();
+    ValidateCompareSlots(numValues, slots);
+    auto cc = ciphertext->GetCryptoContext();
+
+    Ciphertext<DCRTPoly> result = ciphertext->Clone();
+    for (uint32_t j = numValues / 2; j > 0; j >>= 1) {
+        std::vector<double> mask(slots, 0.0);
+        std::fill(mask.begin(), mask.begin() + j, 1.0);
+        auto maskPtxt = cc->MakeCKKSPackedPlaintext(mask, 1, result->GetLevel(), nullptr, slots);
+
+        // the slots outside the window are compared with themselves, so their difference is zero
+        auto partner = cc->EvalAdd(result, cc->EvalMult(cc->EvalSub(cc->EvalRotate(result, j), result), maskPtxt));
+        result       = EvalCompareExchange(result, partner, bound, gap, precision, max);
+    }
+    return result;
+}
+
+}  // namespace
+
+uint32_t AdvancedSHECKKSRNS::GetEvalSignDepth(double gap, uint32_t precision) {
+    auto steps     = GetCompareSteps(gap, precision);
+    uint32_t depth = 0;
+    for (size_t i = 0; i < steps.size(); i += 2) {
+        uint32_t degree = (i + 1 < steps.size()) ? COMPARE_PAIR_DEGREE : COMPARE_STEP_DEGREE;
+        depth += GetMultiplicativeDepthByCoeffVector(std::vector<double>(degree + 1, 1.0), i != 0);
+    }
+    return depth;
+}
+
+Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalSign(ConstCiphertext<DCRTPoly> ciphertext, double bound, double gap,
+                                                  uint32_t precision) const {
+    return EvalCompositeSign(ciphertext, bound, gap, precision, 1.0, 0.0);
+}
+
+Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalCompare(ConstCiphertext<DCRTPoly> ciphertext1,
+                                                     ConstCiphertext<DCRTPoly> ciphertext2, double bound, double gap,
+                                                     uint32_t precision) const {
+    auto diff = ciphertext1->GetCryptoContext()->EvalSub(ciphertext1, ciphertext2);
+    return EvalCompositeSign(diff, bound, gap, precision, 0.5, 0.5);
+}
+
+Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalMax(ConstCiphertext<DCRTPoly> ciphertext1,
+                                                 ConstCiphertext<DCRTPoly> ciphertext2, double bound, double gap,
+                                                 uint32_t precision) const {
+    return EvalCompareExchange(ciphertext1, ciphertext2, bound, gap, precision, true);
+}
+
+Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalMin(ConstCiphertext<DCRTPoly> ciphertext1,
+                                                 ConstCiphertext<DCRTPoly> ciphertext2, double bound, double gap,
+                                                 uint32_t precision) const {
+    return EvalCompareExchange(ciphertext1, ciphertext2, bound, gap, precision, false);
+}
+
+std::shared_ptr<std::map<usint, EvalKey<DCRTPoly>>> AdvancedSHECKKSRNS::EvalCompareSlotsKeyGen(
+    const PrivateKey<DCRTPoly> privateKey, uint32_t numValues) const {
+    auto cc = privateKey->GetCryptoContext();
+    ValidateCompareSlots(numValues, cc->GetRingDimension() / 2);
+
+    std::vector<int32_t> indices;
+    for (int32_t j = 1; j < static_cast<int32_t>(numValues); j <<= 1) {
+        indices.push_back(j);
+        indices.push_back(-j);
+    }
+    return cc->GetScheme()->EvalAtIndexKeyGen(nullptr, privateKey, indices);
+}
+
+Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalMaxSlots(ConstCiphertext<DCRTPoly> ciphertext, uint32_t numValues,
+                                                      double bound, double gap, uint32_t precision) const {
+    return EvalMaxMinSlots(ciphertext, numValues, bound, gap, precision, true);
+}
+
+Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalMinSlots(ConstCiphertext<DCRTPoly> ciphertext, uint32_t numValues,
+                                                      double bound, double gap, uint32_t precision) const {
+    return EvalMaxMinSlots(ciphertext, numValues, bound, gap, precision, false);
+}
+
+Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalSortSlots(ConstCiphertext<DCRTPoly> ciphertext, uint32_t numValues,
+                                                       double bound, double gap, uint32_t precision) const {
+    uint32_t slots = ciphertext->GetSlots();
+    ValidateCompareSlots(numValues, slots);
+    auto cc = ciphertext->GetCryptoContext();
+
+    Ciphertext<DCRTPoly> result = ciphertext->Clone();
+    for (uint32_t k = 2; k <= numValues; k <<= 1) {
+        for (uint32_t j = k / 2; j > 0; j >>= 1) {
+            // slot i is paired with slot i ^ j; blocks of size k alternate between ascending and descending order
+            std::vector<double> maskLo(slots, 0.0);
+            std::vector<double> maskHi(slots, 0.0);
+            std::vector<double> weights(slots, 0.0);
+            for (uint32_t i = 0; i < numValues; ++i) {
+                bool upper = (i & j) != 0;
+                (upper ? maskHi : maskLo)[i] = 1.0;
+                weights[i]                   = (upper == ((i & k) == 0)) ? 1.0 : -1.0;
+            }
+            uint32_t level  = result->GetLevel();
+            auto maskLoPtxt = cc->MakeCKKSPackedPlaintext(maskLo, 1, level, nullptr, slots);
+            auto maskHiPtxt = cc->MakeCKKSPackedPlaintext(maskHi, 1, level, nullptr, slots);
+            auto toLo       = cc->EvalSub(cc->EvalRotate(result, j), result);
+            auto toHi       = cc->EvalSub(cc->EvalRotate(result, -static_cast<int32_t>(j)), result);
+            auto partner    = cc->EvalAdd(result, cc->EvalMult(toLo, maskLoPtxt));
+            cc->EvalAddInPlace(partner, cc->EvalMult(toHi, maskHiPtxt));
+
+            result = EvalCompareExchange(result, partner, bound, gap, precision, true, weights);
+        }
+    }
+    return result;
+}
+
 //------------------------------------------------------------------------------
 // EVAL LINEAR TRANSFORMATION
 //------------------------------------------------------------------------------
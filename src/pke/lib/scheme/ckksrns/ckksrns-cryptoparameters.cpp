@@ -136,17 +136,136 @@ void CryptoParametersCKKSRNS::PrecomputeCRTTables(KeySwitchTechnique ksTech, Sca
             m_dmoduliQ[i] = moduliQ[i].ConvertToDouble();
         }
     }
+    else if (m_scalTechnique == COMPOSITESCALINGAUTO) {
+        // a level consists of compositeDegree moduli that are dropped together, so the scaling factor changes only
+        // at the levels that are multiples of compositeDegree; the levels in between repeat the previous value
+        const uint32_t compositeDegree = GetCompositeDegree();
+
+        m_scalingFactorsReal.resize(sizeQ);
+        double sf = 1.0;
+        for (uint32_t j = 0; j < compositeDegree; j++) {
+            sf *= moduliQ[sizeQ - 1 - j].ConvertToDouble();
+        }
+        for (uint32_t k = 0; k < sizeQ; k += compositeDegree) {
+            if (k > 0) {
+                double modReduceFactor = 1.0;
+                for (uint32_t j = 0; j < compositeDegree; j++) {
+                    modReduceFactor *= moduliQ[sizeQ - k + j].ConvertToDouble();
+                }
+                sf           = sf * sf / modReduceFactor;
+                double ratio = sf / m_scalingFactorsReal[0];
+
+                if (ratio <= 0.5 || ratio >= 2.0)
+                    OPENFHE_THROW(
+                        "CryptoParametersCKKSRNS::PrecomputeCRTTables "
+                        "- COMPOSITESCALINGAUTO cannot support this "
+                        "number of levels in this parameter setting.");
+            }
+            for (uint32_t j = 0; j < compositeDegree && k + j < sizeQ; j++) {
+                m_scalingFactorsReal[k + j] = sf;
+            }
+        }
+
+        m_scalingFactorsRealBig.resize(sizeQ - 1);
+        for (uint32_t k = 0; k < sizeQ - 1; k++) {
+            m_scalingFactorsRealBig[k] = m_scalingFactorsReal[k] * m_scalingFactorsReal[k];
+        }
+
+        // Moduli as real
+        m_dmoduliQ.resize(sizeQ);
+        for (uint32_t i = 0; i < sizeQ; ++i) {
+            m_dmoduliQ[i] = moduliQ[i].ConvertToDouble();
+        }
+    }
     else {
         const auto p = GetPlaintextModulus();
         m_approxSF   = pow(2, p);
     }
-    if (m_ksTechnique == HYBRID) {
+    if (m_ksTechnique == HYBRID || m_ksTechnique == KLSS) {
         const auto BarrettBase128Bit(BigInteger(1).LShiftEq(128));
         m_modqBarrettMu.resize(sizeQ);
         for (uint32_t i = 0; i < sizeQ; i++) {
             m_modqBarrettMu[i] = (BarrettBase128Bit / BigInteger(moduliQ[i])).ConvertToInt<DoubleNativeInt>();
         }
     }
+
+    if (m_fusedRescale)
+        PrecomputeFusedRescaleTables();
+}
+
+void CryptoParametersCKKSRNS::EnableFusedRescale() {
+    if (m_ksTechnique != HYBRID)
+        OPENFHE_THROW("The fused key switch and rescale requires HYBRID key switching");
+    if (m_scalTechnique != FLEXIBLEAUTO && m_scalTechnique != FIXEDMANUAL)
+        OPENFHE_THROW("The fused key switch and rescale requires FLEXIBLEAUTO or FIXEDMANUAL scaling");
+
+    m_fusedRescale = true;
+    if (!HasKeySwitchRescaleTables())
+        PrecomputeFusedRescaleTables();
+}
+
+// Pre-compute the tables for the key switch fused with rescaling, which divides by q_l*P in one ModDown.
+// k counts the towers already dropped, so the ciphertext has towers {q_0,...,q_l} with l = sizeQ - (k + 1)
+void CryptoParametersCKKSRNS::PrecomputeFusedRescaleTables() {
+    size_t sizeQ = GetElementParams()->GetParams().size();
+
+    std::vector<NativeInteger> moduliQ(sizeQ);
+    std::vector<NativeInteger> rootsQ(sizeQ);
+    for (size_t i = 0; i < sizeQ; i++) {
+        moduliQ[i] = GetElementParams()->GetParams()[i]->GetModulus();
+        rootsQ[i]  = GetElementParams()->GetParams()[i]->GetRootOfUnity();
+    }
+
+    const auto paramsP = GetParamsP();
+    size_t sizeP       = paramsP->GetParams().size();
+    uint32_t m         = GetElementParams()->GetCyclotomicOrder();
+
+    m_paramsQlRescale.resize(sizeQ - 1);
+    m_paramsqlP.resize(sizeQ - 1);
+    m_qlPInvModq.resize(sizeQ - 1);
+    m_qlPInvModqPrecon.resize(sizeQ - 1);
+    m_qlPHatInvModp.resize(sizeQ - 1);
+    m_qlPHatInvModpPrecon.resize(sizeQ - 1);
+    m_qlPHatModq.resize(sizeQ - 1);
+    for (size_t k = 0; k < sizeQ - 1; k++) {
+        size_t l = sizeQ - (k + 1);
+
+        std::vector<NativeInteger> moduliQl(moduliQ.begin(), moduliQ.begin() + l);
+        std::vector<NativeInteger> rootsQl(rootsQ.begin(), rootsQ.begin() + l);
+        m_paramsQlRescale[k] = std::make_shared<ILDCRTParams<BigInteger>>(m, moduliQl, rootsQl);
+
+        std::vector<NativeInteger> moduliqlP(sizeP + 1);
+        std::vector<NativeInteger> rootsqlP(sizeP + 1);
+        moduliqlP[0] = moduliQ[l];
+        rootsqlP[0]  = rootsQ[l];
+        for (size_t j = 0; j < sizeP; j++) {
+            moduliqlP[j + 1] = paramsP->GetParams()[j]->GetModulus();
+            rootsqlP[j + 1]  = paramsP->GetParams()[j]->GetRootOfUnity();
+        }
+        m_paramsqlP[k] = std::make_shared<ILDCRTParams<BigInteger>>(m, moduliqlP, rootsqlP);
+
+        BigInteger modulusqlP = paramsP->GetModulus() * BigInteger(moduliQ[l]);
+
+        m_qlPInvModq[k].resize(l);
+        m_qlPInvModqPrecon[k].resize(l);
+        for (size_t i = 0; i < l; i++) {
+            m_qlPInvModq[k][i]       = modulusqlP.ModInverse(moduliQ[i]).ConvertToInt();
+            m_qlPInvModqPrecon[k][i] = m_qlPInvModq[k][i].PrepModMulConst(moduliQ[i]);
+        }
+
+        m_qlPHatInvModp[k].resize(sizeP + 1);
+        m_qlPHatInvModpPrecon[k].resize(sizeP + 1);
+        m_qlPHatModq[k].resize(sizeP + 1);
+        for (size_t j = 0; j < sizeP + 1; j++) {
+            BigInteger qlPHatj          = modulusqlP / BigInteger(moduliqlP[j]);
+            m_qlPHatInvModp[k][j]       = qlPHatj.ModInverse(moduliqlP[j]).ConvertToInt();
+            m_qlPHatInvModpPrecon[k][j] = m_qlPHatInvModp[k][j].PrepModMulConst(moduliqlP[j]);
+            m_qlPHatModq[k][j].resize(l);
+            for (size_t i = 0; i < l; i++) {
+                m_qlPHatModq[k][j][i] = qlPHatj.Mod(moduliQ[i]).ConvertToInt();
+            }
+        }
+    }
 }
 
 uint64_t CryptoParametersCKKSRNS::FindAuxPrimeStep() const {
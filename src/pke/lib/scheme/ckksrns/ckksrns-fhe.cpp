@@ -49,8 +49,13 @@
 #include "utils/utilities.h"
 #include "scheme/ckksrns/ckksrns-utils.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <fstream>
+#include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace lbcrypto {
@@ -77,7 +82,8 @@ void FHECKKSRNS::EvalBootstrapSetup(const CryptoContextImpl<DCRTPoly>& cc, std::
     // Set correction factor by default, if it is not already set.
     if (correctionFactor == 0) {
         if (cryptoParams->GetScalingTechnique() == FLEXIBLEAUTO ||
-            cryptoParams->GetScalingTechnique() == FLEXIBLEAUTOEXT) {
+            cryptoParams->GetScalingTechnique() == FLEXIBLEAUTOEXT ||
+            cryptoParams->GetScalingTechnique() == COMPOSITESCALINGAUTO) {
             // The default correction factors chosen yielded the best precision in our experiments.
             // We chose the best fit line from our experiments by running ckks-bootstrapping-precision.cpp.
             // The spreadsheet with our experiments is here:
@@ -155,13 +161,15 @@ void FHECKKSRNS::EvalBootstrapSetup(const CryptoContextImpl<DCRTPoly>& cc, std::
         }
         ksiPows[m] = ksiPows[0];
 
+        bool sparseSecret = (cryptoParams->GetSecretKeyDist() == SPARSE_TERNARY) ||
+                            (cryptoParams->GetSecretKeyDist() == SPARSE_ENCAPSULATED);
+
         // Extract the modulus prior to bootstrapping
-        NativeInteger q = cryptoParams->GetElementParams()->GetParams()[0]->GetModulus().ConvertToInt();
-        double qDouble  = q.ConvertToDouble();
+        double qDouble = GetLevelZeroModulus(*cryptoParams);
 
         uint128_t factor = ((uint128_t)1 << ((uint32_t)std::round(std::log2(qDouble))));
         double pre       = qDouble / factor;
-        double k         = (cryptoParams->GetSecretKeyDist() == SPARSE_TERNARY) ? K_SPARSE : 1.0;
+        double k         = sparseSecret ? K_SPARSE : 1.0;
         double scaleEnc  = pre / k;
         double scaleDec  = 1 / pre;
 
@@ -174,8 +182,10 @@ void FHECKKSRNS::EvalBootstrapSetup(const CryptoContextImpl<DCRTPoly>& cc, std::
         // for FLEXIBLEAUTOEXT we do not need extra modulus in auxiliary plaintexts
         if (cryptoParams->GetScalingTechnique() == FLEXIBLEAUTOEXT)
             L0 -= 1;
-        uint32_t lEnc = L0 - precom->m_paramsEnc[CKKS_BOOT_PARAMS::LEVEL_BUDGET] - 1;
-        uint32_t lDec = L0 - depthBT;
+        // the levels are counted in towers; with composite scaling every level spans compositeDegree towers
+        uint32_t compositeDegree = cryptoParams->GetCompositeDegree();
+        uint32_t lEnc            = L0 - compositeDegree * (precom->m_paramsEnc[CKKS_BOOT_PARAMS::LEVEL_BUDGET] + 1);
+        uint32_t lDec            = L0 - compositeDegree * depthBT;
 
         bool isLTBootstrap = (precom->m_paramsEnc[CKKS_BOOT_PARAMS::LEVEL_BUDGET] == 1) &&
                              (precom->m_paramsDec[CKKS_BOOT_PARAMS::LEVEL_BUDGET] == 1);
@@ -234,6 +244,28 @@ std::shared_ptr<std::map<usint, EvalKey<DCRTPoly>>> FHECKKSRNS::EvalBootstrapKey
     auto conjKey       = ConjugateKeyGen(privateKey);
     (*evalKeys)[M - 1] = conjKey;
 
+    if (cryptoParams->GetSecretKeyDist() == SPARSE_ENCAPSULATED) {
+        // Keys for sparse-secret encapsulation: an ephemeral sparse secret is used only inside bootstrapping.
+        // The key switching to it is kept modulo Q_0 * P, where Q_0 is the modulus of level 0 (q_0 or the
+        // product of its moduli with composite scaling); ParamsGenCKKSRNS bounds log2(Q_0 * P) so that the
+        // sparse secret is still secure. The key switching back to the main secret is a regular key. The keys
+        // are kept apart from the automorphism keys, so they are neither listed, trimmed nor serialized with them.
+        const auto& s = privateKey->GetPrivateElement();
+        DCRTPoly::TugType tug;
+        PrivateKey<DCRTPoly> sparseKey = std::make_shared<PrivateKeyImpl<DCRTPoly>>(cc);
+        sparseKey->SetPrivateElement(DCRTPoly(tug, s.GetParams(), Format::EVALUATION, H_ENCAPSULATED));
+
+        uint32_t compositeDegree = cryptoParams->GetCompositeDegree();
+        uint32_t sizeQ           = cryptoParams->GetElementParams()->GetParams().size();
+        uint32_t sizeP           = cryptoParams->GetParamsP()->GetParams().size();
+        auto toSparse = algo->TrimEvalKey(algo->KeySwitchGen(privateKey, sparseKey), sizeQ - compositeDegree);
+        if (toSparse->GetBVector()[0].GetNumOfElements() != compositeDegree + sizeP)
+            OPENFHE_THROW("The key switching to the sparse secret must be defined modulo Q_0 * P only");
+
+        CryptoContextImpl<DCRTPoly>::InsertEvalEncapsulationKey({toSparse, algo->KeySwitchGen(sparseKey, privateKey)},
+                                                                privateKey->GetKeyTag());
+    }
+
     return evalKeys;
 }
 
@@ -250,7 +282,12 @@ void FHECKKSRNS::EvalBootstrapPrecompute(const CryptoContextImpl<DCRTPoly>& cc,
     uint32_t M     = cc.GetCyclotomicOrder();
     uint32_t slots = (numSlots == 0) ? M / 4 : numSlots;
 
-    std::shared_ptr<CKKSBootstrapPrecom> precom = m_bootPrecomMap[slots];
+    // look the precomputation up without inserting, so that a missing setup does not add an empty entry
+    auto pair = m_bootPrecomMap.find(slots);
+    if (pair == m_bootPrecomMap.end())
+        OPENFHE_THROW("Precomputations for " + std::to_string(slots) +
+                      " slots were not set up. Need to call EvalBootstrapSetup to proceed");
+    std::shared_ptr<CKKSBootstrapPrecom> precom = pair->second;
 
     std::vector<uint32_t> dim1(
         {precom->m_dim1, static_cast<uint32_t>(precom->m_paramsDec[CKKS_BOOT_PARAMS::GIANT_STEP])});
@@ -281,13 +318,15 @@ void FHECKKSRNS::EvalBootstrapPrecompute(const CryptoContextImpl<DCRTPoly>& cc,
     }
     ksiPows[m] = ksiPows[0];
 
+    bool sparseSecret = (cryptoParams->GetSecretKeyDist() == SPARSE_TERNARY) ||
+                        (cryptoParams->GetSecretKeyDist() == SPARSE_ENCAPSULATED);
+
     // Extract the modulus prior to bootstrapping
-    NativeInteger q = cryptoParams->GetElementParams()->GetParams()[0]->GetModulus().ConvertToInt();
-    double qDouble  = q.ConvertToDouble();
+    double qDouble = GetLevelZeroModulus(*cryptoParams);
 
     uint128_t factor = ((uint128_t)1 << ((uint32_t)std::round(std::log2(qDouble))));
     double pre       = qDouble / factor;
-    double k         = (cryptoParams->GetSecretKeyDist() == SPARSE_TERNARY) ? K_SPARSE : 1.0;
+    double k         = sparseSecret ? K_SPARSE : 1.0;
     double scaleEnc  = pre / k;
     double scaleDec  = 1 / pre;
 
@@ -300,8 +339,10 @@ void FHECKKSRNS::EvalBootstrapPrecompute(const CryptoContextImpl<DCRTPoly>& cc,
     // for FLEXIBLEAUTOEXT we do not need extra modulus in auxiliary plaintexts
     if (cryptoParams->GetScalingTechnique() == FLEXIBLEAUTOEXT)
         L0 -= 1;
-    uint32_t lEnc = L0 - precom->m_paramsEnc[CKKS_BOOT_PARAMS::LEVEL_BUDGET] - 1;
-    uint32_t lDec = L0 - depthBT;
+    // the levels are counted in towers; with composite scaling every level spans compositeDegree towers
+    uint32_t compositeDegree = cryptoParams->GetCompositeDegree();
+    uint32_t lEnc            = L0 - compositeDegree * (precom->m_paramsEnc[CKKS_BOOT_PARAMS::LEVEL_BUDGET] + 1);
+    uint32_t lDec            = L0 - compositeDegree * depthBT;
 
     bool isLTBootstrap = (precom->m_paramsEnc[CKKS_BOOT_PARAMS::LEVEL_BUDGET] == 1) &&
                          (precom->m_paramsDec[CKKS_BOOT_PARAMS::LEVEL_BUDGET] == 1);
@@ -339,6 +380,11 @@ void FHECKKSRNS::EvalBootstrapPrecompute(const CryptoContextImpl<DCRTPoly>& cc,
 
 Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphertext, uint32_t numIterations,
                                                uint32_t precision) const {
+    return EvalBootstrapInternal(ciphertext, numIterations, precision, 0);
+}
+
+Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrapInternal(ConstCiphertext<DCRTPoly> ciphertext, uint32_t numIterations,
+                                                       uint32_t precision, uint32_t logScaleDown) const {
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
 
     if (cryptoParams->GetKeySwitchTechnique() != HYBRID)
@@ -358,10 +404,11 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
     double timeDecode(0.0);
 #endif
 
-    auto cc        = ciphertext->GetCryptoContext();
-    uint32_t M     = cc->GetCyclotomicOrder();
-    uint32_t L0    = cryptoParams->GetElementParams()->GetParams().size();
-    auto initSizeQ = ciphertext->GetElements()[0].GetNumOfElements();
+    auto cc                  = ciphertext->GetCryptoContext();
+    uint32_t M               = cc->GetCyclotomicOrder();
+    uint32_t L0              = cryptoParams->GetElementParams()->GetParams().size();
+    uint32_t compositeDegree = cryptoParams->GetCompositeDegree();
+    auto initSizeQ           = ciphertext->GetElements()[0].GetNumOfElements();
 
     if (numIterations > 1) {
         // Step 1: Get the input.
@@ -406,7 +453,8 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         auto finalCiphertext = cc->EvalSub(ctInitialBootstrap, ctBootstrappedError);
 
         // Step 10: Scale back down by powerOfTwoModulus to get the original message.
-        cc->EvalMultInPlace(finalCiphertext, static_cast<double>(1) / powerOfTwoModulus);
+        cc->EvalMultInPlace(finalCiphertext,
+                            static_cast<double>(1) / powerOfTwoModulus / static_cast<double>(1ULL << logScaleDown));
         return finalCiphertext;
     }
 
@@ -441,8 +489,7 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
     }
     auto elementParamsRaisedPtr = std::make_shared<ILDCRTParams<DCRTPoly::Integer>>(M, moduli, roots);
 
-    NativeInteger q = elementParamsRaisedPtr->GetParams()[0]->GetModulus().ConvertToInt();
-    double qDouble  = q.ConvertToDouble();
+    double qDouble = GetLevelZeroModulus(*cryptoParams);
 
     const auto p = cryptoParams->GetPlaintextModulus();
     double powP  = pow(2, p);
@@ -460,6 +507,24 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
     double pre      = 1. / post;
     uint64_t scalar = std::llround(post);
 
+#if NATIVEINT != 128
+    uint32_t logCorFactor = correction;
+#else
+    uint32_t logCorFactor = 0;
+#endif
+    if (logScaleDown > 0) {
+        // the message is divided by taking the factor out of the integer multipliers applied after the
+        // approximate modular reduction: first from the correction factor, then from the scalar
+        if (deg < 0 || logScaleDown > static_cast<uint32_t>(deg) + logCorFactor) {
+            OPENFHE_THROW("Cannot scale the message down by 2^" + std::to_string(logScaleDown) +
+                          " during bootstrapping; at most 2^" + std::to_string(std::max(deg, 0) + logCorFactor) +
+                          " is supported for these parameters");
+        }
+        uint32_t fromCorFactor = std::min(logScaleDown, logCorFactor);
+        logCorFactor -= fromCorFactor;
+        scalar >>= (logScaleDown - fromCorFactor);
+    }
+
     //------------------------------------------------------------------------------
     // RAISING THE MODULUS
     //------------------------------------------------------------------------------
@@ -475,21 +540,43 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
     algo->ModReduceInternalInPlace(raised, raised->GetNoiseScaleDeg() - 1);
 
     AdjustCiphertext(raised, correction);
+
+    std::shared_ptr<const std::vector<EvalKey<DCRTPoly>>> encapsulationKeys;
+    if (cryptoParams->GetSecretKeyDist() == SPARSE_ENCAPSULATED) {
+        // switch to the ephemeral sparse secret modulo Q_0, so that the overflows of the modulus raising
+        // below are bounded as for a sparse secret. The sparse secret may not be used at any other modulus
+        encapsulationKeys = CryptoContextImpl<DCRTPoly>::GetEvalEncapsulationKeyVectorPtr(raised->GetKeyTag());
+        for (auto& c : raised->GetElements())
+            c.DropLastElements(c.GetNumOfElements() - compositeDegree);
+        raised->SetLevel(L0 - compositeDegree);
+        algo->KeySwitchInPlace(raised, (*encapsulationKeys)[0]);
+    }
+
     auto ctxtDCRT = raised->GetElements();
 
     // We only use the level 0 ciphertext here. All other towers are automatically ignored to make
     // CKKS bootstrapping faster.
-    for (size_t i = 0; i < ctxtDCRT.size(); i++) {
-        DCRTPoly temp(elementParamsRaisedPtr, COEFFICIENT);
-        ctxtDCRT[i].SetFormat(COEFFICIENT);
-        temp = ctxtDCRT[i].GetElementAtIndex(0);
-        temp.SetFormat(EVALUATION);
-        ctxtDCRT[i] = temp;
+    if (compositeDegree > 1) {
+        // level 0 spans several towers, so it is extended to the raised modulus by an exact CRT basis extension
+        ExtendCiphertext(ctxtDCRT, elementParamsRaisedPtr, compositeDegree);
+    }
+    else {
+        for (size_t i = 0; i < ctxtDCRT.size(); i++) {
+            DCRTPoly temp(elementParamsRaisedPtr, COEFFICIENT);
+            ctxtDCRT[i].SetFormat(COEFFICIENT);
+            temp = ctxtDCRT[i].GetElementAtIndex(0);
+            temp.SetFormat(EVALUATION);
+            ctxtDCRT[i] = temp;
+        }
     }
 
     raised->SetElements(ctxtDCRT);
     raised->SetLevel(L0 - ctxtDCRT[0].GetNumOfElements());
 
+    // back to the main secret, now modulo the raised modulus
+    if (cryptoParams->GetSecretKeyDist() == SPARSE_ENCAPSULATED)
+        algo->KeySwitchInPlace(raised, (*encapsulationKeys)[1]);
+
 #ifdef BOOTSTRAPTIMING
     std::cerr << "\nNumber of levels at the beginning of bootstrapping: "
               << raised->GetElements()[0].GetNumOfElements() - 1 << std::endl;
@@ -503,7 +590,8 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
     std::vector<double> coefficients;
     double k = 0;
 
-    if (cryptoParams->GetSecretKeyDist() == SPARSE_TERNARY) {
+    if (cryptoParams->GetSecretKeyDist() == SPARSE_TERNARY ||
+        cryptoParams->GetSecretKeyDist() == SPARSE_ENCAPSULATED) {
         coefficients = g_coefficientsSparse;
         // k = K_SPARSE;
         k = 1.0;  // do not divide by k as we already did it during precomputation
@@ -545,8 +633,8 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         auto ctxtEnc = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0hatTPre, raised) :
                                          EvalCoeffsToSlots(precom->m_U0hatTPreFFT, raised);
 
-        auto evalKeyMap = cc->GetEvalAutomorphismKeyMap(ctxtEnc->GetKeyTag());
-        auto conj       = Conjugate(ctxtEnc, evalKeyMap);
+        auto evalKeyMap = cc->GetEvalAutomorphismKeyMapPtr(ctxtEnc->GetKeyTag(), {M - 1});
+        auto conj       = Conjugate(ctxtEnc, *evalKeyMap);
         auto ctxtEncI   = cc->EvalSub(ctxtEnc, conj);
         cc->EvalAddInPlace(ctxtEnc, conj);
         algo->MultByMonomialInPlace(ctxtEncI, 3 * M / 4);
@@ -574,8 +662,9 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
 
         // Double-angle iterations
         if ((cryptoParams->GetSecretKeyDist() == UNIFORM_TERNARY) ||
-            (cryptoParams->GetSecretKeyDist() == SPARSE_TERNARY)) {
-            if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL) {
+            (cryptoParams->GetSecretKeyDist() == SPARSE_TERNARY) ||
+            (cryptoParams->GetSecretKeyDist() == SPARSE_ENCAPSULATED)) {
+            if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL && ctxtEnc->GetNoiseScaleDeg() == 2) {
                 algo->ModReduceInternalInPlace(ctxtEnc, BASE_NUM_LEVELS_TO_DROP);
                 algo->ModReduceInternalInPlace(ctxtEncI, BASE_NUM_LEVELS_TO_DROP);
             }
@@ -610,7 +699,7 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
 
         // In the case of FLEXIBLEAUTO, we need one extra tower
         // TODO: See if we can remove the extra level in FLEXIBLEAUTO
-        if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL) {
+        if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL && ctxtEnc->GetNoiseScaleDeg() == 2) {
             algo->ModReduceInternalInPlace(ctxtEnc, BASE_NUM_LEVELS_TO_DROP);
         }
 
@@ -645,8 +734,8 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         auto ctxtEnc = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0hatTPre, raised) :
                                          EvalCoeffsToSlots(precom->m_U0hatTPreFFT, raised);
 
-        auto evalKeyMap = cc->GetEvalAutomorphismKeyMap(ctxtEnc->GetKeyTag());
-        auto conj       = Conjugate(ctxtEnc, evalKeyMap);
+        auto evalKeyMap = cc->GetEvalAutomorphismKeyMapPtr(ctxtEnc->GetKeyTag(), {M - 1});
+        auto conj       = Conjugate(ctxtEnc, *evalKeyMap);
         cc->EvalAddInPlace(ctxtEnc, conj);
 
         if (cryptoParams->GetScalingTechnique() == FIXEDMANUAL) {
@@ -679,8 +768,9 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
 
         // Double-angle iterations
         if ((cryptoParams->GetSecretKeyDist() == UNIFORM_TERNARY) ||
-            (cryptoParams->GetSecretKeyDist() == SPARSE_TERNARY)) {
-            if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL) {
+            (cryptoParams->GetSecretKeyDist() == SPARSE_TERNARY) ||
+            (cryptoParams->GetSecretKeyDist() == SPARSE_ENCAPSULATED)) {
+            if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL && ctxtEnc->GetNoiseScaleDeg() == 2) {
                 algo->ModReduceInternalInPlace(ctxtEnc, BASE_NUM_LEVELS_TO_DROP);
             }
             uint32_t numIter;
@@ -710,7 +800,7 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
 
         // In the case of FLEXIBLEAUTO, we need one extra tower
         // TODO: See if we can remove the extra level in FLEXIBLEAUTO
-        if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL) {
+        if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL && ctxtEnc->GetNoiseScaleDeg() == 2) {
             algo->ModReduceInternalInPlace(ctxtEnc, BASE_NUM_LEVELS_TO_DROP);
         }
 
@@ -723,7 +813,7 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
 
 #if NATIVEINT != 128
     // 64-bit only: scale back the message to its original scale.
-    uint64_t corFactor = (uint64_t)1 << std::llround(correction);
+    uint64_t corFactor = (uint64_t)1 << logCorFactor;
     algo->MultByIntegerInPlace(ctxtDec, corFactor);
 #endif
 
@@ -743,6 +833,444 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
     return ctxtDec;
 }
 
+//------------------------------------------------------------------------------
+// Batched Bootstrapping
+//------------------------------------------------------------------------------
+
+// A ciphertext with s slots encrypts a polynomial in Z[X^(N/2s)]. A batch of k = 2^logBatch such
+// ciphertexts is interleaved into one polynomial sum_i X^(i*N/2ks) m_i(X) of Z[X^(N/2ks)], i.e., a
+// ciphertext with k*s slots, by monomial multiplications that are free. After bootstrapping the
+// packed ciphertext, the rotation by k*s/2 maps X^(N/2ks) to -X^(N/2ks), so adding and subtracting
+// the rotated ciphertext separates the even and the odd ciphertexts of the batch; repeating this
+// logBatch times recovers all of them using k - 1 rotations. A smaller batch is padded to k, so it
+// needs k - 1 rotations as well. Every split doubles the message, which is compensated inside
+// bootstrapping.
+
+std::shared_ptr<std::map<usint, EvalKey<DCRTPoly>>> FHECKKSRNS::EvalBootstrapBatchKeyGen(
+    const PrivateKey<DCRTPoly> privateKey, uint32_t slots, uint32_t batchSize) {
+    auto cc    = privateKey->GetCryptoContext();
+    uint32_t M = cc->GetCyclotomicOrder();
+
+    if (slots == 0 || batchSize == 0)
+        OPENFHE_THROW("The number of slots and the batch size must be positive");
+
+    uint32_t logBatch   = std::ceil(std::log2(batchSize));
+    uint32_t batchSlots = slots << logBatch;
+    if (batchSlots > M / 4)
+        OPENFHE_THROW("A batch of " + std::to_string(batchSize) + " ciphertexts with " + std::to_string(slots) +
+                      " slots does not fit into " + std::to_string(M / 4) + " slots");
+
+    auto evalKeys = EvalBootstrapKeyGen(privateKey, batchSlots);
+
+    std::vector<int32_t> indexList;
+    for (uint32_t j = 0; j < logBatch; j++) {
+        int32_t index = slots << j;
+        if (evalKeys->find(FindAutomorphismIndex2nComplex(index, M)) == evalKeys->end())
+            indexList.push_back(index);
+    }
+    if (!indexList.empty()) {
+        auto unpackKeys = cc->GetScheme()->EvalAtIndexKeyGen(nullptr, privateKey, indexList);
+        evalKeys->insert(unpackKeys->begin(), unpackKeys->end());
+    }
+
+    return evalKeys;
+}
+
+std::vector<Ciphertext<DCRTPoly>> FHECKKSRNS::EvalBootstrapBatch(const std::vector<Ciphertext<DCRTPoly>>& ciphertexts,
+                                                                 uint32_t numIterations, uint32_t precision) const {
+    if (ciphertexts.empty())
+        OPENFHE_THROW("The input vector of ciphertexts is empty");
+    if (ciphertexts.size() == 1)
+        return {EvalBootstrap(ciphertexts[0], numIterations, precision)};
+
+    auto cc        = ciphertexts[0]->GetCryptoContext();
+    auto algo      = cc->GetScheme();
+    uint32_t M     = cc->GetCyclotomicOrder();
+    uint32_t slots = ciphertexts[0]->GetSlots();
+    for (const auto& ciphertext : ciphertexts) {
+        if (ciphertext->GetSlots() != slots)
+            OPENFHE_THROW("All ciphertexts of the batch must have the same number of slots");
+    }
+
+    uint32_t batchSize  = ciphertexts.size();
+    uint32_t logBatch   = std::ceil(std::log2(batchSize));
+    uint32_t batchSlots = slots << logBatch;
+    if (batchSlots > M / 4)
+        OPENFHE_THROW("A batch of " + std::to_string(batchSize) + " ciphertexts with " + std::to_string(slots) +
+                      " slots does not fit into " + std::to_string(M / 4) + " slots");
+
+    // distance between the coefficients of the packed ciphertext
+    uint32_t gap = M / (4 * batchSlots);
+
+    Ciphertext<DCRTPoly> packed = ciphertexts[0]->Clone();
+    for (uint32_t i = 1; i < batchSize; i++) {
+        auto shifted = algo->MultByMonomial(ciphertexts[i], i * gap);
+        cc->EvalAddInPlace(packed, shifted);
+    }
+    packed->SetSlots(batchSlots);
+
+    auto refreshed = EvalBootstrapInternal(packed, numIterations, precision, logBatch);
+
+    // bootstrapping returns its input if the input has more towers than the result would have
+    if (refreshed->GetElements()[0].GetNumOfElements() <= packed->GetElements()[0].GetNumOfElements()) {
+        std::vector<Ciphertext<DCRTPoly>> result;
+        result.reserve(batchSize);
+        for (const auto& ciphertext : ciphertexts)
+            result.push_back(ciphertext->Clone());
+        return result;
+    }
+
+    // after step j, result[r] holds the ciphertexts of the batch whose index is r mod 2^j
+    std::vector<Ciphertext<DCRTPoly>> result(1U << logBatch);
+    result[0] = refreshed;
+    for (uint32_t j = 0; j < logBatch; j++) {
+        uint32_t numParts = 1U << j;
+        int32_t index     = batchSlots >> (j + 1);
+        for (uint32_t r = 0; r < numParts; r++) {
+            auto rotated = cc->EvalRotate(result[r], index);
+            // the odd part is empty if the batch has no ciphertexts with an index of r + numParts mod 2^(j+1)
+            if (r + numParts < batchSize) {
+                result[r + numParts] = cc->EvalSub(result[r], rotated);
+                algo->MultByMonomialInPlace(result[r + numParts], M - (gap << j));
+            }
+            cc->EvalAddInPlace(result[r], rotated);
+        }
+    }
+
+    result.resize(batchSize);
+    for (auto& ciphertext : result)
+        ciphertext->SetSlots(slots);
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+// Paired Bootstrapping
+//------------------------------------------------------------------------------
+
+// Multiplying by the monomial X^(N/2) multiplies every slot by i, so two real messages m1 and m2
+// are packed for free into the complex message m1 + i*m2. Bootstrapping does not depend on the
+// slot values being real, and after it the conjugate of the result encrypts m1 - i*m2, so the sum
+// and the difference give 2*m1 and 2*i*m2. The factor of 2 is compensated inside bootstrapping.
+
+std::pair<Ciphertext<DCRTPoly>, Ciphertext<DCRTPoly>> FHECKKSRNS::EvalBootstrapPair(
+    ConstCiphertext<DCRTPoly> ciphertext1, ConstCiphertext<DCRTPoly> ciphertext2, uint32_t numIterations,
+    uint32_t precision) const {
+    if (ciphertext1->GetSlots() != ciphertext2->GetSlots())
+        OPENFHE_THROW("Both ciphertexts of the pair must have the same number of slots");
+
+    auto cc    = ciphertext1->GetCryptoContext();
+    auto algo  = cc->GetScheme();
+    uint32_t M = cc->GetCyclotomicOrder();
+
+    auto packed = algo->MultByMonomial(ciphertext2, M / 4);
+    cc->EvalAddInPlace(packed, ciphertext1);
+
+    auto refreshed = EvalBootstrapInternal(packed, numIterations, precision, 1);
+
+    // bootstrapping returns its input if the input has more towers than the result would have
+    if (refreshed->GetElements()[0].GetNumOfElements() <= packed->GetElements()[0].GetNumOfElements())
+        return {ciphertext1->Clone(), ciphertext2->Clone()};
+
+    auto evalKeyMap = cc->GetEvalAutomorphismKeyMapPtr(refreshed->GetKeyTag(), {M - 1});
+    auto conj       = Conjugate(refreshed, *evalKeyMap);
+
+    auto result2 = cc->EvalSub(refreshed, conj);
+    algo->MultByMonomialInPlace(result2, 3 * M / 4);
+    cc->EvalAddInPlace(refreshed, conj);
+
+    return {refreshed, result2};
+}
+
+//------------------------------------------------------------------------------
+// Serialization of the Bootstrapping Precomputations
+//------------------------------------------------------------------------------
+
+// The precomputation file stores all CKKSBootstrapPrecom objects with their plaintexts already in
+// the evaluation form, so loading it only copies the tower values. Layout:
+//   magic, version, size of the native integer, ring dimension, correction factor,
+//   moduli of Q and P (to check that the file matches the crypto context), number of precomputations;
+//   for every precomputation: slots, dim1, the FFT parameters for encoding and decoding and the
+//   plaintexts m_U0Pre, m_U0hatTPre, m_U0PreFFT, m_U0hatTPreFFT.
+// A plaintext is stored as a presence flag, its metadata, its moduli and the values of its towers.
+
+namespace {
+
+constexpr char BOOT_PRECOM_MAGIC[8]    = {'O', 'F', 'H', 'E', 'B', 'T', 'P', '\0'};
+constexpr uint32_t BOOT_PRECOM_VERSION = 1;
+
+using NativeInt = NativeInteger::Integer;
+
+// cache of the element parameters of the loaded plaintexts, keyed by their moduli
+using PrecomParamsCache = std::map<std::vector<NativeInt>, std::shared_ptr<DCRTPoly::Params>>;
+
+template <typename T>
+void WriteValue(std::ostream& os, const T& value) {
+    os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void WriteModuli(std::ostream& os, const std::vector<std::shared_ptr<ILNativeParams>>& params) {
+    WriteValue(os, static_cast<uint64_t>(params.size()));
+    for (const auto& p : params)
+        WriteValue(os, p->GetModulus().ConvertToInt());
+}
+
+void WritePlaintext(std::ostream& os, const ConstPlaintext& plaintext) {
+    WriteValue(os, static_cast<uint8_t>(plaintext != nullptr));
+    if (plaintext == nullptr)
+        return;
+
+    const DCRTPoly* element = &plaintext->GetElement<DCRTPoly>();
+    DCRTPoly converted;
+    if (element->GetFormat() != Format::EVALUATION) {
+        converted = *element;
+        converted.SetFormat(Format::EVALUATION);
+        element = &converted;
+    }
+
+    const auto& towers = element->GetAllElements();
+    WriteValue(os, static_cast<uint32_t>(plaintext->GetLevel()));
+    WriteValue(os, static_cast<uint32_t>(plaintext->GetNoiseScaleDeg()));
+    WriteValue(os, static_cast<uint32_t>(plaintext->GetSlots()));
+    WriteValue(os, static_cast<uint32_t>(towers.size()));
+    WriteValue(os, plaintext->GetScalingFactor());
+    for (const auto& tower : towers)
+        WriteValue(os, tower.GetModulus().ConvertToInt());
+
+    std::vector<NativeInt> buffer(element->GetRingDimension());
+    for (const auto& tower : towers) {
+        const auto& values = tower.GetValues();
+        for (size_t j = 0; j < buffer.size(); ++j)
+            buffer[j] = values[j].ConvertToInt();
+        os.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(NativeInt));
+    }
+}
+
+void WritePlaintexts(std::ostream& os, const std::vector<ConstPlaintext>& plaintexts) {
+    WriteValue(os, static_cast<uint64_t>(plaintexts.size()));
+    for (const auto& plaintext : plaintexts)
+        WritePlaintext(os, plaintext);
+}
+
+void WritePlaintexts(std::ostream& os, const std::vector<std::vector<ConstPlaintext>>& plaintexts) {
+    WriteValue(os, static_cast<uint64_t>(plaintexts.size()));
+    for (const auto& level : plaintexts)
+        WritePlaintexts(os, level);
+}
+
+void WriteParams(std::ostream& os, const std::vector<int32_t>& params) {
+    WriteValue(os, static_cast<uint64_t>(params.size()));
+    os.write(reinterpret_cast<const char*>(params.data()), params.size() * sizeof(int32_t));
+}
+
+// reads the file sequentially; the towers are read straight into a buffer reused for all plaintexts
+class PrecomReader {
+public:
+    explicit PrecomReader(std::istream& is) : m_is(is) {}
+
+    template <typename T>
+    T Read() {
+        T value;
+        ReadBytes(&value, sizeof(T));
+        return value;
+    }
+
+    void ReadBytes(void* data, uint64_t size) {
+        if (!m_is.read(static_cast<char*>(data), size))
+            OPENFHE_THROW("Unexpected end of the bootstrapping precomputation file");
+    }
+
+    // returns the values of the next tower with ringDim coefficients
+    const std::vector<NativeInt>& ReadTower(uint32_t ringDim) {
+        m_tower.resize(ringDim);
+        ReadBytes(m_tower.data(), static_cast<uint64_t>(ringDim) * sizeof(NativeInt));
+        return m_tower;
+    }
+
+private:
+    std::istream& m_is;
+    std::vector<NativeInt> m_tower;
+};
+
+void CheckModuli(PrecomReader& reader, const std::vector<std::shared_ptr<ILNativeParams>>& params) {
+    if (reader.Read<uint64_t>() != params.size())
+        OPENFHE_THROW("The bootstrapping precomputations were written for different crypto parameters");
+    for (const auto& p : params) {
+        if (reader.Read<NativeInt>() != p->GetModulus().ConvertToInt())
+            OPENFHE_THROW("The bootstrapping precomputations were written for different crypto parameters");
+    }
+}
+
+ConstPlaintext ReadPlaintext(PrecomReader& reader, const CryptoContextImpl<DCRTPoly>& cc,
+                             const std::map<NativeInt, NativeInteger>& roots, PrecomParamsCache& paramsCache) {
+    if (reader.Read<uint8_t>() == 0)
+        return nullptr;
+
+    uint32_t level         = reader.Read<uint32_t>();
+    uint32_t noiseScaleDeg = reader.Read<uint32_t>();
+    uint32_t slots         = reader.Read<uint32_t>();
+    uint32_t numTowers     = reader.Read<uint32_t>();
+    double scalingFactor   = reader.Read<double>();
+
+    std::vector<NativeInt> moduli(numTowers);
+    for (auto& modulus : moduli)
+        modulus = reader.Read<NativeInt>();
+
+    auto& params = paramsCache[moduli];
+    if (params == nullptr) {
+        std::vector<NativeInteger> nativeModuli(numTowers);
+        std::vector<NativeInteger> nativeRoots(numTowers);
+        for (uint32_t i = 0; i < numTowers; ++i) {
+            auto it = roots.find(moduli[i]);
+            if (it == roots.end())
+                OPENFHE_THROW("The bootstrapping precomputations were written for different crypto parameters");
+            nativeModuli[i] = moduli[i];
+            nativeRoots[i]  = it->second;
+        }
+        params = std::make_shared<DCRTPoly::Params>(cc.GetCyclotomicOrder(), nativeModuli, nativeRoots);
+    }
+
+    auto plaintext = std::make_shared<CKKSPackedEncoding>(params, cc.GetEncodingParams(),
+                                                          std::vector<std::complex<double>>(), noiseScaleDeg, level,
+                                                          scalingFactor, slots);
+
+    const uint32_t N = cc.GetRingDimension();
+    DCRTPoly element(params, Format::EVALUATION, true);
+    for (uint32_t i = 0; i < numTowers; ++i) {
+        const auto& tower = reader.ReadTower(N);
+        auto& values      = element.GetAllElements()[i];
+        for (uint32_t j = 0; j < N; ++j)
+            values[j] = tower[j];
+    }
+    plaintext->GetElement<DCRTPoly>() = std::move(element);
+
+    return plaintext;
+}
+
+std::vector<ConstPlaintext> ReadPlaintexts(PrecomReader& reader, const CryptoContextImpl<DCRTPoly>& cc,
+                                           const std::map<NativeInt, NativeInteger>& roots,
+                                           PrecomParamsCache& paramsCache) {
+    std::vector<ConstPlaintext> plaintexts(reader.Read<uint64_t>());
+    for (auto& plaintext : plaintexts)
+        plaintext = ReadPlaintext(reader, cc, roots, paramsCache);
+    return plaintexts;
+}
+
+std::vector<int32_t> ReadParams(PrecomReader& reader) {
+    std::vector<int32_t> params(reader.Read<uint64_t>());
+    for (auto& param : params)
+        param = reader.Read<int32_t>();
+    return params;
+}
+
+}  // namespace
+
+bool FHECKKSRNS::SerializeEvalBootstrapPrecomputation(const CryptoContextImpl<DCRTPoly>& cc,
+                                                      const std::string& filename) const {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(cc.GetCryptoParameters());
+
+    if (cryptoParams->GetKeySwitchTechnique() != HYBRID)
+        OPENFHE_THROW("CKKS Bootstrapping is only supported for the Hybrid key switching method.");
+
+    if (m_bootPrecomMap.empty())
+        return false;
+
+    std::ofstream file(filename, std::ios::out | std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    file.write(BOOT_PRECOM_MAGIC, sizeof(BOOT_PRECOM_MAGIC));
+    WriteValue(file, BOOT_PRECOM_VERSION);
+    WriteValue(file, static_cast<uint32_t>(sizeof(NativeInt)));
+    WriteValue(file, static_cast<uint32_t>(cc.GetRingDimension()));
+    WriteValue(file, m_correctionFactor);
+    WriteModuli(file, cryptoParams->GetElementParams()->GetParams());
+    WriteModuli(file, cryptoParams->GetParamsP()->GetParams());
+
+    WriteValue(file, static_cast<uint64_t>(m_bootPrecomMap.size()));
+    for (const auto& [slots, precom] : m_bootPrecomMap) {
+        WriteValue(file, slots);
+        WriteValue(file, precom->m_dim1);
+        WriteParams(file, precom->m_paramsEnc);
+        WriteParams(file, precom->m_paramsDec);
+        WritePlaintexts(file, precom->m_U0Pre);
+        WritePlaintexts(file, precom->m_U0hatTPre);
+        WritePlaintexts(file, precom->m_U0PreFFT);
+        WritePlaintexts(file, precom->m_U0hatTPreFFT);
+    }
+
+    return file.good();
+}
+
+bool FHECKKSRNS::DeserializeEvalBootstrapPrecomputation(const CryptoContextImpl<DCRTPoly>& cc,
+                                                        const std::string& filename) {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(cc.GetCryptoParameters());
+
+    if (cryptoParams->GetKeySwitchTechnique() != HYBRID)
+        OPENFHE_THROW("CKKS Bootstrapping is only supported for the Hybrid key switching method.");
+
+    std::ifstream file(filename, std::ios::in | std::ios::binary);
+    if (!file.is_open())
+        OPENFHE_THROW("Can not open " + filename);
+    PrecomReader reader(file);
+
+    char magic[sizeof(BOOT_PRECOM_MAGIC)];
+    reader.ReadBytes(magic, sizeof(magic));
+    if (std::memcmp(magic, BOOT_PRECOM_MAGIC, sizeof(BOOT_PRECOM_MAGIC)) != 0)
+        OPENFHE_THROW(filename + " is not a bootstrapping precomputation file");
+    if (reader.Read<uint32_t>() > BOOT_PRECOM_VERSION)
+        OPENFHE_THROW(filename + " is from a later version of the library");
+    if (reader.Read<uint32_t>() != sizeof(NativeInt))
+        OPENFHE_THROW(filename + " was written by a build with a different native integer size");
+    if (reader.Read<uint32_t>() != cc.GetRingDimension())
+        OPENFHE_THROW("The bootstrapping precomputations were written for a different ring dimension");
+
+    uint32_t correctionFactor = reader.Read<uint32_t>();
+
+    const auto& paramsQ = cryptoParams->GetElementParams()->GetParams();
+    const auto& paramsP = cryptoParams->GetParamsP()->GetParams();
+    CheckModuli(reader, paramsQ);
+    CheckModuli(reader, paramsP);
+
+    std::map<NativeInt, NativeInteger> roots;
+    for (const auto& p : paramsQ)
+        roots[p->GetModulus().ConvertToInt()] = p->GetRootOfUnity();
+    for (const auto& p : paramsP)
+        roots[p->GetModulus().ConvertToInt()] = p->GetRootOfUnity();
+
+    // the current precomputations are replaced only if the whole file is read successfully
+    PrecomParamsCache paramsCache;
+    std::map<uint32_t, std::shared_ptr<CKKSBootstrapPrecom>> precomMap;
+    uint64_t numPrecoms = reader.Read<uint64_t>();
+    for (uint64_t i = 0; i < numPrecoms; ++i) {
+        auto precom         = std::make_shared<CKKSBootstrapPrecom>();
+        precom->m_slots     = reader.Read<uint32_t>();
+        precom->m_dim1      = reader.Read<uint32_t>();
+        precom->m_paramsEnc = ReadParams(reader);
+        precom->m_paramsDec = ReadParams(reader);
+        precom->m_U0Pre     = ReadPlaintexts(reader, cc, roots, paramsCache);
+        precom->m_U0hatTPre = ReadPlaintexts(reader, cc, roots, paramsCache);
+
+        precom->m_U0PreFFT.resize(reader.Read<uint64_t>());
+        for (auto& plaintexts : precom->m_U0PreFFT)
+            plaintexts = ReadPlaintexts(reader, cc, roots, paramsCache);
+        precom->m_U0hatTPreFFT.resize(reader.Read<uint64_t>());
+        for (auto& plaintexts : precom->m_U0hatTPreFFT)
+            plaintexts = ReadPlaintexts(reader, cc, roots, paramsCache);
+
+        if (precom->m_paramsEnc.size() != CKKS_BOOT_PARAMS::TOTAL_ELEMENTS ||
+            precom->m_paramsDec.size() != CKKS_BOOT_PARAMS::TOTAL_ELEMENTS)
+            OPENFHE_THROW(filename + " has invalid bootstrapping parameters");
+        precomMap[precom->m_slots] = precom;
+    }
+
+    m_correctionFactor = correctionFactor;
+    for (auto& [slots, precom] : precomMap)
+        m_bootPrecomMap[slots] = std::move(precom);
+
+    return true;
+}
+
 //------------------------------------------------------------------------------
 // Find Rotation Indices
 //------------------------------------------------------------------------------
@@ -1013,7 +1541,7 @@ std::vector<ConstPlaintext> FHECKKSRNS::EvalLinearTransformPrecompute(
 
     uint32_t towersToDrop = 0;
     if (L != 0) {
-        towersToDrop = elementParams.GetParams().size() - L - 1;
+        towersToDrop = elementParams.GetParams().size() - L - cryptoParams->GetCompositeDegree();
     }
 
     for (uint32_t i = 0; i < towersToDrop; i++) {
@@ -1091,7 +1619,7 @@ std::vector<ConstPlaintext> FHECKKSRNS::EvalLinearTransformPrecompute(
 
     uint32_t towersToDrop = 0;
     if (L != 0) {
-        towersToDrop = elementParams.GetParams().size() - L - 1;
+        towersToDrop = elementParams.GetParams().size() - L - cryptoParams->GetCompositeDegree();
     }
 
     for (uint32_t i = 0; i < towersToDrop; i++) {
@@ -1224,17 +1752,19 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute
 
     auto elementParams = *(cryptoParams->GetElementParams());
 
-    uint32_t towersToDrop = 0;
+    // every level of the linear transform drops compositeDegree towers
+    uint32_t compositeDegree = cryptoParams->GetCompositeDegree();
+    uint32_t towersToDrop    = 0;
 
     if (L != 0) {
-        towersToDrop = elementParams.GetParams().size() - L - levelBudget;
+        towersToDrop = elementParams.GetParams().size() - L - compositeDegree * levelBudget;
     }
 
     for (uint32_t i = 0; i < towersToDrop; i++) {
         elementParams.PopLastParam();
     }
 
-    uint32_t level0 = towersToDrop + levelBudget - 1;
+    uint32_t level0 = towersToDrop + compositeDegree * (levelBudget - 1);
 
     auto paramsQ = elementParams.GetParams();
     usint sizeQ  = paramsQ.size();
@@ -1257,9 +1787,9 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute
     std::vector<std::shared_ptr<ILDCRTParams<BigInteger>>> paramsVector(levelBudget - stop);
     for (int32_t s = levelBudget - 1; s >= stop; s--) {
         paramsVector[s - stop] = std::make_shared<ILDCRTParams<BigInteger>>(M, moduli, roots);
-        moduli.erase(moduli.begin() + sizeQ - 1);
-        roots.erase(roots.begin() + sizeQ - 1);
-        sizeQ--;
+        moduli.erase(moduli.begin() + sizeQ - compositeDegree, moduli.begin() + sizeQ);
+        roots.erase(roots.begin() + sizeQ - compositeDegree, roots.begin() + sizeQ);
+        sizeQ -= compositeDegree;
     }
 
     if (slots == M / 4) {
@@ -1287,8 +1817,8 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute
 
                         auto rotateTemp = Rotate(coeff[s][g * i + j], rot);
 
-                        result[s][g * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[s - stop], rotateTemp, 1, level0 - s, rotateTemp.size());
+                        result[s][g * i + j] = MakeAuxPlaintext(cc, paramsVector[s - stop], rotateTemp, 1,
+                                                                level0 - compositeDegree * s, rotateTemp.size());
                     }
                 }
             }
@@ -1341,8 +1871,8 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute
                         }
 
                         auto rotateTemp = Rotate(clearTemp, rot);
-                        result[s][g * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[s - stop], rotateTemp, 1, level0 - s, rotateTemp.size());
+                        result[s][g * i + j] = MakeAuxPlaintext(cc, paramsVector[s - stop], rotateTemp, 1,
+                                                                level0 - compositeDegree * s, rotateTemp.size());
                     }
                 }
             }
@@ -1423,10 +1953,12 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute
 
     auto elementParams = *(cryptoParams->GetElementParams());
 
-    uint32_t towersToDrop = 0;
+    // every level of the linear transform drops compositeDegree towers
+    uint32_t compositeDegree = cryptoParams->GetCompositeDegree();
+    uint32_t towersToDrop    = 0;
 
     if (L != 0) {
-        towersToDrop = elementParams.GetParams().size() - L - levelBudget;
+        towersToDrop = elementParams.GetParams().size() - L - compositeDegree * levelBudget;
     }
 
     for (uint32_t i = 0; i < towersToDrop; i++) {
@@ -1456,9 +1988,9 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute
     std::vector<std::shared_ptr<ILDCRTParams<BigInteger>>> paramsVector(levelBudget - flagRem + 1);
     for (int32_t s = 0; s < levelBudget - flagRem + 1; s++) {
         paramsVector[s] = std::make_shared<ILDCRTParams<BigInteger>>(M, moduli, roots);
-        moduli.erase(moduli.begin() + sizeQ - 1);
-        roots.erase(roots.begin() + sizeQ - 1);
-        sizeQ--;
+        moduli.erase(moduli.begin() + sizeQ - compositeDegree, moduli.begin() + sizeQ);
+        roots.erase(roots.begin() + sizeQ - compositeDegree, roots.begin() + sizeQ);
+        sizeQ -= compositeDegree;
     }
 
     if (slots == M / 4) {
@@ -1479,8 +2011,8 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute
                         }
 
                         auto rotateTemp = Rotate(coeff[s][g * i + j], rot);
-                        result[s][g * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[s], rotateTemp, 1, level0 + s, rotateTemp.size());
+                        result[s][g * i + j] = MakeAuxPlaintext(cc, paramsVector[s], rotateTemp, 1,
+                                                                level0 + compositeDegree * s, rotateTemp.size());
                     }
                 }
             }
@@ -1498,8 +2030,8 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute
                         }
 
                         auto rotateTemp = Rotate(coeff[s][gRem * i + j], rot);
-                        result[s][gRem * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[s], rotateTemp, 1, level0 + s, rotateTemp.size());
+                        result[s][gRem * i + j] = MakeAuxPlaintext(cc, paramsVector[s], rotateTemp, 1,
+                                                                   level0 + compositeDegree * s, rotateTemp.size());
                     }
                 }
             }
@@ -1531,8 +2063,8 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute
                         }
 
                         auto rotateTemp = Rotate(clearTemp, rot);
-                        result[s][g * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[s], rotateTemp, 1, level0 + s, rotateTemp.size());
+                        result[s][g * i + j] = MakeAuxPlaintext(cc, paramsVector[s], rotateTemp, 1,
+                                                                level0 + compositeDegree * s, rotateTemp.size());
                     }
                 }
             }
@@ -1554,8 +2086,8 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute
                         }
 
                         auto rotateTemp = Rotate(clearTemp, rot);
-                        result[s][gRem * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[s], rotateTemp, 1, level0 + s, rotateTemp.size());
+                        result[s][gRem * i + j] = MakeAuxPlaintext(cc, paramsVector[s], rotateTemp, 1,
+                                                                   level0 + compositeDegree * s, rotateTemp.size());
                     }
                 }
             }
@@ -1656,7 +2188,6 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector
 
     auto cc    = ctxt->GetCryptoContext();
     uint32_t M = cc->GetCyclotomicOrder();
-    uint32_t N = cc->GetRingDimension();
 
     int32_t levelBudget     = precom->m_paramsEnc[CKKS_BOOT_PARAMS::LEVEL_BUDGET];
     int32_t layersCollapse  = precom->m_paramsEnc[CKKS_BOOT_PARAMS::LAYERS_COLL];
@@ -1739,49 +2270,7 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector
             }
         }
 
-        Ciphertext<DCRTPoly> outer;
-        DCRTPoly first;
-        for (int32_t i = 0; i < b; i++) {
-            // for the first iteration with j=0:
-            int32_t G                  = g * i;
-            Ciphertext<DCRTPoly> inner = EvalMultExt(fastRotation[0], A[s][G]);
-            // continue the loop
-            for (int32_t j = 1; j < g; j++) {
-                if ((G + j) != int32_t(numRotations)) {
-                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], A[s][G + j]));
-                }
-            }
-
-            if (i == 0) {
-                first         = cc->KeySwitchDownFirstElement(inner);
-                auto elements = inner->GetElements();
-                elements[0].SetValuesToZero();
-                inner->SetElements(elements);
-                outer = inner;
-            }
-            else {
-                if (rot_out[s][i] != 0) {
-                    inner = cc->KeySwitchDown(inner);
-                    // Find the automorphism index that corresponds to rotation index index.
-                    usint autoIndex = FindAutomorphismIndex2nComplex(rot_out[s][i], M);
-                    std::vector<usint> map(N);
-                    PrecomputeAutoMap(N, autoIndex, &map);
-                    first += inner->GetElements()[0].AutomorphismTransform(autoIndex, map);
-                    auto innerDigits = cc->EvalFastRotationPrecompute(inner);
-                    EvalAddExtInPlace(outer, cc->EvalFastRotationExt(inner, rot_out[s][i], innerDigits, false));
-                }
-                else {
-                    first += cc->KeySwitchDownFirstElement(inner);
-                    auto elements = inner->GetElements();
-                    elements[0].SetValuesToZero();
-                    inner->SetElements(elements);
-                    EvalAddExtInPlace(outer, inner);
-                }
-            }
-        }
-        result                          = cc->KeySwitchDown(outer);
-        std::vector<DCRTPoly>& elements = result->GetElements();
-        elements[0] += first;
+        result = EvalGiantStepsExt(fastRotation, A[s], rot_out[s], b, g, numRotations);
     }
 
     if (flagRem) {
@@ -1801,51 +2290,7 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector
             }
         }
 
-        Ciphertext<DCRTPoly> outer;
-        DCRTPoly first;
-        for (int32_t i = 0; i < bRem; i++) {
-            Ciphertext<DCRTPoly> inner;
-            // for the first iteration with j=0:
-            int32_t GRem = gRem * i;
-            inner        = EvalMultExt(fastRotation[0], A[stop][GRem]);
-            // continue the loop
-            for (int32_t j = 1; j < gRem; j++) {
-                if ((GRem + j) != int32_t(numRotationsRem)) {
-                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], A[stop][GRem + j]));
-                }
-            }
-
-            if (i == 0) {
-                first         = cc->KeySwitchDownFirstElement(inner);
-                auto elements = inner->GetElements();
-                elements[0].SetValuesToZero();
-                inner->SetElements(elements);
-                outer = inner;
-            }
-            else {
-                if (rot_out[stop][i] != 0) {
-                    inner = cc->KeySwitchDown(inner);
-                    // Find the automorphism index that corresponds to rotation index index.
-                    usint autoIndex = FindAutomorphismIndex2nComplex(rot_out[stop][i], M);
-                    std::vector<usint> map(N);
-                    PrecomputeAutoMap(N, autoIndex, &map);
-                    first += inner->GetElements()[0].AutomorphismTransform(autoIndex, map);
-                    auto innerDigits = cc->EvalFastRotationPrecompute(inner);
-                    EvalAddExtInPlace(outer, cc->EvalFastRotationExt(inner, rot_out[stop][i], innerDigits, false));
-                }
-                else {
-                    first += cc->KeySwitchDownFirstElement(inner);
-                    auto elements = inner->GetElements();
-                    elements[0].SetValuesToZero();
-                    inner->SetElements(elements);
-                    EvalAddExtInPlace(outer, inner);
-                }
-            }
-        }
-
-        result                          = cc->KeySwitchDown(outer);
-        std::vector<DCRTPoly>& elements = result->GetElements();
-        elements[0] += first;
+        result = EvalGiantStepsExt(fastRotation, A[stop], rot_out[stop], bRem, gRem, numRotationsRem);
     }
 
     return result;
@@ -1868,7 +2313,6 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffs(const std::vector<std::vector
     auto cc = ctxt->GetCryptoContext();
 
     uint32_t M = cc->GetCyclotomicOrder();
-    uint32_t N = cc->GetRingDimension();
 
     int32_t levelBudget     = precom->m_paramsDec[CKKS_BOOT_PARAMS::LEVEL_BUDGET];
     int32_t layersCollapse  = precom->m_paramsDec[CKKS_BOOT_PARAMS::LAYERS_COLL];
@@ -1951,51 +2395,7 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffs(const std::vector<std::vector
             }
         }
 
-        Ciphertext<DCRTPoly> outer;
-        DCRTPoly first;
-        for (int32_t i = 0; i < b; i++) {
-            Ciphertext<DCRTPoly> inner;
-            // for the first iteration with j=0:
-            int32_t G = g * i;
-            inner     = EvalMultExt(fastRotation[0], A[s][G]);
-            // continue the loop
-            for (int32_t j = 1; j < g; j++) {
-                if ((G + j) != int32_t(numRotations)) {
-                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], A[s][G + j]));
-                }
-            }
-
-            if (i == 0) {
-                first         = cc->KeySwitchDownFirstElement(inner);
-                auto elements = inner->GetElements();
-                elements[0].SetValuesToZero();
-                inner->SetElements(elements);
-                outer = inner;
-            }
-            else {
-                if (rot_out[s][i] != 0) {
-                    inner = cc->KeySwitchDown(inner);
-                    // Find the automorphism index that corresponds to rotation index index.
-                    usint autoIndex = FindAutomorphismIndex2nComplex(rot_out[s][i], M);
-                    std::vector<usint> map(N);
-                    PrecomputeAutoMap(N, autoIndex, &map);
-                    first += inner->GetElements()[0].AutomorphismTransform(autoIndex, map);
-                    auto innerDigits = cc->EvalFastRotationPrecompute(inner);
-                    EvalAddExtInPlace(outer, cc->EvalFastRotationExt(inner, rot_out[s][i], innerDigits, false));
-                }
-                else {
-                    first += cc->KeySwitchDownFirstElement(inner);
-                    auto elements = inner->GetElements();
-                    elements[0].SetValuesToZero();
-                    inner->SetElements(elements);
-                    EvalAddExtInPlace(outer, inner);
-                }
-            }
-        }
-
-        result                          = cc->KeySwitchDown(outer);
-        std::vector<DCRTPoly>& elements = result->GetElements();
-        elements[0] += first;
+        result = EvalGiantStepsExt(fastRotation, A[s], rot_out[s], b, g, numRotations);
     }
 
     if (flagRem) {
@@ -2015,52 +2415,91 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffs(const std::vector<std::vector
             }
         }
 
-        Ciphertext<DCRTPoly> outer;
-        DCRTPoly first;
-        for (int32_t i = 0; i < bRem; i++) {
-            Ciphertext<DCRTPoly> inner;
+        result = EvalGiantStepsExt(fastRotation, A[s], rot_out[s], bRem, gRem, numRotationsRem);
+    }
+
+    return result;
+}
+
+Ciphertext<DCRTPoly> FHECKKSRNS::EvalGiantStepsExt(const std::vector<Ciphertext<DCRTPoly>>& fastRotation,
+                                                   const std::vector<ConstPlaintext>& A,
+                                                   const std::vector<int32_t>& rotOut, int32_t b, int32_t g,
+                                                   int32_t numRotations) const {
+    auto cc    = fastRotation[0]->GetCryptoContext();
+    uint32_t M = cc->GetCyclotomicOrder();
+    uint32_t N = cc->GetRingDimension();
+
+    Ciphertext<DCRTPoly> outer;
+    DCRTPoly first;
+
+    // Nested parallelism is off, so a team smaller than the thread count would run the tower loops inside
+    // EvalMultExt and KeySwitchDown serially and leave threads idle. The giant steps are therefore split
+    // between threads only if there are enough of them; otherwise they run one after another with all
+    // threads working on the towers.
+#pragma omp parallel if (b >= omp_get_max_threads()) num_threads(OpenFHEParallelControls.GetThreadLimit(b))
+    {
+        // partial sums of the giant steps handled by this thread
+        Ciphertext<DCRTPoly> outerLocal;
+        DCRTPoly firstLocal;
+        bool empty = true;
+
+#pragma omp for schedule(dynamic)
+        for (int32_t i = 0; i < b; i++) {
             // for the first iteration with j=0:
-            int32_t GRem = gRem * i;
-            inner        = EvalMultExt(fastRotation[0], A[s][GRem]);
+            int32_t G                  = g * i;
+            Ciphertext<DCRTPoly> inner = EvalMultExt(fastRotation[0], A[G]);
             // continue the loop
-            for (int32_t j = 1; j < gRem; j++) {
-                if ((GRem + j) != int32_t(numRotationsRem))
-                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], A[s][GRem + j]));
+            for (int32_t j = 1; j < g; j++) {
+                if ((G + j) != numRotations) {
+                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], A[G + j]));
+                }
+            }
+
+            DCRTPoly firstCurrent;
+            if (rotOut[i] != 0) {
+                inner = cc->KeySwitchDown(inner);
+                // Find the automorphism index that corresponds to rotation index index.
+                usint autoIndex = FindAutomorphismIndex2nComplex(rotOut[i], M);
+                std::vector<usint> map(N);
+                PrecomputeAutoMap(N, autoIndex, &map);
+                firstCurrent     = inner->GetElements()[0].AutomorphismTransform(autoIndex, map);
+                auto innerDigits = cc->EvalFastRotationPrecompute(inner);
+                inner            = cc->EvalFastRotationExt(inner, rotOut[i], innerDigits, false);
+            }
+            else {
+                firstCurrent = cc->KeySwitchDownFirstElement(inner);
+                inner->GetElements()[0].SetValuesToZero();
             }
 
-            if (i == 0) {
-                first         = cc->KeySwitchDownFirstElement(inner);
-                auto elements = inner->GetElements();
-                elements[0].SetValuesToZero();
-                inner->SetElements(elements);
-                outer = inner;
+            if (empty) {
+                outerLocal = inner;
+                firstLocal = std::move(firstCurrent);
+                empty      = false;
             }
             else {
-                if (rot_out[s][i] != 0) {
-                    inner = cc->KeySwitchDown(inner);
-                    // Find the automorphism index that corresponds to rotation index index.
-                    usint autoIndex = FindAutomorphismIndex2nComplex(rot_out[s][i], M);
-                    std::vector<usint> map(N);
-                    PrecomputeAutoMap(N, autoIndex, &map);
-                    first += inner->GetElements()[0].AutomorphismTransform(autoIndex, map);
-                    auto innerDigits = cc->EvalFastRotationPrecompute(inner);
-                    EvalAddExtInPlace(outer, cc->EvalFastRotationExt(inner, rot_out[s][i], innerDigits, false));
+                EvalAddExtInPlace(outerLocal, inner);
+                firstLocal += firstCurrent;
+            }
+        }
+
+        if (!empty) {
+#pragma omp critical
+            {
+                if (!outer) {
+                    outer = outerLocal;
+                    first = std::move(firstLocal);
                 }
                 else {
-                    first += cc->KeySwitchDownFirstElement(inner);
-                    auto elements = inner->GetElements();
-                    elements[0].SetValuesToZero();
-                    inner->SetElements(elements);
-                    EvalAddExtInPlace(outer, inner);
+                    EvalAddExtInPlace(outer, outerLocal);
+                    first += firstLocal;
                 }
             }
         }
-
-        result                          = cc->KeySwitchDown(outer);
-        std::vector<DCRTPoly>& elements = result->GetElements();
-        elements[0] += first;
     }
 
+    Ciphertext<DCRTPoly> result     = cc->KeySwitchDown(outer);
+    std::vector<DCRTPoly>& elements = result->GetElements();
+    elements[0] += first;
     return result;
 }
 
@@ -2102,12 +2541,16 @@ void FHECKKSRNS::AdjustCiphertext(Ciphertext<DCRTPoly>& ciphertext, double corre
     auto cc   = ciphertext->GetCryptoContext();
     auto algo = cc->GetScheme();
 
-    if (cryptoParams->GetScalingTechnique() == FLEXIBLEAUTO || cryptoParams->GetScalingTechnique() == FLEXIBLEAUTOEXT) {
-        uint32_t lvl       = cryptoParams->GetScalingTechnique() == FLEXIBLEAUTO ? 0 : 1;
+    if (cryptoParams->GetScalingTechnique() == FLEXIBLEAUTO || cryptoParams->GetScalingTechnique() == FLEXIBLEAUTOEXT ||
+        cryptoParams->GetScalingTechnique() == COMPOSITESCALINGAUTO) {
+        uint32_t lvl       = cryptoParams->GetScalingTechnique() == FLEXIBLEAUTOEXT ? 1 : 0;
         double targetSF    = cryptoParams->GetScalingFactorReal(lvl);
         double sourceSF    = ciphertext->GetScalingFactor();
         uint32_t numTowers = ciphertext->GetElements()[0].GetNumOfElements();
-        double modToDrop = cryptoParams->GetElementParams()->GetParams()[numTowers - 1]->GetModulus().ConvertToDouble();
+        // the rescaling below drops all the towers of the current level
+        double modToDrop = 1.0;
+        for (uint32_t i = numTowers - cryptoParams->GetCompositeDegree(); i < numTowers; ++i)
+            modToDrop *= cryptoParams->GetElementParams()->GetParams()[i]->GetModulus().ConvertToDouble();
 
         // in the case of FLEXIBLEAUTO, we need to bring the ciphertext to the right scale using a
         // a scaling multiplication. Note the at currently FLEXIBLEAUTO is only supported for NATIVEINT = 64.
@@ -2135,6 +2578,68 @@ void FHECKKSRNS::AdjustCiphertext(Ciphertext<DCRTPoly>& ciphertext, double corre
     }
 }
 
+double FHECKKSRNS::GetLevelZeroModulus(const CryptoParametersCKKSRNS& cryptoParams) {
+    const auto& params = cryptoParams.GetElementParams()->GetParams();
+    double q0          = 1.0;
+    for (uint32_t i = 0; i < cryptoParams.GetCompositeDegree(); ++i)
+        q0 *= params[i]->GetModulus().ConvertToDouble();
+    return q0;
+}
+
+void FHECKKSRNS::ExtendCiphertext(std::vector<DCRTPoly>& ctxtDCRT,
+                                  const std::shared_ptr<DCRTPoly::Params>& paramsRaised, uint32_t numTowers) {
+    const auto& raised = paramsRaised->GetParams();
+    uint32_t M         = paramsRaised->GetCyclotomicOrder();
+    uint32_t sizeP     = raised.size() - numTowers;
+
+    std::vector<NativeInteger> moduliQ(numTowers), rootsQ(numTowers);
+    for (uint32_t i = 0; i < numTowers; ++i) {
+        moduliQ[i] = raised[i]->GetModulus();
+        rootsQ[i]  = raised[i]->GetRootOfUnity();
+    }
+    std::vector<NativeInteger> moduliP(sizeP), rootsP(sizeP);
+    for (uint32_t j = 0; j < sizeP; ++j) {
+        moduliP[j] = raised[numTowers + j]->GetModulus();
+        rootsP[j]  = raised[numTowers + j]->GetRootOfUnity();
+    }
+    auto paramsP = std::make_shared<ILDCRTParams<BigInteger>>(M, moduliP, rootsP);
+
+    // precomputations of the CRT basis switching from the moduli of level 0 to the other raised moduli
+    BigInteger modulusQ(1);
+    for (const auto& qi : moduliQ)
+        modulusQ *= BigInteger(qi.ConvertToInt());
+
+    std::vector<NativeInteger> QHatInvModq(numTowers), QHatInvModqPrecon(numTowers);
+    std::vector<double> qInv(numTowers);
+    std::vector<std::vector<NativeInteger>> QHatModp(sizeP, std::vector<NativeInteger>(numTowers));
+    for (uint32_t i = 0; i < numTowers; ++i) {
+        BigInteger qi(moduliQ[i].ConvertToInt());
+        BigInteger QHati     = modulusQ.DividedBy(qi);
+        QHatInvModq[i]       = QHati.ModInverse(qi).Mod(qi).ConvertToInt();
+        QHatInvModqPrecon[i] = QHatInvModq[i].PrepModMulConst(moduliQ[i]);
+        qInv[i]              = 1. / moduliQ[i].ConvertToDouble();
+        for (uint32_t j = 0; j < sizeP; ++j)
+            QHatModp[j][i] = QHati.Mod(BigInteger(moduliP[j].ConvertToInt())).ConvertToInt();
+    }
+
+    const auto BarrettBase128Bit(BigInteger(1).LShiftEq(128));
+    std::vector<std::vector<NativeInteger>> alphaQModp(numTowers + 1, std::vector<NativeInteger>(sizeP));
+    std::vector<DoubleNativeInt> modpBarrettMu(sizeP);
+    for (uint32_t j = 0; j < sizeP; ++j) {
+        BigInteger pj(moduliP[j].ConvertToInt());
+        for (uint32_t alpha = 0; alpha <= numTowers; ++alpha)
+            alphaQModp[alpha][j] = (modulusQ * BigInteger(alpha)).Mod(pj).ConvertToInt();
+        modpBarrettMu[j] = (BarrettBase128Bit / pj).ConvertToInt<DoubleNativeInt>();
+    }
+
+    // the basis switching rounds to the centered representative modulo Q_0, as the lifting of a single tower does
+    for (auto& c : ctxtDCRT) {
+        c.DropLastElements(c.GetNumOfElements() - numTowers);
+        c.ExpandCRTBasis(paramsRaised, paramsP, QHatInvModq, QHatInvModqPrecon, QHatModp, alphaQModp, modpBarrettMu,
+                         qInv, EVALUATION);
+    }
+}
+
 void FHECKKSRNS::ApplyDoubleAngleIterations(Ciphertext<DCRTPoly>& ciphertext, uint32_t numIter) const {
     auto cc = ciphertext->GetCryptoContext();
 
@@ -44,6 +44,22 @@ CKKS implementation. See https://eprint.iacr.org/2020/1118 for details.
 
 namespace lbcrypto {
 
+namespace {
+// looks the constant encoded for the towers of ciphertext up in the context cache or encodes it with encode
+template <typename EncodeFunc>
+std::vector<DCRTPoly::Integer> GetCachedConstant(ConstCiphertext<DCRTPoly> ciphertext, double operand, bool forMult,
+                                                 const EncodeFunc& encode) {
+    // NaN breaks the ordering of the keys
+    if (std::isnan(operand))
+        return encode();
+
+    const uint32_t numTowers     = ciphertext->GetElements()[0].GetNumOfElements();
+    const uint32_t noiseScaleDeg = forMult ? 0 : ciphertext->GetNoiseScaleDeg();
+    return ciphertext->GetCryptoContext()->GetEncodedConstantCache().GetOrCompute(
+        {operand, static_cast<uint32_t>(ciphertext->GetLevel()), numTowers, noiseScaleDeg, forMult}, encode);
+}
+}  // namespace
+
 /////////////////////////////////////////
 // SHE ADDITION CONSTANT
 /////////////////////////////////////////
@@ -56,7 +72,9 @@ Ciphertext<DCRTPoly> LeveledSHECKKSRNS::EvalAdd(ConstCiphertext<DCRTPoly> cipher
 
 void LeveledSHECKKSRNS::EvalAddInPlace(Ciphertext<DCRTPoly>& ciphertext, double operand) const {
     std::vector<DCRTPoly>& cv = ciphertext->GetElements();
-    cv[0]                     = cv[0] + GetElementForEvalAddOrSub(ciphertext, operand);
+    cv[0]                     = cv[0] + GetCachedConstant(ciphertext, operand, false, [&]() {
+        return GetElementForEvalAddOrSub(ciphertext, operand);
+    });
 }
 
 /////////////////////////////////////////
@@ -71,13 +89,62 @@ Ciphertext<DCRTPoly> LeveledSHECKKSRNS::EvalSub(ConstCiphertext<DCRTPoly> cipher
 
 void LeveledSHECKKSRNS::EvalSubInPlace(Ciphertext<DCRTPoly>& ciphertext, double operand) const {
     std::vector<DCRTPoly>& cv = ciphertext->GetElements();
-    cv[0]                     = cv[0] - GetElementForEvalAddOrSub(ciphertext, operand);
+    cv[0]                     = cv[0] - GetCachedConstant(ciphertext, operand, false, [&]() {
+        return GetElementForEvalAddOrSub(ciphertext, operand);
+    });
 }
 
 /////////////////////////////////////////
 // SHE MULTIPLICATION
 /////////////////////////////////////////
 
+Ciphertext<DCRTPoly> LeveledSHECKKSRNS::EvalMult(ConstCiphertext<DCRTPoly> ciphertext1,
+                                                 ConstCiphertext<DCRTPoly> ciphertext2,
+                                                 const EvalKey<DCRTPoly> evalKey) const {
+    Ciphertext<DCRTPoly> ciphertext = EvalMult(ciphertext1, ciphertext2);
+    RelinearizeCoreInPlace(ciphertext, evalKey);
+    return ciphertext;
+}
+
+void LeveledSHECKKSRNS::EvalMultInPlace(Ciphertext<DCRTPoly>& ciphertext1, ConstCiphertext<DCRTPoly> ciphertext2,
+                                        const EvalKey<DCRTPoly> evalKey) const {
+    ciphertext1 = EvalMult(ciphertext1, ciphertext2);
+    RelinearizeCoreInPlace(ciphertext1, evalKey);
+}
+
+Ciphertext<DCRTPoly> LeveledSHECKKSRNS::EvalMultMutable(Ciphertext<DCRTPoly>& ciphertext1,
+                                                        Ciphertext<DCRTPoly>& ciphertext2,
+                                                        const EvalKey<DCRTPoly> evalKey) const {
+    Ciphertext<DCRTPoly> ciphertext = EvalMultMutable(ciphertext1, ciphertext2);
+    RelinearizeCoreInPlace(ciphertext, evalKey);
+    return ciphertext;
+}
+
+void LeveledSHECKKSRNS::EvalMultMutableInPlace(Ciphertext<DCRTPoly>& ciphertext1, Ciphertext<DCRTPoly>& ciphertext2,
+                                               const EvalKey<DCRTPoly> evalKey) const {
+    ciphertext1 = EvalMultMutable(ciphertext1, ciphertext2);
+    RelinearizeCoreInPlace(ciphertext1, evalKey);
+}
+
+Ciphertext<DCRTPoly> LeveledSHECKKSRNS::EvalSquare(ConstCiphertext<DCRTPoly> ciphertext,
+                                                   const EvalKey<DCRTPoly> evalKey) const {
+    Ciphertext<DCRTPoly> csquare = EvalSquare(ciphertext);
+    RelinearizeCoreInPlace(csquare, evalKey);
+    return csquare;
+}
+
+void LeveledSHECKKSRNS::EvalSquareInPlace(Ciphertext<DCRTPoly>& ciphertext, const EvalKey<DCRTPoly> evalKey) const {
+    ciphertext = EvalSquare(ciphertext);
+    RelinearizeCoreInPlace(ciphertext, evalKey);
+}
+
+Ciphertext<DCRTPoly> LeveledSHECKKSRNS::EvalSquareMutable(Ciphertext<DCRTPoly>& ciphertext,
+                                                          const EvalKey<DCRTPoly> evalKey) const {
+    Ciphertext<DCRTPoly> csquare = EvalSquareMutable(ciphertext);
+    RelinearizeCoreInPlace(csquare, evalKey);
+    return csquare;
+}
+
 Ciphertext<DCRTPoly> LeveledSHECKKSRNS::EvalMult(ConstCiphertext<DCRTPoly> ciphertext, double operand) const {
     Ciphertext<DCRTPoly> result = ciphertext->Clone();
     EvalMultInPlace(result, operand);
@@ -113,7 +180,10 @@ void LeveledSHECKKSRNS::ModReduceInternalInPlace(Ciphertext<DCRTPoly>& ciphertex
     size_t sizeQl = cv[0].GetNumOfElements();
     size_t diffQl = sizeQ - sizeQl;
 
-    for (size_t l = 0; l < levels; ++l) {
+    // with composite scaling every rescaling drops all the moduli of one level
+    size_t towers = levels * cryptoParams->GetCompositeDegree();
+
+    for (size_t l = 0; l < towers; ++l) {
         for (size_t i = 0; i < cv.size(); ++i) {
             cv[i].DropLastElementAndScale(cryptoParams->GetQlQlInvModqlDivqlModq(diffQl + l),
                                           cryptoParams->GetqlInvModq(diffQl + l));
@@ -121,14 +191,30 @@ void LeveledSHECKKSRNS::ModReduceInternalInPlace(Ciphertext<DCRTPoly>& ciphertex
     }
 
     ciphertext->SetNoiseScaleDeg(ciphertext->GetNoiseScaleDeg() - levels);
-    ciphertext->SetLevel(ciphertext->GetLevel() + levels);
+    ciphertext->SetLevel(ciphertext->GetLevel() + towers);
 
-    for (usint i = 0; i < levels; ++i) {
+    for (usint i = 0; i < towers; ++i) {
         double modReduceFactor = cryptoParams->GetModReduceFactor(sizeQl - 1 - i);
         ciphertext->SetScalingFactor(ciphertext->GetScalingFactor() / modReduceFactor);
     }
 }
 
+Ciphertext<DCRTPoly> LeveledSHECKKSRNS::ComposedEvalMult(ConstCiphertext<DCRTPoly> ciphertext1,
+                                                         ConstCiphertext<DCRTPoly> ciphertext2,
+                                                         const EvalKey<DCRTPoly> evalKey) const {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext1->GetCryptoParameters());
+    if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL || !cryptoParams->GetFusedRescale())
+        return LeveledSHERNS::ComposedEvalMult(ciphertext1, ciphertext2, evalKey);
+
+    Ciphertext<DCRTPoly> ciphertext = EvalMult(ciphertext1, ciphertext2);
+    if (KeySwitchRescaleInPlace(ciphertext, evalKey))
+        return ciphertext;
+
+    RelinearizeCoreInPlace(ciphertext, evalKey);
+    ModReduceInPlace(ciphertext, BASE_NUM_LEVELS_TO_DROP);
+    return ciphertext;
+}
+
 /////////////////////////////////////
 // Level Reduce
 /////////////////////////////////////
@@ -280,8 +366,7 @@ std::vector<DCRTPoly::Integer> LeveledSHECKKSRNS::GetElementForEvalAddOrSub(Cons
         return crtConstant;
     }
 
-    DCRTPoly::Integer intScFactor = static_cast<uint64_t>(scFactor + 0.5);
-    std::vector<DCRTPoly::Integer> crtScFactor(sizeQl, intScFactor);
+    std::vector<DCRTPoly::Integer> crtScFactor = CKKSPackedEncoding::CRTFromDouble(scFactor, moduli);
 
     for (usint i = 1; i < ciphertext->GetNoiseScaleDeg(); i++) {
         crtConstant = CKKSPackedEncoding::CRTMult(crtConstant, crtScFactor, moduli);
@@ -433,63 +518,6 @@ std::vector<DCRTPoly::Integer> LeveledSHECKKSRNS::GetElementForEvalMult(ConstCip
 
 #endif
 
-Ciphertext<DCRTPoly> LeveledSHECKKSRNS::EvalFastRotationExt(ConstCiphertext<DCRTPoly> ciphertext, usint index,
-                                                            const std::shared_ptr<std::vector<DCRTPoly>> digits,
-                                                            bool addFirst,
-                                                            const std::map<usint, EvalKey<DCRTPoly>>& evalKeys) const {
-    //  if (index == 0) {
-    //    Ciphertext<DCRTPoly> result = ciphertext->Clone();
-    //    return result;
-    //  }
-
-    const auto cc = ciphertext->GetCryptoContext();
-
-    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
-
-    usint N = cryptoParams->GetElementParams()->GetRingDimension();
-    usint M = cryptoParams->GetElementParams()->GetCyclotomicOrder();
-
-    // Find the automorphism index that corresponds to rotation index index.
-    usint autoIndex = FindAutomorphismIndex2nComplex(index, M);
-
-    // Retrieve the automorphism key that corresponds to the auto index.
-    auto evalKeyIterator = evalKeys.find(autoIndex);
-    if (evalKeyIterator == evalKeys.end()) {
-        OPENFHE_THROW("EvalKey for index [" + std::to_string(autoIndex) + "] is not found.");
-    }
-    auto evalKey = evalKeyIterator->second;
-
-    const std::vector<DCRTPoly>& cv = ciphertext->GetElements();
-    const auto paramsQl             = cv[0].GetParams();
-
-    auto algo = cc->GetScheme();
-
-    std::shared_ptr<std::vector<DCRTPoly>> cTilda = algo->EvalFastKeySwitchCoreExt(digits, evalKey, paramsQl);
-
-    if (addFirst) {
-        const auto paramsQlP = (*cTilda)[0].GetParams();
-        size_t sizeQl        = paramsQl->GetParams().size();
-        DCRTPoly psiC0       = DCRTPoly(paramsQlP, Format::EVALUATION, true);
-        auto cMult           = ciphertext->GetElements()[0].TimesNoCheck(cryptoParams->GetPModq());
-        for (usint i = 0; i < sizeQl; i++) {
-            psiC0.SetElementAtIndex(i, cMult.GetElementAtIndex(i));
-        }
-        (*cTilda)[0] += psiC0;
-    }
-
-    std::vector<usint> vec(N);
-    PrecomputeAutoMap(N, autoIndex, &vec);
-
-    (*cTilda)[0] = (*cTilda)[0].AutomorphismTransform(autoIndex, vec);
-    (*cTilda)[1] = (*cTilda)[1].AutomorphismTransform(autoIndex, vec);
-
-    Ciphertext<DCRTPoly> result = ciphertext->CloneZero();
-
-    result->SetElements({std::move((*cTilda)[0]), std::move((*cTilda)[1])});
-
-    return result;
-}
-
 Ciphertext<DCRTPoly> LeveledSHECKKSRNS::MultByInteger(ConstCiphertext<DCRTPoly> ciphertext, uint64_t integer) const {
     const std::vector<DCRTPoly>& cv = ciphertext->GetElements();
 
@@ -518,6 +546,16 @@ void LeveledSHECKKSRNS::AdjustLevelsAndDepthInPlace(Ciphertext<DCRTPoly>& cipher
     usint c2depth           = ciphertext2->GetNoiseScaleDeg();
     auto sizeQl1            = ciphertext1->GetElements()[0].GetNumOfElements();
     auto sizeQl2            = ciphertext2->GetElements()[0].GetNumOfElements();
+    // number of RNS towers consumed by one rescaling
+    usint d = cryptoParams->GetCompositeDegree();
+
+    // product of the moduli dropped by the next rescaling of a ciphertext with sizeQl towers
+    auto modReduceFactor = [&](size_t sizeQl) {
+        double q = 1.0;
+        for (usint j = 1; j <= d; ++j)
+            q *= cryptoParams->GetModReduceFactor(sizeQl - j);
+        return q;
+    };
 
     if (c1lvl < c2lvl) {
         if (c1depth == 2) {
@@ -525,27 +563,27 @@ void LeveledSHECKKSRNS::AdjustLevelsAndDepthInPlace(Ciphertext<DCRTPoly>& cipher
                 double scf1 = ciphertext1->GetScalingFactor();
                 double scf2 = ciphertext2->GetScalingFactor();
                 double scf  = cryptoParams->GetScalingFactorReal(c1lvl);
-                double q1   = cryptoParams->GetModReduceFactor(sizeQl1 - 1);
+                double q1   = modReduceFactor(sizeQl1);
                 EvalMultCoreInPlace(ciphertext1, scf2 / scf1 * q1 / scf);
                 ModReduceInternalInPlace(ciphertext1, BASE_NUM_LEVELS_TO_DROP);
-                if (c1lvl + 1 < c2lvl) {
-                    LevelReduceInternalInPlace(ciphertext1, c2lvl - c1lvl - 1);
+                if (c1lvl + d < c2lvl) {
+                    LevelReduceInternalInPlace(ciphertext1, c2lvl - c1lvl - d);
                 }
                 ciphertext1->SetScalingFactor(ciphertext2->GetScalingFactor());
             }
             else {
-                if (c1lvl + 1 == c2lvl) {
+                if (c1lvl + d == c2lvl) {
                     ModReduceInternalInPlace(ciphertext1, BASE_NUM_LEVELS_TO_DROP);
                 }
                 else {
                     double scf1 = ciphertext1->GetScalingFactor();
-                    double scf2 = cryptoParams->GetScalingFactorRealBig(c2lvl - 1);
+                    double scf2 = cryptoParams->GetScalingFactorRealBig(c2lvl - d);
                     double scf  = cryptoParams->GetScalingFactorReal(c1lvl);
-                    double q1   = cryptoParams->GetModReduceFactor(sizeQl1 - 1);
+                    double q1   = modReduceFactor(sizeQl1);
                     EvalMultCoreInPlace(ciphertext1, scf2 / scf1 * q1 / scf);
                     ModReduceInternalInPlace(ciphertext1, BASE_NUM_LEVELS_TO_DROP);
-                    if (c1lvl + 2 < c2lvl) {
-                        LevelReduceInternalInPlace(ciphertext1, c2lvl - c1lvl - 2);
+                    if (c1lvl + 2 * d < c2lvl) {
+                        LevelReduceInternalInPlace(ciphertext1, c2lvl - c1lvl - 2 * d);
                     }
                     ModReduceInternalInPlace(ciphertext1, BASE_NUM_LEVELS_TO_DROP);
                     ciphertext1->SetScalingFactor(ciphertext2->GetScalingFactor());
@@ -563,11 +601,11 @@ void LeveledSHECKKSRNS::AdjustLevelsAndDepthInPlace(Ciphertext<DCRTPoly>& cipher
             }
             else {
                 double scf1 = ciphertext1->GetScalingFactor();
-                double scf2 = cryptoParams->GetScalingFactorRealBig(c2lvl - 1);
+                double scf2 = cryptoParams->GetScalingFactorRealBig(c2lvl - d);
                 double scf  = cryptoParams->GetScalingFactorReal(c1lvl);
                 EvalMultCoreInPlace(ciphertext1, scf2 / scf1 / scf);
-                if (c1lvl + 1 < c2lvl) {
-                    LevelReduceInternalInPlace(ciphertext1, c2lvl - c1lvl - 1);
+                if (c1lvl + d < c2lvl) {
+                    LevelReduceInternalInPlace(ciphertext1, c2lvl - c1lvl - d);
                 }
                 ModReduceInternalInPlace(ciphertext1, BASE_NUM_LEVELS_TO_DROP);
                 ciphertext1->SetScalingFactor(ciphertext2->GetScalingFactor());
@@ -580,27 +618,27 @@ void LeveledSHECKKSRNS::AdjustLevelsAndDepthInPlace(Ciphertext<DCRTPoly>& cipher
                 double scf2 = ciphertext2->GetScalingFactor();
                 double scf1 = ciphertext1->GetScalingFactor();
                 double scf  = cryptoParams->GetScalingFactorReal(c2lvl);
-                double q2   = cryptoParams->GetModReduceFactor(sizeQl2 - 1);
+                double q2   = modReduceFactor(sizeQl2);
                 EvalMultCoreInPlace(ciphertext2, scf1 / scf2 * q2 / scf);
                 ModReduceInternalInPlace(ciphertext2, BASE_NUM_LEVELS_TO_DROP);
-                if (c2lvl + 1 < c1lvl) {
-                    LevelReduceInternalInPlace(ciphertext2, c1lvl - c2lvl - 1);
+                if (c2lvl + d < c1lvl) {
+                    LevelReduceInternalInPlace(ciphertext2, c1lvl - c2lvl - d);
                 }
                 ciphertext2->SetScalingFactor(ciphertext1->GetScalingFactor());
             }
             else {
-                if (c2lvl + 1 == c1lvl) {
+                if (c2lvl + d == c1lvl) {
                     ModReduceInternalInPlace(ciphertext2, BASE_NUM_LEVELS_TO_DROP);
                 }
                 else {
                     double scf2 = ciphertext2->GetScalingFactor();
-                    double scf1 = cryptoParams->GetScalingFactorRealBig(c1lvl - 1);
+                    double scf1 = cryptoParams->GetScalingFactorRealBig(c1lvl - d);
                     double scf  = cryptoParams->GetScalingFactorReal(c2lvl);
-                    double q2   = cryptoParams->GetModReduceFactor(sizeQl2 - 1);
+                    double q2   = modReduceFactor(sizeQl2);
                     EvalMultCoreInPlace(ciphertext2, scf1 / scf2 * q2 / scf);
                     ModReduceInternalInPlace(ciphertext2, BASE_NUM_LEVELS_TO_DROP);
-                    if (c2lvl + 2 < c1lvl) {
-                        LevelReduceInternalInPlace(ciphertext2, c1lvl - c2lvl - 2);
+                    if (c2lvl + 2 * d < c1lvl) {
+                        LevelReduceInternalInPlace(ciphertext2, c1lvl - c2lvl - 2 * d);
                     }
                     ModReduceInternalInPlace(ciphertext2, BASE_NUM_LEVELS_TO_DROP);
                     ciphertext2->SetScalingFactor(ciphertext1->GetScalingFactor());
@@ -618,11 +656,11 @@ void LeveledSHECKKSRNS::AdjustLevelsAndDepthInPlace(Ciphertext<DCRTPoly>& cipher
             }
             else {
                 double scf2 = ciphertext2->GetScalingFactor();
-                double scf1 = cryptoParams->GetScalingFactorRealBig(c1lvl - 1);
+                double scf1 = cryptoParams->GetScalingFactorRealBig(c1lvl - d);
                 double scf  = cryptoParams->GetScalingFactorReal(c2lvl);
                 EvalMultCoreInPlace(ciphertext2, scf1 / scf2 / scf);
-                if (c2lvl + 1 < c1lvl) {
-                    LevelReduceInternalInPlace(ciphertext2, c1lvl - c2lvl - 1);
+                if (c2lvl + d < c1lvl) {
+                    LevelReduceInternalInPlace(ciphertext2, c1lvl - c2lvl - d);
                 }
                 ModReduceInternalInPlace(ciphertext2, BASE_NUM_LEVELS_TO_DROP);
                 ciphertext2->SetScalingFactor(ciphertext1->GetScalingFactor());
@@ -649,10 +687,54 @@ void LeveledSHECKKSRNS::AdjustLevelsAndDepthToOneInPlace(Ciphertext<DCRTPoly>& c
     }
 }
 
+void LeveledSHECKKSRNS::RelinearizeCoreInPlace(Ciphertext<DCRTPoly>& ciphertext,
+                                               const EvalKey<DCRTPoly> evalKey) const {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
+
+    // With the fused rescale enabled, FLEXIBLEAUTO products are rescaled now instead of before the next
+    // multiplication, so that the rescaling shares the ModDown of the key switch
+    if (cryptoParams->GetScalingTechnique() == FLEXIBLEAUTO && ciphertext->GetNoiseScaleDeg() == 2 &&
+        KeySwitchRescaleInPlace(ciphertext, evalKey))
+        return;
+
+    std::vector<DCRTPoly>& cv = ciphertext->GetElements();
+    for (auto& c : cv)
+        c.SetFormat(Format::EVALUATION);
+
+    auto ab = ciphertext->GetCryptoContext()->GetScheme()->KeySwitchCore(cv[2], evalKey);
+
+    cv[0] += (*ab)[0];
+    cv[1] += (*ab)[1];
+
+    cv.resize(2);
+}
+
+bool LeveledSHECKKSRNS::KeySwitchRescaleInPlace(Ciphertext<DCRTPoly>& ciphertext,
+                                                const EvalKey<DCRTPoly> evalKey) const {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
+
+    std::vector<DCRTPoly>& cv = ciphertext->GetElements();
+    size_t sizeQl             = cv[0].GetNumOfElements();
+    if (!cryptoParams->GetFusedRescale() || !cryptoParams->HasKeySwitchRescaleTables() || cv.size() != 3 ||
+        sizeQl < 2)
+        return false;
+
+    for (auto& c : cv)
+        c.SetFormat(Format::EVALUATION);
+
+    ciphertext->GetCryptoContext()->GetScheme()->KeySwitchRescaleInPlace(ciphertext, evalKey);
+
+    ciphertext->SetNoiseScaleDeg(ciphertext->GetNoiseScaleDeg() - 1);
+    ciphertext->SetLevel(ciphertext->GetLevel() + 1);
+    ciphertext->SetScalingFactor(ciphertext->GetScalingFactor() / cryptoParams->GetModReduceFactor(sizeQl - 1));
+    return true;
+}
+
 void LeveledSHECKKSRNS::EvalMultCoreInPlace(Ciphertext<DCRTPoly>& ciphertext, double operand) const {
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
 
-    std::vector<DCRTPoly::Integer> factors = GetElementForEvalMult(ciphertext, operand);
+    std::vector<DCRTPoly::Integer> factors =
+        GetCachedConstant(ciphertext, operand, true, [&]() { return GetElementForEvalMult(ciphertext, operand); });
     std::vector<DCRTPoly>& cv              = ciphertext->GetElements();
     for (usint i = 0; i < cv.size(); ++i) {
         cv[i] = cv[i] * factors;
@@ -122,6 +122,9 @@ Ciphertext<DCRTPoly> MultipartyCKKSRNS::IntMPBootAdjustScale(ConstCiphertext<DCR
     auto cc                 = ciphertext->GetCryptoContext();
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(cc->GetCryptoParameters());
 
+    if (cryptoParams->GetScalingTechnique() == COMPOSITESCALINGAUTO)
+        OPENFHE_THROW("Interactive bootstrapping is not supported for the COMPOSITESCALINGAUTO method.");
+
     auto compressionLevel = cryptoParams->GetMPIntBootCiphertextCompressionLevel();
 
     // Compress ctxt and reduce it to numPrimesToKeep towers
@@ -47,17 +47,159 @@ const size_t AUXMODSIZE = 119;
 const size_t AUXMODSIZE = 60;
 #endif
 
+namespace {
+// Sets the element parameters built from moduliQ, checks/sets the batch size and runs the CRT precomputations
+void SetElementParamsAndPrecompute(const std::shared_ptr<CryptoParametersCKKSRNS>& cryptoParamsCKKSRNS,
+                                   usint cyclOrder, const std::vector<NativeInteger>& moduliQ,
+                                   const std::vector<NativeInteger>& rootsQ, uint32_t numPartQ, uint32_t auxBits,
+                                   usint extraModSize) {
+    auto paramsDCRT = std::make_shared<ILDCRTParams<BigInteger>>(cyclOrder, moduliQ, rootsQ);
+
+    cryptoParamsCKKSRNS->SetElementParams(paramsDCRT);
+
+    uint32_t n                          = cyclOrder / 2;
+    const EncodingParams encodingParams = cryptoParamsCKKSRNS->GetEncodingParams();
+    if (encodingParams->GetBatchSize() > n / 2)
+        OPENFHE_THROW("The batch size cannot be larger than ring dimension / 2.");
+
+    if (encodingParams->GetBatchSize() & (encodingParams->GetBatchSize() - 1))
+        OPENFHE_THROW("The batch size can only be set to zero (for full packing) or a power of two.");
+
+    // if no batch size was specified, we set batchSize = n/2 by default (for full
+    // packing)
+    if (encodingParams->GetBatchSize() == 0) {
+        uint32_t batchSize = n / 2;
+        EncodingParams encodingParamsNew(
+            std::make_shared<EncodingParamsImpl>(encodingParams->GetPlaintextModulus(), batchSize));
+        cryptoParamsCKKSRNS->SetEncodingParams(encodingParamsNew);
+    }
+
+    cryptoParamsCKKSRNS->PrecomputeCRTTables(
+        cryptoParamsCKKSRNS->GetKeySwitchTechnique(), cryptoParamsCKKSRNS->GetScalingTechnique(),
+        cryptoParamsCKKSRNS->GetEncryptionTechnique(), cryptoParamsCKKSRNS->GetMultiplicationTechnique(), numPartQ,
+        auxBits, extraModSize);
+}
+
+/*
+ * With SPARSE_ENCAPSULATED, the key switching to the ephemeral secret of Hamming weight H_ENCAPSULATED (32)
+ * is an RLWE sample modulo Q_0 * P, where Q_0 is the modulus of level 0 and P is the whole key switching
+ * modulus. Such a sparse secret is secure only for a much smaller modulus than a uniform ternary secret.
+ * The supported bound is 120 bits for N = 2^16, i.e., one 60-bit prime of Q and one of P, scaled linearly
+ * with N like the HE standard bounds. It is a conservative setting for 128-bit classical security; other
+ * security levels are not supported. Nothing is checked for HEStd_NotSet, as for the rest of the parameters.
+ */
+void CheckEncapsulationModulus(const std::shared_ptr<CryptoParametersCKKSRNS>& cryptoParamsCKKSRNS) {
+    SecurityLevel stdLevel = cryptoParamsCKKSRNS->GetStdLevel();
+    if (cryptoParamsCKKSRNS->GetSecretKeyDist() != SPARSE_ENCAPSULATED || stdLevel == HEStd_NotSet)
+        return;
+
+    if (stdLevel != HEStd_128_classic)
+        OPENFHE_THROW("SPARSE_ENCAPSULATED is supported for HEStd_128_classic or HEStd_NotSet only.");
+
+    const auto& paramsQ = cryptoParamsCKKSRNS->GetElementParams()->GetParams();
+    const auto& paramsP = cryptoParamsCKKSRNS->GetParamsP()->GetParams();
+
+    double logQ0P = 0;
+    for (uint32_t i = 0; i < cryptoParamsCKKSRNS->GetCompositeDegree(); ++i)
+        logQ0P += std::log2(paramsQ[i]->GetModulus().ConvertToDouble());
+    for (const auto& p : paramsP)
+        logQ0P += std::log2(p->GetModulus().ConvertToDouble());
+
+    uint32_t n       = cryptoParamsCKKSRNS->GetElementParams()->GetRingDimension();
+    double maxLogQ0P = 120.0 * n / (1 << 16);
+    if (logQ0P > maxLogQ0P) {
+        OPENFHE_THROW("SPARSE_ENCAPSULATED needs log2(Q_0 * P) <= " + std::to_string(maxLogQ0P) +
+                      " for ring dimension " + std::to_string(n) + " to keep the sparse secret secure, but it is " +
+                      std::to_string(logQ0P) +
+                      ". Increase the number of large digits (numLargeDigits) to reduce the number of P moduli,"
+                      " or increase the ring dimension.");
+    }
+}
+
+/*
+ * Generates the moduli for COMPOSITESCALINGAUTO: every level is the product of compositeDegree primes,
+ * so scaling factors wider than a machine word can be used. The towers of level i are stored at
+ * [i*compositeDegree, (i+1)*compositeDegree). As in FLEXIBLEAUTO, the primes of each level are chosen to
+ * track the scaling factor of that level (sf_i = sf_{i+1}^2 / Q_{i+1}) so that it stays close to the
+ * original one.
+ */
+std::vector<NativeInteger> GenerateCompositeModuli(usint cyclOrder, usint numPrimes, uint32_t compositeDegree,
+                                                   usint scalingModSize, usint firstModSize) {
+    for (auto bits : {scalingModSize, firstModSize}) {
+        if (static_cast<usint>(std::ceil(static_cast<double>(bits) / compositeDegree)) > MAX_MODULUS_SIZE - 1)
+            OPENFHE_THROW("A modulus size of " + std::to_string(bits) + " bits cannot be split into " +
+                          std::to_string(compositeDegree) + " primes of at most " +
+                          std::to_string(MAX_MODULUS_SIZE - 1) + " bits each.");
+    }
+
+    std::vector<NativeInteger> moduliQ(numPrimes * compositeDegree);
+    uint32_t numAssigned = 0;
+
+    // unused prime congruent to 1 modulo cyclOrder that is closest to target
+    auto closestPrime = [&](double target) -> NativeInteger {
+        NativeInteger t(static_cast<uint64_t>(std::llround(target)));
+        NativeInteger below = t - t.Mod(cyclOrder) + NativeInteger(1);
+        NativeInteger above = below + NativeInteger(cyclOrder);
+        auto isUsable       = [&](const NativeInteger& p) {
+            auto end = moduliQ.end();
+            auto beg = end - numAssigned;
+            return std::find(beg, end, p) == end && MillerRabinPrimalityTest(p);
+        };
+        while (true) {
+            if (below > NativeInteger(cyclOrder) &&
+                std::abs(below.ConvertToDouble() - target) <= std::abs(above.ConvertToDouble() - target)) {
+                if (isUsable(below))
+                    return below;
+                below -= NativeInteger(cyclOrder);
+            }
+            else {
+                if (isUsable(above))
+                    return above;
+                above += NativeInteger(cyclOrder);
+            }
+        }
+    };
+
+    // fills the towers of level i with primes whose product is close to target
+    auto assignLevel = [&](usint i, double target) {
+        for (uint32_t j = compositeDegree; j > 0; --j) {
+            double q     = (j == 1) ? target : std::pow(target, 1.0 / j);
+            uint32_t idx = i * compositeDegree + j - 1;
+            moduliQ[idx] = closestPrime(q);
+            numAssigned++;
+            target /= moduliQ[idx].ConvertToDouble();
+        }
+    };
+    auto levelProduct = [&](usint i) {
+        double prod = 1;
+        for (uint32_t j = 0; j < compositeDegree; ++j)
+            prod *= moduliQ[i * compositeDegree + j].ConvertToDouble();
+        return prod;
+    };
+
+    if (numPrimes > 1) {
+        assignLevel(numPrimes - 1, std::pow(2.0, scalingModSize));
+        double sf = levelProduct(numPrimes - 1);
+        for (usint i = numPrimes - 2; i >= 1; i--) {
+            sf = sf * (sf / levelProduct(i + 1));
+            assignLevel(i, sf);
+        }
+    }
+    assignLevel(0, std::pow(2.0, firstModSize));
+
+    return moduliQ;
+}
+}  // namespace
+
 bool ParameterGenerationCKKSRNS::ParamsGenCKKSRNS(std::shared_ptr<CryptoParametersBase<DCRTPoly>> cryptoParams,
                                                   usint cyclOrder, usint numPrimes, usint scalingModSize,
                                                   usint firstModSize, uint32_t numPartQ,
                                                   COMPRESSION_LEVEL mPIntBootCiphertextCompressionLevel) const {
     const auto cryptoParamsCKKSRNS = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(cryptoParams);
 
-    KeySwitchTechnique ksTech        = cryptoParamsCKKSRNS->GetKeySwitchTechnique();
-    ScalingTechnique scalTech        = cryptoParamsCKKSRNS->GetScalingTechnique();
-    EncryptionTechnique encTech      = cryptoParamsCKKSRNS->GetEncryptionTechnique();
-    MultiplicationTechnique multTech = cryptoParamsCKKSRNS->GetMultiplicationTechnique();
-    ProxyReEncryptionMode PREMode    = cryptoParamsCKKSRNS->GetPREMode();
+    KeySwitchTechnique ksTech     = cryptoParamsCKKSRNS->GetKeySwitchTechnique();
+    ScalingTechnique scalTech     = cryptoParamsCKKSRNS->GetScalingTechnique();
+    ProxyReEncryptionMode PREMode = cryptoParamsCKKSRNS->GetPREMode();
 
     if ((PREMode != INDCPA) && (PREMode != NOT_SET)) {
         std::stringstream s;
@@ -65,6 +207,11 @@ bool ParameterGenerationCKKSRNS::ParamsGenCKKSRNS(std::shared_ptr<CryptoParamete
         OPENFHE_THROW(s.str());
     }
 
+    // the ephemeral sparse secret of SPARSE_ENCAPSULATED may only be used modulo q_0 * P, which requires a key
+    // switching key that can be trimmed to the first level
+    if (cryptoParamsCKKSRNS->GetSecretKeyDist() == SPARSE_ENCAPSULATED && ksTech != HYBRID)
+        OPENFHE_THROW("SPARSE_ENCAPSULATED is supported for the HYBRID key switching method only.");
+
     usint extraModSize = 0;
     if (scalTech == FLEXIBLEAUTOEXT) {
         // TODO: Allow the user to specify this?
@@ -77,7 +224,7 @@ bool ParameterGenerationCKKSRNS::ParamsGenCKKSRNS(std::shared_ptr<CryptoParamete
     uint32_t n             = cyclOrder / 2;
     uint32_t qBound        = firstModSize + (numPrimes - 1) * scalingModSize + extraModSize;
     // Estimate ciphertext modulus Q bound (in case of GHS/HYBRID P*Q)
-    if (ksTech == HYBRID) {
+    if (ksTech == HYBRID || ksTech == KLSS) {
         qBound += ceil(ceil(static_cast<double>(qBound) / numPartQ) / auxBits) * auxBits;
     }
 
@@ -112,6 +259,19 @@ bool ParameterGenerationCKKSRNS::ParamsGenCKKSRNS(std::shared_ptr<CryptoParamete
     }
     //// End HE Standards compliance logic/check
 
+    if (scalTech == COMPOSITESCALINGAUTO) {
+        auto moduliQ = GenerateCompositeModuli(cyclOrder, numPrimes, COMPOSITE_SCALING_DEGREE, scalingModSize,
+                                               firstModSize);
+        std::vector<NativeInteger> rootsQ(moduliQ.size());
+        for (size_t i = 0; i < moduliQ.size(); ++i)
+            rootsQ[i] = RootOfUnity(cyclOrder, moduliQ[i]);
+
+        SetElementParamsAndPrecompute(cryptoParamsCKKSRNS, cyclOrder, moduliQ, rootsQ, numPartQ, auxBits,
+                                      extraModSize);
+        CheckEncapsulationModulus(cryptoParamsCKKSRNS);
+        return true;
+    }
+
     usint dcrtBits = scalingModSize;
 
     uint32_t vecSize = (extraModSize == 0) ? numPrimes : numPrimes + 1;
@@ -210,27 +370,8 @@ bool ParameterGenerationCKKSRNS::ParamsGenCKKSRNS(std::shared_ptr<CryptoParamete
         rootsQ[numPrimes]  = RootOfUnity(cyclOrder, moduliQ[numPrimes]);
     }
 
-    auto paramsDCRT = std::make_shared<ILDCRTParams<BigInteger>>(cyclOrder, moduliQ, rootsQ);
-
-    cryptoParamsCKKSRNS->SetElementParams(paramsDCRT);
-
-    const EncodingParams encodingParams = cryptoParamsCKKSRNS->GetEncodingParams();
-    if (encodingParams->GetBatchSize() > n / 2)
-        OPENFHE_THROW("The batch size cannot be larger than ring dimension / 2.");
-
-    if (encodingParams->GetBatchSize() & (encodingParams->GetBatchSize() - 1))
-        OPENFHE_THROW("The batch size can only be set to zero (for full packing) or a power of two.");
-
-    // if no batch size was specified, we set batchSize = n/2 by default (for full
-    // packing)
-    if (encodingParams->GetBatchSize() == 0) {
-        uint32_t batchSize = n / 2;
-        EncodingParams encodingParamsNew(
-            std::make_shared<EncodingParamsImpl>(encodingParams->GetPlaintextModulus(), batchSize));
-        cryptoParamsCKKSRNS->SetEncodingParams(encodingParamsNew);
-    }
-
-    cryptoParamsCKKSRNS->PrecomputeCRTTables(ksTech, scalTech, encTech, multTech, numPartQ, auxBits, extraModSize);
+    SetElementParamsAndPrecompute(cryptoParamsCKKSRNS, cyclOrder, moduliQ, rootsQ, numPartQ, auxBits, extraModSize);
+    CheckEncapsulationModulus(cryptoParamsCKKSRNS);
 
     return true;
 }
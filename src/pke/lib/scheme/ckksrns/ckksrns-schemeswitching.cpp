@@ -1216,6 +1216,9 @@ Ciphertext<DCRTPoly> SWITCHCKKSRNS::EvalPartialHomDecryption(const CryptoContext
 // Scheme switching Wrapper
 //------------------------------------------------------------------------------
 LWEPrivateKey SWITCHCKKSRNS::EvalCKKStoFHEWSetup(const SchSwchParams& params) {
+    if (params.GetScalingTechniqueCKKS() == COMPOSITESCALINGAUTO)
+        OPENFHE_THROW("Scheme switching is not supported for the COMPOSITESCALINGAUTO method.");
+
     if (params.GetSecurityLevelFHEW() != TOY && params.GetSecurityLevelFHEW() != STD128)
         OPENFHE_THROW("Only STD128 or TOY are currently supported.");
 
@@ -1440,6 +1443,10 @@ void SWITCHCKKSRNS::EvalFHEWtoCKKSSetup(const CryptoContextImpl<DCRTPoly>& ccCKK
                                         uint32_t logQ) {
     m_ccLWE = ccLWE;
 
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ccCKKS.GetCryptoParameters());
+    if (cryptoParams->GetScalingTechnique() == COMPOSITESCALINGAUTO)
+        OPENFHE_THROW("Scheme switching is not supported for the COMPOSITESCALINGAUTO method.");
+
     if (m_ccLWE->GetParams()->GetLWEParams()->Getn() * 2 > ccCKKS.GetRingDimension())
         OPENFHE_THROW("The lattice parameter in LWE cannot be larger than half the RLWE ring dimension.");
 
@@ -1625,7 +1632,7 @@ Ciphertext<DCRTPoly> SWITCHCKKSRNS::EvalFHEWtoCKKS(std::vector<std::shared_ptr<L
 
     auto BminusAdotS3 = ccCKKS->EvalChebyshevSeries(BminusAdotS, coefficientsFHEW, a_cheby, b_cheby);
 
-    if (cryptoParamsCKKS->GetScalingTechnique() != FIXEDMANUAL) {
+    if (cryptoParamsCKKS->GetScalingTechnique() != FIXEDMANUAL && BminusAdotS3->GetNoiseScaleDeg() == 2) {
         ccCKKS->GetScheme()->ModReduceInternalInPlace(BminusAdotS3, BASE_NUM_LEVELS_TO_DROP);
     }
 
@@ -1638,7 +1645,7 @@ Ciphertext<DCRTPoly> SWITCHCKKSRNS::EvalFHEWtoCKKS(std::vector<std::shared_ptr<L
         if (cryptoParamsCKKS->GetScalingTechnique() == FIXEDMANUAL) {
             ccCKKS->ModReduceInPlace(BminusAdotS3);
         }
-        else {
+        else if (BminusAdotS3->GetNoiseScaleDeg() == 2) {
             ccCKKS->GetScheme()->ModReduceInternalInPlace(BminusAdotS3, BASE_NUM_LEVELS_TO_DROP);
         }
     }
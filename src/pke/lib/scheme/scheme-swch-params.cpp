@@ -55,7 +55,8 @@ std::ostream& operator<<(std::ostream& os, const SchSwchParams& obj) {
         << "  initialCKKSModulus: " << obj.initialCKKSModulus
         << "; ringDimension: " << obj.ringDimension
         << "; scalingModSize: " << obj.scalingModSize
-        << "; batchSize: " << obj.batchSize;
+        << "; batchSize: " << obj.batchSize
+        << "; scalingTechniqueCKKS: " << obj.scalingTechniqueCKKS;
 
     return os;
 }
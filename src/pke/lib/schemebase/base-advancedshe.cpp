@@ -33,6 +33,9 @@
 #include "key/privatekey.h"
 #include "cryptocontext.h"
 #include "schemebase/base-scheme.h"
+#include "utils/parallel.h"
+
+#include <functional>
 
 namespace lbcrypto {
 
@@ -296,6 +299,27 @@ Ciphertext<Element> AdvancedSHEBase<Element>::EvalSum(ConstCiphertext<Element> c
     return newCiphertext;
 }
 
+template <class Element>
+std::vector<uint32_t> AdvancedSHEBase<Element>::FindEvalSumAutomorphismIndices(ConstCiphertext<Element> ciphertext,
+                                                                              usint batchSize) const {
+    const auto cryptoParams = ciphertext->GetCryptoParameters();
+    usint m                 = cryptoParams->GetElementParams()->GetCyclotomicOrder();
+
+    // the same automorphisms as in EvalSum
+    if (IsPowerOfTwo(m)) {
+        return (ciphertext->GetEncodingType() == CKKS_PACKED_ENCODING) ? GenerateIndices2nComplex(batchSize, m) :
+                                                                         GenerateIndices_2n(batchSize, m);
+    }
+
+    std::vector<uint32_t> indices;
+    usint g = cryptoParams->GetEncodingParams()->GetPlaintextGenerator();
+    for (int i = 0; i < floor(log2(batchSize)); i++) {
+        indices.push_back(g);
+        g = (g * g) % m;
+    }
+    return indices;
+}
+
 template <class Element>
 Ciphertext<Element> AdvancedSHEBase<Element>::EvalSumRows(ConstCiphertext<Element> ciphertext, usint rowSize,
                                                           const std::map<usint, EvalKey<Element>>& evalKeyMap,
@@ -443,6 +467,209 @@ Ciphertext<Element> AdvancedSHEBase<Element>::EvalMerge(const std::vector<Cipher
     return ciphertextMerged;
 }
 
+template <class Element>
+std::vector<int32_t> AdvancedSHEBase<Element>::FindMatMulRotationIndices(uint32_t dim) const {
+    if (dim == 0)
+        OPENFHE_THROW("The matrix dimension should be positive");
+
+    // sigma and phi rotate by -d < r < d, tau and psi by multiples r * d of the row size
+    const int32_t d = static_cast<int32_t>(dim);
+    std::vector<int32_t> indices;
+    indices.reserve(4 * (dim - 1));
+    for (int32_t r = 1; r < d; ++r) {
+        indices.push_back(r);
+        indices.push_back(-r);
+        indices.push_back(r * d);
+        indices.push_back(-r * d);
+    }
+
+    return indices;
+}
+
+template <class Element>
+std::shared_ptr<const MatMulPrecom> AdvancedSHEBase<Element>::EvalMatMulPrecompute(const CryptoContextImpl<Element>& cc,
+                                                                                   uint32_t dim, uint32_t level,
+                                                                                   uint32_t slots) const {
+    if (dim == 0)
+        OPENFHE_THROW("The matrix dimension should be positive");
+
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(cc.GetCryptoParameters());
+    const bool isCKKSScheme = isCKKS(cc.getSchemeId());
+    const uint32_t size     = dim * dim;
+    // BGV and BFV rotations cycle within the rows of N/2 slots
+    const uint32_t maxSlots = (isCKKSScheme && slots != 0) ? slots : cc.GetRingDimension() / 2;
+    if (size > maxSlots)
+        OPENFHE_THROW("The matrix size [" + std::to_string(size) + "] exceeds the number of slots [" +
+                      std::to_string(maxSlots) + "]");
+
+    // sigma(A) and tau(B) are rescaled before they are masked again for phi^k and psi^k
+    const uint32_t nextLevel = isBFVRNS(cc.getSchemeId()) ? 0 : level + cryptoParams->GetCompositeDegree();
+
+    auto precom   = std::make_shared<MatMulPrecom>();
+    precom->dim   = dim;
+    precom->level = level;
+    precom->sigma.resize(2 * dim - 1);
+    precom->tau.resize(2 * dim - 1);
+    precom->phi.resize(dim);
+    precom->psi.resize(dim);
+
+    // the masks are collected with their levels and destinations and then encoded in one parallel batch
+    std::vector<std::vector<int64_t>> masks;
+    std::vector<uint32_t> levels;
+    std::vector<Plaintext*> targets;
+    auto addMask = [&](Plaintext& target, uint32_t maskLevel, const std::function<bool(uint32_t, uint32_t)>& isSet) {
+        std::vector<int64_t> mask(size);
+        for (uint32_t i = 0; i < dim; ++i) {
+            for (uint32_t j = 0; j < dim; ++j)
+                mask[i * dim + j] = isSet(i, j);
+        }
+        masks.push_back(std::move(mask));
+        levels.push_back(maskLevel);
+        targets.push_back(&target);
+    };
+
+    // slot (i, j) of sigma(A) is A(i, i + j mod d): rotation by i or i - d
+    // slot (i, j) of tau(B) is B(i + j mod d, j): rotation by j * d or (j - d) * d
+    for (uint32_t r = 0; r < dim; ++r) {
+        addMask(precom->sigma[dim - 1 + r], level, [=](uint32_t i, uint32_t j) { return i == r && j < dim - r; });
+        addMask(precom->tau[dim - 1 + r], level, [=](uint32_t i, uint32_t j) { return j == r && i < dim - r; });
+        if (r > 0) {
+            addMask(precom->sigma[dim - 1 - r], level, [=](uint32_t i, uint32_t j) { return i == dim - r && j >= r; });
+            addMask(precom->tau[dim - 1 - r], level, [=](uint32_t i, uint32_t j) { return j == dim - r && i >= r; });
+        }
+    }
+    // slot (i, j) of phi^k(A) is A(i, j + k mod d), of psi^k(B) is B(i + k mod d, j)
+    for (uint32_t k = 0; k < dim; ++k) {
+        addMask(precom->phi[k][0], nextLevel, [=](uint32_t i, uint32_t j) { return j < dim - k; });
+        addMask(precom->psi[k][0], nextLevel, [=](uint32_t i, uint32_t j) { return i < dim - k; });
+        if (k > 0) {
+            addMask(precom->phi[k][1], nextLevel, [=](uint32_t i, uint32_t j) { return j >= dim - k; });
+            addMask(precom->psi[k][1], nextLevel, [=](uint32_t i, uint32_t j) { return i >= dim - k; });
+        }
+    }
+
+    std::vector<Plaintext> plaintexts;
+    if (isCKKSScheme) {
+        std::vector<std::vector<double>> realMasks(masks.size());
+        for (size_t i = 0; i < masks.size(); ++i)
+            realMasks[i] = std::vector<double>(masks[i].begin(), masks[i].end());
+        plaintexts = cc.MakeCKKSPackedPlaintexts(realMasks, {}, levels, slots);
+    }
+    else {
+        plaintexts = cc.MakePackedPlaintexts(masks, {}, levels);
+    }
+    for (size_t i = 0; i < plaintexts.size(); ++i)
+        *targets[i] = std::move(plaintexts[i]);
+
+    precom->slots = isCKKSScheme ? precom->sigma[0]->GetSlots() : cc.GetRingDimension() / 2;
+    if (size > precom->slots)
+        OPENFHE_THROW("The matrix size [" + std::to_string(size) + "] exceeds the number of slots [" +
+                      std::to_string(precom->slots) + "]");
+
+    return precom;
+}
+
+template <class Element>
+Ciphertext<Element> AdvancedSHEBase<Element>::EvalMatMul(ConstCiphertext<Element> ciphertextA,
+                                                        ConstCiphertext<Element> ciphertextB,
+                                                        const MatMulPrecom& precom) const {
+    if (ciphertextA->GetLevel() != precom.level || ciphertextB->GetLevel() != precom.level)
+        OPENFHE_THROW("The levels of the input ciphertexts [" + std::to_string(ciphertextA->GetLevel()) + ", " +
+                      std::to_string(ciphertextB->GetLevel()) + "] should match the level of the precomputation [" +
+                      std::to_string(precom.level) + "]");
+    if (ciphertextA->GetEncodingType() == CKKS_PACKED_ENCODING &&
+        (ciphertextA->GetSlots() != precom.slots || ciphertextB->GetSlots() != precom.slots))
+        OPENFHE_THROW("The numbers of slots of the input ciphertexts [" + std::to_string(ciphertextA->GetSlots()) +
+                      ", " + std::to_string(ciphertextB->GetSlots()) +
+                      "] should match the number of slots of the precomputation [" + std::to_string(precom.slots) +
+                      "]");
+
+    const auto cc           = ciphertextA->GetCryptoContext();
+    const uint32_t m        = cc->GetCyclotomicOrder();
+    const int32_t d         = static_cast<int32_t>(precom.dim);
+    const uint32_t numDiags = 2 * precom.dim - 1;
+    // the masked ciphertexts are rescaled explicitly only in FIXEDMANUAL; BFV does not rescale
+    const bool isBFVScheme = isBFVRNS(cc->getSchemeId());
+
+    std::string exceptionMessage;
+    bool hadEx = false;
+
+    // sigma(A) and tau(B): 2d - 1 masked rotations of each input, all hoisted
+    auto digitsA = cc->EvalFastRotationPrecompute(ciphertextA);
+    auto digitsB = cc->EvalFastRotationPrecompute(ciphertextB);
+    std::vector<Ciphertext<Element>> diags(2 * numDiags);
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(2 * numDiags))
+    for (uint32_t i = 0; i < 2 * numDiags; ++i) {
+        try {
+            const int32_t r = static_cast<int32_t>(i % numDiags) - (d - 1);
+            if (i < numDiags)
+                diags[i] = cc->EvalMult(cc->EvalFastRotation(ciphertextA, r, m, digitsA), precom.sigma[i]);
+            else
+                diags[i] = cc->EvalMult(cc->EvalFastRotation(ciphertextB, r * d, m, digitsB),
+                                        precom.tau[i - numDiags]);
+        }
+        catch (std::exception& e) {
+#pragma omp critical
+            {
+                if (!hadEx) {
+                    exceptionMessage = e.what();
+                    hadEx            = true;
+                }
+            }
+        }
+    }
+    if (hadEx)
+        OPENFHE_THROW(exceptionMessage);
+
+    std::vector<Ciphertext<Element>> diagsA(diags.begin(), diags.begin() + numDiags);
+    std::vector<Ciphertext<Element>> diagsB(diags.begin() + numDiags, diags.end());
+    auto sigmaA = EvalAddManyInPlace(diagsA);
+    auto tauB   = EvalAddManyInPlace(diagsB);
+    if (!isBFVScheme) {
+        cc->ModReduceInPlace(sigmaA);
+        cc->ModReduceInPlace(tauB);
+    }
+
+    // phi^k(sigma(A)) * psi^k(tau(B)) for every k: two masked rotations of each factor, hoisted over all k
+    auto digitsSigma = cc->EvalFastRotationPrecompute(sigmaA);
+    auto digitsTau   = cc->EvalFastRotationPrecompute(tauB);
+    std::vector<Ciphertext<Element>> products(precom.dim);
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(precom.dim))
+    for (int32_t k = 0; k < d; ++k) {
+        try {
+            auto shiftA = cc->EvalMult(cc->EvalFastRotation(sigmaA, k, m, digitsSigma), precom.phi[k][0]);
+            auto shiftB = cc->EvalMult(cc->EvalFastRotation(tauB, k * d, m, digitsTau), precom.psi[k][0]);
+            if (k > 0) {
+                auto wrapA = cc->EvalFastRotation(sigmaA, k - d, m, digitsSigma);
+                auto wrapB = cc->EvalFastRotation(tauB, (k - d) * d, m, digitsTau);
+                cc->EvalAddInPlace(shiftA, cc->EvalMult(wrapA, precom.phi[k][1]));
+                cc->EvalAddInPlace(shiftB, cc->EvalMult(wrapB, precom.psi[k][1]));
+            }
+            if (!isBFVScheme) {
+                cc->ModReduceInPlace(shiftA);
+                cc->ModReduceInPlace(shiftB);
+            }
+            products[k] = cc->EvalMultNoRelin(shiftA, shiftB);
+        }
+        catch (std::exception& e) {
+#pragma omp critical
+            {
+                if (!hadEx) {
+                    exceptionMessage = e.what();
+                    hadEx            = true;
+                }
+            }
+        }
+    }
+    if (hadEx)
+        OPENFHE_THROW(exceptionMessage);
+
+    auto result = EvalAddManyInPlace(products);
+    cc->RelinearizeInPlace(result);
+
+    return result;
+}
+
 template <class Element>
 std::vector<usint> AdvancedSHEBase<Element>::GenerateIndices_2n(usint batchSize, usint m) const {
     // stores automorphism indices needed for EvalSum
@@ -101,6 +101,7 @@ KeyPair<Element> MultipartyBase<Element>::MultipartyKeyGen(CryptoContext<Element
             s = Element(dgg, paramsPK, Format::EVALUATION);
             break;
         case UNIFORM_TERNARY:
+        case SPARSE_ENCAPSULATED:
             s = Element(tug, paramsPK, Format::EVALUATION);
             break;
         case SPARSE_TERNARY:
@@ -306,9 +307,9 @@ EvalKey<Element> MultipartyBase<Element>::MultiAddEvalKeys(EvalKey<Element> eval
 
     EvalKey<Element> evalKeySum = std::make_shared<EvalKeyRelinImpl<Element>>(cc);
 
-    const std::vector<Element>& a  = evalKey1->GetAVector();
-    const std::vector<Element>& b1 = evalKey1->GetBVector();
-    const std::vector<Element>& b2 = evalKey2->GetBVector();
+    const std::vector<Element> a  = evalKey1->CopyAVector();
+    const std::vector<Element> b1 = evalKey1->CopyBVector();
+    const std::vector<Element> b2 = evalKey2->CopyBVector();
 
     std::vector<Element> b;
     b.reserve(a.size());
@@ -330,10 +331,10 @@ EvalKey<Element> MultipartyBase<Element>::MultiAddEvalMultKeys(EvalKey<Element>
 
     EvalKey<Element> evalKeySum = std::make_shared<EvalKeyRelinImpl<Element>>(cc);
 
-    const std::vector<Element>& a1 = evalKey1->GetAVector();
-    const std::vector<Element>& a2 = evalKey2->GetAVector();
-    const std::vector<Element>& b1 = evalKey1->GetBVector();
-    const std::vector<Element>& b2 = evalKey2->GetBVector();
+    const std::vector<Element> a1 = evalKey1->CopyAVector();
+    const std::vector<Element> a2 = evalKey2->CopyAVector();
+    const std::vector<Element> b1 = evalKey1->CopyBVector();
+    const std::vector<Element> b2 = evalKey2->CopyBVector();
 
     std::vector<Element> a;
     a.reserve(a1.size());
@@ -363,8 +364,8 @@ EvalKey<Element> MultipartyBase<Element>::MultiMultEvalKey(PrivateKey<Element> p
 
     EvalKey<Element> evalKeyResult = std::make_shared<EvalKeyRelinImpl<Element>>(cc);
 
-    const std::vector<Element>& a0 = evalKey->GetAVector();
-    const std::vector<Element>& b0 = evalKey->GetBVector();
+    const std::vector<Element> a0 = evalKey->CopyAVector();
+    const std::vector<Element> b0 = evalKey->CopyBVector();
 
     const Element& s = privateKey->GetPrivateElement();
     const auto ns    = cryptoParams->GetNoiseScale();
@@ -0,0 +1,258 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+Polynomial evaluation for the integer RNS schemes (BFV and BGV)
+ */
+
+#include "cryptocontext.h"
+#include "schemerns/rns-advancedshe.h"
+
+#include "utils/parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace lbcrypto {
+
+//------------------------------------------------------------------------------
+// EVAL POLYNOMIAL
+//------------------------------------------------------------------------------
+
+namespace {
+// c + ciphertext, where ciphertext may be nullptr
+struct PolyTerm {
+    Ciphertext<DCRTPoly> ciphertext;
+    int64_t constant{0};
+};
+
+// Checks that the coefficients are integers and reduces them mod t to (-t/2, t/2]
+std::vector<int64_t> ReduceCoefficients(const std::vector<double>& coefficients, PlaintextModulus t) {
+    if (coefficients.empty())
+        OPENFHE_THROW("The coefficients vector can not be empty");
+
+    const int64_t modulus = static_cast<int64_t>(t);
+    std::vector<int64_t> result(coefficients.size());
+    for (size_t i = 0; i < coefficients.size(); ++i) {
+        double c = coefficients[i];
+        if (std::nearbyint(c) != c || std::fabs(c) >= 9.2e18)
+            OPENFHE_THROW("The coefficient at index " + std::to_string(i) + " is not an integer: " + std::to_string(c));
+        int64_t r = static_cast<int64_t>(c) % modulus;
+        if (r < 0)
+            r += modulus;
+        result[i] = (r > modulus / 2) ? r - modulus : r;
+    }
+    return result;
+}
+
+uint32_t DegreeOf(const std::vector<int64_t>& coefficients) {
+    uint32_t n = coefficients.size() - 1;
+    while (n > 0 && coefficients[n] == 0)
+        --n;
+    return n;
+}
+
+// The plaintext modulus, not the ciphertext modulus, bounds the constants, so the elements are multiplied by
+// the signed integer directly; the scaling factor and the noise scale degree do not change
+Ciphertext<DCRTPoly> MultByCoefficient(ConstCiphertext<DCRTPoly> ciphertext, int64_t coefficient) {
+    const std::vector<DCRTPoly>& cv = ciphertext->GetElements();
+    std::vector<DCRTPoly> resultDCRT(cv.size());
+    for (size_t i = 0; i < cv.size(); ++i)
+        resultDCRT[i] = cv[i].Times(static_cast<NativeInteger::SignedNativeInt>(coefficient));
+
+    Ciphertext<DCRTPoly> result = ciphertext->CloneZero();
+    result->SetElements(std::move(resultDCRT));
+    return result;
+}
+
+// The BFV tensor product is returned in coefficient format; the terms of a sum need to be in the same format
+void ToEvaluationFormat(Ciphertext<DCRTPoly>& ciphertext) {
+    for (auto& element : ciphertext->GetElements())
+        element.SetFormat(Format::EVALUATION);
+}
+
+// Computes x^1, ..., x^n. A power 2^j < i <= 2^{j+1} is x^{2^j} * x^{i - 2^j}, so the powers of one such range
+// depend only on lower ranges. They are computed in parallel if there are at least as many of them as threads:
+// nested parallelism is off, so a smaller parallel range would leave the per-tower loops serial. Only the powers
+// that are factors of higher powers (and x^n if relinTop is set) are relinearized; the others are used in linear
+// combinations only and keep three elements until the combination is relinearized
+std::vector<Ciphertext<DCRTPoly>> EvalPowers(ConstCiphertext<DCRTPoly> x, uint32_t n, bool relinTop) {
+    auto cc = x->GetCryptoContext();
+
+    std::vector<Ciphertext<DCRTPoly>> powers(n + 1);
+    powers[1] = x->Clone();
+    for (uint32_t lo = 1; lo < n; lo *= 2) {
+        const uint32_t hi = std::min(2 * lo, n);
+#pragma omp parallel for if (static_cast<int>(hi - lo) >= omp_get_max_threads()) \
+    num_threads(OpenFHEParallelControls.GetThreadLimit(hi - lo))
+        for (uint32_t i = lo + 1; i <= hi; ++i) {
+            const bool isFactor = (2 * i <= n) || (i == 2 * lo && i < n) || (relinTop && i == n);
+            powers[i] = isFactor ? cc->EvalMult(powers[lo], powers[i - lo]) :
+                                   cc->EvalMultNoRelin(powers[lo], powers[i - lo]);
+            cc->ModReduceInPlace(powers[i]);
+            ToEvaluationFormat(powers[i]);
+        }
+    }
+    return powers;
+}
+
+// sum_{i=1}^{count} coefficients[first + i] * x^i; nullptr if all coefficients are zero
+Ciphertext<DCRTPoly> EvalLinearCombination(const std::vector<Ciphertext<DCRTPoly>>& powers,
+                                           const std::vector<int64_t>& coefficients, uint32_t first, uint32_t count) {
+    auto cc = powers[1]->GetCryptoContext();
+
+    Ciphertext<DCRTPoly> result;
+    for (uint32_t i = 1; i <= count && first + i < coefficients.size(); ++i) {
+        int64_t c = coefficients[first + i];
+        if (c == 0)
+            continue;
+        if (!result)
+            result = MultByCoefficient(powers[i], c);
+        else
+            cc->EvalAddInPlace(result, MultByCoefficient(powers[i], c));
+    }
+    return result;
+}
+
+// term.ciphertext + term.constant as a relinearized ciphertext
+Ciphertext<DCRTPoly> Materialize(const PolyTerm& term) {
+    auto cc     = term.ciphertext->GetCryptoContext();
+    auto result = term.ciphertext;
+    if (result->NumberCiphertextElements() > 2)
+        result = cc->Relinearize(result);
+    if (term.constant != 0) {
+        // a constant polynomial encodes the same constant in every slot, so it is added directly by the scheme
+        // regardless of the encoding type of the ciphertext
+        Plaintext constant = cc->MakeCoefPackedPlaintext({term.constant});
+        constant->SetFormat(EVALUATION);
+        result = cc->GetScheme()->EvalAdd(result, constant);
+    }
+    return result;
+}
+}  // namespace
+
+Ciphertext<DCRTPoly> AdvancedSHERNS::EvalPoly(ConstCiphertext<DCRTPoly> x,
+                                              const std::vector<double>& coefficients) const {
+    auto f = ReduceCoefficients(coefficients, x->GetCryptoParameters()->GetPlaintextModulus());
+
+    if (DegreeOf(f) < 5) {
+        return EvalPolyLinear(x, coefficients);
+    }
+
+    return EvalPolyPS(x, coefficients);
+}
+
+Ciphertext<DCRTPoly> AdvancedSHERNS::EvalPolyLinear(ConstCiphertext<DCRTPoly> x,
+                                                    const std::vector<double>& coefficients) const {
+    auto f     = ReduceCoefficients(coefficients, x->GetCryptoParameters()->GetPlaintextModulus());
+    uint32_t n = DegreeOf(f);
+    if (n == 0)
+        OPENFHE_THROW("The polynomial should have a degree of at least 1 mod the plaintext modulus");
+
+    auto powers = EvalPowers(x, n, false);
+
+    PolyTerm result{EvalLinearCombination(powers, f, 0, n), f[0]};
+    return Materialize(result);
+}
+
+Ciphertext<DCRTPoly> AdvancedSHERNS::EvalPolyPS(ConstCiphertext<DCRTPoly> x,
+                                                const std::vector<double>& coefficients) const {
+    auto f     = ReduceCoefficients(coefficients, x->GetCryptoParameters()->GetPlaintextModulus());
+    uint32_t n = DegreeOf(f);
+    if (n == 0)
+        OPENFHE_THROW("The polynomial should have a degree of at least 1 mod the plaintext modulus");
+    f.resize(n + 1);
+
+    auto cc = x->GetCryptoContext();
+
+    // f is split into blocks of k = 2^a coefficients, f = sum_j f_j(x) x^{jk} with deg f_j < k. With k close
+    // to sqrt(n), the baby steps x, ..., x^k and the giant steps x^{2^i k} take O(sqrt(n)) products, and the
+    // blocks are merged pairwise in a tree: f_{2j} + x^{2^i k} f_{2j+1}. The depth is ceil(log2(n + 1))
+    uint32_t a = std::max<uint32_t>(1, static_cast<uint32_t>(std::lround(std::log2(std::sqrt(n + 1.0)))));
+    uint32_t k = 1 << a;
+    uint32_t g = (n + k) / k;
+    uint32_t m = 0;
+    while ((1u << m) < g)
+        ++m;
+
+    auto powers = EvalPowers(x, k, true);
+
+    std::vector<Ciphertext<DCRTPoly>> giant(std::max<uint32_t>(m, 1));
+    giant[0] = powers[k];
+    for (uint32_t i = 1; i < m; ++i) {
+        giant[i] = cc->EvalSquare(giant[i - 1]);
+        cc->ModReduceInPlace(giant[i]);
+    }
+
+    // the blocks, and the merges of one tree level, are independent; as in EvalPowers, they are computed in
+    // parallel only if there are at least as many of them as threads
+    std::vector<PolyTerm> terms(size_t(1) << m);
+#pragma omp parallel for if (static_cast<int>(g) >= omp_get_max_threads()) \
+    num_threads(OpenFHEParallelControls.GetThreadLimit(g))
+    for (uint32_t j = 0; j < g; ++j) {
+        terms[j] = {EvalLinearCombination(powers, f, j * k, k - 1), f[j * k]};
+    }
+
+    for (uint32_t i = 0; i < m; ++i) {
+        const uint32_t half = terms.size() / 2;
+        std::vector<PolyTerm> merged(half);
+#pragma omp parallel for if (static_cast<int>(half) >= omp_get_max_threads()) \
+    num_threads(OpenFHEParallelControls.GetThreadLimit(half))
+        for (uint32_t j = 0; j < half; ++j) {
+            const PolyTerm& low  = terms[2 * j];
+            const PolyTerm& high = terms[2 * j + 1];
+            merged[j]            = low;
+            if (!high.ciphertext && high.constant == 0)
+                continue;
+
+            Ciphertext<DCRTPoly> product;
+            if (high.ciphertext) {
+                // the sum is relinearized only once, when it becomes a factor
+                product = cc->EvalMultNoRelin(giant[i], Materialize(high));
+                cc->ModReduceInPlace(product);
+                ToEvaluationFormat(product);
+            }
+            else {
+                product = MultByCoefficient(giant[i], high.constant);
+            }
+            if (low.ciphertext)
+                cc->EvalAddInPlace(product, low.ciphertext);
+            merged[j].ciphertext = product;
+        }
+        terms = std::move(merged);
+    }
+
+    return Materialize(terms[0]);
+}
+
+}  // namespace lbcrypto
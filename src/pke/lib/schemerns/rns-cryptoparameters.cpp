@@ -35,6 +35,8 @@
 #include "cryptocontext.h"
 #include "schemerns/rns-cryptoparameters.h"
 
+#include <algorithm>
+
 namespace lbcrypto {
 
 void CryptoParametersRNS::PrecomputeCRTTables(KeySwitchTechnique ksTech, ScalingTechnique scalTech,
@@ -69,7 +71,7 @@ void CryptoParametersRNS::PrecomputeCRTTables(KeySwitchTechnique ksTech, Scaling
     // Pre-compute CRT::FFT values for Q
     DiscreteFourierTransform::Initialize(n * 2, n / 2);
     ChineseRemainderTransformFTT<NativeVector>().PreCompute(rootsQ, 2 * n, moduliQ);
-    if (m_ksTechnique == HYBRID) {
+    if (m_ksTechnique == HYBRID || m_ksTechnique == KLSS) {
         // Compute ceil(sizeQ/m_numPartQ), the # of towers per digit
         uint32_t a = ceil(static_cast<double>(sizeQ) / numPartQ);
         if ((int32_t)(sizeQ - a * (numPartQ - 1)) <= 0) {
@@ -331,6 +333,173 @@ void CryptoParametersRNS::PrecomputeCRTTables(KeySwitchTechnique ksTech, Scaling
                 }
             }
         }
+
+        if (m_ksTechnique == KLSS) {
+            // KLSS key switching decomposes the key a second time over parts {QP}_c of QP: the towers of Q
+            // and the towers of P are grouped into parts of alphaQP towers each. The product of the digits
+            // and the key is computed exactly in an auxiliary CRT basis R = r_1*...*r_m and then converted
+            // to every part {QP}_c.
+            //
+            // The digits are lifted to integers below alpha * Q_j and the key parts to integers below
+            // alphaQP * {QP}_c, so every coefficient of sum_j d_j * key_{j,c} is bounded in absolute value
+            // by numPartQ * n * alpha * alphaQP * Q_j * {QP}_c. R must exceed twice this bound (one bit), and
+            // two more bits keep the exact conversion from R away from its rounding boundary.
+            auto partBits = [](const std::vector<NativeInteger>& moduli, uint32_t size) {
+                uint32_t bits = 0;
+                for (uint32_t start = 0; start < moduli.size(); start += size) {
+                    BigInteger product(1);
+                    for (uint32_t i = start; i < std::min<uint32_t>(start + size, moduli.size()); i++)
+                        product *= BigInteger(moduli[i]);
+                    bits = std::max(bits, product.GetLengthForBase(2));
+                }
+                return bits;
+            };
+            auto numPartsR = [&](uint32_t alphaQP) {
+                uint32_t maxBitsPartQP = std::max(partBits(moduliQ, alphaQP), partBits(moduliP, alphaQP));
+                double boundBits = std::log2(m_numPartQ) + std::log2(n) + std::log2(alpha) + std::log2(alphaQP) +
+                                   maxBits + maxBitsPartQP + 1 + 2;
+                return static_cast<uint32_t>(ceil(boundBits / auxBits));
+            };
+            auto numPartsQP = [&](uint32_t alphaQP) {
+                return static_cast<uint32_t>(ceil(static_cast<double>(sizeQ) / alphaQP) +
+                                             ceil(static_cast<double>(sizeP) / alphaQP));
+            };
+
+            // Larger parts mean fewer, but longer, products in R. alphaQP minimizes the estimated cost of
+            // the key switching core in products of two polynomials in one tower: the inner product of the
+            // digits with the key (numPartQ * numPartQP * sizeR products per component), the NTTs of the
+            // lifted digits and of the products in R (one NTT costs about log2(n) / 2 products) and the
+            // conversion from R to all parts (sizeR * (sizeQ + sizeP) products per component). The key has
+            // numPartQ * numPartQP * sizeR towers per component, so it shrinks with the cost.
+            const double nttCost = std::log2(n) / 2;
+            auto keySwitchCost   = [&](uint32_t alphaQP) {
+                double sizeR     = numPartsR(alphaQP);
+                double numPartQP = numPartsQP(alphaQP);
+                return 2 * m_numPartQ * numPartQP * sizeR + nttCost * (m_numPartQ + 2 * numPartQP) * sizeR +
+                       2 * sizeR * (sizeQ + sizeP);
+            };
+            m_numPerPartQP = alpha;
+            for (uint32_t alphaQP = alpha + 1; alphaQP <= std::max<uint32_t>(sizeQ, sizeP); alphaQP++) {
+                if (keySwitchCost(alphaQP) < keySwitchCost(m_numPerPartQP))
+                    m_numPerPartQP = alphaQP;
+            }
+
+            m_numPartQInQP    = ceil(static_cast<double>(sizeQ) / m_numPerPartQP);
+            uint32_t numPartP = ceil(static_cast<double>(sizeP) / m_numPerPartQP);
+            m_paramsPartQP.resize(m_numPartQInQP + numPartP);
+            auto makeParts = [&](const std::vector<NativeInteger>& moduliAll, const std::vector<NativeInteger>& rootsAll,
+                                 uint32_t numParts, uint32_t firstPart) {
+                for (uint32_t c = 0; c < numParts; c++) {
+                    uint32_t startTower = c * m_numPerPartQP;
+                    uint32_t endTower   = std::min<uint32_t>(startTower + m_numPerPartQP, moduliAll.size());
+                    std::vector<NativeInteger> moduli(moduliAll.begin() + startTower, moduliAll.begin() + endTower);
+                    std::vector<NativeInteger> roots(rootsAll.begin() + startTower, rootsAll.begin() + endTower);
+                    m_paramsPartQP[firstPart + c] = std::make_shared<ILDCRTParams<BigInteger>>(2 * n, moduli, roots);
+                }
+            };
+            makeParts(moduliQ, rootsQ, m_numPartQInQP, 0);
+            makeParts(moduliP, rootsP, numPartP, m_numPartQInQP);
+
+            uint32_t sizeR = numPartsR(m_numPerPartQP);
+
+            // The primes of R follow the primes of P and differ from all primes of Q and P
+            std::vector<NativeInteger> moduliR(sizeR);
+            std::vector<NativeInteger> rootsR(sizeR);
+            NativeInteger rPrev = *std::min_element(moduliP.begin(), moduliP.end());
+            for (uint32_t k = 0; k < sizeR; k++) {
+                do {
+                    moduliR[k] = PreviousPrime<NativeInteger>(rPrev, primeStep);
+                    rPrev      = moduliR[k];
+                } while (std::find(moduliQ.begin(), moduliQ.end(), moduliR[k]) != moduliQ.end() ||
+                         std::find(moduliP.begin(), moduliP.end(), moduliR[k]) != moduliP.end());
+                rootsR[k] = RootOfUnity<NativeInteger>(2 * n, moduliR[k]);
+            }
+            m_paramsAux = std::make_shared<ILDCRTParams<BigInteger>>(2 * n, moduliR, rootsR);
+            ChineseRemainderTransformFTT<NativeVector>().PreCompute(rootsR, 2 * n, moduliR);
+
+            const auto BarrettBase128Bit(BigInteger(1).LShiftEq(128));
+            m_modAuxBarrettMu.resize(sizeR);
+            for (uint32_t k = 0; k < sizeR; k++)
+                m_modAuxBarrettMu[k] = (BarrettBase128Bit / BigInteger(moduliR[k])).ConvertToInt<DoubleNativeInt>();
+
+            // Pre-compute [(Q_j)^(l)/q_i]_{r_k} for the ModUp of the digits to R
+            m_PartQlHatModAux.resize(m_numPartQ);
+            for (uint32_t j = 0; j < m_numPartQ; j++) {
+                const auto& params  = m_paramsPartQ[j]->GetParams();
+                uint32_t sizePartQj = params.size();
+                auto modulusPartQ   = m_paramsPartQ[j]->GetModulus();
+                m_PartQlHatModAux[j].resize(sizePartQj);
+                for (uint32_t l = 0; l < sizePartQj; l++) {
+                    if (l > 0)
+                        modulusPartQ = modulusPartQ / BigInteger(params[sizePartQj - l]->GetModulus());
+                    auto& PartQlHatModr = m_PartQlHatModAux[j][sizePartQj - l - 1];
+                    PartQlHatModr.resize(sizePartQj - l);
+                    for (uint32_t i = 0; i < sizePartQj - l; i++) {
+                        BigInteger QHat = modulusPartQ / BigInteger(params[i]->GetModulus());
+                        PartQlHatModr[i].resize(sizeR);
+                        for (uint32_t k = 0; k < sizeR; k++)
+                            PartQlHatModr[i][k] = QHat.Mod(moduliR[k]).ConvertToInt();
+                    }
+                }
+            }
+
+            // Pre-compute [({QP}_c/q_i)^{-1}]_{q_i} and [{QP}_c/q_i]_{r_k} for lifting the key parts to R
+            uint32_t numPartQP = m_paramsPartQP.size();
+            m_PartQPHatInvModq.resize(numPartQP);
+            m_PartQPHatInvModqPrecon.resize(numPartQP);
+            m_PartQPHatModAux.resize(numPartQP);
+            for (uint32_t c = 0; c < numPartQP; c++) {
+                const auto& params       = m_paramsPartQP[c]->GetParams();
+                BigInteger modulusPartQP = m_paramsPartQP[c]->GetModulus();
+                m_PartQPHatInvModq[c].resize(params.size());
+                m_PartQPHatInvModqPrecon[c].resize(params.size());
+                m_PartQPHatModAux[c].resize(params.size());
+                for (uint32_t i = 0; i < params.size(); i++) {
+                    const auto& qi                = params[i]->GetModulus();
+                    BigInteger QPHat              = modulusPartQP / BigInteger(qi);
+                    m_PartQPHatInvModq[c][i]       = QPHat.ModInverse(qi).ConvertToInt();
+                    m_PartQPHatInvModqPrecon[c][i] = m_PartQPHatInvModq[c][i].PrepModMulConst(qi);
+                    m_PartQPHatModAux[c][i].resize(sizeR);
+                    for (uint32_t k = 0; k < sizeR; k++)
+                        m_PartQPHatModAux[c][i][k] = QPHat.Mod(moduliR[k]).ConvertToInt();
+                }
+            }
+
+            // Pre-compute the tables for the exact conversion from R to every part {QP}_c
+            BigInteger modulusR = m_paramsAux->GetModulus();
+            m_AuxHatInvModAux.resize(sizeR);
+            m_AuxHatInvModAuxPrecon.resize(sizeR);
+            m_auxInv.resize(sizeR);
+            for (uint32_t k = 0; k < sizeR; k++) {
+                BigInteger RHat        = modulusR / BigInteger(moduliR[k]);
+                m_AuxHatInvModAux[k]       = RHat.ModInverse(moduliR[k]).ConvertToInt();
+                m_AuxHatInvModAuxPrecon[k] = m_AuxHatInvModAux[k].PrepModMulConst(moduliR[k]);
+                m_auxInv[k]              = 1. / moduliR[k].ConvertToDouble();
+            }
+
+            m_AuxHatModPartQP.resize(numPartQP);
+            m_alphaAuxModPartQP.resize(numPartQP);
+            m_modPartQPBarrettMu.resize(numPartQP);
+            for (uint32_t c = 0; c < numPartQP; c++) {
+                const auto& params = m_paramsPartQP[c]->GetParams();
+                m_AuxHatModPartQP[c].resize(params.size());
+                m_modPartQPBarrettMu[c].resize(params.size());
+                for (uint32_t i = 0; i < params.size(); i++) {
+                    const auto& qi = params[i]->GetModulus();
+                    m_AuxHatModPartQP[c][i].resize(sizeR);
+                    for (uint32_t k = 0; k < sizeR; k++)
+                        m_AuxHatModPartQP[c][i][k] = (modulusR / BigInteger(moduliR[k])).Mod(qi).ConvertToInt();
+                    m_modPartQPBarrettMu[c][i] = (BarrettBase128Bit / BigInteger(qi)).ConvertToInt<DoubleNativeInt>();
+                }
+                // [u * R]_{q_i} for u = 0...sizeR
+                m_alphaAuxModPartQP[c].resize(sizeR + 1);
+                for (uint32_t u = 0; u <= sizeR; u++) {
+                    m_alphaAuxModPartQP[c][u].resize(params.size());
+                    for (uint32_t i = 0; i < params.size(); i++)
+                        m_alphaAuxModPartQP[c][u][i] = (modulusR * BigInteger(u)).Mod(params[i]->GetModulus()).ConvertToInt();
+                }
+            }
+        }
     }
     /////////////////////////////////////
     // BFVrns and BGVrns : Multiparty Decryption : ExpandCRTBasis
@@ -306,6 +306,107 @@ void LeveledSHERNS::MultByMonomialInPlace(Ciphertext<DCRTPoly>& ciphertext, usin
 // SHE AUTOMORPHISM
 /////////////////////////////////////////
 
+Ciphertext<DCRTPoly> LeveledSHERNS::EvalFastRotationExt(ConstCiphertext<DCRTPoly> ciphertext, usint index,
+                                                        const std::shared_ptr<std::vector<DCRTPoly>> digits,
+                                                        bool addFirst,
+                                                        const std::map<usint, EvalKey<DCRTPoly>>& evalKeys) const {
+    const auto cc = ciphertext->GetCryptoContext();
+
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(ciphertext->GetCryptoParameters());
+
+    usint N = cryptoParams->GetElementParams()->GetRingDimension();
+    usint M = cryptoParams->GetElementParams()->GetCyclotomicOrder();
+
+    // Find the automorphism index that corresponds to rotation index index.
+    usint autoIndex = FindAutomorphismIndex(index, M);
+
+    // Retrieve the automorphism key that corresponds to the auto index.
+    auto evalKeyIterator = evalKeys.find(autoIndex);
+    if (evalKeyIterator == evalKeys.end()) {
+        OPENFHE_THROW("EvalKey for index [" + std::to_string(autoIndex) + "] is not found.");
+    }
+    auto evalKey = evalKeyIterator->second;
+
+    const std::vector<DCRTPoly>& cv = ciphertext->GetElements();
+    const auto paramsQl             = cv[0].GetParams();
+
+    auto algo = cc->GetScheme();
+
+    std::shared_ptr<std::vector<DCRTPoly>> cTilda = algo->EvalFastKeySwitchCoreExt(digits, evalKey, paramsQl);
+
+    if (addFirst) {
+        const auto paramsQlP = (*cTilda)[0].GetParams();
+        size_t sizeQl        = paramsQl->GetParams().size();
+        DCRTPoly psiC0       = DCRTPoly(paramsQlP, Format::EVALUATION, true);
+        auto cMult           = ciphertext->GetElements()[0].TimesNoCheck(cryptoParams->GetPModq());
+        for (usint i = 0; i < sizeQl; i++) {
+            psiC0.SetElementAtIndex(i, cMult.GetElementAtIndex(i));
+        }
+        (*cTilda)[0] += psiC0;
+    }
+
+    std::vector<usint> vec(N);
+    PrecomputeAutoMap(N, autoIndex, &vec);
+
+    (*cTilda)[0] = (*cTilda)[0].AutomorphismTransform(autoIndex, vec);
+    (*cTilda)[1] = (*cTilda)[1].AutomorphismTransform(autoIndex, vec);
+
+    Ciphertext<DCRTPoly> result = ciphertext->CloneZero();
+
+    result->SetElements({std::move((*cTilda)[0]), std::move((*cTilda)[1])});
+
+    return result;
+}
+
+/////////////////////////////////////////
+// SHE EXTENDED BASIS
+/////////////////////////////////////////
+
+Ciphertext<DCRTPoly> LeveledSHERNS::EvalMultExt(ConstCiphertext<DCRTPoly> ciphertext, ConstPlaintext plaintext) const {
+    DCRTPoly pt = plaintext->GetElement<DCRTPoly>();
+    if (pt.GetNumOfElements() != ciphertext->GetElements()[0].GetNumOfElements()) {
+        OPENFHE_THROW("The plaintext has " + std::to_string(pt.GetNumOfElements()) +
+                      " towers, but the ciphertext in the extended basis has " +
+                      std::to_string(ciphertext->GetElements()[0].GetNumOfElements()) +
+                      "; the plaintext should be encoded in the extended basis at the level of the ciphertext");
+    }
+    pt.SetFormat(Format::EVALUATION);
+
+    Ciphertext<DCRTPoly> result = ciphertext->Clone();
+    for (auto& c : result->GetElements()) {
+        c *= pt;
+    }
+
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(ciphertext->GetCryptoParameters());
+    result->SetNoiseScaleDeg(result->GetNoiseScaleDeg() + plaintext->GetNoiseScaleDeg());
+    // TODO (Andrey) : This part is only used in CKKS scheme
+    result->SetScalingFactor(result->GetScalingFactor() * plaintext->GetScalingFactor());
+    // TODO (Andrey) : This part is only used in BGV scheme
+    if (cryptoParams->GetScalingTechnique() == FLEXIBLEAUTO || cryptoParams->GetScalingTechnique() == FLEXIBLEAUTOEXT) {
+        const auto plainMod = ciphertext->GetCryptoParameters()->GetPlaintextModulus();
+        result->SetScalingFactorInt(result->GetScalingFactorInt().ModMul(plaintext->GetScalingFactorInt(), plainMod));
+    }
+    return result;
+}
+
+void LeveledSHERNS::EvalAddExtInPlace(Ciphertext<DCRTPoly>& ciphertext1, ConstCiphertext<DCRTPoly> ciphertext2) const {
+    std::vector<DCRTPoly>& cv1       = ciphertext1->GetElements();
+    const std::vector<DCRTPoly>& cv2 = ciphertext2->GetElements();
+    if (cv1.size() != cv2.size() || cv1[0].GetNumOfElements() != cv2[0].GetNumOfElements())
+        OPENFHE_THROW("Ciphertexts in the extended basis should have the same number of elements and towers");
+
+    for (size_t i = 0; i < cv1.size(); ++i) {
+        cv1[i] += cv2[i];
+    }
+}
+
+Ciphertext<DCRTPoly> LeveledSHERNS::EvalAddExt(ConstCiphertext<DCRTPoly> ciphertext1,
+                                               ConstCiphertext<DCRTPoly> ciphertext2) const {
+    Ciphertext<DCRTPoly> result = ciphertext1->Clone();
+    EvalAddExtInPlace(result, ciphertext2);
+    return result;
+}
+
 /////////////////////////////////////
 // SHE LEVELED Mod Reduce
 /////////////////////////////////////
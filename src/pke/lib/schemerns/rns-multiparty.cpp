@@ -183,14 +183,16 @@ Ciphertext<DCRTPoly> MultipartyRNS::MultipartyDecryptMain(ConstCiphertext<DCRTPo
 EvalKey<DCRTPoly> MultipartyRNS::MultiMultEvalKey(PrivateKey<DCRTPoly> privateKey, EvalKey<DCRTPoly> evalKey) const {
     const auto cryptoParams =
         std::dynamic_pointer_cast<CryptoParametersRNS>(evalKey->GetCryptoContext()->GetCryptoParameters());
+    if (cryptoParams->GetKeySwitchTechnique() == KLSS)
+        OPENFHE_THROW("Multiparty key generation is not supported for KLSS key switching");
     const auto ns = cryptoParams->GetNoiseScale();
 
     const DggType& dgg = cryptoParams->GetDiscreteGaussianGenerator();
 
     EvalKey<DCRTPoly> evalKeyResult = std::make_shared<EvalKeyRelinImpl<DCRTPoly>>(evalKey->GetCryptoContext());
 
-    const std::vector<DCRTPoly>& a0 = evalKey->GetAVector();
-    const std::vector<DCRTPoly>& b0 = evalKey->GetBVector();
+    const std::vector<DCRTPoly> a0 = evalKey->CopyAVector();
+    const std::vector<DCRTPoly> b0 = evalKey->CopyBVector();
 
     const size_t size = a0.size();
 
@@ -37,6 +37,7 @@
 
 #include "encoding/encodings.h"
 #include "gtest/gtest.h"
+#include "openfhe.h"
 #include "lattice/lat-hal.h"
 #include "math/math-hal.h"
 #include "utils/utilities.h"
@@ -255,3 +256,130 @@ TEST_F(UTGENERAL_ENCODING, string_encoding) {
     se2.Decode();
     EXPECT_EQ(se2.GetStringValue(), value.substr(0, lp2->GetRingDimension())) << "string truncate encode/decode";
 }
+
+TEST_F(UTGENERAL_ENCODING, ckks_packed_encoding_batch) {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetMultiplicativeDepth(3);
+    parameters.SetScalingModSize(50);
+    parameters.SetRingDim(1024);
+    parameters.SetBatchSize(16);
+    parameters.SetSecurityLevel(HEStd_NotSet);
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+
+    std::vector<std::vector<double>> values(9);
+    std::vector<size_t> scaleDegs(values.size());
+    std::vector<uint32_t> levels(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        for (size_t j = 0; j <= i; ++j)
+            values[i].push_back(0.1 * j - 0.05 * i);
+        scaleDegs[i] = 1 + i % 2;
+        levels[i]    = i % 3;
+    }
+
+    auto plaintexts = cc->MakeCKKSPackedPlaintexts(values, scaleDegs, levels);
+    ASSERT_EQ(plaintexts.size(), values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        auto expected = cc->MakeCKKSPackedPlaintext(values[i], scaleDegs[i], levels[i]);
+        EXPECT_EQ(plaintexts[i]->GetElement<DCRTPoly>(), expected->GetElement<DCRTPoly>()) << "item " << i;
+        EXPECT_EQ(plaintexts[i]->GetLevel(), expected->GetLevel()) << "item " << i;
+        EXPECT_EQ(plaintexts[i]->GetNoiseScaleDeg(), expected->GetNoiseScaleDeg()) << "item " << i;
+    }
+
+    EXPECT_TRUE(cc->MakeCKKSPackedPlaintexts({}).empty());
+    EXPECT_THROW(cc->MakeCKKSPackedPlaintexts(values, {}, {0, 1}), OpenFHEException);
+    values.back().clear();
+    EXPECT_THROW(cc->MakeCKKSPackedPlaintexts(values), OpenFHEException);
+}
+
+TEST_F(UTGENERAL_ENCODING, packed_encoding_batch) {
+    CCParams<CryptoContextBFVRNS> parameters;
+    parameters.SetPlaintextModulus(65537);
+    parameters.SetMultiplicativeDepth(2);
+    parameters.SetRingDim(1024);
+    parameters.SetSecurityLevel(HEStd_NotSet);
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+
+    std::vector<std::vector<int64_t>> values(9);
+    for (size_t i = 0; i < values.size(); ++i) {
+        for (size_t j = 0; j <= i; ++j)
+            values[i].push_back(static_cast<int64_t>(7 * j) - static_cast<int64_t>(3 * i));
+    }
+
+    auto plaintexts = cc->MakePackedPlaintexts(values);
+    ASSERT_EQ(plaintexts.size(), values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        auto expected = cc->MakePackedPlaintext(values[i]);
+        EXPECT_EQ(plaintexts[i]->GetElement<DCRTPoly>(), expected->GetElement<DCRTPoly>()) << "item " << i;
+    }
+
+    EXPECT_THROW(cc->MakePackedPlaintexts(values, {}, std::vector<uint32_t>(values.size(), 1)), OpenFHEException);
+}
+
+TEST_F(UTGENERAL_ENCODING, ckks_encoding_cache) {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetMultiplicativeDepth(3);
+    parameters.SetScalingModSize(50);
+    parameters.SetRingDim(1024);
+    parameters.SetBatchSize(8);
+    parameters.SetSecurityLevel(HEStd_NotSet);
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+    KeyPair<DCRTPoly> kp = cc->KeyGen();
+
+    std::vector<double> x = {0.25, -0.5, 0.75, 1.0, -1.0, 0.5, -0.25, 0.125};
+    auto ct               = cc->Encrypt(kp.publicKey, cc->MakeCKKSPackedPlaintext(x));
+
+    // disabled by default
+    cc->EvalMult(ct, 0.5);
+    EXPECT_EQ(cc->GetEncodedConstantCacheStats().misses, 0U);
+    EXPECT_EQ(cc->GetEncodedConstantCacheStats().capacity, 0U);
+
+    cc->EnableEncodingCache(4);
+    auto uncached = cc->EvalAdd(cc->EvalMult(ct, 0.5), 0.5);
+    auto cached   = cc->EvalAdd(cc->EvalMult(ct, 0.5), 0.5);
+    auto stats    = cc->GetEncodedConstantCacheStats();
+    EXPECT_EQ(stats.misses, 2U);
+    EXPECT_EQ(stats.hits, 2U);
+    EXPECT_EQ(stats.size, 2U);
+    EXPECT_EQ(cached->GetElements(), uncached->GetElements());
+
+    // a different level is a different entry
+    cc->EvalMult(cc->EvalMult(ct, 0.5), 0.5);
+    EXPECT_EQ(cc->GetEncodedConstantCacheStats().misses, 3U);
+
+    Plaintext result;
+    cc->Decrypt(kp.secretKey, cached, &result);
+    result->SetLength(x.size());
+    for (size_t i = 0; i < x.size(); ++i)
+        EXPECT_NEAR(result->GetRealPackedValue()[i], 0.5 * x[i] + 0.5, 1e-6);
+
+    auto pt1 = cc->MakeCKKSPackedPlaintext(x, 1, 1);
+    auto pt2 = cc->MakeCKKSPackedPlaintext(x, 1, 1);
+    EXPECT_EQ(pt1->GetElement<DCRTPoly>(), pt2->GetElement<DCRTPoly>());
+    // the callers get copies of the cached plaintext
+    EXPECT_NE(pt1.get(), pt2.get());
+    pt1->SetLength(2);
+    EXPECT_EQ(cc->MakeCKKSPackedPlaintext(x, 1, 1)->GetLength(), pt2->GetLength());
+    EXPECT_NE(cc->MakeCKKSPackedPlaintext(x, 1, 2)->GetElement<DCRTPoly>(), pt1->GetElement<DCRTPoly>());
+    EXPECT_EQ(cc->GetEncodedPlaintextCacheStats().hits, 2U);
+    EXPECT_EQ(cc->GetEncodedPlaintextCacheStats().misses, 2U);
+
+    // least recently used entries are evicted
+    for (double c = 1; c <= 5; ++c)
+        cc->EvalMult(ct, c);
+    EXPECT_EQ(cc->GetEncodedConstantCacheStats().size, 4U);
+
+    cc->ClearEncodingCache();
+    stats = cc->GetEncodedConstantCacheStats();
+    EXPECT_EQ(stats.size, 0U);
+    EXPECT_EQ(stats.hits + stats.misses, 0U);
+    EXPECT_EQ(stats.capacity, 4U);
+
+    cc->EnableEncodingCache(0);
+    EXPECT_EQ(cc->MakeCKKSPackedPlaintext(x, 1, 1)->GetElement<DCRTPoly>(), pt2->GetElement<DCRTPoly>());
+    EXPECT_EQ(cc->GetEncodedPlaintextCacheStats().size, 0U);
+}
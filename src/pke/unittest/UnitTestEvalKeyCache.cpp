@@ -0,0 +1,166 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+/***
+ * Stress test for the evaluation key cache: several threads run EvalRotate/EvalMult while another
+ * thread keeps adding and removing keys for other secret keys
+ */
+#include "openfhe.h"
+#include "UnitTestUtils.h"
+#include "include/gtest/gtest.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace lbcrypto;
+
+class UTGENERAL_EVALKEYCACHE : public ::testing::Test {
+protected:
+    virtual void SetUp() {}
+
+    virtual void TearDown() {
+        CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+        CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+        CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+    }
+};
+
+TEST_F(UTGENERAL_EVALKEYCACHE, concurrent_eval_and_key_updates) {
+    constexpr uint32_t NUM_READERS    = 4;
+    constexpr uint32_t NUM_ITERATIONS = 250;
+    constexpr uint32_t NUM_OTHER_KEYS = 4;
+
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetMultiplicativeDepth(2);
+    parameters.SetScalingModSize(50);
+    parameters.SetRingDim(1024);
+    parameters.SetBatchSize(8);
+    parameters.SetSecurityLevel(HEStd_NotSet);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+
+    KeyPair<DCRTPoly> kp = cc->KeyGen();
+    cc->EvalMultKeyGen(kp.secretKey);
+    cc->EvalRotateKeyGen(kp.secretKey, {1});
+
+    std::vector<KeyPair<DCRTPoly>> others;
+    for (uint32_t i = 0; i < NUM_OTHER_KEYS; ++i)
+        others.push_back(cc->KeyGen());
+
+    std::vector<double> values = {1.0, -0.5, 0.25, 0.75, -1.0, 0.5, -0.25, 0.125};
+    Plaintext ptxt             = cc->MakeCKKSPackedPlaintext(values);
+    auto ciphertext            = cc->Encrypt(kp.publicKey, ptxt);
+
+    std::vector<double> rotated(values.size());
+    std::vector<double> squared(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        rotated[i] = values[(i + 1) % values.size()];
+        squared[i] = values[i] * values[i];
+    }
+
+    std::atomic<uint32_t> readersDone{0};
+    std::atomic<uint32_t> failures{0};
+    std::atomic<uint32_t> updates{0};
+
+    std::vector<std::thread> readers;
+    for (uint32_t t = 0; t < NUM_READERS; ++t) {
+        readers.emplace_back([&]() {
+            try {
+                Ciphertext<DCRTPoly> ctRot;
+                Ciphertext<DCRTPoly> ctMult;
+                for (uint32_t i = 0; i < NUM_ITERATIONS; ++i) {
+                    ctRot  = cc->EvalRotate(ciphertext, 1);
+                    ctMult = cc->EvalMult(ciphertext, ciphertext);
+                }
+
+                Plaintext result;
+                cc->Decrypt(kp.secretKey, ctRot, &result);
+                result->SetLength(values.size());
+                if (!checkEquality(rotated, result->GetRealPackedValue(), EPSILON_HIGH))
+                    ++failures;
+
+                cc->Decrypt(kp.secretKey, ctMult, &result);
+                result->SetLength(values.size());
+                if (!checkEquality(squared, result->GetRealPackedValue(), EPSILON_HIGH))
+                    ++failures;
+            }
+            catch (...) {
+                ++failures;
+            }
+            ++readersDone;
+        });
+    }
+
+    std::thread writer([&]() {
+        try {
+            // keep inserting and removing keys of other secret keys until all readers are finished
+            for (uint32_t i = 0; readersDone < NUM_READERS; ++i) {
+                const auto& other = others[i % NUM_OTHER_KEYS];
+                cc->EvalMultKeyGen(other.secretKey);
+                cc->EvalRotateKeyGen(other.secretKey, {1, 2});
+                if (i % 2 == 1) {
+                    CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys(other.secretKey->GetKeyTag());
+                    CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys(other.secretKey->GetKeyTag());
+                }
+                ++updates;
+            }
+        }
+        catch (...) {
+            ++failures;
+        }
+    });
+
+    for (auto& reader : readers)
+        reader.join();
+    writer.join();
+
+    EXPECT_EQ(failures.load(), 0U) << "concurrent evaluation returned a wrong result or threw an exception";
+    EXPECT_GT(updates.load(), 0U) << "no keys were updated while evaluating";
+
+    // the keys of the evaluating secret key are untouched
+    EXPECT_EQ(CryptoContextImpl<DCRTPoly>::GetEvalMultKeyVector(kp.secretKey->GetKeyTag())->size(), 1U);
+    EXPECT_EQ(CryptoContextImpl<DCRTPoly>::GetEvalAutomorphismKeyMap(kp.secretKey->GetKeyTag())->size(), 1U);
+
+    // the keys of the evaluating secret key can be removed on their own; the keys that were looked up
+    // before stay valid
+    auto multKeys = CryptoContextImpl<DCRTPoly>::GetEvalMultKeyVector(kp.secretKey->GetKeyTag());
+    auto rotKeys  = CryptoContextImpl<DCRTPoly>::GetEvalAutomorphismKeyMap(kp.secretKey->GetKeyTag());
+    CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys(kp.secretKey->GetKeyTag());
+    CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys(kp.secretKey->GetKeyTag());
+    EXPECT_THROW(cc->EvalRotate(ciphertext, 1), OpenFHEException);
+    EXPECT_EQ(multKeys->size(), 1U);
+    EXPECT_EQ(rotKeys->size(), 1U);
+    for (const auto& [keyTag, keys] : CryptoContextImpl<DCRTPoly>::GetAllEvalMultKeys())
+        EXPECT_NE(keyTag, kp.secretKey->GetKeyTag());
+}
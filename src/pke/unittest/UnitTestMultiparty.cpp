@@ -394,7 +394,7 @@ protected:
                 std::make_shared<std::map<usint, EvalKey<Element>>>(cc->GetEvalSumKeyMap(kp1.secretKey->GetKeyTag()));
             cc->EvalAtIndexKeyGen(kp1.secretKey, indices);
             auto evalAtIndexKeys = std::make_shared<std::map<usint, EvalKey<Element>>>(
-                cc->GetEvalAutomorphismKeyMap(kp1.secretKey->GetKeyTag()));
+                *(cc->GetEvalAutomorphismKeyMap(kp1.secretKey->GetKeyTag())));
             //====================================================================
             KeyPair<Element> kp2 =
                 testData.star ? cc->MultipartyKeyGen(kp1.publicKey) : cc->MultipartyKeyGen(kp1.publicKey, false, true);
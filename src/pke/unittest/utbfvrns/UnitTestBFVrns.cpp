@@ -44,6 +44,8 @@ using namespace lbcrypto;
 //===========================================================================================================
 enum TEST_CASE_TYPE {
     EVAL_FAST_ROTATION = 0,
+    EVAL_POLY,
+    EVAL_MULT_FUSED,
 };
 
 static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
@@ -52,6 +54,12 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
         case EVAL_FAST_ROTATION:
             typeName = "EVAL_FAST_ROTATION";
             break;
+        case EVAL_POLY:
+            typeName = "EVAL_POLY";
+            break;
+        case EVAL_MULT_FUSED:
+            typeName = "EVAL_MULT_FUSED";
+            break;
         default:
             typeName = "UNKNOWN";
             break;
@@ -104,6 +112,20 @@ static std::vector<TEST_CASE_UTBFVRNS> testCases = {
     { EVAL_FAST_ROTATION, "06", {BFVRNS_SCHEME, DFLT, MULDEPTH,  DFLT,     DFLT,  DFLT,    DFLT,       DFLT,          DFLT,     DFLT,   HYBRID, DFLT,     DFLT,    PTM,   DFLT,   DFLT,      DFLT, HPS, DFLT,    DFLT}},
     { EVAL_FAST_ROTATION, "07", {BFVRNS_SCHEME, DFLT, MULDEPTH,  DFLT,     DFLT,  DFLT,    DFLT,       DFLT,          DFLT,     DFLT,   BV,     DFLT,     DFLT,    PTM,   DFLT,   DFLT,      DFLT, BEHZ, DFLT,    DFLT}},
     { EVAL_FAST_ROTATION, "08", {BFVRNS_SCHEME, DFLT, MULDEPTH,  DFLT,     DFLT,  DFLT,    DFLT,       DFLT,          DFLT,     DFLT,   HYBRID, DFLT,     DFLT,    PTM,   DFLT,   DFLT,      DFLT, BEHZ, DFLT,    DFLT}},
+    { EVAL_FAST_ROTATION, "09", {BFVRNS_SCHEME, DFLT, MULDEPTH,  DFLT,     DFLT,  DFLT,    DFLT,       DFLT,          DFLT,     DFLT,   KLSS,   DFLT,     DFLT,    PTM,   DFLT,   DFLT,      DFLT, HPSPOVERQLEVELED, DFLT,    DFLT}},
+    { EVAL_FAST_ROTATION, "10", {BFVRNS_SCHEME, DFLT, MULDEPTH,  DFLT,     DFLT,  DFLT,    DFLT,       DFLT,          DFLT,     DFLT,   KLSS,   DFLT,     DFLT,    PTM,   DFLT,   DFLT,      DFLT, BEHZ, DFLT,    DFLT}},
+    // ==========================================
+    // TestType, Descr,  Scheme,        RDim, MultDepth, SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl, KSTech, ScalTech, LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech,         EncTech, PREMode
+    { EVAL_POLY, "01", {BFVRNS_SCHEME, DFLT, MULDEPTH,  DFLT,     DFLT,  DFLT,    DFLT,       DFLT,          DFLT,     DFLT,   HYBRID, DFLT,     DFLT,    PTM,   DFLT,   DFLT,      DFLT, HPSPOVERQLEVELED, DFLT,    DFLT}},
+    { EVAL_POLY, "02", {BFVRNS_SCHEME, DFLT, MULDEPTH,  DFLT,     DFLT,  DFLT,    DFLT,       DFLT,          DFLT,     DFLT,   BV,     DFLT,     DFLT,    PTM,   DFLT,   DFLT,      DFLT, HPS,              DFLT,    DFLT}},
+    { EVAL_POLY, "03", {BFVRNS_SCHEME, DFLT, MULDEPTH,  DFLT,     DFLT,  DFLT,    DFLT,       DFLT,          DFLT,     DFLT,   HYBRID, DFLT,     DFLT,    PTM,   DFLT,   DFLT,      DFLT, BEHZ,             DFLT,    DFLT}},
+    // ==========================================
+    // TestType,       Descr,  Scheme,        RDim, MultDepth, SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl, KSTech, ScalTech, LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech,         EncTech, PREMode
+    { EVAL_MULT_FUSED, "01", {BFVRNS_SCHEME, DFLT, MULDEPTH,  60,       DFLT,  DFLT,    DFLT,       DFLT,          DFLT,     DFLT,   HYBRID, DFLT,     DFLT,    PTM,   DFLT,   DFLT,      DFLT, HPS,              DFLT,    DFLT}},
+    { EVAL_MULT_FUSED, "02", {BFVRNS_SCHEME, DFLT, MULDEPTH,  60,       DFLT,  DFLT,    DFLT,       DFLT,          DFLT,     DFLT,   HYBRID, DFLT,     DFLT,    PTM,   DFLT,   DFLT,      DFLT, HPSPOVERQ,        DFLT,    DFLT}},
+    { EVAL_MULT_FUSED, "03", {BFVRNS_SCHEME, DFLT, MULDEPTH,  60,       DFLT,  DFLT,    DFLT,       DFLT,          DFLT,     DFLT,   HYBRID, DFLT,     DFLT,    PTM,   DFLT,   DFLT,      DFLT, HPSPOVERQLEVELED, DFLT,    DFLT}},
+    { EVAL_MULT_FUSED, "04", {BFVRNS_SCHEME, DFLT, MULDEPTH,  60,       DFLT,  DFLT,    DFLT,       DFLT,          DFLT,     DFLT,   HYBRID, DFLT,     DFLT,    PTM,   DFLT,   DFLT,      DFLT, BEHZ,             DFLT,    DFLT}},
+    { EVAL_MULT_FUSED, "05", {BFVRNS_SCHEME, DFLT, MULDEPTH,  45,       DFLT,  DFLT,    DFLT,       DFLT,          DFLT,     DFLT,   BV,     DFLT,     DFLT,    PTM,   DFLT,   DFLT,      DFLT, HPSPOVERQLEVELED, DFLT,    DFLT}},
     // ==========================================
 };
 // clang-format on
@@ -213,6 +235,147 @@ protected:
             std::string name("EMSCRIPTEN_UNKNOWN");
 #else
             std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
+#endif
+            std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+    }
+
+    void UnitTest_EvalPoly(const TEST_CASE_UTBFVRNS& testData, const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            KeyPair<Element> keyPair = cc->KeyGen();
+            cc->EvalMultKeyGen(keyPair.secretKey);
+
+            const int64_t t = static_cast<int64_t>(cc->GetCryptoParameters()->GetPlaintextModulus());
+            std::vector<int64_t> x(16);
+            for (size_t i = 0; i < x.size(); ++i)
+                x[i] = static_cast<int64_t>(i * 29 % 41) - 20;
+            auto ciphertext = cc->Encrypt(keyPair.publicKey, cc->MakePackedPlaintext(x));
+
+            // degree 4 is evaluated with the linear method, degree 31 with Paterson-Stockmeyer
+            for (size_t degree : {4, 31}) {
+                std::vector<double> coefficients(degree + 1);
+                for (size_t i = 0; i <= degree; ++i)
+                    coefficients[i] = static_cast<double>(static_cast<int64_t>(i * 37 % 11) - 5);
+
+                std::vector<int64_t> expected(x.size());
+                for (size_t i = 0; i < x.size(); ++i) {
+                    int64_t value = 0;
+                    for (size_t j = degree + 1; j > 0; --j)
+                        value = (value * x[i] + static_cast<int64_t>(coefficients[j - 1])) % t;
+                    value       = (value + t) % t;
+                    expected[i] = (value > t / 2) ? value - t : value;
+                }
+
+                auto result = cc->EvalPoly(ciphertext, coefficients);
+
+                Plaintext plaintext;
+                cc->Decrypt(keyPair.secretKey, result, &plaintext);
+                plaintext->SetLength(x.size());
+                checkEquality(plaintext->GetPackedValue(), expected, eps,
+                              failmsg + " EvalPoly of degree " + std::to_string(degree) + " failed");
+            }
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+#if defined EMSCRIPTEN
+            std::string name("EMSCRIPTEN_UNKNOWN");
+#else
+            std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
+#endif
+            std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+    }
+
+    // A ciphertext padded with a zero element takes the generic tensor product loop instead of the fused
+    // 2 x 2 path, so both have to give the same elements
+    static Ciphertext<Element> PadWithZero(ConstCiphertext<Element> ciphertext) {
+        auto padded = ciphertext->Clone();
+        padded->GetElements().emplace_back(ciphertext->GetElements()[0].GetParams(), Format::EVALUATION, true);
+        return padded;
+    }
+
+    void CheckTensorProduct(const CryptoContext<Element>& cc, ConstCiphertext<Element> ciphertext1,
+                            ConstCiphertext<Element> ciphertext2, const std::string& failmsg) {
+        auto fused   = cc->EvalMultNoRelin(ciphertext1, ciphertext2);
+        auto generic = cc->EvalMultNoRelin(PadWithZero(ciphertext1), ciphertext2);
+
+        const auto& cvFused   = fused->GetElements();
+        const auto& cvGeneric = generic->GetElements();
+        ASSERT_EQ(cvFused.size() + 1, cvGeneric.size()) << failmsg;
+        for (size_t i = 0; i < cvFused.size(); ++i)
+            EXPECT_TRUE(cvFused[i] == cvGeneric[i]) << failmsg << " element " << i << " differs";
+
+        Element zero(cvGeneric.back().GetParams(), cvGeneric.back().GetFormat(), true);
+        EXPECT_TRUE(cvGeneric.back() == zero) << failmsg << " the padded element is not zero";
+    }
+
+    void UnitTest_EvalMultFused(const TEST_CASE_UTBFVRNS& testData, const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            KeyPair<Element> keyPair = cc->KeyGen();
+            cc->EvalMultKeyGen(keyPair.secretKey);
+
+            const int64_t t = static_cast<int64_t>(cc->GetCryptoParameters()->GetPlaintextModulus());
+            std::vector<int64_t> x(16);
+            std::vector<int64_t> y(16);
+            for (size_t i = 0; i < x.size(); ++i) {
+                x[i] = static_cast<int64_t>(i * 29 % 41) - 20;
+                y[i] = static_cast<int64_t>(i * 13 % 23) - 11;
+            }
+            auto ciphertext1 = cc->Encrypt(keyPair.publicKey, cc->MakePackedPlaintext(x));
+            auto ciphertext2 = cc->Encrypt(keyPair.publicKey, cc->MakePackedPlaintext(y));
+
+            // 2 x 2 takes the fused path
+            CheckTensorProduct(cc, ciphertext1, ciphertext2, failmsg + " EvalMult of sizes 2 x 2");
+
+            // 3 x 2 takes the generic loop
+            auto ciphertext3 = cc->EvalMultNoRelin(ciphertext1, ciphertext2);
+            CheckTensorProduct(cc, ciphertext3, ciphertext2, failmsg + " EvalMult of sizes 3 x 2");
+
+            auto ciphertextMult    = cc->EvalMult(ciphertext1, ciphertext2);
+            auto ciphertextMult3x2 = cc->EvalMultNoRelin(ciphertext3, ciphertext2);
+
+            std::vector<int64_t> expected(x.size());
+            std::vector<int64_t> expected3x2(x.size());
+            for (size_t i = 0; i < x.size(); ++i) {
+                int64_t value  = (x[i] * y[i]) % t;
+                expected[i]    = value;
+                value          = (value * y[i] % t + t) % t;
+                expected3x2[i] = (value > t / 2) ? value - t : value;
+            }
+
+            Plaintext plaintextMult;
+            cc->Decrypt(keyPair.secretKey, ciphertextMult, &plaintextMult);
+            plaintextMult->SetLength(x.size());
+            checkEquality(plaintextMult->GetPackedValue(), expected, eps, failmsg + " EvalMult of sizes 2 x 2 failed");
+
+            Plaintext plaintextMult3x2;
+            cc->Decrypt(keyPair.secretKey, ciphertextMult3x2, &plaintextMult3x2);
+            plaintextMult3x2->SetLength(x.size());
+            checkEquality(plaintextMult3x2->GetPackedValue(), expected3x2, eps,
+                          failmsg + " EvalMult of sizes 3 x 2 failed");
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+#if defined EMSCRIPTEN
+            std::string name("EMSCRIPTEN_UNKNOWN");
+#else
+            std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
 #endif
             std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
             // make it fail
@@ -229,6 +392,12 @@ TEST_P(UTBFVRNS, BFVRNS) {
         case EVAL_FAST_ROTATION:
             UnitTest_EvalFastRotation(test, test.buildTestName());
             break;
+        case EVAL_POLY:
+            UnitTest_EvalPoly(test, test.buildTestName());
+            break;
+        case EVAL_MULT_FUSED:
+            UnitTest_EvalMultFused(test, test.buildTestName());
+            break;
         default:
             break;
     }
@@ -47,6 +47,8 @@ using namespace lbcrypto;
 enum TEST_CASE_TYPE {
     EVAL_MULT_SINGLE = 0,
     EVAL_ADD_SINGLE,
+    EVAL_MAT_MUL,
+    EVAL_POLY,
 };
 
 static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
@@ -58,6 +60,12 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
         case EVAL_ADD_SINGLE:
             typeName = "EVAL_ADD_SINGLE";
             break;
+        case EVAL_MAT_MUL:
+            typeName = "EVAL_MAT_MUL";
+            break;
+        case EVAL_POLY:
+            typeName = "EVAL_POLY";
+            break;
         default:
             typeName = "UNKNOWN";
             break;
@@ -99,6 +107,11 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_UTBGVRNS_SHEAD
 //===========================================================================================================
 constexpr usint RING_DIM = 8192;
 constexpr usint PTM      = 20;
+// parameters for packed test cases
+constexpr usint RING_DIM_PACKED = 1024;
+constexpr usint PTM_PACKED      = 65537;
+constexpr usint MULT_DEPTH      = 3;
+constexpr usint POLY_DEPTH      = 5;
 constexpr usint DSIZE    = 4;
 constexpr double STD_DEV = 3.19;
 
@@ -115,6 +128,18 @@ static std::vector<TEST_CASE_UTBGVRNS_SHEADVANCED> testCasesUTBGVRNS_SHEADVANCED
     { EVAL_ADD_SINGLE, "02", {BGVRNS_SCHEME, RING_DIM, DFLT,      DFLT,     DSIZE, DFLT,    DFLT,       DFLT,           DFLT,     DFLT,   DFLT,   FIXEDMANUAL,     DFLT,    PTM,   STD_DEV, DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
     { EVAL_ADD_SINGLE, "03", {BGVRNS_SCHEME, RING_DIM, DFLT,      DFLT,     DSIZE, DFLT,    DFLT,       DFLT,           DFLT,     DFLT,   DFLT,   FIXEDAUTO,       DFLT,    PTM,   STD_DEV, DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
     { EVAL_ADD_SINGLE, "04", {BGVRNS_SCHEME, RING_DIM, DFLT,      DFLT,     DSIZE, DFLT,    DFLT,       DFLT,           DFLT,     DFLT,   DFLT,   FLEXIBLEAUTOEXT, DFLT,    PTM,   STD_DEV, DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    // ==========================================
+    // TestType,   Descr,  Scheme,        RDim,            MultDepth,  SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod,      StdDev,  EvalAddCt, KSCt, MultTech, EncTech, PREMode
+    { EVAL_MAT_MUL, "01", {BGVRNS_SCHEME, RING_DIM_PACKED, MULT_DEPTH, DFLT,     DSIZE, DFLT,    DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FLEXIBLEAUTO,    DFLT,    PTM_PACKED, STD_DEV, DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { EVAL_MAT_MUL, "02", {BGVRNS_SCHEME, RING_DIM_PACKED, MULT_DEPTH, DFLT,     DSIZE, DFLT,    DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDMANUAL,     DFLT,    PTM_PACKED, STD_DEV, DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { EVAL_MAT_MUL, "03", {BGVRNS_SCHEME, RING_DIM_PACKED, MULT_DEPTH, DFLT,     DSIZE, DFLT,    DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDAUTO,       DFLT,    PTM_PACKED, STD_DEV, DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { EVAL_MAT_MUL, "04", {BGVRNS_SCHEME, RING_DIM_PACKED, MULT_DEPTH, DFLT,     DSIZE, DFLT,    DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,    PTM_PACKED, STD_DEV, DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    // ==========================================
+    // TestType, Descr,  Scheme,        RDim,            MultDepth,  SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod,      StdDev,  EvalAddCt, KSCt, MultTech, EncTech, PREMode
+    { EVAL_POLY, "01", {BGVRNS_SCHEME, RING_DIM_PACKED, POLY_DEPTH, DFLT,     DSIZE, DFLT,    DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FLEXIBLEAUTO,    DFLT,    PTM_PACKED, STD_DEV, DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { EVAL_POLY, "02", {BGVRNS_SCHEME, RING_DIM_PACKED, POLY_DEPTH, DFLT,     DSIZE, DFLT,    DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDMANUAL,     DFLT,    PTM_PACKED, STD_DEV, DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { EVAL_POLY, "03", {BGVRNS_SCHEME, RING_DIM_PACKED, POLY_DEPTH, DFLT,     DSIZE, DFLT,    DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDAUTO,       DFLT,    PTM_PACKED, STD_DEV, DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { EVAL_POLY, "04", {BGVRNS_SCHEME, RING_DIM_PACKED, POLY_DEPTH, DFLT,     DSIZE, DFLT,    DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,    PTM_PACKED, STD_DEV, DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
 };
 // clang-format on
 //===========================================================================================================
@@ -217,6 +242,116 @@ protected:
             EXPECT_TRUE(0 == 1) << failmsg;
         }
     }
+    void UnitTest_EvalMatMul(const TEST_CASE_UTBGVRNS_SHEADVANCED& testData,
+                             const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            constexpr uint32_t dim = 4;
+            // matrices packed row by row
+            std::vector<int64_t> matA(dim * dim);
+            std::vector<int64_t> matB(dim * dim);
+            for (uint32_t i = 0; i < dim * dim; ++i) {
+                matA[i] = static_cast<int64_t>(i % 7) - 3;
+                matB[i] = static_cast<int64_t>(i % 5) - 2;
+            }
+            std::vector<int64_t> matAB(dim * dim, 0);
+            for (uint32_t i = 0; i < dim; ++i) {
+                for (uint32_t j = 0; j < dim; ++j) {
+                    for (uint32_t k = 0; k < dim; ++k)
+                        matAB[i * dim + j] += matA[i * dim + k] * matB[k * dim + j];
+                }
+            }
+
+            KeyPair<Element> kp = cc->KeyGen();
+            cc->EvalMultKeyGen(kp.secretKey);
+            cc->EvalMatMulKeyGen(kp.secretKey, dim);
+
+            Ciphertext<Element> ctA = cc->Encrypt(kp.publicKey, cc->MakePackedPlaintext(matA));
+            Ciphertext<Element> ctB = cc->Encrypt(kp.publicKey, cc->MakePackedPlaintext(matB));
+
+            auto precom = cc->EvalMatMulPrecompute(dim);
+            auto ctAB   = cc->EvalMatMul(ctA, ctB, precom);
+
+            Plaintext result;
+            cc->Decrypt(kp.secretKey, ctAB, &result);
+            result->SetLength(dim * dim);
+
+            EXPECT_TRUE(checkEquality(result->GetPackedValue(), matAB)) << failmsg;
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+    #if defined EMSCRIPTEN
+            std::string name("EMSCRIPTEN_UNKNOWN");
+    #else
+            std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
+    #endif
+            std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+    }
+
+    void UnitTest_EvalPoly(const TEST_CASE_UTBGVRNS_SHEADVANCED& testData, const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            KeyPair<Element> kp = cc->KeyGen();
+            cc->EvalMultKeyGen(kp.secretKey);
+
+            const int64_t t = static_cast<int64_t>(cc->GetCryptoParameters()->GetPlaintextModulus());
+            std::vector<int64_t> x(16);
+            for (size_t i = 0; i < x.size(); ++i)
+                x[i] = static_cast<int64_t>(i * 29 % 41) - 20;
+            Ciphertext<Element> ctX = cc->Encrypt(kp.publicKey, cc->MakePackedPlaintext(x));
+
+            // degree 4 is evaluated with the linear method, degree 23 with Paterson-Stockmeyer
+            for (size_t degree : {4, 23}) {
+                std::vector<double> coefficients(degree + 1);
+                for (size_t i = 0; i <= degree; ++i)
+                    coefficients[i] = static_cast<double>(static_cast<int64_t>(i * 37 % 11) - 5);
+                coefficients[degree] = t + 3;
+
+                std::vector<int64_t> expected(x.size());
+                for (size_t i = 0; i < x.size(); ++i) {
+                    int64_t value = 0;
+                    for (size_t j = degree + 1; j > 0; --j)
+                        value = (value * x[i] + static_cast<int64_t>(coefficients[j - 1])) % t;
+                    value = (value + t) % t;
+                    expected[i] = (value > t / 2) ? value - t : value;
+                }
+
+                auto ctResult = cc->EvalPoly(ctX, coefficients);
+                EXPECT_EQ(ctResult->NumberCiphertextElements(), 2u) << failmsg << " degree " << degree;
+
+                Plaintext result;
+                cc->Decrypt(kp.secretKey, ctResult, &result);
+                result->SetLength(x.size());
+                EXPECT_TRUE(checkEquality(result->GetPackedValue(), expected)) << failmsg << " degree " << degree;
+            }
+
+            EXPECT_THROW(cc->EvalPoly(ctX, {1.0, 0.5}), OpenFHEException) << failmsg;
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+    #if defined EMSCRIPTEN
+            std::string name("EMSCRIPTEN_UNKNOWN");
+    #else
+            std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
+    #endif
+            std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+    }
 };
 //===========================================================================================================
 TEST_P(UTBGVRNS_SHEADVANCED, SHEADVANCED) {
@@ -230,6 +365,12 @@ TEST_P(UTBGVRNS_SHEADVANCED, SHEADVANCED) {
         case EVAL_ADD_SINGLE:
             UnitTest_EvalAddSingle(test, test.buildTestName());
             break;
+        case EVAL_MAT_MUL:
+            UnitTest_EvalMatMul(test, test.buildTestName());
+            break;
+        case EVAL_POLY:
+            UnitTest_EvalPoly(test, test.buildTestName());
+            break;
         default:
             break;
     }
@@ -41,7 +41,10 @@
 #include "cryptocontext-ser.h"
 #include "scheme/ckksrns/ckksrns-ser.h"
 
+#include <atomic>
+#include <cstdio>
 #include <iostream>
+#include <thread>
 #include <vector>
 #include "gtest/gtest.h"
 #include <cxxabi.h>
@@ -58,6 +61,11 @@ enum TEST_CASE_TYPE {
     BOOTSTRAP_ITERATIVE,
     BOOTSTRAP_NUM_TOWERS,
     BOOTSTRAP_SERIALIZE,
+    BOOTSTRAP_BATCH,
+    BOOTSTRAP_PRECOMPUTATION,
+    BOOTSTRAP_PAIR,
+    BOOTSTRAP_CONCURRENT,
+    BOOTSTRAP_ENCAPSULATION_BOUND,
 };
 
 static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
@@ -84,6 +92,21 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
         case BOOTSTRAP_SERIALIZE:
             typeName = "BOOTSTRAP_SERIALIZE";
             break;
+        case BOOTSTRAP_BATCH:
+            typeName = "BOOTSTRAP_BATCH";
+            break;
+        case BOOTSTRAP_PRECOMPUTATION:
+            typeName = "BOOTSTRAP_PRECOMPUTATION";
+            break;
+        case BOOTSTRAP_PAIR:
+            typeName = "BOOTSTRAP_PAIR";
+            break;
+        case BOOTSTRAP_CONCURRENT:
+            typeName = "BOOTSTRAP_CONCURRENT";
+            break;
+        case BOOTSTRAP_ENCAPSULATION_BOUND:
+            typeName = "BOOTSTRAP_ENCAPSULATION_BOUND";
+            break;
         default:
             typeName = "UNKNOWN";
             break;
@@ -136,6 +159,9 @@ constexpr uint32_t FMODSIZE = 89;
 #else
 constexpr uint32_t SMODSIZE = 59;
 constexpr uint32_t FMODSIZE = 60;
+// COMPOSITESCALINGAUTO splits every level into 2 moduli
+constexpr uint32_t SMODSIZE_COMP = 78;
+constexpr uint32_t FMODSIZE_COMP = 89;
 #endif
 
 // clang-format off
@@ -162,6 +188,17 @@ static std::vector<TEST_CASE_UTCKKSRNS_BOOT> testCases = {
     { BOOTSTRAP_FULL, "16", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 3 },  { 0, 0 }, RDIM/2 },
     { BOOTSTRAP_FULL, "17", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 3 },  { 0, 0 }, RDIM/2 },
     { BOOTSTRAP_FULL, "18", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 3 },  { 0, 0 }, RDIM/2 },
+#endif
+    // ==========================================
+    // TestType,     Descr, Scheme,          RDim, MultDepth,  SModSize,     DSize, BatchSz, SecKeyDist,         MaxRelinSkDeg, FModSize,  SecLvl,       KSTech, ScalTech,        LDigits,      PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, LvlBudget, Dim1,       Slots
+    { BOOTSTRAP_FULL, "21", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_ENCAPSULATED, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 3 },  { 0, 0 }, RDIM/2 },
+    { BOOTSTRAP_FULL, "22", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_ENCAPSULATED, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDMANUAL,     NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 3 },  { 0, 0 }, RDIM/2 },
+#if NATIVEINT != 128
+    { BOOTSTRAP_FULL, "23", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_ENCAPSULATED, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 3 },  { 0, 0 }, RDIM/2 },
+    { BOOTSTRAP_FULL, "24", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_ENCAPSULATED, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 3 },  { 0, 0 }, RDIM/2 },
+    { BOOTSTRAP_FULL, "25", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE_COMP, DFLT, DFLT,    UNIFORM_TERNARY,     DFLT,          FMODSIZE_COMP, HEStd_NotSet, HYBRID, COMPOSITESCALINGAUTO, NUM_LRG_DIGS, DFLT, DFLT, DFLT, DFLT, DFLT, DFLT,    DFLT},   { 1, 1 },  { 32, 32 }, RDIM/2 },
+    { BOOTSTRAP_FULL, "26", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE_COMP, DFLT, DFLT,    SPARSE_TERNARY,      DFLT,          FMODSIZE_COMP, HEStd_NotSet, HYBRID, COMPOSITESCALINGAUTO, NUM_LRG_DIGS, DFLT, DFLT, DFLT, DFLT, DFLT, DFLT,    DFLT},   { 3, 3 },  { 0, 0 }, RDIM/2 },
+    { BOOTSTRAP_FULL, "27", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE_COMP, DFLT, DFLT,    SPARSE_ENCAPSULATED, DFLT,          FMODSIZE_COMP, HEStd_NotSet, HYBRID, COMPOSITESCALINGAUTO, NUM_LRG_DIGS, DFLT, DFLT, DFLT, DFLT, DFLT, DFLT,    DFLT},   { 3, 3 },  { 0, 0 }, RDIM/2 },
 #endif
     // ==========================================
     // TestType,      Descr, Scheme,          RDim, MultDepth,  SModSize,     DSize, BatchSz, SecKeyDist,      MaxRelinSkDeg, FModSize,  SecLvl,       KSTech, ScalTech,        LDigits,      PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, LvlBudget, Dim1,     Slots
@@ -313,6 +350,40 @@ static std::vector<TEST_CASE_UTCKKSRNS_BOOT> testCases = {
     { BOOTSTRAP_SERIALIZE, "05", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 2, 2 },  { 4, 4 },   RDIM/2 },
     { BOOTSTRAP_SERIALIZE, "06", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 2, 2 },  { 4, 4 },   RDIM/2 },
     // ==========================================
+    // TestType,       Descr, Scheme,         RDim, MultDepth,  SModSize,     DSize, BatchSz, SecKeyDist,      MaxRelinSkDeg, FModSize,  SecLvl,       KSTech, ScalTech,        LDigits,      PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, LvlBudget, Dim1,     Slots
+    { BOOTSTRAP_BATCH, "01", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 }, RDIM/8 },
+    { BOOTSTRAP_BATCH, "02", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDMANUAL,     NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 }, RDIM/16},
+#if NATIVEINT != 128
+    { BOOTSTRAP_BATCH, "03", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 }, RDIM/16},
+#endif
+    // ==========================================
+    // TestType,                Descr, Scheme,         RDim, MultDepth,  SModSize,     DSize, BatchSz, SecKeyDist,      MaxRelinSkDeg, FModSize,  SecLvl,       KSTech, ScalTech,        LDigits,      PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, LvlBudget, Dim1,       Slots
+    { BOOTSTRAP_PRECOMPUTATION, "01", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 1, 1 },  { 32, 32 }, RDIM/2 },
+    { BOOTSTRAP_PRECOMPUTATION, "02", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDMANUAL,     NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 2, 2 },  { 0, 0 },   RDIM/2 },
+#if NATIVEINT != 128
+    { BOOTSTRAP_PRECOMPUTATION, "03", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 },   RDIM/2 },
+#endif
+    // ==========================================
+    // TestType,      Descr, Scheme,         RDim, MultDepth,  SModSize,     DSize, BatchSz, SecKeyDist,      MaxRelinSkDeg, FModSize,  SecLvl,       KSTech, ScalTech,        LDigits,      PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, LvlBudget, Dim1,     Slots
+    { BOOTSTRAP_PAIR, "01", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 }, RDIM/2 },
+    { BOOTSTRAP_PAIR, "02", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDMANUAL,     NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 }, RDIM/2 },
+    { BOOTSTRAP_PAIR, "03", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 }, RDIM/8 },
+#if NATIVEINT != 128
+    { BOOTSTRAP_PAIR, "04", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 }, RDIM/8 },
+#endif
+    // ==========================================
+    // TestType,            Descr, Scheme,         RDim, MultDepth,  SModSize,     DSize, BatchSz, SecKeyDist,      MaxRelinSkDeg, FModSize,  SecLvl,       KSTech, ScalTech,        LDigits,      PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, LvlBudget, Dim1,     Slots
+    { BOOTSTRAP_CONCURRENT, "01", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 }, RDIM/4 },
+#if NATIVEINT != 128
+    { BOOTSTRAP_CONCURRENT, "02", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 }, RDIM/8 },
+#endif
+    // ==========================================
+    // TestType,                     Descr, Scheme,         RDim, MultDepth, SModSize,     DSize, BatchSz, SecKeyDist,          MaxRelinSkDeg, FModSize,  SecLvl,            KSTech, ScalTech,        LDigits,      PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, LvlBudget, Dim1,     Slots
+    { BOOTSTRAP_ENCAPSULATION_BOUND, "01", {CKKSRNS_SCHEME, DFLT, 5,         SMODSIZE,     DFLT,  DFLT,    SPARSE_ENCAPSULATED, DFLT,          FMODSIZE,  HEStd_128_classic, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 1, 1 },  { 0, 0 }, 0 },
+#if NATIVEINT != 128
+    { BOOTSTRAP_ENCAPSULATION_BOUND, "02", {CKKSRNS_SCHEME, DFLT, 5,         SMODSIZE,     DFLT,  DFLT,    SPARSE_ENCAPSULATED, DFLT,          FMODSIZE,  HEStd_128_classic, HYBRID, FLEXIBLEAUTO,    NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 1, 1 },  { 0, 0 }, 0 },
+#endif
+    // ==========================================
 };
 // clang-format on
 //===========================================================================================================
@@ -346,8 +417,14 @@ protected:
 
     void TearDown() {
         CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+        // the file is removed here, so it is not left behind by a failed assertion
+        if (!m_precomFile.empty())
+            std::remove(m_precomFile.c_str());
     }
 
+    // the file written by UnitTest_Bootstrap_Precomputation
+    std::string m_precomFile;
+
     void UnitTest_Bootstrap(const TEST_CASE_UTCKKSRNS_BOOT& testData, const std::string& failmsg = std::string()) {
         try {
             CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
@@ -359,6 +436,14 @@ protected:
             cc->EvalAtIndexKeyGen(keyPair.secretKey, {6});
             cc->EvalMultKeyGen(keyPair.secretKey);
 
+            if (testData.params.secretKeyDist == SPARSE_ENCAPSULATED) {
+                // the encapsulation keys are kept apart from the automorphism keys, which have odd indices only
+                const std::string& keyTag = keyPair.secretKey->GetKeyTag();
+                EXPECT_EQ(cc->GetEvalEncapsulationKeyVectorPtr(keyTag)->size(), 2u) << failmsg;
+                for (auto index : cc->GetExistingEvalAutomorphismKeyIndices(keyTag))
+                    EXPECT_EQ(index % 2, 1u) << failmsg << " automorphism key with even index " << index;
+            }
+
             std::vector<std::complex<double>> input;
             if (testData.slots < 8) {
                 input = Fill({0.1415926}, testData.slots);
@@ -574,6 +659,258 @@ protected:
         }
     }
 
+    void UnitTest_Bootstrap_Batch(const TEST_CASE_UTCKKSRNS_BOOT& testData,
+                                  const std::string& failmsg = std::string()) {
+        try {
+            // 3 ciphertexts are packed into 4 * slots slots
+            constexpr uint32_t BATCH_SIZE = 3;
+            const uint32_t batchSlots     = 4 * testData.slots;
+
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            cc->EvalBootstrapSetup(testData.levelBudget, testData.dim1, batchSlots);
+
+            auto keyPair = cc->KeyGen();
+            cc->EvalBootstrapBatchKeyGen(keyPair.secretKey, testData.slots, BATCH_SIZE);
+            cc->EvalMultKeyGen(keyPair.secretKey);
+            cc->EvalAtIndexKeyGen(keyPair.secretKey, {1});
+
+            std::vector<std::vector<std::complex<double>>> inputs;
+            std::vector<Ciphertext<Element>> ciphertexts;
+            for (uint32_t i = 0; i < BATCH_SIZE; i++) {
+                std::vector<std::complex<double>> input(testData.slots);
+                for (uint32_t j = 0; j < testData.slots; j++)
+                    input[j] = 0.1 * (i + 1) + 0.05 * j;
+                Plaintext plaintext = cc->MakeCKKSPackedPlaintext(input, 1, MULT_DEPTH - 1, nullptr, testData.slots);
+                inputs.push_back(input);
+                ciphertexts.push_back(cc->Encrypt(keyPair.publicKey, plaintext));
+            }
+
+            auto ciphertextsAfter = cc->EvalBootstrapBatch(ciphertexts);
+            EXPECT_EQ(ciphertextsAfter.size(), BATCH_SIZE) << failmsg;
+
+            for (uint32_t i = 0; i < std::min<size_t>(BATCH_SIZE, ciphertextsAfter.size()); i++) {
+                EXPECT_EQ(ciphertextsAfter[i]->GetSlots(), testData.slots) << failmsg;
+                EXPECT_GT(ciphertextsAfter[i]->GetElements()[0].GetNumOfElements(),
+                          ciphertexts[i]->GetElements()[0].GetNumOfElements())
+                    << failmsg << " batched bootstrapping did not raise the modulus";
+
+                Plaintext result;
+                cc->Decrypt(keyPair.secretKey, ciphertextsAfter[i], &result);
+                result->SetLength(testData.slots);
+                checkEquality(result->GetCKKSPackedValue(), inputs[i], eps,
+                              failmsg + " Batched bootstrapping fails for ciphertext " + std::to_string(i));
+
+                // the unpacked ciphertexts are regular sparsely packed ciphertexts
+                auto rotated = inputs[i];
+                std::rotate(rotated.begin(), rotated.begin() + 1, rotated.end());
+
+                cc->Decrypt(keyPair.secretKey, cc->EvalAtIndex(ciphertextsAfter[i], 1), &result);
+                result->SetLength(testData.slots);
+                checkEquality(result->GetCKKSPackedValue(), rotated, eps,
+                              failmsg + " EvalAtIndex after batched bootstrapping fails for ciphertext " +
+                                  std::to_string(i));
+            }
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+#if defined EMSCRIPTEN
+            std::string name("EMSCRIPTEN_UNKNOWN");
+#else
+            std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
+#endif
+            std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+    }
+
+    void UnitTest_Bootstrap_Pair(const TEST_CASE_UTCKKSRNS_BOOT& testData,
+                                 const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            cc->EvalBootstrapSetup(testData.levelBudget, testData.dim1, testData.slots);
+
+            auto keyPair = cc->KeyGen();
+            cc->EvalBootstrapKeyGen(keyPair.secretKey, testData.slots);
+            cc->EvalMultKeyGen(keyPair.secretKey);
+
+            std::vector<std::complex<double>> input1(testData.slots);
+            std::vector<std::complex<double>> input2(testData.slots);
+            for (uint32_t j = 0; j < testData.slots; j++) {
+                input1[j] = 0.9 * std::sin(0.1 * j);
+                input2[j] = 0.5 - 0.4 * std::cos(0.3 * j);
+            }
+
+            Plaintext plaintext1 = cc->MakeCKKSPackedPlaintext(input1, 1, MULT_DEPTH - 1, nullptr, testData.slots);
+            Plaintext plaintext2 = cc->MakeCKKSPackedPlaintext(input2, 1, MULT_DEPTH - 1, nullptr, testData.slots);
+            auto ciphertext1     = cc->Encrypt(keyPair.publicKey, plaintext1);
+            auto ciphertext2     = cc->Encrypt(keyPair.publicKey, plaintext2);
+
+            auto ciphertextsAfter = cc->EvalBootstrapPair(ciphertext1, ciphertext2);
+            auto ciphertextSingle = cc->EvalBootstrap(ciphertext1);
+
+            // maximum error of the real parts; the imaginary parts are checked by checkEquality
+            auto maxError = [&](ConstCiphertext<Element> ciphertext, const std::vector<std::complex<double>>& expected,
+                                const std::string& msg) {
+                EXPECT_EQ(ciphertext->GetSlots(), testData.slots) << failmsg;
+                EXPECT_GT(ciphertext->GetElements()[0].GetNumOfElements(),
+                          ciphertext1->GetElements()[0].GetNumOfElements())
+                    << failmsg << " bootstrapping did not raise the modulus";
+
+                Plaintext result;
+                cc->Decrypt(keyPair.secretKey, ciphertext, &result);
+                result->SetLength(testData.slots);
+                auto values = result->GetCKKSPackedValue();
+                checkEquality(values, expected, eps, failmsg + msg);
+
+                double error = 0;
+                for (uint32_t j = 0; j < testData.slots; j++)
+                    error = std::max(error, std::abs(values[j].real() - expected[j].real()));
+                return error;
+            };
+
+            const std::string msg = " Paired bootstrapping fails for ciphertext ";
+            double error1         = maxError(ciphertextsAfter.first, input1, msg + "0");
+            double error2         = maxError(ciphertextsAfter.second, input2, msg + "1");
+            double errorSingle    = maxError(ciphertextSingle, input1, " Bootstrapping fails");
+
+            // the two messages share one bootstrapping, so each of them gets about the precision of a
+            // single bootstrapping; allow up to 3 bits less
+            EXPECT_LE(error1, 8 * errorSingle) << failmsg << " precision loss of paired bootstrapping is too high";
+            EXPECT_LE(error2, 8 * errorSingle) << failmsg << " precision loss of paired bootstrapping is too high";
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+#if defined EMSCRIPTEN
+            std::string name("EMSCRIPTEN_UNKNOWN");
+#else
+            std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
+#endif
+            std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+    }
+
+    void UnitTest_Bootstrap_Concurrent(const TEST_CASE_UTCKKSRNS_BOOT& testData,
+                                       const std::string& failmsg = std::string()) {
+        // every thread bootstraps its own pair of ciphertexts using the shared precomputations and keys;
+        // the threads alternate between EvalBootstrap, EvalBootstrapPair and EvalBootstrapBatch
+        constexpr uint32_t NUM_THREADS    = 16;
+        constexpr uint32_t NUM_ITERATIONS = 4;
+        constexpr uint32_t BATCH_SIZE     = 2;
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            cc->EvalBootstrapSetup(testData.levelBudget, testData.dim1, testData.slots);
+            cc->EvalBootstrapSetup(testData.levelBudget, testData.dim1, BATCH_SIZE * testData.slots);
+
+            auto keyPair = cc->KeyGen();
+            cc->EvalBootstrapKeyGen(keyPair.secretKey, testData.slots);
+            cc->EvalBootstrapBatchKeyGen(keyPair.secretKey, testData.slots, BATCH_SIZE);
+            cc->EvalMultKeyGen(keyPair.secretKey);
+
+            std::vector<std::vector<std::vector<std::complex<double>>>> inputs(NUM_THREADS);
+            std::vector<std::vector<Ciphertext<Element>>> ciphertexts(NUM_THREADS);
+            for (uint32_t t = 0; t < NUM_THREADS; ++t) {
+                for (uint32_t k = 0; k < BATCH_SIZE; ++k) {
+                    std::vector<std::complex<double>> input(testData.slots);
+                    for (uint32_t j = 0; j < testData.slots; ++j)
+                        input[j] = 0.05 * t - 0.4 + 0.3 * k + 0.2 * std::sin(0.1 * j);
+                    Plaintext plaintext =
+                        cc->MakeCKKSPackedPlaintext(input, 1, MULT_DEPTH - 1, nullptr, testData.slots);
+                    inputs[t].push_back(input);
+                    ciphertexts[t].push_back(cc->Encrypt(keyPair.publicKey, plaintext));
+                }
+            }
+
+            std::atomic<uint32_t> failures{0};
+            std::vector<std::vector<Ciphertext<Element>>> results(NUM_THREADS);
+            std::vector<std::thread> threads;
+            for (uint32_t t = 0; t < NUM_THREADS; ++t) {
+                threads.emplace_back([&, t]() {
+                    try {
+                        for (uint32_t i = 0; i < NUM_ITERATIONS; ++i) {
+                            switch (t % 3) {
+                                case 0:
+                                    results[t] = {cc->EvalBootstrap(ciphertexts[t][0]),
+                                                  cc->EvalBootstrap(ciphertexts[t][1])};
+                                    break;
+                                case 1: {
+                                    auto pair  = cc->EvalBootstrapPair(ciphertexts[t][0], ciphertexts[t][1]);
+                                    results[t] = {pair.first, pair.second};
+                                    break;
+                                }
+                                default:
+                                    results[t] = cc->EvalBootstrapBatch(ciphertexts[t]);
+                                    break;
+                            }
+                        }
+                    }
+                    catch (...) {
+                        ++failures;
+                    }
+                });
+            }
+            for (auto& thread : threads)
+                thread.join();
+
+            EXPECT_EQ(failures.load(), 0U) << failmsg << " concurrent bootstrapping threw an exception";
+
+            for (uint32_t t = 0; t < NUM_THREADS; ++t) {
+                for (uint32_t k = 0; k < results[t].size(); ++k) {
+                    Plaintext result;
+                    cc->Decrypt(keyPair.secretKey, results[t][k], &result);
+                    result->SetLength(testData.slots);
+                    checkEquality(result->GetCKKSPackedValue(), inputs[t][k], eps,
+                                  failmsg + " Concurrent bootstrapping fails for thread " + std::to_string(t) +
+                                      ", ciphertext " + std::to_string(k));
+                }
+            }
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+#if defined EMSCRIPTEN
+            std::string name("EMSCRIPTEN_UNKNOWN");
+#else
+            std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
+#endif
+            std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+    }
+
+    void UnitTest_Bootstrap_EncapsulationBound(const TEST_CASE_UTCKKSRNS_BOOT& testData,
+                                               const std::string& failmsg = std::string()) {
+        // the key switching to the sparse secret of SPARSE_ENCAPSULATED spans Q_0 * P, which is far beyond
+        // the bound for a Hamming weight of 32 with these parameters, so the context must be rejected
+        bool rejected = false;
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+        }
+        catch (const OpenFHEException& e) {
+            rejected = std::string(e.what()).find("log2(Q_0 * P)") != std::string::npos;
+        }
+        catch (...) {
+        }
+        EXPECT_TRUE(rejected) << failmsg << " SPARSE_ENCAPSULATED was not rejected for a too large Q_0 * P";
+    }
+
     void UnitTest_Bootstrap_NumTowers(const TEST_CASE_UTCKKSRNS_BOOT& testData,
                                       const std::string& failmsg = std::string()) {
         // This test checks to make sure that we return the original ciphertext if we
@@ -732,6 +1069,75 @@ protected:
             std::string name("EMSCRIPTEN_UNKNOWN");
 #else
             std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
+#endif
+            std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+    }
+    void UnitTest_Bootstrap_Precomputation(const TEST_CASE_UTCKKSRNS_BOOT& testData,
+                                           const std::string& failmsg = std::string()) {
+        m_precomFile = "boot_precom_" + testData.buildTestName() + ".bin";
+        try {
+            CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+            CryptoContextImpl<DCRTPoly>::ClearEvalSumKeys();
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+            CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+
+            CryptoContext<Element> ccInit(UnitTestGenerateContext(testData.params));
+            ccInit->EvalBootstrapSetup(testData.levelBudget, testData.dim1, testData.slots);
+            ccInit->EvalBootstrapSetup(testData.levelBudget, testData.dim1, testData.slots / 2);
+            ASSERT_TRUE(ccInit->SerializeEvalBootstrapPrecomputation(m_precomFile))
+                << failmsg << " precomputation serialization failed";
+            CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+
+            // the precomputations can not be loaded into a context with other parameters
+            UnitTestCCParams otherParams    = testData.params;
+            otherParams.multiplicativeDepth = MULT_DEPTH + 1;
+            CryptoContext<Element> ccOther(UnitTestGenerateContext(otherParams));
+            EXPECT_THROW(ccOther->DeserializeEvalBootstrapPrecomputation(m_precomFile), OpenFHEException)
+                << failmsg << " precomputations for other parameters are accepted";
+            CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+
+            // a new context is ready for bootstrapping without EvalBootstrapSetup
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+            ASSERT_TRUE(cc->DeserializeEvalBootstrapPrecomputation(m_precomFile))
+                << failmsg << " precomputation deserialization failed";
+
+            auto keyPair = cc->KeyGen();
+            cc->EvalMultKeyGen(keyPair.secretKey);
+            cc->EvalBootstrapKeyGen(keyPair.secretKey, testData.slots);
+            cc->EvalBootstrapKeyGen(keyPair.secretKey, testData.slots / 2);
+
+            for (uint32_t slots : {testData.slots, testData.slots / 2}) {
+                std::vector<std::complex<double>> input(
+                    Fill({0.111111, 0.222222, 0.333333, 0.444444, 0.555555, 0.666666, 0.777777, 0.888888}, slots));
+                size_t encodedLength = input.size();
+
+                Plaintext plaintext  = cc->MakeCKKSPackedPlaintext(input, 1, MULT_DEPTH - 1, nullptr, slots);
+                auto ciphertext      = cc->Encrypt(keyPair.publicKey, plaintext);
+                auto ciphertextAfter = cc->EvalBootstrap(ciphertext);
+
+                Plaintext result;
+                cc->Decrypt(keyPair.secretKey, ciphertextAfter, &result);
+                result->SetLength(encodedLength);
+                plaintext->SetLength(encodedLength);
+                checkEquality(result->GetCKKSPackedValue(), plaintext->GetCKKSPackedValue(), eps,
+                              failmsg + " Bootstrapping with loaded precomputations fails for " +
+                                  std::to_string(slots) + " slots");
+            }
+
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+#if defined EMSCRIPTEN
+            std::string name("EMSCRIPTEN_UNKNOWN");
+#else
+            std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
 #endif
             std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
             // make it fail
@@ -763,6 +1169,21 @@ TEST_P(UTCKKSRNS_BOOT, CKKSRNS) {
         case BOOTSTRAP_SERIALIZE:
             UnitTest_Bootstrap_Serialize(test, test.buildTestName());
             break;
+        case BOOTSTRAP_BATCH:
+            UnitTest_Bootstrap_Batch(test, test.buildTestName());
+            break;
+        case BOOTSTRAP_PRECOMPUTATION:
+            UnitTest_Bootstrap_Precomputation(test, test.buildTestName());
+            break;
+        case BOOTSTRAP_PAIR:
+            UnitTest_Bootstrap_Pair(test, test.buildTestName());
+            break;
+        case BOOTSTRAP_CONCURRENT:
+            UnitTest_Bootstrap_Concurrent(test, test.buildTestName());
+            break;
+        case BOOTSTRAP_ENCAPSULATION_BOUND:
+            UnitTest_Bootstrap_EncapsulationBound(test, test.buildTestName());
+            break;
         default:
             break;
     }
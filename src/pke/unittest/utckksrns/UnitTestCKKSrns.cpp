@@ -44,6 +44,7 @@
 #include <cxxabi.h>
 #include <iterator>
 #include "utils/demangle.h"
+#include "keyswitch/keyswitch-klss.h"
 
 using namespace lbcrypto;
 
@@ -64,6 +65,13 @@ enum TEST_CASE_TYPE {
     ADD_PACKED_PRECISION,
     MULT_PACKED_PRECISION,
     EVALSQUARE,
+    TRIMMED_EVAL_KEYS,
+    COMPOSITE_SCALING_PRECISION,
+    EVAL_MAT_MUL,
+    EVAL_MULT_RESCALE,
+    EVAL_ADD_MANY_LEVELS,
+    EVAL_ROTATION_EXT,
+    KLSS_EXACT_CONVERSION,
 };
 
 static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
@@ -114,6 +122,27 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
         case EVALSQUARE:
             typeName = "EVALSQUARE";
             break;
+        case TRIMMED_EVAL_KEYS:
+            typeName = "TRIMMED_EVAL_KEYS";
+            break;
+        case COMPOSITE_SCALING_PRECISION:
+            typeName = "COMPOSITE_SCALING_PRECISION";
+            break;
+        case EVAL_MAT_MUL:
+            typeName = "EVAL_MAT_MUL";
+            break;
+        case EVAL_MULT_RESCALE:
+            typeName = "EVAL_MULT_RESCALE";
+            break;
+        case EVAL_ADD_MANY_LEVELS:
+            typeName = "EVAL_ADD_MANY_LEVELS";
+            break;
+        case EVAL_ROTATION_EXT:
+            typeName = "EVAL_ROTATION_EXT";
+            break;
+        case KLSS_EXACT_CONVERSION:
+            typeName = "KLSS_EXACT_CONVERSION";
+            break;
         default:
             typeName = "UNKNOWN";
             break;
@@ -171,6 +200,9 @@ constexpr usint SMODSIZE = 90;
 #else
 constexpr usint RING_DIM_PREC = 2048;  // for test cases with approximation error comparison only
 constexpr usint SMODSIZE      = 50;
+// COMPOSITESCALINGAUTO splits every level into 2 moduli, so the scaling factor may exceed a machine word
+constexpr usint SMODSIZE_COMP = 80;
+constexpr usint FMODSIZE_COMP = 100;
 #endif
 // MIN_PRECISION_DIFF is the minimal difference expected between approximation error/precision for FLEXIBLEAUTO and FLEXIBLEAUTOEXT
 constexpr double MIN_PRECISION_DIFF = 1.5;
@@ -186,6 +218,8 @@ static std::vector<TEST_CASE_UTCKKSRNS> testCases = {
     { ADD_PACKED, "06", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   0},
     { ADD_PACKED, "07", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   0},
     { ADD_PACKED, "08", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   0},
+    { ADD_PACKED, "09", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE_COMP, DSIZE, BATCH,   DFLT,       DFLT,          FMODSIZE_COMP, HEStd_NotSet, BV,     COMPOSITESCALINGAUTO, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   0},
+    { ADD_PACKED, "10", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE_COMP, DSIZE, BATCH,   DFLT,       DFLT,          FMODSIZE_COMP, HEStd_NotSet, HYBRID, COMPOSITESCALINGAUTO, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   0},
     // TestType,            Descr, Scheme,         RDim,      MultDepth, SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech, LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, Slots, LowPrec,      HighPrec
     { ADD_PACKED_PRECISION, "01", {CKKSRNS_SCHEME, RING_DIM_PREC, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, DFLT,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   0,     FLEXIBLEAUTO, FLEXIBLEAUTOEXT},
     { ADD_PACKED_PRECISION, "02", {CKKSRNS_SCHEME, RING_DIM_PREC, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     DFLT,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   0,     FLEXIBLEAUTO, FLEXIBLEAUTOEXT},
@@ -231,6 +265,8 @@ static std::vector<TEST_CASE_UTCKKSRNS> testCases = {
     { MULT_PACKED, "06", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   0},
     { MULT_PACKED, "07", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   0},
     { MULT_PACKED, "08", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   0},
+    { MULT_PACKED, "09", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE_COMP, DSIZE, BATCH,   DFLT,       DFLT,          FMODSIZE_COMP, HEStd_NotSet, BV,     COMPOSITESCALINGAUTO, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   0},
+    { MULT_PACKED, "10", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE_COMP, DSIZE, BATCH,   DFLT,       DFLT,          FMODSIZE_COMP, HEStd_NotSet, HYBRID, COMPOSITESCALINGAUTO, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   0},
     // TestType,             Descr, Scheme,         RDim,      MultDepth, SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech, LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, Slots, LowPrec,      HighPrec
     { MULT_PACKED_PRECISION, "01", {CKKSRNS_SCHEME, RING_DIM_PREC, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, DFLT,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   0,     FLEXIBLEAUTO, FLEXIBLEAUTOEXT},
     { MULT_PACKED_PRECISION, "02", {CKKSRNS_SCHEME, RING_DIM_PREC, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     DFLT,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   0,     FLEXIBLEAUTO, FLEXIBLEAUTOEXT},
@@ -299,11 +335,17 @@ static std::vector<TEST_CASE_UTCKKSRNS> testCases = {
     { MULT_PACKED, "46", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   RING_DIM_HALF},
     { MULT_PACKED, "47", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   RING_DIM_HALF},
     { MULT_PACKED, "48", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   RING_DIM_HALF},
+    { MULT_PACKED, "49", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, KLSS,   FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   RING_DIM_HALF},
+    { MULT_PACKED, "50", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, KLSS,   FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   RING_DIM_HALF},
     // TestType,             Descr, Scheme,         RDim,      MultDepth, SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech, LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, Slots,         LowPrec,      HighPrec
     { MULT_PACKED_PRECISION, "41", {CKKSRNS_SCHEME, RING_DIM_PREC, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, DFLT,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   RING_DIM_HALF, FLEXIBLEAUTO, FLEXIBLEAUTOEXT },
     { MULT_PACKED_PRECISION, "42", {CKKSRNS_SCHEME, RING_DIM_PREC, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     DFLT,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   RING_DIM_HALF, FLEXIBLEAUTO, FLEXIBLEAUTOEXT },
     { MULT_PACKED_PRECISION, "43", {CKKSRNS_SCHEME, RING_DIM_PREC, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, DFLT,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   RING_DIM_HALF, FIXEDAUTO,    FLEXIBLEAUTO },
     { MULT_PACKED_PRECISION, "44", {CKKSRNS_SCHEME, RING_DIM_PREC, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     DFLT,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   RING_DIM_HALF, FIXEDAUTO,    FLEXIBLEAUTO },
+    // the lower precision run uses FLEXIBLEAUTO with SMODSIZE and the default first modulus size
+    // TestType,                   Descr, Scheme,         RDim,          MultDepth, SModSize,      DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize,      SecLvl,       KSTech, ScalTech, LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, Slots, LowerPrecTech, HigherPrecTech
+    { COMPOSITE_SCALING_PRECISION, "01", {CKKSRNS_SCHEME, RING_DIM_PREC, 7,     SMODSIZE_COMP, DSIZE, BATCH,   DFLT,       DFLT,          FMODSIZE_COMP, HEStd_NotSet, HYBRID, DFLT,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   0,     FLEXIBLEAUTO, COMPOSITESCALINGAUTO},
+    { COMPOSITE_SCALING_PRECISION, "02", {CKKSRNS_SCHEME, RING_DIM_PREC, 7,     SMODSIZE_COMP, DSIZE, BATCH,   DFLT,       DFLT,          FMODSIZE_COMP, HEStd_NotSet, BV,     DFLT,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   0,     FLEXIBLEAUTO, COMPOSITESCALINGAUTO},
 #endif
     // ==========================================
     // TestType,               Descr, Scheme,          RDim, MultDepth, SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode
@@ -317,6 +359,8 @@ static std::vector<TEST_CASE_UTCKKSRNS> testCases = {
     { SCALE_FACTOR_ADJUSTMENTS, "06", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
     { SCALE_FACTOR_ADJUSTMENTS, "07", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
     { SCALE_FACTOR_ADJUSTMENTS, "08", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { SCALE_FACTOR_ADJUSTMENTS, "09", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE_COMP, DSIZE, BATCH,   DFLT,       DFLT,          FMODSIZE_COMP, HEStd_NotSet, BV,     COMPOSITESCALINGAUTO, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { SCALE_FACTOR_ADJUSTMENTS, "10", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE_COMP, DSIZE, BATCH,   DFLT,       DFLT,          FMODSIZE_COMP, HEStd_NotSet, HYBRID, COMPOSITESCALINGAUTO, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
 #endif
     // ==========================================
     // TestType,        Descr, Scheme,          RDim, MultDepth, SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode
@@ -329,6 +373,8 @@ static std::vector<TEST_CASE_UTCKKSRNS> testCases = {
     { AUTO_LEVEL_REDUCE, "06", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
     { AUTO_LEVEL_REDUCE, "07", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
     { AUTO_LEVEL_REDUCE, "08", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { AUTO_LEVEL_REDUCE, "09", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE_COMP, DSIZE, BATCH,   DFLT,       DFLT,          FMODSIZE_COMP, HEStd_NotSet, BV,     COMPOSITESCALINGAUTO, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { AUTO_LEVEL_REDUCE, "10", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE_COMP, DSIZE, BATCH,   DFLT,       DFLT,          FMODSIZE_COMP, HEStd_NotSet, HYBRID, COMPOSITESCALINGAUTO, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
 #endif
     // ==========================================
     // TestType, Descr, Scheme,          RDim, MultDepth, SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode
@@ -404,6 +450,8 @@ static std::vector<TEST_CASE_UTCKKSRNS> testCases = {
     { EVAL_FAST_ROTATION, "46", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   RING_DIM_HALF},
     { EVAL_FAST_ROTATION, "47", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   RING_DIM_HALF},
     { EVAL_FAST_ROTATION, "48", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   RING_DIM_HALF},
+    { EVAL_FAST_ROTATION, "49", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, KLSS,   FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   RING_DIM_HALF},
+    { EVAL_FAST_ROTATION, "50", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, KLSS,   FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   RING_DIM_HALF},
 #endif
     // ==========================================
     // TestType,  Descr,  Scheme,         RDim, MultDepth, SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, Slots
@@ -446,6 +494,10 @@ static std::vector<TEST_CASE_UTCKKSRNS> testCases = {
     { EVALATINDEX, "30", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},  RING_DIM_HALF},
     { EVALATINDEX, "31", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},  RING_DIM_HALF},
     { EVALATINDEX, "32", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},  RING_DIM_HALF},
+    { EVALATINDEX, "33", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, KLSS,   FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},  RING_DIM_HALF},
+    { EVALATINDEX, "34", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, KLSS,   FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},  RING_DIM_HALF},
+    { EVALATINDEX, "35", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE_COMP, DSIZE, BATCH,   DFLT,       DFLT,          FMODSIZE_COMP, HEStd_NotSet, BV,     COMPOSITESCALINGAUTO, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},  RING_DIM_HALF},
+    { EVALATINDEX, "36", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE_COMP, DSIZE, BATCH,   DFLT,       DFLT,          FMODSIZE_COMP, HEStd_NotSet, HYBRID, COMPOSITESCALINGAUTO, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},  RING_DIM_HALF},
 #endif
     // ==========================================
     // TestType, Descr, Scheme,         RDim, MultDepth, SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode
@@ -458,6 +510,45 @@ static std::vector<TEST_CASE_UTCKKSRNS> testCases = {
     { EVALMERGE, "06", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
     { EVALMERGE, "07", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
     { EVALMERGE, "08", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+#endif
+    // ==========================================
+    // TestType,         Descr, Scheme,         RDim, MultDepth, SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, Slots
+    { EVAL_MULT_RESCALE, "01", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { EVAL_MULT_RESCALE, "02", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { EVAL_MULT_RESCALE, "03", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDAUTO,       DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+#if NATIVEINT != 128
+    { EVAL_MULT_RESCALE, "04", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { EVAL_MULT_RESCALE, "05", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { EVAL_MULT_RESCALE, "06", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+#endif
+#if NATIVEINT != 128
+    // ==========================================
+    // TestType,            Descr, Scheme,         RDim, MultDepth, SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, Slots
+    { EVAL_ADD_MANY_LEVELS, "01", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDAUTO,       DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { EVAL_ADD_MANY_LEVELS, "02", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { EVAL_ADD_MANY_LEVELS, "03", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { EVAL_ADD_MANY_LEVELS, "04", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+#endif
+    // ==========================================
+    // TestType,         Descr, Scheme,         RDim, MultDepth, SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, Slots
+    { EVAL_ROTATION_EXT, "01", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   BATCH},
+    { EVAL_ROTATION_EXT, "02", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDAUTO,       DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   BATCH},
+#if NATIVEINT != 128
+    { EVAL_ROTATION_EXT, "03", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   BATCH},
+    { EVAL_ROTATION_EXT, "04", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   BATCH},
+#endif
+    // ==========================================
+    // TestType,    Descr, Scheme,         RDim, MultDepth, SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, Slots
+    { EVAL_MAT_MUL, "01", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},  16},
+    { EVAL_MAT_MUL, "02", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FIXEDAUTO,       DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},  16},
+    { EVAL_MAT_MUL, "03", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},  RING_DIM_HALF},
+    { EVAL_MAT_MUL, "04", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDAUTO,       DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},  RING_DIM_HALF},
+#if NATIVEINT != 128
+    { EVAL_MAT_MUL, "05", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},  16},
+    { EVAL_MAT_MUL, "06", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},  RING_DIM_HALF},
+    { EVAL_MAT_MUL, "07", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},  16},
+    { EVAL_MAT_MUL, "08", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},  RING_DIM_HALF},
+    { EVAL_MAT_MUL, "09", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE_COMP, DSIZE, BATCH,   DFLT,       DFLT,          FMODSIZE_COMP, HEStd_NotSet, HYBRID, COMPOSITESCALINGAUTO, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},  RING_DIM_HALF},
 #endif
     // ==========================================
     // TestType,       Descr, Scheme,          RDim, MultDepth, SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode
@@ -470,6 +561,8 @@ static std::vector<TEST_CASE_UTCKKSRNS> testCases = {
     { EVAL_LINEAR_WSUM, "06", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
     { EVAL_LINEAR_WSUM, "07", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
     { EVAL_LINEAR_WSUM, "08", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { EVAL_LINEAR_WSUM, "09", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE_COMP, DSIZE, BATCH,   DFLT,       DFLT,          FMODSIZE_COMP, HEStd_NotSet, BV,     COMPOSITESCALINGAUTO, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { EVAL_LINEAR_WSUM, "10", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE_COMP, DSIZE, BATCH,   DFLT,       DFLT,          FMODSIZE_COMP, HEStd_NotSet, HYBRID, COMPOSITESCALINGAUTO, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
 #endif
     // ==========================================
     // TestType,     Descr, Scheme,         RDim, MultDepth, SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode
@@ -494,6 +587,8 @@ static std::vector<TEST_CASE_UTCKKSRNS> testCases = {
     { EVAL_POLY, "06", {CKKSRNS_SCHEME, RING_DIM, 5,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
     { EVAL_POLY, "07", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
     { EVAL_POLY, "08", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { EVAL_POLY, "09", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE_COMP, DSIZE, BATCH,   DFLT,       DFLT,          FMODSIZE_COMP, HEStd_NotSet, BV,     COMPOSITESCALINGAUTO, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { EVAL_POLY, "10", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE_COMP, DSIZE, BATCH,   DFLT,       DFLT,          FMODSIZE_COMP, HEStd_NotSet, HYBRID, COMPOSITESCALINGAUTO, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
 #endif
     // ==========================================
     // TestType, Descr, Scheme,        RDim, MultDepth, SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode
@@ -521,6 +616,20 @@ static std::vector<TEST_CASE_UTCKKSRNS> testCases = {
 #endif
 #endif
     // ==========================================
+    // TestType,          Descr, Scheme,        RDim, MultDepth, SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode
+    { TRIMMED_EVAL_KEYS, "01", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { TRIMMED_EVAL_KEYS, "02", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+#if NATIVEINT != 128
+    { TRIMMED_EVAL_KEYS, "03", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { TRIMMED_EVAL_KEYS, "04", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+#endif
+    // ==========================================
+    // TestType,              Descr, Scheme,        RDim,     MultDepth, SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode
+    // one digit: the parts of QP have the largest possible size
+    { KLSS_EXACT_CONVERSION, "01", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, KLSS,   FIXEDMANUAL,     1,       DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { KLSS_EXACT_CONVERSION, "02", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, KLSS,   FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { KLSS_EXACT_CONVERSION, "03", {CKKSRNS_SCHEME, RING_DIM, 7,     SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, KLSS,   FIXEDMANUAL,     4,       DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    // ==========================================
 };
 // clang-format on
 //===========================================================================================================
@@ -982,6 +1091,33 @@ protected:
                      failmsg + " Approximation errors' comparison failed");
     }
 
+    /**
+     * Compares the precision of COMPOSITESCALINGAUTO with the scaling factor and first modulus sizes of the test
+     * case against FLEXIBLEAUTO with a scaling factor that fits in a single modulus.
+     */
+    void UnitTest_Composite_Scaling_Precision(const TEST_CASE_UTCKKSRNS& testData,
+                                              const std::string& failmsg = std::string()) {
+        TEST_CASE_UTCKKSRNS testDataLocal(testData);
+
+        std::vector<double> lowPrecisions;
+        CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+        testDataLocal.params.scalTech       = testDataLocal.lowerPrecisionTechnique;
+        testDataLocal.params.scalingModSize = SMODSIZE;
+        testDataLocal.params.firstModSize   = DFLT;
+        if (!UnitTest_Mult_Packed(testDataLocal, lowPrecisions, failmsg))
+            return;
+
+        std::vector<double> highPrecisions;
+        CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+        testDataLocal                 = testData;
+        testDataLocal.params.scalTech = testDataLocal.higherPrecisionTechnique;
+        if (!UnitTest_Mult_Packed(testDataLocal, highPrecisions, failmsg))
+            return;
+
+        checkMinDiff(highPrecisions, lowPrecisions, MIN_PRECISION_DIFF,
+                     failmsg + " Approximation errors' comparison failed");
+    }
+
     /**
      * Tests the correct operation of the following:
      * - addition/subtraction of constant to ciphertext of depth > 1
@@ -1700,6 +1836,309 @@ protected:
         }
     }
 
+    void UnitTest_EvalMatMul(const TEST_CASE_UTCKKSRNS& testData, const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            constexpr uint32_t dim = 4;
+            // matrices packed row by row
+            std::vector<double> matA(dim * dim);
+            std::vector<double> matB(dim * dim);
+            for (uint32_t i = 0; i < dim * dim; ++i) {
+                matA[i] = (static_cast<double>(i % 7) - 3) / 4;
+                matB[i] = (static_cast<double>(i % 5) - 2) / 2;
+            }
+            std::vector<double> matAB(dim * dim, 0);
+            for (uint32_t i = 0; i < dim; ++i) {
+                for (uint32_t j = 0; j < dim; ++j) {
+                    for (uint32_t k = 0; k < dim; ++k)
+                        matAB[i * dim + j] += matA[i * dim + k] * matB[k * dim + j];
+                }
+            }
+
+            KeyPair<Element> kp = cc->KeyGen();
+            cc->EvalMultKeyGen(kp.secretKey);
+            cc->EvalMatMulKeyGen(kp.secretKey, dim);
+
+            Plaintext ptA = cc->MakeCKKSPackedPlaintext(matA, 1, 0, nullptr, testData.slots);
+            Plaintext ptB = cc->MakeCKKSPackedPlaintext(matB, 1, 0, nullptr, testData.slots);
+            Ciphertext<Element> ctA = cc->Encrypt(kp.publicKey, ptA);
+            Ciphertext<Element> ctB = cc->Encrypt(kp.publicKey, ptB);
+
+            auto precom = cc->EvalMatMulPrecompute(dim, 0, testData.slots);
+            auto ctAB   = cc->EvalMatMul(ctA, ctB, precom);
+
+            Plaintext result;
+            cc->Decrypt(kp.secretKey, ctAB, &result);
+            result->SetLength(dim * dim);
+            checkEquality(matAB, result->GetRealPackedValue(), eps, failmsg + " EvalMatMul fails");
+
+            // the diagonals are reused for another product
+            auto ctAA = cc->EvalMatMul(ctA, ctA, precom);
+            cc->Decrypt(kp.secretKey, ctAA, &result);
+            result->SetLength(dim * dim);
+            std::vector<double> matAA(dim * dim, 0);
+            for (uint32_t i = 0; i < dim; ++i) {
+                for (uint32_t j = 0; j < dim; ++j) {
+                    for (uint32_t k = 0; k < dim; ++k)
+                        matAA[i * dim + j] += matA[i * dim + k] * matA[k * dim + j];
+                }
+            }
+            checkEquality(matAA, result->GetRealPackedValue(), eps, failmsg + " EvalMatMul with reused precom fails");
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+#if defined EMSCRIPTEN
+            std::string name("EMSCRIPTEN_UNKNOWN");
+#else
+            std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
+#endif
+            std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+    }
+
+    void UnitTest_EvalMultRescale(const TEST_CASE_UTCKKSRNS& testData, const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            KeyPair<Element> kp = cc->KeyGen();
+            cc->EvalMultKeyGen(kp.secretKey);
+
+            std::vector<double> x{0.5, -0.25, 1.0, 0.75, -1.0, 0.125, 0.3, -0.6};
+            std::vector<double> y{1.5, 0.5, -0.5, 2.0, 0.25, -1.25, 0.8, 1.0};
+            std::vector<double> xy(x.size());
+            std::vector<double> xyyPlusXx(x.size());
+            for (size_t i = 0; i < x.size(); ++i) {
+                xy[i]        = x[i] * y[i];
+                xyyPlusXx[i] = xy[i] * y[i] + x[i] * x[i];
+            }
+
+            Ciphertext<Element> ctX = cc->Encrypt(kp.publicKey, cc->MakeCKKSPackedPlaintext(x));
+            Ciphertext<Element> ctY = cc->Encrypt(kp.publicKey, cc->MakeCKKSPackedPlaintext(y));
+
+            // checks the decrypted values and returns their precision in bits
+            auto checkPrecision = [&](const Ciphertext<Element>& ct, const std::vector<double>& expected,
+                                      const std::string& msg) {
+                Plaintext decrypted;
+                cc->Decrypt(kp.secretKey, ct, &decrypted);
+                decrypted->SetLength(expected.size());
+                checkEquality(expected, decrypted->GetRealPackedValue(), eps, failmsg + msg);
+                return CalculateApproximationError<double>(
+                    decrypted->GetCKKSPackedValue(), std::vector<std::complex<double>>(expected.begin(), expected.end()));
+            };
+
+            // products, and sums of products at different levels
+            auto evalChain = [&]() {
+                Ciphertext<Element> ctXY = cc->EvalMult(ctX, ctY);
+                cc->RescaleInPlace(ctXY);
+                return cc->EvalAdd(cc->EvalMult(ctXY, ctY), cc->EvalSquare(ctX));
+            };
+
+            // by default FLEXIBLEAUTO products keep a pending rescale
+            Ciphertext<Element> ctXY = cc->EvalMult(ctX, ctY);
+            if (testData.params.scalTech == FLEXIBLEAUTO) {
+                EXPECT_EQ(ctXY->GetNoiseScaleDeg(), 2u) << failmsg << " EvalMult noise scale degree";
+                EXPECT_EQ(ctXY->GetLevel(), 0u) << failmsg << " EvalMult level";
+            }
+            double precisionChain    = checkPrecision(evalChain(), xyyPlusXx, " EvalMult chain fails");
+            double precisionComposed = checkPrecision(cc->ComposedEvalMult(ctX, ctY), xy, " ComposedEvalMult fails");
+
+            const bool fusable = (testData.params.ksTech == HYBRID) && (testData.params.scalTech == FLEXIBLEAUTO ||
+                                                                        testData.params.scalTech == FIXEDMANUAL);
+            if (!fusable) {
+                EXPECT_THROW(cc->EnableFusedRescale(), OpenFHEException) << failmsg;
+                return;
+            }
+
+            cc->EnableFusedRescale();
+            const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(cc->GetCryptoParameters());
+            EXPECT_TRUE(cryptoParams->GetFusedRescale()) << failmsg;
+
+            // the fused rescale returns FLEXIBLEAUTO products rescaled, and ComposedEvalMult rescales under FIXEDMANUAL
+            ctXY = cc->EvalMult(ctX, ctY);
+            if (testData.params.scalTech == FLEXIBLEAUTO) {
+                EXPECT_EQ(ctXY->GetNoiseScaleDeg(), 1u) << failmsg << " fused EvalMult noise scale degree";
+                EXPECT_EQ(ctXY->GetLevel(), 1u) << failmsg << " fused EvalMult level";
+            }
+            Ciphertext<Element> ctComposed = cc->ComposedEvalMult(ctX, ctY);
+            EXPECT_EQ(ctComposed->GetNoiseScaleDeg(), 1u) << failmsg << " ComposedEvalMult noise scale degree";
+            EXPECT_EQ(ctComposed->GetLevel(), 1u) << failmsg << " ComposedEvalMult level";
+
+            // the single ModDown by q_l*P may not lose more than a few bits compared to the separate rescale
+            double precisionChainFused    = checkPrecision(evalChain(), xyyPlusXx, " fused EvalMult chain fails");
+            double precisionComposedFused = checkPrecision(ctComposed, xy, " fused ComposedEvalMult fails");
+            EXPECT_GE(precisionChainFused, precisionChain - 3) << failmsg << " fused EvalMult chain loses precision";
+            EXPECT_GE(precisionComposedFused, precisionComposed - 3)
+                << failmsg << " fused ComposedEvalMult loses precision";
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+#if defined EMSCRIPTEN
+            std::string name("EMSCRIPTEN_UNKNOWN");
+#else
+            std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
+#endif
+            std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+    }
+
+    void UnitTest_EvalRotationExt(const TEST_CASE_UTCKKSRNS& testData, const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            const uint32_t slots    = testData.slots;
+            const uint32_t numTerms = 4;
+
+            // result[j] = sum_i w[i][j] * x[j + i], i.e., a diagonal-by-diagonal linear transform
+            std::vector<double> x(slots);
+            for (uint32_t j = 0; j < slots; ++j)
+                x[j] = 0.125 * (j % 7) - 0.25;
+            std::vector<std::vector<double>> w(numTerms, std::vector<double>(slots));
+            std::vector<double> expected(slots, 0);
+            for (uint32_t i = 0; i < numTerms; ++i) {
+                for (uint32_t j = 0; j < slots; ++j) {
+                    w[i][j] = 0.5 - 0.25 * i + 0.0625 * j;
+                    expected[j] += w[i][j] * x[(j + i) % slots];
+                }
+            }
+
+            KeyPair<Element> kp = cc->KeyGen();
+            cc->EvalAtIndexKeyGen(kp.secretKey, {1, 2, 3});
+
+            Ciphertext<Element> ct = cc->Encrypt(kp.publicKey, cc->MakeCKKSPackedPlaintext(x, 1, 0, nullptr, slots));
+            const uint32_t level   = ct->GetLevel();
+
+            // all terms are accumulated in the extended basis and scaled down once
+            auto digits             = cc->EvalFastRotationPrecompute(ct);
+            Ciphertext<Element> acc = cc->EvalMultExt(cc->KeySwitchExt(ct, true),
+                                                      cc->MakeCKKSPackedPlaintextExt(w[0], 1, level, slots));
+            for (uint32_t i = 1; i < numTerms; ++i) {
+                cc->EvalAddExtInPlace(acc, cc->EvalMultExt(cc->EvalFastRotationExt(ct, i, digits, true),
+                                                           cc->MakeCKKSPackedPlaintextExt(w[i], 1, level, slots)));
+            }
+            Ciphertext<Element> result = cc->KeySwitchDown(acc);
+            cc->RescaleInPlace(result);
+
+            Plaintext decrypted;
+            cc->Decrypt(kp.secretKey, result, &decrypted);
+            decrypted->SetLength(slots);
+            checkEquality(expected, decrypted->GetRealPackedValue(), eps,
+                          failmsg + " extended-basis accumulation fails");
+
+            // a plaintext in the regular basis cannot be multiplied in the extended basis
+            EXPECT_THROW(cc->EvalMultExt(acc, cc->MakeCKKSPackedPlaintext(w[0], 1, level, nullptr, slots)),
+                         OpenFHEException)
+                << failmsg;
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+#if defined EMSCRIPTEN
+            std::string name("EMSCRIPTEN_UNKNOWN");
+#else
+            std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
+#endif
+            std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+    }
+
+    void UnitTest_EvalAddManyLevels(const TEST_CASE_UTCKKSRNS& testData, const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            KeyPair<Element> kp = cc->KeyGen();
+            cc->EvalMultKeyGen(kp.secretKey);
+
+            const size_t numTerms = 4;
+            std::vector<std::vector<double>> x(numTerms);
+            std::vector<std::vector<double>> y(numTerms);
+            std::vector<Ciphertext<Element>> ctX(numTerms);
+            std::vector<Ciphertext<Element>> ctY(numTerms);
+            for (size_t k = 0; k < numTerms; ++k) {
+                for (size_t i = 0; i < 8; ++i) {
+                    x[k].push_back(0.1 * static_cast<double>(k + 1) - 0.05 * static_cast<double>(i));
+                    y[k].push_back(0.5 - 0.1 * static_cast<double>(k) + 0.02 * static_cast<double>(i));
+                }
+                ctX[k] = cc->Encrypt(kp.publicKey, cc->MakeCKKSPackedPlaintext(x[k]));
+                ctY[k] = cc->Encrypt(kp.publicKey, cc->MakeCKKSPackedPlaintext(y[k]));
+            }
+
+            // products with a pending rescale at two levels mixed with fresh ciphertexts
+            std::vector<Ciphertext<Element>> terms;
+            std::vector<double> expected(8, 0.0);
+            for (size_t k = 0; k < numTerms; ++k) {
+                terms.push_back(cc->EvalMult(ctX[k], ctY[k]));
+                for (size_t i = 0; i < expected.size(); ++i)
+                    expected[i] += x[k][i] * y[k][i];
+            }
+            terms.insert(terms.begin() + 1, ctX[2]);
+            terms.push_back(ctY[3]);
+            terms.insert(terms.begin() + 3, cc->EvalMult(terms[0], ctX[1]));
+            for (size_t i = 0; i < expected.size(); ++i)
+                expected[i] += x[2][i] + y[3][i] + x[0][i] * y[0][i] * x[1][i];
+
+            std::vector<uint32_t> levels;
+            for (const auto& term : terms)
+                levels.push_back(term->GetLevel());
+
+            Ciphertext<Element> ctRef = terms[0];
+            for (size_t k = 1; k < terms.size(); ++k)
+                ctRef = cc->EvalAdd(ctRef, terms[k]);
+
+            Ciphertext<Element> ctSum = cc->EvalAddMany(terms);
+            EXPECT_EQ(ctSum->GetLevel(), terms[3]->GetLevel()) << failmsg << " level of the sum";
+            EXPECT_EQ(ctSum->GetNoiseScaleDeg(), terms[3]->GetNoiseScaleDeg()) << failmsg << " noise scale degree";
+            EXPECT_EQ(ctSum->GetLevel(), ctRef->GetLevel()) << failmsg << " level of the pairwise sum";
+
+            Plaintext result;
+            cc->Decrypt(kp.secretKey, ctSum, &result);
+            result->SetLength(expected.size());
+            checkEquality(expected, result->GetRealPackedValue(), eps, failmsg + " EvalAddMany fails");
+
+            auto inPlaceTerms                = terms;
+            Ciphertext<Element> ctSumInPlace = cc->EvalAddManyInPlace(inPlaceTerms);
+            cc->Decrypt(kp.secretKey, ctSumInPlace, &result);
+            result->SetLength(expected.size());
+            checkEquality(expected, result->GetRealPackedValue(), eps, failmsg + " EvalAddManyInPlace fails");
+
+            // the inputs are not adjusted
+            for (size_t k = 0; k < terms.size(); ++k)
+                EXPECT_EQ(terms[k]->GetLevel(), levels[k]) << failmsg << " level of input " << k;
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+#if defined EMSCRIPTEN
+            std::string name("EMSCRIPTEN_UNKNOWN");
+#else
+            std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
+#endif
+            std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+    }
+
     void UnitTest_EvalLinearWSum(const TEST_CASE_UTCKKSRNS& testData, const std::string& failmsg = std::string()) {
         try {
             CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
@@ -1744,6 +2183,31 @@ protected:
             results->SetLength(pOut->GetLength());
             checkEquality(pOut->GetCKKSPackedValue(), results->GetCKKSPackedValue(), eps,
                           failmsg + " EvalLinearWSumMutable fails");
+
+            // enough terms to fill the accumulators of the fused kernel for the first modulus;
+            // the result must match term-by-term scalar products and additions exactly
+            const size_t numTerms = 300;
+            std::vector<ConstCiphertext<Element>> manyCiphertexts(numTerms);
+            std::vector<double> manyWeights(numTerms);
+            std::vector<std::complex<double>> manyOut(VECTOR_SIZE);
+            for (size_t j = 0; j < numTerms; ++j) {
+                manyCiphertexts[j] = (j % 3 == 0) ? cIn1 : ((j % 3 == 1) ? cIn2 : cIn3);
+                manyWeights[j]     = 0.01 * (static_cast<double>(j % 11) - 5);
+                for (usint i = 0; i < VECTOR_SIZE; i++)
+                    manyOut[i] += manyWeights[j] * ((j % 3 == 0) ? in1[i] : ((j % 3 == 1) ? in2[i] : in3[i]));
+            }
+
+            auto cManyResult = cc->EvalLinearWSum(manyCiphertexts, manyWeights);
+            cc->Decrypt(kp.secretKey, cManyResult, &results);
+            results->SetLength(VECTOR_SIZE);
+            checkEquality(manyOut, results->GetCKKSPackedValue(), eps, failmsg + " EvalLinearWSum of many terms fails");
+
+            auto cReference = cc->EvalMult(manyCiphertexts[0], manyWeights[0]);
+            for (size_t j = 1; j < numTerms; ++j)
+                cc->EvalAddInPlace(cReference, cc->EvalMult(manyCiphertexts[j], manyWeights[j]));
+            cc->ModReduceInPlace(cReference);
+            EXPECT_EQ(cReference->GetElements(), cManyResult->GetElements())
+                << failmsg << " EvalLinearWSum differs from EvalMult and EvalAdd";
         }
         catch (std::exception& e) {
             std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
@@ -2144,6 +2608,168 @@ protected:
             std::string name("EMSCRIPTEN_UNKNOWN");
 #else
             std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
+#endif
+            std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+    }
+
+    void UnitTest_TrimmedEvalKeys(const TEST_CASE_UTCKKSRNS& testData, const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            constexpr uint32_t LEVEL = 3;
+
+            const std::vector<std::complex<double>> vectorOfInts = {1, 0, 3, 1, 0, 1, 2, 1};
+            Plaintext plaintext                                  = cc->MakeCKKSPackedPlaintext(vectorOfInts);
+
+            const std::vector<std::complex<double>> vectorOfIntsSquare = {1, 0, 9, 1, 0, 1, 4, 1};
+            Plaintext intArrayExpectedSquare = cc->MakeCKKSPackedPlaintext(vectorOfIntsSquare);
+
+            KeyPair<Element> kp = cc->KeyGen();
+
+            // keys that only support ciphertexts at level LEVEL or above
+            cc->EvalMultKeyGen(kp.secretKey, LEVEL);
+            cc->EvalRotateKeyGen(kp.secretKey, {1}, LEVEL);
+
+            const std::string keyTag = kp.secretKey->GetKeyTag();
+            auto fullKey             = cc->GetScheme()->EvalMultKeyGen(kp.secretKey);
+            auto trimmedKey          = (*cc->GetEvalMultKeyVector(keyTag))[0];
+            EXPECT_EQ(fullKey->GetAVector()[0].GetNumOfElements() - LEVEL,
+                      trimmedKey->GetAVector()[0].GetNumOfElements())
+                << failmsg << " trimmed relinearization key has a wrong number of towers";
+            EXPECT_LE(trimmedKey->GetAVector().size(), fullKey->GetAVector().size()) << failmsg;
+
+            Ciphertext<Element> ciphertext = cc->Encrypt(kp.publicKey, plaintext);
+
+            // a ciphertext with more towers than the keys cannot be key-switched
+            EXPECT_THROW(cc->EvalRotate(ciphertext, 1), OpenFHEException) << failmsg;
+
+            // LevelReduce() drops towers in FIXEDMANUAL only
+            auto dropLevels = [&cc](ConstCiphertext<Element> ct, size_t levels) {
+                return cc->Compress(ct, ct->GetElements()[0].GetNumOfElements() - levels);
+            };
+            ciphertext = dropLevels(ciphertext, LEVEL);
+
+            Plaintext results;
+
+            Ciphertext<Element> ciphertextSq = cc->EvalSquare(ciphertext);
+            cc->Decrypt(kp.secretKey, ciphertextSq, &results);
+            results->SetLength(intArrayExpectedSquare->GetLength());
+            checkEquality(intArrayExpectedSquare->GetCKKSPackedValue(), results->GetCKKSPackedValue(), eps,
+                          failmsg + " EvalSquare with a trimmed key fails");
+
+            std::vector<std::complex<double>> vectorOfIntsRotated(vectorOfInts.size());
+            for (size_t i = 0; i < vectorOfInts.size(); ++i)
+                vectorOfIntsRotated[i] = vectorOfInts[(i + 1) % vectorOfInts.size()];
+
+            // the keys also work below the level they were trimmed to
+            Ciphertext<Element> ciphertextRot = cc->EvalRotate(dropLevels(ciphertext, 1), 1);
+            cc->Decrypt(kp.secretKey, ciphertextRot, &results);
+            results->SetLength(vectorOfIntsRotated.size());
+            checkEquality(vectorOfIntsRotated, results->GetCKKSPackedValue(), eps,
+                          failmsg + " EvalRotate with a trimmed key fails");
+
+            // a trimmed key has the same towers as the untrimmed one it was trimmed from, so key switching
+            // with either of them gives the same ciphertext at every level the trimmed key supports
+            auto trimmedFullKey = cc->GetScheme()->TrimEvalKey(fullKey, LEVEL);
+            for (size_t levels = 0; levels < 4; ++levels) {
+                auto ct         = dropLevels(ciphertext, levels);
+                auto ctFull     = cc->KeySwitch(ct, fullKey);
+                auto ctTrimmed  = cc->KeySwitch(ct, trimmedFullKey);
+                const auto& cv1 = ctFull->GetElements();
+                const auto& cv2 = ctTrimmed->GetElements();
+                ASSERT_EQ(cv1.size(), cv2.size()) << failmsg;
+                for (size_t i = 0; i < cv1.size(); ++i) {
+                    EXPECT_EQ(cv1[i], cv2[i]) << failmsg << " trimmed and untrimmed keys differ " << levels
+                                              << " levels below the trimmed level";
+                }
+            }
+
+            // trimming the stored keys further
+            cc->TrimEvalMultKeys(keyTag, LEVEL + 1);
+            cc->TrimEvalAutomorphismKeys(keyTag, LEVEL + 1);
+            EXPECT_EQ(fullKey->GetAVector()[0].GetNumOfElements() - LEVEL - 1,
+                      (*cc->GetEvalMultKeyVector(keyTag))[0]->GetAVector()[0].GetNumOfElements())
+                << failmsg;
+            EXPECT_THROW(cc->EvalSquare(ciphertext), OpenFHEException) << failmsg;
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+#if defined EMSCRIPTEN
+            std::string name("EMSCRIPTEN_UNKNOWN");
+#else
+            std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
+#endif
+            std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+    }
+
+    void UnitTest_KLSSExactConversion(const TEST_CASE_UTCKKSRNS& testData, const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(cc->GetCryptoParameters());
+            const uint32_t sizeQ    = cryptoParams->GetElementParams()->GetParams().size();
+            const uint32_t sizeP    = cryptoParams->GetParamsP()->GetParams().size();
+            const uint32_t numPartQ = cryptoParams->GetNumPartQ();
+            const uint32_t alpha    = cryptoParams->GetNumPerPartQ();
+            const uint32_t alphaQP  = cryptoParams->GetNumPerPartQP();
+            if (numPartQ == 1) {
+                EXPECT_EQ(alphaQP, std::max(sizeQ, sizeP)) << failmsg << " the parts of QP are not the largest possible";
+            }
+
+            // R exceeds twice the largest coefficient of sum_j d_j * key_{j,c} with two bits to spare
+            BigInteger maxPartQ(0);
+            for (uint32_t j = 0; j < numPartQ; ++j)
+                maxPartQ = std::max(maxPartQ, cryptoParams->GetParamsPartQ(j)->GetModulus());
+            BigInteger maxPartQP(0);
+            for (const auto& paramsPart : cryptoParams->GetParamsPartQP())
+                maxPartQP = std::max(maxPartQP, paramsPart->GetModulus());
+            const uint64_t factor = static_cast<uint64_t>(numPartQ) * cc->GetRingDimension() * alpha * alphaQP;
+            const BigInteger bound = BigInteger(factor) * maxPartQ * maxPartQP;
+            EXPECT_GT(cryptoParams->GetParamsAux()->GetModulus(), BigInteger(8) * bound)
+                << failmsg << " the auxiliary basis R is too small";
+
+            // the conversion from R is exact, so KLSS key switching gives exactly the hybrid result
+            KeySwitchHYBRID hybrid;
+            KeySwitchKLSS klss;
+            KeyPair<Element> kp    = cc->KeyGen();
+            KeyPair<Element> kpNew = cc->KeyGen();
+            auto hybridKey         = hybrid.KeySwitchGenInternal(kp.secretKey, kpNew.secretKey);
+            auto klssKey           = klss.ConvertHybridKey(hybridKey);
+
+            const std::vector<std::complex<double>> vectorOfInts = {1, 0, 3, 1, 0, 1, 2, 1};
+            Plaintext plaintext                                  = cc->MakeCKKSPackedPlaintext(vectorOfInts);
+            Ciphertext<Element> ciphertext                       = cc->Encrypt(kp.publicKey, plaintext);
+            for (uint32_t levels = 0; levels < 3; ++levels) {
+                auto ct           = cc->Compress(ciphertext, sizeQ - levels);
+                const Element& c1 = ct->GetElements()[1];
+                auto expected     = hybrid.EvalFastKeySwitchCoreExt(
+                    hybrid.EvalKeySwitchPrecomputeCore(c1, cryptoParams), hybridKey, c1.GetParams());
+                auto result = klss.EvalFastKeySwitchCoreExt(klss.EvalKeySwitchPrecomputeCore(c1, cryptoParams),
+                                                            klssKey, c1.GetParams());
+                EXPECT_TRUE((*result)[0] == (*expected)[0] && (*result)[1] == (*expected)[1])
+                    << failmsg << " KLSS and hybrid key switching differ " << levels << " levels down";
+            }
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+#if defined EMSCRIPTEN
+            std::string name("EMSCRIPTEN_UNKNOWN");
+#else
+            std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
 #endif
             std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
             // make it fail
@@ -2207,6 +2833,18 @@ TEST_P(UTCKKSRNS, CKKSRNS) {
         case EVALMERGE:
             UnitTest_EvalMerge(test, test.buildTestName());
             break;
+        case EVAL_MAT_MUL:
+            UnitTest_EvalMatMul(test, test.buildTestName());
+            break;
+        case EVAL_MULT_RESCALE:
+            UnitTest_EvalMultRescale(test, test.buildTestName());
+            break;
+        case EVAL_ADD_MANY_LEVELS:
+            UnitTest_EvalAddManyLevels(test, test.buildTestName());
+            break;
+        case EVAL_ROTATION_EXT:
+            UnitTest_EvalRotationExt(test, test.buildTestName());
+            break;
         case EVAL_LINEAR_WSUM:
             UnitTest_EvalLinearWSum(test, test.buildTestName());
             break;
@@ -2225,8 +2863,18 @@ TEST_P(UTCKKSRNS, CKKSRNS) {
         case MULT_PACKED_PRECISION:
             UnitTest_Mult_Packed_Precision(test, test.buildTestName());
             break;
+        case COMPOSITE_SCALING_PRECISION:
+            UnitTest_Composite_Scaling_Precision(test, test.buildTestName());
+            break;
         case EVALSQUARE:
             UnitTest_EvalSquare(test, test.buildTestName());
+            break;
+        case TRIMMED_EVAL_KEYS:
+            UnitTest_TrimmedEvalKeys(test, test.buildTestName());
+            break;
+        case KLSS_EXACT_CONVERSION:
+            UnitTest_KLSSExactConversion(test, test.buildTestName());
+            break;
         default:
             break;
     }
@@ -34,6 +34,7 @@
 #include "UnitTestCCParams.h"
 #include "UnitTestCryptoContext.h"
 
+#include <cstdio>
 #include <iostream>
 #include <vector>
 #include "gtest/gtest.h"
@@ -52,6 +53,8 @@ enum TEST_CASE_TYPE {
     CONTEXT_WITH_SERTYPE = 0,
     KEYS_AND_CIPHERTEXTS,
     NO_CRT_TABLES,
+    LAZY_EVAL_KEYS,
+    PACKED_EVAL_KEYS,
 };
 
 static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
@@ -66,6 +69,12 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
         case NO_CRT_TABLES:
             typeName = "NO_CRT_TABLES";
             break;
+        case LAZY_EVAL_KEYS:
+            typeName = "LAZY_EVAL_KEYS";
+            break;
+        case PACKED_EVAL_KEYS:
+            typeName = "PACKED_EVAL_KEYS";
+            break;
         default:
             typeName = "UNKNOWN";
             break;
@@ -168,6 +177,17 @@ static std::vector<TEST_CASE_UTCKKSRNS_SER> testCases = {
     { NO_CRT_TABLES, "06", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, 0,     BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
     { NO_CRT_TABLES, "07", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, 0,     BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
     { NO_CRT_TABLES, "08", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, 0,     BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+#endif
+    // ==========================================
+    // TestType,     Descr, Scheme,         RDim,     MultDepth,  SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech,  EncTech, PREMode
+    { LAZY_EVAL_KEYS, "01", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+    { LAZY_EVAL_KEYS, "02", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDAUTO,       DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+    // ==========================================
+    // TestType,       Descr, Scheme,         RDim,     MultDepth,  SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech,  EncTech, PREMode
+    { PACKED_EVAL_KEYS, "01", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+    { PACKED_EVAL_KEYS, "02", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDMANUAL,     2,       DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+#if NATIVEINT != 128
+    { PACKED_EVAL_KEYS, "03", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    3,       DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
 #endif
     // ==========================================
 };
@@ -182,13 +202,38 @@ protected:
 
     void TearDown() {
         CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+        // the file is removed here, so it is not left behind by a failed assertion
+        if (!m_keyFile.empty()) {
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+            std::remove(m_keyFile.c_str());
+        }
     }
 
+    // the file written by UnitTestLazyEvalKeys
+    std::string m_keyFile;
+
     void UnitTestContext(const TEST_CASE_UTCKKSRNS_SER& testData, const std::string& failmsg = std::string()) {
         CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
 
         UnitTestContextWithSertype(cc, SerType::JSON, "json");
         UnitTestContextWithSertype(cc, SerType::BINARY, "binary");
+
+        // the fused rescale is a part of the crypto parameters and has to survive serialization
+        if (testData.params.ksTech == HYBRID &&
+            (testData.params.scalTech == FIXEDMANUAL || testData.params.scalTech == FLEXIBLEAUTO)) {
+            cc->EnableFusedRescale();
+
+            std::stringstream s;
+            Serial::Serialize(cc, s, SerType::BINARY);
+            CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+            CryptoContext<Element> newcc;
+            Serial::Deserialize(newcc, s, SerType::BINARY);
+            ASSERT_TRUE(newcc) << failmsg << " Deserialize failed";
+
+            const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(newcc->GetCryptoParameters());
+            EXPECT_TRUE(cryptoParams->GetFusedRescale()) << failmsg << " fused rescale lost after ser/deser";
+            EXPECT_TRUE(cryptoParams->HasKeySwitchRescaleTables()) << failmsg << " fused rescale tables missing";
+        }
     }
 
     template <typename ST>
@@ -471,6 +516,171 @@ protected:
         TestDecryptionSerNoCRTTables(testData, SerType::JSON, "json");
         TestDecryptionSerNoCRTTables(testData, SerType::BINARY, "binary");
     }
+
+    void UnitTestLazyEvalKeys(const TEST_CASE_UTCKKSRNS_SER& testData, const std::string& failmsg = std::string()) {
+        m_keyFile                  = "lazy_eval_keys_" + testData.buildTestName() + ".bin";
+        const std::string& keyFile = m_keyFile;
+        try {
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+            CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            KeyPair<Element> kp = cc->KeyGen();
+            const std::vector<int32_t> indices{1, 2, 3, -1};
+            cc->EvalRotateKeyGen(kp.secretKey, indices);
+            const std::string keyTag = kp.secretKey->GetKeyTag();
+            const size_t numKeys     = cc->GetEvalAutomorphismKeyMap(keyTag)->size();
+
+            std::vector<std::complex<double>> vals = {1.0, 3.0, 5.0, 7.0, 9.0, 2.0, 4.0, 6.0, 8.0, 11.0};
+            Plaintext plaintext                    = cc->MakeCKKSPackedPlaintext(vals);
+            Ciphertext<DCRTPoly> ciphertext        = cc->Encrypt(kp.publicKey, plaintext);
+
+            ASSERT_TRUE(CryptoContextImpl<DCRTPoly>::SerializeEvalAutomorphismKeyIndexed(keyFile, keyTag))
+                << failmsg << " indexed key serialization failed";
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+
+            // at most 2 keys stay deserialized
+            ASSERT_TRUE(CryptoContextImpl<DCRTPoly>::DeserializeEvalAutomorphismKeyLazy(keyFile, 2))
+                << failmsg << " lazy key deserialization failed";
+            auto store = CryptoContextImpl<DCRTPoly>::GetEvalAutomorphismKeyStore(keyTag);
+            ASSERT_TRUE(store != nullptr) << failmsg << " no key store for the key tag";
+            EXPECT_EQ(store->GetIndices().size(), numKeys) << failmsg << " wrong number of indexed keys";
+            EXPECT_EQ(store->GetResidentCount(), 0U) << failmsg << " keys deserialized too early";
+
+            for (int32_t index : indices) {
+                auto rotated = cc->EvalRotate(ciphertext, index);
+                EXPECT_LE(store->GetResidentCount(), 2U) << failmsg << " resident key limit is exceeded";
+
+                Plaintext result;
+                cc->Decrypt(kp.secretKey, rotated, &result);
+                result->SetLength(vals.size());
+                // the slots after vals are zero, so nothing non-zero wraps around for these indices
+                std::vector<std::complex<double>> expected(vals.size());
+                for (size_t i = 0; i < vals.size(); ++i) {
+                    int32_t j   = static_cast<int32_t>(i) + index;
+                    expected[i] = (j >= 0 && j < static_cast<int32_t>(vals.size())) ? vals[j] : 0.0;
+                }
+                checkEquality(result->GetCKKSPackedValue(), expected, eps,
+                              failmsg + " rotation with a lazily loaded key fails");
+            }
+
+            // EvalMerge of two ciphertexts needs only the key for -1, so the key file stays in use
+            cc->EvalMerge({ciphertext, ciphertext});
+            EXPECT_TRUE(CryptoContextImpl<DCRTPoly>::GetEvalAutomorphismKeyStore(keyTag) != nullptr)
+                << failmsg << " EvalMerge deserializes the whole key map";
+
+            // listing all keys deserializes the lazily loaded keys and releases the key file
+            const auto allKeys = CryptoContextImpl<DCRTPoly>::GetAllEvalAutomorphismKeys();
+            ASSERT_EQ(allKeys.count(keyTag), 1U) << failmsg << " lazily loaded keys are not listed";
+            EXPECT_EQ(allKeys.at(keyTag)->size(), numKeys) << failmsg << " listed key map mismatch";
+            EXPECT_EQ(cc->GetEvalAutomorphismKeyMap(keyTag)->size(), numKeys) << failmsg << " full key map mismatch";
+            EXPECT_TRUE(CryptoContextImpl<DCRTPoly>::GetEvalAutomorphismKeyStore(keyTag) == nullptr)
+                << failmsg << " the key store is not released";
+
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+            CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+#if defined EMSCRIPTEN
+            std::string name("EMSCRIPTEN_UNKNOWN");
+#else
+            std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
+#endif
+            std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+    }
+
+    template <typename ST>
+    void TestPackedEvalKeys(const TEST_CASE_UTCKKSRNS_SER& testData, const ST& sertype,
+                            const std::string& failmsg = std::string()) {
+        try {
+            CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            KeyPair<Element> kp = cc->KeyGen();
+            auto evalKey =
+                std::dynamic_pointer_cast<EvalKeyRelinImpl<Element>>(cc->GetScheme()->EvalMultKeyGen(kp.secretKey));
+            ASSERT_TRUE(evalKey != nullptr) << failmsg << " not a relinearization key";
+
+            const std::vector<Element> av = evalKey->CopyAVector();
+            const std::vector<Element> bv = evalKey->CopyBVector();
+
+            // packing and unpacking gives the same key
+            auto packedKey = evalKey->GetPackedKey();
+            EXPECT_EQ(packedKey->GetNumDigits(), av.size()) << failmsg << " wrong number of digits";
+            EXPECT_EQ(packedKey->GetNumTowers(), av[0].GetNumOfElements()) << failmsg << " wrong number of towers";
+            std::vector<Element> avUnpacked;
+            std::vector<Element> bvUnpacked;
+            packedKey->Unpack(bvUnpacked, avUnpacked);
+            EXPECT_TRUE(av == avUnpacked && bv == bvUnpacked) << failmsg << " unpacked key mismatch";
+            EXPECT_TRUE(av == evalKey->CopyAVector() && bv == evalKey->CopyBVector())
+                << failmsg << " copies of the packed key mismatch";
+            EXPECT_EQ(packedKey, evalKey->GetPackedKey()) << failmsg << " the key is packed again";
+
+            // the inner product with the packed key is the same as with the per-digit polynomials
+            std::vector<std::complex<double>> vals = {1.0, 3.0, 5.0, 7.0, 9.0, 2.0, 4.0, 6.0, 8.0, 11.0};
+            Plaintext plaintext                    = cc->MakeCKKSPackedPlaintext(vals);
+            Ciphertext<DCRTPoly> ciphertext        = cc->Encrypt(kp.publicKey, plaintext);
+            const Element& c1                      = ciphertext->GetElements()[1];
+
+            auto digits = cc->GetScheme()->EvalKeySwitchPrecomputeCore(c1, cc->GetCryptoParameters());
+            auto result = cc->GetScheme()->EvalFastKeySwitchCoreExt(digits, evalKey, c1.GetParams());
+            Element expected0 = (*digits)[0] * bv[0];
+            Element expected1 = (*digits)[0] * av[0];
+            for (size_t j = 1; j < digits->size(); ++j) {
+                expected0 += (*digits)[j] * bv[j];
+                expected1 += (*digits)[j] * av[j];
+            }
+            EXPECT_TRUE((*result)[0] == expected0 && (*result)[1] == expected1)
+                << failmsg << " packed and per-digit key switching differ";
+
+            // a packed key is serialized like an unpacked one and stays packed
+            std::stringstream s;
+            Serial::Serialize(std::static_pointer_cast<EvalKeyImpl<Element>>(evalKey), s, sertype);
+            EXPECT_EQ(packedKey, evalKey->GetPackedKey()) << failmsg << " serialization unpacked the key";
+
+            EvalKey<Element> newKey;
+            Serial::Deserialize(newKey, s, sertype);
+            ASSERT_TRUE(newKey) << failmsg << " key deserialization failed";
+            EXPECT_TRUE(*newKey == *evalKey) << failmsg << " deserialized key mismatch";
+            EXPECT_TRUE(av == newKey->CopyAVector() && bv == newKey->CopyBVector())
+                << failmsg << " deserialized key components mismatch";
+
+            auto newResult = cc->GetScheme()->EvalFastKeySwitchCoreExt(digits, newKey, c1.GetParams());
+            EXPECT_TRUE((*newResult)[0] == expected0 && (*newResult)[1] == expected1)
+                << failmsg << " key switching with the deserialized key fails";
+
+            CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+#if defined EMSCRIPTEN
+            std::string name("EMSCRIPTEN_UNKNOWN");
+#else
+            std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
+#endif
+            std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+    }
+    void UnitTestPackedEvalKeys(const TEST_CASE_UTCKKSRNS_SER& testData, const std::string& failmsg = std::string()) {
+        TestPackedEvalKeys(testData, SerType::JSON, failmsg + " json");
+        TestPackedEvalKeys(testData, SerType::BINARY, failmsg + " binary");
+    }
 };
 //===========================================================================================================
 TEST_P(UTCKKSRNS_SER, CKKSSer) {
@@ -483,6 +693,10 @@ TEST_P(UTCKKSRNS_SER, CKKSSer) {
         UnitTestKeysAndCiphertexts(test, test.buildTestName());
     else if (test.testCaseType == NO_CRT_TABLES)
         UnitTestDecryptionSerNoCRTTables(test, test.buildTestName());
+    else if (test.testCaseType == LAZY_EVAL_KEYS)
+        UnitTestLazyEvalKeys(test, test.buildTestName());
+    else if (test.testCaseType == PACKED_EVAL_KEYS)
+        UnitTestPackedEvalKeys(test, test.buildTestName());
 }
 
 INSTANTIATE_TEST_SUITE_P(UnitTests, UTCKKSRNS_SER, ::testing::ValuesIn(testCases), testName);
@@ -36,7 +36,10 @@
 #include "UnitTestUtils.h"
 #include "UnitTestCCParams.h"
 #include "UnitTestCryptoContext.h"
+#include "math/chebyshev.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <vector>
 #include "gtest/gtest.h"
@@ -52,12 +55,15 @@ enum TEST_CASE_TYPE {
     EVAL_CHEB_DIVISION,
     EVAL_CHEB_LOGIT,
     EVAL_CHEB_LOGIT_NOLIN,
+    EVAL_CHEB_BASIS,
     EVAL_CHEB_SINE,
     EVAL_CHEB_POLY,
     EVAL_DIVIDE,
     EVAL_LOGISTIC,
     EVAL_SIN,
     EVAL_COS,
+    EVAL_COMPARE,
+    EVAL_SORT,
 };
 
 static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
@@ -75,6 +81,9 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
         case EVAL_CHEB_LOGIT_NOLIN:
             typeName = "EVAL_CHEB_LOGIT_NOLIN";
             break;
+        case EVAL_CHEB_BASIS:
+            typeName = "EVAL_CHEB_BASIS";
+            break;
         case EVAL_CHEB_SINE:
             typeName = "EVAL_CHEB_SINE";
             break;
@@ -93,6 +102,12 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
         case EVAL_COS:
             typeName = "EVAL_COS";
             break;
+        case EVAL_COMPARE:
+            typeName = "EVAL_COMPARE";
+            break;
+        case EVAL_SORT:
+            typeName = "EVAL_SORT";
+            break;
         default:
             typeName = "UNKNOWN";
             break;
@@ -136,6 +151,10 @@ constexpr uint32_t RDIM       = 512;
 constexpr uint32_t RDIM_LRG   = 1024;
 constexpr uint32_t MULT_DEPTH = 10;
 constexpr uint32_t BATCH      = 8;
+// EvalSign with gap 0.05 and 6 bits of precision consumes 11 levels; EvalMax adds one level,
+// every stage of EvalSortSlots adds two levels and sorting 4 values takes 3 stages
+constexpr uint32_t CMP_DEPTH  = 12;
+constexpr uint32_t SORT_DEPTH = 39;
 
 #if NATIVEINT == 128 && !defined(__EMSCRIPTEN__)
 constexpr uint32_t SMODSIZE = 78;
@@ -193,6 +212,18 @@ static std::vector<TEST_CASE_UTCKKSRNS_EVAL_POLY> testCases = {
     { EVAL_CHEB_LOGIT_NOLIN, "06", {CKKSRNS_SCHEME, RDIM_LRG, MULT_DEPTH, SMODSIZE,   DFLT,  16,      UNIFORM_TERNARY, DFLT,          FMODSIZE, HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,       DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT} },
     { EVAL_CHEB_LOGIT_NOLIN, "07", {CKKSRNS_SCHEME, RDIM_LRG, MULT_DEPTH, SMODSIZE,   DFLT,  16,      UNIFORM_TERNARY, DFLT,          FMODSIZE, HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,       DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT} },
     { EVAL_CHEB_LOGIT_NOLIN, "08", {CKKSRNS_SCHEME, RDIM_LRG, MULT_DEPTH, SMODSIZE,   DFLT,  16,      UNIFORM_TERNARY, DFLT,          FMODSIZE, HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,       DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT} },
+#endif
+    // ==========================================
+    // TestType,       Descr, Scheme,         RDim,     MultDepth,  SModSize,   DSize, BatchSz, SecKeyDist,      MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits,    PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode
+    { EVAL_CHEB_BASIS, "01", {CKKSRNS_SCHEME, RDIM_LRG, MULT_DEPTH, SMODSIZE,   DFLT,  16,      UNIFORM_TERNARY, DFLT,          FMODSIZE, HEStd_NotSet, HYBRID, FIXEDMANUAL,     DFLT,       DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT} },
+    { EVAL_CHEB_BASIS, "02", {CKKSRNS_SCHEME, RDIM_LRG, MULT_DEPTH, SMODSIZE,   DFLT,  16,      UNIFORM_TERNARY, DFLT,          FMODSIZE, HEStd_NotSet, HYBRID, FIXEDAUTO,       DFLT,       DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT} },
+    { EVAL_CHEB_BASIS, "03", {CKKSRNS_SCHEME, RDIM_LRG, MULT_DEPTH, SMODSIZE,   DFLT,  16,      UNIFORM_TERNARY, DFLT,          FMODSIZE, HEStd_NotSet, HYBRID, FIXEDMANUAL,     DFLT,       DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT} },
+    { EVAL_CHEB_BASIS, "04", {CKKSRNS_SCHEME, RDIM_LRG, MULT_DEPTH, SMODSIZE,   DFLT,  16,      UNIFORM_TERNARY, DFLT,          FMODSIZE, HEStd_NotSet, HYBRID, FIXEDAUTO,       DFLT,       DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT} },
+#if NATIVEINT != 128
+    { EVAL_CHEB_BASIS, "05", {CKKSRNS_SCHEME, RDIM_LRG, MULT_DEPTH, SMODSIZE,   DFLT,  16,      UNIFORM_TERNARY, DFLT,          FMODSIZE, HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,       DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT} },
+    { EVAL_CHEB_BASIS, "06", {CKKSRNS_SCHEME, RDIM_LRG, MULT_DEPTH, SMODSIZE,   DFLT,  16,      UNIFORM_TERNARY, DFLT,          FMODSIZE, HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,       DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT} },
+    { EVAL_CHEB_BASIS, "07", {CKKSRNS_SCHEME, RDIM_LRG, MULT_DEPTH, SMODSIZE,   DFLT,  16,      UNIFORM_TERNARY, DFLT,          FMODSIZE, HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,       DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT} },
+    { EVAL_CHEB_BASIS, "08", {CKKSRNS_SCHEME, RDIM_LRG, MULT_DEPTH, SMODSIZE,   DFLT,  16,      UNIFORM_TERNARY, DFLT,          FMODSIZE, HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,       DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT} },
 #endif
     // ==========================================
     // TestType,      Descr, Scheme,         RDim,     MultDepth,  SModSize,   DSize, BatchSz, SecKeyDist,      MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits,    PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode
@@ -265,6 +296,18 @@ static std::vector<TEST_CASE_UTCKKSRNS_EVAL_POLY> testCases = {
     { EVAL_COS, "06", {CKKSRNS_SCHEME, RDIM_LRG, MULT_DEPTH, SMODSIZE,   DFLT,  16,      UNIFORM_TERNARY, DFLT,          FMODSIZE, HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,       DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT} },
     { EVAL_COS, "07", {CKKSRNS_SCHEME, RDIM_LRG, MULT_DEPTH, SMODSIZE,   DFLT,  16,      UNIFORM_TERNARY, DFLT,          FMODSIZE, HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,       DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT} },
     { EVAL_COS, "08", {CKKSRNS_SCHEME, RDIM_LRG, MULT_DEPTH, SMODSIZE,   DFLT,  16,      UNIFORM_TERNARY, DFLT,          FMODSIZE, HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,       DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT} },
+#endif
+    // ==========================================
+    // TestType,    Descr, Scheme,         RDim,     MultDepth,  SModSize,   DSize, BatchSz, SecKeyDist,      MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits,    PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode
+    { EVAL_COMPARE, "01", {CKKSRNS_SCHEME, RDIM_LRG, CMP_DEPTH,  SMODSIZE,   DFLT,  BATCH,   UNIFORM_TERNARY, DFLT,          FMODSIZE, HEStd_NotSet, HYBRID, FIXEDAUTO,       DFLT,       DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT} },
+#if NATIVEINT != 128
+    { EVAL_COMPARE, "02", {CKKSRNS_SCHEME, RDIM_LRG, CMP_DEPTH,  SMODSIZE,   DFLT,  BATCH,   UNIFORM_TERNARY, DFLT,          FMODSIZE, HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,       DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT} },
+#endif
+    // ==========================================
+    // TestType, Descr, Scheme,         RDim,     MultDepth,  SModSize,   DSize, BatchSz, SecKeyDist,      MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits,    PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode
+    { EVAL_SORT, "01", {CKKSRNS_SCHEME, RDIM_LRG, SORT_DEPTH, SMODSIZE,   DFLT,  BATCH,   UNIFORM_TERNARY, DFLT,          FMODSIZE, HEStd_NotSet, HYBRID, FIXEDAUTO,       DFLT,       DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT} },
+#if NATIVEINT != 128
+    { EVAL_SORT, "02", {CKKSRNS_SCHEME, RDIM_LRG, SORT_DEPTH, SMODSIZE,   DFLT,  BATCH,   UNIFORM_TERNARY, DFLT,          FMODSIZE, HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,       DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT} },
 #endif
     // ==========================================
 };
@@ -557,6 +600,80 @@ protected:
         }
     }
 
+    void UnitTest_EvalChebBasis(const TEST_CASE_UTCKKSRNS_EVAL_POLY& testData,
+                                const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            std::vector<std::complex<double>> input{-4.0, -3.0, -2.0, -1.0, 0.0, 1.0, 2.0, 3.0, 4.0};
+            size_t encodedLength = input.size();
+
+            double a = -4;
+            double b = 4;
+
+            std::vector<double> coeffLogit({1.0, 0.558971, 0.0, -0.0943712, 0.0, 0.0215023, 0.0, -0.00505348, 0.0,
+                                            0.00119324, 0.0, -0.000281928, 0.0, 0.0000664347, 0.0, -0.0000148709});
+            std::vector<std::complex<double>> outputLogit(
+                {0.0179885, 0.0474289, 0.119205, 0.268936, 0.5, 0.731064, 0.880795, 0.952571, 0.982011});
+
+            // a second series of the same degree
+            uint32_t degree = 15;
+            std::vector<double> coeffSin =
+                EvalChebyshevCoefficients([](double x) { return std::sin(x); }, a, b, degree);
+            std::vector<std::complex<double>> outputSin(encodedLength);
+            for (size_t i = 0; i < encodedLength; ++i)
+                outputSin[i] = std::sin(input[i].real());
+
+            auto keyPair = cc->KeyGen();
+            cc->EvalMultKeyGen(keyPair.secretKey);
+            auto ciphertext1 = cc->Encrypt(keyPair.publicKey, cc->MakeCKKSPackedPlaintext(input));
+
+            auto basis = cc->EvalChebyshevPowerBasis(ciphertext1, degree, a, b);
+
+            auto decrypt = [&](ConstCiphertext<Element> ciphertext) {
+                Plaintext plaintextDec;
+                cc->Decrypt(keyPair.secretKey, ciphertext, &plaintextDec);
+                plaintextDec->SetLength(encodedLength);
+                std::vector<std::complex<double>> result = plaintextDec->GetCKKSPackedValue();
+                result.resize(encodedLength);
+                return result;
+            };
+
+            auto results = cc->EvalChebyshevSeriesWithBasis(basis, {coeffLogit, coeffSin});
+            ASSERT_EQ(results.size(), 2u) << failmsg;
+            checkEquality(outputLogit, decrypt(results[0]), eps,
+                          failmsg + " EvalChebyshevSeriesWithBasis approximation for logistic function fails");
+            checkEquality(outputSin, decrypt(results[1]), eps,
+                          failmsg + " EvalChebyshevSeriesWithBasis approximation for sine function fails");
+
+            // the basis is not modified by the evaluation and gives the same result as EvalChebyshevSeries
+            auto resultLogit = cc->EvalChebyshevSeriesWithBasis(basis, coeffLogit);
+            auto reference   = cc->EvalChebyshevSeries(ciphertext1, coeffLogit, a, b);
+            EXPECT_EQ(resultLogit->GetLevel(), reference->GetLevel()) << failmsg;
+            checkEquality(decrypt(reference), decrypt(resultLogit), eps,
+                          failmsg + " EvalChebyshevSeriesWithBasis differs from EvalChebyshevSeries");
+
+            // a series with other Paterson-Stockmeyer degrees cannot use the basis
+            std::vector<double> coeffOther(60, 0.01);
+            EXPECT_THROW(cc->EvalChebyshevSeriesWithBasis(basis, coeffOther), OpenFHEException) << failmsg;
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+#if defined EMSCRIPTEN
+            std::string name("EMSCRIPTEN_UNKNOWN");
+#else
+            std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
+#endif
+            std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+    }
+
     void UnitTest_EvalChebSine(const TEST_CASE_UTCKKSRNS_EVAL_POLY& testData,
                                const std::string& failmsg = std::string()) {
         try {
@@ -798,6 +915,86 @@ protected:
 
         checkEquality(expectedOutput, finalResult, eps, failmsg + " EvalCos Chebyshev approximation fails");
     }
+    void UnitTest_EvalCompare(const TEST_CASE_UTCKKSRNS_EVAL_POLY& testData,
+                              const std::string& failmsg = std::string()) {
+        CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+        std::vector<double> input1{0.5, -0.3, 0.9, 0.1, -0.8, 0.0, 0.35, -0.55};
+        std::vector<double> input2{0.2, 0.4, -0.9, 0.25, -0.6, 0.7, 0.05, -0.4};
+        size_t encodedLength = input1.size();
+
+        auto keyPair = cc->KeyGen();
+        cc->EvalMultKeyGen(keyPair.secretKey);
+        auto ciphertext1 = cc->Encrypt(keyPair.publicKey, cc->MakeCKKSPackedPlaintext(input1));
+        auto ciphertext2 = cc->Encrypt(keyPair.publicKey, cc->MakeCKKSPackedPlaintext(input2));
+
+        // the differences are at least 0.1 = gap * bound apart from zero
+        double bound       = 2;
+        double gap         = 0.05;
+        uint32_t precision = 6;
+        double epsCompare  = std::ldexp(1.0, -static_cast<int32_t>(precision));
+
+        std::vector<double> expectedSign(encodedLength);
+        std::vector<double> expectedCompare(encodedLength);
+        std::vector<double> expectedMax(encodedLength);
+        std::vector<double> expectedMin(encodedLength);
+        for (size_t i = 0; i < encodedLength; ++i) {
+            expectedSign[i]    = (input1[i] > 0) ? 1.0 : ((input1[i] < 0) ? -1.0 : 0.0);
+            expectedCompare[i] = (input1[i] > input2[i]) ? 1.0 : 0.0;
+            expectedMax[i]     = std::max(input1[i], input2[i]);
+            expectedMin[i]     = std::min(input1[i], input2[i]);
+        }
+
+        auto decrypt = [&](ConstCiphertext<Element> ciphertext) {
+            Plaintext plaintextDec;
+            cc->Decrypt(keyPair.secretKey, ciphertext, &plaintextDec);
+            plaintextDec->SetLength(encodedLength);
+            return plaintextDec->GetRealPackedValue();
+        };
+
+        checkEquality(expectedSign, decrypt(cc->EvalSign(ciphertext1, 1.0, 2 * gap, precision)), epsCompare,
+                      failmsg + " EvalSign fails");
+        checkEquality(expectedCompare, decrypt(cc->EvalCompare(ciphertext1, ciphertext2, bound, gap, precision)),
+                      epsCompare, failmsg + " EvalCompare fails");
+        checkEquality(expectedMax, decrypt(cc->EvalMax(ciphertext1, ciphertext2, bound, gap, precision)),
+                      bound * epsCompare, failmsg + " EvalMax fails");
+        checkEquality(expectedMin, decrypt(cc->EvalMin(ciphertext1, ciphertext2, bound, gap, precision)),
+                      bound * epsCompare, failmsg + " EvalMin fails");
+    }
+    void UnitTest_EvalSort(const TEST_CASE_UTCKKSRNS_EVAL_POLY& testData, const std::string& failmsg = std::string()) {
+        CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+        // only the first 4 values are compared; the other slots must not change
+        std::vector<double> input{0.5, -0.3, 0.9, 0.1, -0.8, 0.0, 0.35, -0.55};
+        std::vector<double> expectedSorted{-0.3, 0.1, 0.5, 0.9, -0.8, 0.0, 0.35, -0.55};
+        size_t encodedLength = input.size();
+        uint32_t numValues   = 4;
+
+        auto keyPair = cc->KeyGen();
+        cc->EvalMultKeyGen(keyPair.secretKey);
+        cc->EvalCompareSlotsKeyGen(keyPair.secretKey, numValues);
+        auto ciphertext = cc->Encrypt(keyPair.publicKey, cc->MakeCKKSPackedPlaintext(input));
+
+        double bound       = 2;
+        double gap         = 0.05;
+        uint32_t precision = 6;
+        double epsSort     = bound * std::ldexp(1.0, -static_cast<int32_t>(precision));
+
+        auto decrypt = [&](ConstCiphertext<Element> ciphertext) {
+            Plaintext plaintextDec;
+            cc->Decrypt(keyPair.secretKey, ciphertext, &plaintextDec);
+            plaintextDec->SetLength(encodedLength);
+            return plaintextDec->GetRealPackedValue();
+        };
+
+        auto max = decrypt(cc->EvalMaxSlots(ciphertext, numValues, bound, gap, precision));
+        auto min = decrypt(cc->EvalMinSlots(ciphertext, numValues, bound, gap, precision));
+        EXPECT_NEAR(max[0], 0.9, epsSort) << failmsg << " EvalMaxSlots fails";
+        EXPECT_NEAR(min[0], -0.3, epsSort) << failmsg << " EvalMinSlots fails";
+
+        checkEquality(expectedSorted, decrypt(cc->EvalSortSlots(ciphertext, numValues, bound, gap, precision)),
+                      epsSort, failmsg + " EvalSortSlots fails");
+    }
 };
 
 //===========================================================================================================
@@ -818,6 +1015,9 @@ TEST_P(UTCKKSRNS_EVAL_POLY, CKKSRNS) {
         case EVAL_CHEB_LOGIT_NOLIN:
             UnitTest_EvalChebLogitNoLin(test, test.buildTestName());
             break;
+        case EVAL_CHEB_BASIS:
+            UnitTest_EvalChebBasis(test, test.buildTestName());
+            break;
         case EVAL_CHEB_SINE:
             UnitTest_EvalChebSine(test, test.buildTestName());
             break;
@@ -836,6 +1036,12 @@ TEST_P(UTCKKSRNS_EVAL_POLY, CKKSRNS) {
         case EVAL_COS:
             UnitTest_EvalCos(test, test.buildTestName());
             break;
+        case EVAL_COMPARE:
+            UnitTest_EvalCompare(test, test.buildTestName());
+            break;
+        case EVAL_SORT:
+            UnitTest_EvalSort(test, test.buildTestName());
+            break;
         default:
             break;
     }
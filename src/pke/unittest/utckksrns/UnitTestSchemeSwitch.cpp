@@ -61,6 +61,7 @@ enum TEST_CASE_TYPE {
     SCHEME_SWITCH_ARGMIN,
     SCHEME_SWITCH_ALT_ARGMIN,
     SCHEME_SWITCH_SERIALIZE,
+    SCHEME_SWITCH_COMPOSITE_SCALING,
 };
 
 static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
@@ -84,6 +85,9 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
         case SCHEME_SWITCH_SERIALIZE:
             typeName = "SCHEME_SWITCH_SERIALIZE";
             break;
+        case SCHEME_SWITCH_COMPOSITE_SCALING:
+            typeName = "SCHEME_SWITCH_COMPOSITE_SCALING";
+            break;
         default:
             typeName = "UNKNOWN";
             break;
@@ -140,6 +144,9 @@ constexpr uint32_t FMODSIZE = 80;
 #else
 constexpr uint32_t SMODSIZE = 50;
 constexpr uint32_t FMODSIZE = 60;
+// COMPOSITESCALINGAUTO splits every level into 2 moduli
+constexpr uint32_t SMODSIZE_COMP = 78;
+constexpr uint32_t FMODSIZE_COMP = 89;
 #endif
 
 // clang-format off
@@ -248,6 +255,11 @@ static std::vector<TEST_CASE_UTCKKSRNS_SCHEMESWITCH> testCases = {
     { SCHEME_SWITCH_SERIALIZE, "05", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH2, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 16, 16 }, 25, 8, 8},
     { SCHEME_SWITCH_SERIALIZE, "06", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH2, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 16, 16 }, 25, 8, 8},
 #endif
+#if NATIVEINT != 128
+    // ==========================================
+    // TestType,     Descr, Scheme,          RDim, MultDepth,  SModSize,      DSize, BatchSz, SecKeyDist,      MaxRelinSkDeg, FModSize,      SecLvl,       KSTech, ScalTech,             LDigits,      PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, Dim1, LogQ, NumValues, Slots
+    { SCHEME_SWITCH_COMPOSITE_SCALING, "01", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH1, SMODSIZE_COMP, DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE_COMP, HEStd_NotSet, HYBRID, COMPOSITESCALINGAUTO, NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 16, 16 }, 25, 8, 8},
+#endif
 };
 // clang-format on
 //===========================================================================================================
@@ -806,6 +818,44 @@ protected:
             std::string name("EMSCRIPTEN_UNKNOWN");
 #else
             std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
+#endif
+            std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+    }
+
+    void UnitTest_SchemeSwitch_CompositeScaling(const TEST_CASE_UTCKKSRNS_SCHEMESWITCH& testData,
+                                                const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            cc->Enable(SCHEMESWITCH);
+
+            // scheme switching does not support COMPOSITESCALINGAUTO in either direction
+            SchSwchParams params;
+            params.SetSecurityLevelCKKS(HEStd_NotSet);
+            params.SetSecurityLevelFHEW(TOY);
+            params.SetCtxtModSizeFHEWLargePrec(testData.logQ);
+            params.SetNumSlotsCKKS(testData.slots);
+            EXPECT_THROW(cc->EvalCKKStoFHEWSetup(params), OpenFHEException) << failmsg << " CKKS to FHEW";
+            EXPECT_THROW(cc->EvalSchemeSwitchingSetup(params), OpenFHEException) << failmsg << " CKKS to FHEW and back";
+
+            auto ccLWE = std::make_shared<BinFHEContext>();
+            ccLWE->BinFHEContext::GenerateBinFHEContext(TOY, false, testData.logQ, 0, GINX, false);
+            EXPECT_THROW(cc->EvalFHEWtoCKKSSetup(ccLWE, testData.slots, testData.logQ), OpenFHEException)
+                << failmsg << " FHEW to CKKS";
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+#if defined EMSCRIPTEN
+            std::string name("EMSCRIPTEN_UNKNOWN");
+#else
+            std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
 #endif
             std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
             // make it fail
@@ -838,6 +888,9 @@ TEST_P(UTCKKSRNS_SCHEMESWITCH, CKKSRNS) {
         case SCHEME_SWITCH_SERIALIZE:
             UnitTest_SchemeSwitch_Serialize(test, test.buildTestName());
             break;
+        case SCHEME_SWITCH_COMPOSITE_SCALING:
+            UnitTest_SchemeSwitch_CompositeScaling(test, test.buildTestName());
+            break;
         default:
             break;
     }